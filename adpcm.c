@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file adpcm.c
+*
+*   \brief IMA-ADPCM (4 bits per sample) decoder and encoder.
+*
+*   Decoding is incremental: ADPCM_fill() decodes exactly the frames the
+*   I2S transmit path asks for, straight into its block buffers, so a
+*   prompt costs a quarter of its 16-bit size in memory and no decode
+*   buffer is needed. The encoder follows the usual IMA reference and is
+*   meant for preparing prompts on a host, see tools/adpcm_encode; it
+*   produces the same codes the decoder expects.
+*
+*/
+
+#include "adpcm.h"
+
+static const Int16 adpcmIndexTable[16] =
+{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const Int16 adpcmStepTable[89] =
+{
+	    7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+	   19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+	   50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+	  130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+	  337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+	  876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+	 2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+	 5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+/* Applies one 4-bit code to the state and returns the new sample */
+static Int16 ADPCM_step(ADPCM_State *state, Uint16 code)
+{
+	Int16  step;
+	Int32  diff;
+	Int32  sample;
+	Int16  index;
+
+	step = adpcmStepTable[state->index];
+
+	/* diff = (code + 0.5) * step / 4, computed as in the IMA reference */
+	diff = step >> 3;
+	if (code & 4)
+	{
+		diff += step;
+	}
+	if (code & 2)
+	{
+		diff += step >> 1;
+	}
+	if (code & 1)
+	{
+		diff += step >> 2;
+	}
+
+	sample = state->predictor;
+	if (code & 8)
+	{
+		sample -= diff;
+	}
+	else
+	{
+		sample += diff;
+	}
+
+	if (sample > 32767)
+	{
+		sample = 32767;
+	}
+	else if (sample < -32768)
+	{
+		sample = -32768;
+	}
+
+	index = state->index + adpcmIndexTable[code & 0xF];
+	if (index < 0)
+	{
+		index = 0;
+	}
+	else if (index > 88)
+	{
+		index = 88;
+	}
+
+	state->predictor = (Int16)sample;
+	state->index     = index;
+
+	return ((Int16)sample);
+}
+
+/**
+ *
+ * \brief Sets the decoder/encoder state
+ *
+ * \param  state     - state
+ * \param  predictor - initial sample
+ * \param  index     - initial step index, 0 to 88
+ *
+ * \return void
+ *
+ */
+void ADPCM_init(ADPCM_State *state, Int16 predictor, Int16 index)
+{
+	state->predictor = predictor;
+	state->index     = (index < 0) ? 0 : ((index > 88) ? 88 : index);
+}
+
+/**
+ *
+ * \brief Decodes 'count' samples starting at code number 'offset'
+ *
+ * \param  state  - decoder state, updated
+ * \param  codes  - packed codes, four per word
+ * \param  offset - index of the first code to decode
+ * \param  out    - decoded samples
+ * \param  count  - number of samples
+ *
+ * \return void
+ *
+ */
+void ADPCM_decode(ADPCM_State *state, const Uint16 *codes, Uint32 offset,
+                  Int16 *out, Uint16 count)
+{
+	const Uint16 *word;
+	Uint16        shift;
+	Uint16        bits;
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	word  = &codes[offset >> 2];
+	shift = (Uint16)(offset & 3) << 2;
+	bits  = *word >> shift;
+
+	while (count--)
+	{
+		*out++ = ADPCM_step(state, bits & 0xF);
+
+		shift += 4;
+		if (shift == 16)
+		{
+			/* The next word may lie past the end of the codes */
+			shift = 0;
+			if (count != 0)
+			{
+				bits = *++word;
+			}
+		}
+		else
+		{
+			bits >>= 4;
+		}
+	}
+}
+
+/**
+ *
+ * \brief Encodes 'count' samples into codes starting at code 'offset'
+ *
+ * \param  state  - encoder state, updated exactly as the decoder's will be
+ * \param  in     - 16-bit samples
+ * \param  codes  - packed codes, four per word
+ * \param  offset - index of the first code to write
+ * \param  count  - number of samples
+ *
+ * \return void
+ *
+ */
+void ADPCM_encode(ADPCM_State *state, const Int16 *in, Uint16 *codes,
+                  Uint32 offset, Uint16 count)
+{
+	Int32  diff;
+	Int16  step;
+	Uint16 code;
+	Uint16 shift;
+	Uint16 *word;
+
+	while (count--)
+	{
+		step = adpcmStepTable[state->index];
+		diff = (Int32)*in++ - state->predictor;
+
+		code = 0;
+		if (diff < 0)
+		{
+			code = 8;
+			diff = -diff;
+		}
+		if (diff >= step)
+		{
+			code |= 4;
+			diff -= step;
+		}
+		if (diff >= (step >> 1))
+		{
+			code |= 2;
+			diff -= step >> 1;
+		}
+		if (diff >= (step >> 2))
+		{
+			code |= 1;
+		}
+
+		/* Track the decoder so that errors do not accumulate */
+		ADPCM_step(state, code);
+
+		word  = &codes[offset >> 2];
+		shift = (Uint16)(offset & 3) << 2;
+		*word = (*word & ~(0xFU << shift)) | (code << shift);
+		offset++;
+	}
+}
+
+/**
+ *
+ * \brief Prepares a prompt for ADPCM_fill()
+ *
+ * \param  stream  - stream object
+ * \param  codes   - packed codes
+ * \param  samples - number of samples in 'codes'
+ * \param  start   - encoder state at the first sample
+ * \param  loop    - restart from the beginning at the end
+ *
+ * \return void
+ *
+ */
+void ADPCM_streamInit(ADPCM_Stream *stream, const Uint16 *codes,
+                      Uint32 samples, const ADPCM_State *start, Bool loop)
+{
+	stream->codes      = codes;
+	stream->samples    = samples;
+	stream->position   = 0;
+	stream->state      = *start;
+	stream->startState = *start;
+	stream->loop       = loop;
+}
+
+/**
+ *
+ * \brief I2S_DmaFillFxn that decodes the next block of an ADPCM_Stream
+ *        ('arg') into the left channel and copies it to the right.
+ *        Silence is output once a non-looping stream has ended.
+ *
+ */
+void ADPCM_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg)
+{
+	ADPCM_Stream *stream = (ADPCM_Stream *)arg;
+	Uint32        remain;
+	Uint16        count;
+	Uint16        done = 0;
+
+	while (done < frames)
+	{
+		remain = stream->samples - stream->position;
+		if (remain == 0)
+		{
+			if (!stream->loop)
+			{
+				memset(&left[done], 0, (frames - done) * sizeof(Int16));
+				break;
+			}
+			stream->position = 0;
+			stream->state    = stream->startState;
+			continue;
+		}
+
+		count = frames - done;
+		if (count > remain)
+		{
+			count = (Uint16)remain;
+		}
+
+		ADPCM_decode(&stream->state, stream->codes, stream->position,
+		             &left[done], count);
+
+		stream->position += count;
+		done += count;
+	}
+
+	memcpy(right, left, frames * sizeof(Int16));
+}
+
+/**
+ *
+ * \brief Returns TRUE once a non-looping stream has played out
+ *
+ */
+Bool ADPCM_streamDone(const ADPCM_Stream *stream)
+{
+	return ((!stream->loop && (stream->position == stream->samples)) ?
+	        TRUE : FALSE);
+}
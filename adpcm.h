@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file adpcm.h
+*
+*   \brief IMA-ADPCM (4 bits per sample) decoder and encoder.
+*
+*/
+
+#ifndef _ADPCM_H_
+#define _ADPCM_H_
+
+#include "audio_common.h"
+
+/* Words needed to hold 'samples' 4-bit codes */
+#define ADPCM_WORDS(samples)    (((samples) + 3) >> 2)
+
+typedef struct
+{
+	Int16   predictor;      /* last decoded sample */
+	Int16   index;          /* step table index    */
+} ADPCM_State;
+
+/**
+ * \brief Mono ADPCM prompt played through an I2S_DmaFillFxn. Codes are
+ *        packed four per word, first sample in the least significant
+ *        nibble, which is the byte stream order of IMA-ADPCM.
+ */
+typedef struct
+{
+	const Uint16   *codes;
+	Uint32          samples;
+	Uint32          position;
+	ADPCM_State     state;
+	ADPCM_State     startState;
+	Bool            loop;
+} ADPCM_Stream;
+
+void ADPCM_init(ADPCM_State *state, Int16 predictor, Int16 index);
+void ADPCM_decode(ADPCM_State *state, const Uint16 *codes, Uint32 offset,
+                  Int16 *out, Uint16 count);
+void ADPCM_encode(ADPCM_State *state, const Int16 *in, Uint16 *codes,
+                  Uint32 offset, Uint16 count);
+
+void ADPCM_streamInit(ADPCM_Stream *stream, const Uint16 *codes,
+                      Uint32 samples, const ADPCM_State *start, Bool loop);
+void ADPCM_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg);
+Bool ADPCM_streamDone(const ADPCM_Stream *stream);
+
+#endif /* _ADPCM_H_ */
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file aic3206_cache.c
+*
+*   \brief Page aware shadow copy of the AIC3206 registers.
+*
+*   Every value written to or read from pages 0 and 1 is kept in a shadow
+*   table along with the currently selected page. AIC3206_write() and
+*   AIC3206_writeSeq() ask the shadow before going to the bus, so page
+*   selects to the page already selected and writes of a value the
+*   register already holds are dropped. A software reset (page 0,
+*   register 1, bit 0) clears the shadow since every register returns to
+*   its default.
+*
+*   The self-clearing reset register and the status/flag registers are
+*   never served from the shadow.
+*
+*/
+
+#include "aic3206_cache.h"
+#include "aic3206_seq.h"
+
+static Uint8   cacheValue[AIC3206_CACHE_PAGES][AIC3206_CACHE_REGS];
+static Uint16  cacheValid[AIC3206_CACHE_PAGES][AIC3206_CACHE_REGS / 16];
+static Uint16  cachePage = AIC3206_PAGE_UNKNOWN;
+
+static AIC3206_CacheStats cacheStats;
+
+/* Registers whose contents the codec changes on its own */
+static Bool AIC3206_cacheVolatile(Uint16 page, Uint16 reg)
+{
+	if (page == 0)
+	{
+		/* Software reset, DAC/ADC flag and interrupt status registers */
+		return ((reg == 1) || ((reg >= 36) && (reg <= 47))) ? TRUE : FALSE;
+	}
+
+	/* Page 1: PGA gain and analog status flags */
+	return ((reg == 62) || (reg == 63)) ? TRUE : FALSE;
+}
+
+/* TRUE and the value in '*value' if the shadow holds the register */
+static Bool AIC3206_cacheLookup(Uint16 page, Uint16 reg, Uint16 *value)
+{
+	if ((page >= AIC3206_CACHE_PAGES) || (reg >= AIC3206_CACHE_REGS) ||
+	    AIC3206_cacheVolatile(page, reg))
+	{
+		return (FALSE);
+	}
+
+	if ((cacheValid[page][reg >> 4] & (1 << (reg & 0xF))) == 0)
+	{
+		return (FALSE);
+	}
+
+	*value = cacheValue[page][reg];
+
+	return (TRUE);
+}
+
+/* Records the register contents */
+static void AIC3206_cacheStore(Uint16 page, Uint16 reg, Uint16 value)
+{
+	if ((page >= AIC3206_CACHE_PAGES) || (reg >= AIC3206_CACHE_REGS))
+	{
+		return;
+	}
+
+	cacheValue[page][reg] = (Uint8)(value & 0xFF);
+	cacheValid[page][reg >> 4] |= (1 << (reg & 0xF));
+}
+
+/**
+ *
+ * \brief Forgets every shadowed register. The selected page is reset to
+ *        page 0, which is where the codec comes out of reset.
+ *
+ */
+void AIC3206_cacheInvalidate(void)
+{
+	memset(cacheValid, 0, sizeof(cacheValid));
+	cachePage = 0;
+	cacheStats.invalidates++;
+}
+
+/**
+ *
+ * \brief Forgets every shadowed register and the selected page, for when
+ *        a write may or may not have reached the codec
+ *
+ */
+void AIC3206_cacheForget(void)
+{
+	memset(cacheValid, 0, sizeof(cacheValid));
+	cachePage = AIC3206_PAGE_UNKNOWN;
+	cacheStats.invalidates++;
+}
+
+/**
+ *
+ * \brief Returns the selected page, AIC3206_PAGE_UNKNOWN before the first
+ *        page select
+ *
+ */
+Uint16 AIC3206_cachePage(void)
+{
+	return (cachePage);
+}
+
+/**
+ *
+ * \brief Tells whether the shadow says a register already holds a value.
+ *        Register 0 is the page select and 'page' is ignored for it.
+ *
+ * \param  page  - page of the register
+ * \param  reg   - register number
+ * \param  value - value to compare against
+ *
+ * \return TRUE if the codec already holds the value
+ *
+ */
+Bool AIC3206_cacheHolds(Uint16 page, Uint16 reg, Uint16 value)
+{
+	Uint16 cached;
+
+	if (reg == 0)
+	{
+		return ((cachePage == value) ? TRUE : FALSE);
+	}
+
+	if (AIC3206_cacheLookup(page, reg, &cached) && (cached == (value & 0xFF)))
+	{
+		return (TRUE);
+	}
+
+	return (FALSE);
+}
+
+/**
+ *
+ * \brief Tells whether a write has to go to the codec, counting the
+ *        writes that can be skipped
+ *
+ * \param  page  - page the write is meant for
+ * \param  reg   - register number, 0 for a page select
+ * \param  value - value to write
+ *
+ * \return TRUE if the write is needed, FALSE if it can be skipped
+ *
+ */
+Bool AIC3206_cacheNeedsWrite(Uint16 page, Uint16 reg, Uint16 value)
+{
+	if (!AIC3206_cacheHolds(page, reg, value))
+	{
+		return (TRUE);
+	}
+
+	if (reg == 0)
+	{
+		cacheStats.pageSkipped++;
+	}
+	else
+	{
+		cacheStats.writesSkipped++;
+	}
+
+	return (FALSE);
+}
+
+/**
+ *
+ * \brief Updates the shadow after a successful write
+ *
+ * \param  page  - page the write went to
+ * \param  reg   - register number, 0 for a page select
+ * \param  value - value written
+ *
+ */
+void AIC3206_cacheWritten(Uint16 page, Uint16 reg, Uint16 value)
+{
+	cacheStats.writesIssued++;
+
+	if (reg == 0)
+	{
+		cachePage = value;
+	}
+	else if ((page == 0) && (reg == 1) && (value & 0x01))
+	{
+		AIC3206_cacheInvalidate();
+	}
+	else if (page != AIC3206_PAGE_UNKNOWN)
+	{
+		AIC3206_cacheStore(page, reg, value);
+	}
+}
+
+/**
+ *
+ * \brief This function reads a codec register on the selected page,
+ *        from the shadow when it holds the register
+ *
+ * \param  regnum - register number
+ * \param  regval - returns the register contents
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS AIC3206_read(Uint16 regnum, Uint16 *regval)
+{
+	if (regnum == 0)
+	{
+		if (cachePage != AIC3206_PAGE_UNKNOWN)
+		{
+			cacheStats.readHits++;
+			*regval = cachePage;
+			return (TEST_PASS);
+		}
+	}
+	else if (AIC3206_cacheLookup(cachePage, regnum, regval))
+	{
+		cacheStats.readHits++;
+		return (TEST_PASS);
+	}
+
+	cacheStats.readMisses++;
+
+	if (AIC3206_busRead(regnum, regval) != TEST_PASS)
+	{
+		return (TEST_FAIL);
+	}
+
+	if (regnum == 0)
+	{
+		cachePage = *regval;
+	}
+	else if (cachePage != AIC3206_PAGE_UNKNOWN)
+	{
+		AIC3206_cacheStore(cachePage, regnum, *regval);
+	}
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Copies the shadow hit/miss counters
+ *
+ */
+void AIC3206_getCacheStats(AIC3206_CacheStats *stats)
+{
+	*stats = cacheStats;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file aic3206_cache.h
+*
+*   \brief Page aware shadow copy of the AIC3206 registers.
+*
+*/
+
+#ifndef _AIC3206_CACHE_H_
+#define _AIC3206_CACHE_H_
+
+#include "audio_common.h"
+
+#define AIC3206_CACHE_PAGES     (2)
+#define AIC3206_CACHE_REGS      (128)
+#define AIC3206_PAGE_UNKNOWN    (0xFF)
+
+typedef struct
+{
+	Uint32  writesIssued;     /* register writes that reached the bus     */
+	Uint32  writesSkipped;    /* writes dropped, value already in codec   */
+	Uint32  pageSkipped;      /* page selects dropped, page already set   */
+	Uint32  readHits;         /* AIC3206_read() served from the shadow    */
+	Uint32  readMisses;       /* AIC3206_read() that went to the codec    */
+	Uint32  invalidates;
+} AIC3206_CacheStats;
+
+void   AIC3206_cacheInvalidate(void);
+void   AIC3206_cacheForget(void);
+Uint16 AIC3206_cachePage(void);
+Bool   AIC3206_cacheHolds(Uint16 page, Uint16 reg, Uint16 value);
+Bool   AIC3206_cacheNeedsWrite(Uint16 page, Uint16 reg, Uint16 value);
+void   AIC3206_cacheWritten(Uint16 page, Uint16 reg, Uint16 value);
+TEST_STATUS AIC3206_read(Uint16 regnum, Uint16 *regval);
+void   AIC3206_getCacheStats(AIC3206_CacheStats *stats);
+
+#endif /* _AIC3206_CACHE_H_ */
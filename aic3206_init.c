@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file aic3206_init.c
+*
+*   \brief AIC3206 bring-up sequences of the playback test.
+*
+*   The power up sequence goes out with AIC3206_writeSeqNoWait() so that
+*   the 40ms reference wait overlaps the clock setup; the routing
+*   sequence needs the reference and follows AIC3206_seqWait(). The
+*   sample rate registers in between come from audio_set_sample_rate().
+*
+*/
+
+#include "aic3206_init.h"
+
+#define AIC3206_SEQ_LEN(seq)    (sizeof(seq) / sizeof(seq[0]))
+
+/* Reset, codec interface and analog supplies. Only the reset and the
+ * reference power up need a wait; the reference comes last so that its
+ * 40ms run while the clocks and the rest of the board are set up. */
+const AIC3206_RegSeq aic3206PowerUpSeq[] =
+{
+	/* page reg  value delay */
+	{ 0,   1,   0x01,  1 },    // Reset codec, wait 1ms
+	{ 0,   27,  0x0d,  0 },    // BCLK and WCLK are set as o/p; AIC3206(Master)
+	{ 0,   28,  0x00,  0 },    // Data ofset = 0
+	{ 1,   1,   0x08,  0 },    // Disable crude AVDD generation from DVDD
+	{ 1,   2,   0x01,  0 },    // Enable Analog Blocks, use LDO power
+	{ 1,   123, 0x05,  40 }    // Force reference to power up in 40ms
+};
+
+const Uint16 aic3206PowerUpLen = AIC3206_SEQ_LEN(aic3206PowerUpSeq);
+
+/* DAC and ADC routing and power up. The ADC input routing is sorted so
+ * that neighbouring registers go out as one burst. */
+const AIC3206_RegSeq aic3206RoutingSeq[] =
+{
+	/* page reg  value delay */
+	{ 1,   12,  0x08,  0 },    // LDAC AFIR routed to HPL
+	{ 1,   13,  0x08,  0 },    // RDAC AFIR routed to HPR
+	{ 0,   64,  0x02,  0 },    // Left vol=right vol
+	{ 0,   65,  0x00,  0 },    // Left DAC gain to 0dB VOL; Right tracks Left
+	{ 0,   63,  0xd4,  0 },    // Power up left,right data paths and set channel
+	{ 1,   16,  0x00,  0 },    // Unmute HPL , 0dB gain
+	{ 1,   17,  0x00,  0 },    // Unmute HPR , 0dB gain
+	{ 1,   9,   0x30,  1 },    // Power up HPL,HPR, wait 1 msec
+	{ 1,   52,  0x30,  0 },    // STEREO 1 Jack, IN2_L to LADC_P through 40 kohm
+	{ 1,   54,  0x03,  0 },    // CM_1 (common mode) to LADC_M through 40 kohm
+	{ 1,   55,  0x30,  0 },    // IN2_R to RADC_P through 40 kohmm
+	{ 1,   57,  0xc0,  0 },    // CM_1 (common mode) to RADC_M through 40 kohm
+	{ 1,   59,  0x00,  0 },    // MIC_PGA_L unmute
+	{ 1,   60,  0x00,  0 },    // MIC_PGA_R unmute
+	{ 0,   81,  0xc0,  0 },    // Powerup Left and Right ADC
+	{ 0,   82,  0x00,  1 }     // Unmute Left and Right ADC, wait 1 msec
+};
+
+const Uint16 aic3206RoutingLen = AIC3206_SEQ_LEN(aic3206RoutingSeq);
@@ -0,0 +1,535 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file aic3206_seq.c
+*
+*   \brief AIC3206 register sequences written as auto-increment I2C bursts.
+*
+*   The AIC3206 auto-increments its register pointer on writes, so any run
+*   of consecutive registers on the same page can go out as a single I2C
+*   transaction: register address followed by the data bytes. The writer
+*   splits a sequence into such runs, inserts page selects only when the
+*   page changes, and only waits where an entry asks for it. Entries the
+*   register shadow says the codec already holds are left out.
+*
+*   AIC3206_writeSeqNoWait() leaves the wait of the last entry pending, so
+*   that work not involving the delayed block (other codec pages, other
+*   peripherals) can run meanwhile; AIC3206_seqWait() finishes it.
+*
+*   Once I2C_asyncOpen() has run, bursts are queued on the interrupt
+*   driven driver instead of being sent with the polled CSL call. The
+*   shadow is updated when a burst is queued; a burst that fails later
+*   makes the shadow forget everything, as it no longer knows what the
+*   codec holds. A wait entry first lets the queue drain, so the wait
+*   counts from the write that asked for it.
+*
+*/
+
+#include "aic3206_seq.h"
+#include "aic3206_cache.h"
+#include "i2c_clock.h"
+#include "timebase.h"
+#include "cpu_idle.h"
+#include "bin_log.h"
+#include "i2c_async.h"
+
+static AIC3206_SeqStats seqStats;
+
+/* Queued bursts. A slot is free again once the burst queued
+ * I2C_ASYNC_QUEUE_SIZE bursts before it has completed, which is the
+ * case whenever the queue has room. */
+static Uint16           busBuf[I2C_ASYNC_QUEUE_SIZE][AIC3206_SEQ_MAX_BURST];
+static Uint16           busNext;
+static volatile Uint16  busFailed;
+static Uint16           busFailedSeen;
+
+/* Queued register read; busReadBusy holds the buffers from the submit
+ * to the completion, which the driver calls for aborts too */
+static Uint16           busReadReg;
+static Uint16           busReadData;
+static Uint16           busReadSeq;
+static volatile Bool    busReadBusy;
+static volatile Bool    busReadDone;
+static CSL_Status       busReadStatus;
+
+/* Deadline of a wait left pending by AIC3206_writeSeqNoWait() */
+static Uint32 seqReadyAt;
+static Bool   seqWaitPending;
+
+/* Accounts for one transaction of 'dataBytes' register bytes */
+static void AIC3206_seqCount(Uint16 dataBytes)
+{
+	Uint16 bytes;
+
+	/* Slave address + register address + data */
+	bytes = 2 + dataBytes;
+
+	seqStats.transactions++;
+	seqStats.bytes += bytes;
+	/* 9 clocks per byte plus start and stop */
+	seqStats.busTimeUs += (((Uint32)bytes * 9 + 2) * 1000000) /
+	                      I2C_clockGetBusRate();
+}
+
+/* Completion of a queued burst, in the I2C ISR */
+static void AIC3206_busWriteDone(CSL_Status status, void *arg)
+{
+	if (status != CSL_SOK)
+	{
+		busFailed++;
+	}
+}
+
+/* Completion of a queued read, in the I2C ISR */
+static void AIC3206_busReadDone(CSL_Status status, void *arg)
+{
+	/* Only the read still waited for takes the status */
+	if ((Uint16)(size_t)arg == busReadSeq)
+	{
+		busReadStatus = status;
+		busReadDone   = TRUE;
+	}
+	busReadBusy = FALSE;
+}
+
+/* Reports queued bursts that have failed since the last check */
+static TEST_STATUS AIC3206_busCheck(void)
+{
+	Uint16 failed = busFailed;
+
+	if (failed == busFailedSeen)
+	{
+		return (TEST_PASS);
+	}
+
+	busFailedSeen = failed;
+	AIC3206_cacheForget();
+	BLOG0(BLOG_ID_I2C_WR_FAIL);
+
+	return (TEST_FAIL);
+}
+
+/**
+ *
+ * \brief Writes 'count' consecutive registers starting at 'reg' in one
+ *        auto-increment transaction. With the async driver open the
+ *        burst is only queued; AIC3206_busDrain() waits for it.
+ *
+ * \param  reg    - first register
+ * \param  values - register data, one byte per word
+ * \param  count  - number of registers, 1 to AIC3206_SEQ_MAX_BURST
+ *
+ * \return
+ * \n      TEST_PASS  - Written or queued
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS AIC3206_busWrite(Uint16 reg, const Uint16 *values, Uint16 count)
+{
+	Int16   retVal;
+	Uint16  startStop = ((CSL_I2C_START) | (CSL_I2C_STOP));
+	Uint16  cmd[AIC3206_SEQ_MAX_BURST + 1];
+	Uint16 *buf;
+	Uint32  deadline;
+	Uint16  i;
+
+	if (I2C_asyncIsOpen())
+	{
+		AIC3206_busCheck();
+
+		/* Room in the queue frees the slot as well */
+		deadline = C55x_deadline(AIC3206_BUS_TIMEOUT_USEC);
+		while (I2C_asyncPending() >= I2C_ASYNC_QUEUE_SIZE)
+		{
+			if (C55x_deadlinePassed(deadline))
+			{
+				BLOG0(BLOG_ID_I2C_WR_FAIL);
+				return (TEST_FAIL);
+			}
+		}
+
+		buf = busBuf[busNext & (I2C_ASYNC_QUEUE_SIZE - 1)];
+		for (i = 0; i < count; i++)
+		{
+			buf[i] = values[i];
+		}
+
+		if (I2C_asyncBurst(AIC3206_I2C_ADDR, reg & 0x007F, buf, count,
+		                   AIC3206_busWriteDone, NULL) != TEST_PASS)
+		{
+			BLOG0(BLOG_ID_I2C_WR_FAIL);
+			return (TEST_FAIL);
+		}
+		busNext++;
+
+		return (TEST_PASS);
+	}
+
+	cmd[0] = reg & 0x007F;      // 7-bit Device Register
+	for (i = 0; i < count; i++)
+	{
+		cmd[i + 1] = values[i]; // 8-bit Register Data
+	}
+
+	retVal = I2C_write(cmd, count + 1, AIC3206_I2C_ADDR,
+	                   TRUE, startStop, CSL_I2C_MAX_TIMEOUT);
+	if (retVal != 0)
+	{
+		BLOG0(BLOG_ID_I2C_WR_FAIL);
+		return (TEST_FAIL);
+	}
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Reads one codec register on the selected page, through the
+ *        async driver when it is open
+ *
+ * \param  reg   - register number
+ * \param  value - returns the register contents
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS AIC3206_busRead(Uint16 reg, Uint16 *value)
+{
+	Int16       retVal;
+	Uint16      startStop = ((CSL_I2C_START) | (CSL_I2C_STOP));
+	Uint16      subAddr;
+	Uint16      data;
+	Uint32      deadline;
+
+	if (I2C_asyncIsOpen())
+	{
+		deadline = C55x_deadline(AIC3206_BUS_TIMEOUT_USEC);
+
+		/* A read that timed out may still be on the bus with the
+		 * buffers */
+		while (busReadBusy)
+		{
+			if (C55x_deadlinePassed(deadline))
+			{
+				BLOG0(BLOG_ID_I2C_RD_FAIL);
+				return (TEST_FAIL);
+			}
+		}
+
+		/* Queued behind any pending bursts, so it reads what they wrote */
+		busReadReg  = reg & 0x007F;
+		busReadSeq++;
+		busReadDone = FALSE;
+		busReadBusy = TRUE;
+
+		while (I2C_asyncWriteRead(AIC3206_I2C_ADDR, &busReadReg, 1,
+		                          &busReadData, 1, AIC3206_busReadDone,
+		                          (void *)(size_t)busReadSeq) != TEST_PASS)
+		{
+			if (C55x_deadlinePassed(deadline))
+			{
+				busReadBusy = FALSE;
+				BLOG0(BLOG_ID_I2C_RD_FAIL);
+				return (TEST_FAIL);
+			}
+		}
+
+		while (!busReadDone)
+		{
+			if (C55x_deadlinePassed(deadline))
+			{
+				BLOG0(BLOG_ID_I2C_RD_FAIL);
+				return (TEST_FAIL);
+			}
+		}
+
+		if (busReadStatus != CSL_SOK)
+		{
+			BLOG0(BLOG_ID_I2C_RD_FAIL);
+			return (TEST_FAIL);
+		}
+
+		*value = busReadData & 0xFF;
+
+		return (TEST_PASS);
+	}
+
+	subAddr = reg & 0x007F;
+	retVal = I2C_read(&data, 1, AIC3206_I2C_ADDR, &subAddr, 1,
+	                  TRUE, startStop, CSL_I2C_MAX_TIMEOUT, FALSE);
+	if (retVal != 0)
+	{
+		BLOG0(BLOG_ID_I2C_RD_FAIL);
+		return (TEST_FAIL);
+	}
+
+	*value = data & 0xFF;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Waits until the queued bursts are on the bus
+ *
+ * \return
+ * \n      TEST_PASS  - All written
+ * \n      TEST_FAIL  - A burst failed or the bus did not drain
+ *
+ */
+TEST_STATUS AIC3206_busDrain(void)
+{
+	Uint32 deadline;
+
+	if (!I2C_asyncIsOpen())
+	{
+		return (TEST_PASS);
+	}
+
+	deadline = C55x_deadline(AIC3206_BUS_TIMEOUT_USEC);
+	while (I2C_asyncPending() != 0)
+	{
+		if (C55x_deadlinePassed(deadline))
+		{
+			BLOG0(BLOG_ID_I2C_WR_FAIL);
+			return (TEST_FAIL);
+		}
+	}
+
+	return (AIC3206_busCheck());
+}
+
+/* Sends one burst of a sequence */
+static TEST_STATUS AIC3206_burst(Uint16 reg, const Uint16 *values,
+                                 Uint16 count)
+{
+	AIC3206_seqCount(count);
+
+	return (AIC3206_busWrite(reg, values, count));
+}
+
+/**
+ *
+ * \brief Writes a register sequence, merging runs of consecutive
+ *        registers into bursts
+ *
+ * \param  seq       - register sequence
+ * \param  count     - number of entries
+ * \param  deferLast - leave the wait of the last entry pending
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+static TEST_STATUS AIC3206_writeSeqRun(const AIC3206_RegSeq *seq,
+                                       Uint16 count, Bool deferLast)
+{
+	Uint16 values[AIC3206_SEQ_MAX_BURST];
+	Uint16 page;
+	Uint16 first;
+	Uint16 len;
+	Uint16 i = 0;
+	Uint16 j;
+
+	while (i < count)
+	{
+		page = seq[i].page;
+
+		if (!AIC3206_cacheNeedsWrite(page, seq[i].reg, seq[i].value))
+		{
+			i++;
+			continue;
+		}
+
+		if (AIC3206_cacheNeedsWrite(page, 0, page))
+		{
+			if (AIC3206_burst(0, &page, 1) != TEST_PASS)
+			{
+				return (TEST_FAIL);
+			}
+			AIC3206_cacheWritten(page, 0, page);
+		}
+
+		/* Extend the run while registers are consecutive, on the same
+		 * page, not already in the codec and nothing has to be waited
+		 * for */
+		first = i;
+		len   = 0;
+		do
+		{
+			values[len++] = seq[i].value;
+			i++;
+		} while ((i < count) && (len < AIC3206_SEQ_MAX_BURST) &&
+		         (seq[i].page == page) &&
+		         (seq[i].reg == seq[i - 1].reg + 1) &&
+		         (seq[i - 1].delayMs == 0) &&
+		         !AIC3206_cacheHolds(page, seq[i].reg, seq[i].value));
+
+		if (AIC3206_burst(seq[first].reg, values, len) != TEST_PASS)
+		{
+			return (TEST_FAIL);
+		}
+
+		for (j = first; j < i; j++)
+		{
+			AIC3206_cacheWritten(page, seq[j].reg, seq[j].value);
+		}
+
+		seqStats.writes += len;
+
+		if (seq[i - 1].delayMs != 0)
+		{
+			if (AIC3206_busDrain() != TEST_PASS)
+			{
+				return (TEST_FAIL);
+			}
+
+			if (deferLast && (i == count))
+			{
+				seqReadyAt = C55x_deadline((Uint32)seq[i - 1].delayMs *
+				                           1000);
+				seqWaitPending = TRUE;
+			}
+			else
+			{
+				C55x_delay_msec(seq[i - 1].delayMs);
+				seqStats.delayMs += seq[i - 1].delayMs;
+			}
+		}
+	}
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief This function writes a register sequence to the codec, merging
+ *        runs of consecutive registers into bursts
+ *
+ * \param  seq   - register sequence
+ * \param  count - number of entries
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS AIC3206_writeSeq(const AIC3206_RegSeq *seq, Uint16 count)
+{
+	if (AIC3206_writeSeqRun(seq, count, FALSE) != TEST_PASS)
+	{
+		return (TEST_FAIL);
+	}
+
+	return (AIC3206_busDrain());
+}
+
+/**
+ *
+ * \brief Writes a register sequence like AIC3206_writeSeq(), but returns
+ *        without the wait of the last entry, and with the async driver
+ *        open possibly before the last bursts are on the bus.
+ *        AIC3206_seqWait() has to be called before anything that depends
+ *        on it.
+ *
+ * \param  seq   - register sequence
+ * \param  count - number of entries
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS AIC3206_writeSeqNoWait(const AIC3206_RegSeq *seq, Uint16 count)
+{
+	return (AIC3206_writeSeqRun(seq, count, TRUE));
+}
+
+/**
+ *
+ * \brief Finishes the bursts and the wait left pending by
+ *        AIC3206_writeSeqNoWait()
+ *
+ * \return Microseconds actually waited
+ *
+ */
+Uint32 AIC3206_seqWait(void)
+{
+	Uint32 start;
+	Uint32 waitStart;
+	Uint32 now;
+
+	start = C55x_nowUsec();
+
+	/* Bursts still queued by AIC3206_writeSeqNoWait() */
+	AIC3206_busDrain();
+
+	if (seqWaitPending)
+	{
+		/* Only what is left of the delay counts, the rest overlapped */
+		waitStart = C55x_nowUsec();
+		now = C55x_nowCycles();
+		if (!C55x_deadlinePassed(seqReadyAt))
+		{
+			C55x_idleDelayUsec(C55x_cyclesToUsec(seqReadyAt - now));
+		}
+		seqWaitPending = FALSE;
+
+		seqStats.delayMs += (C55x_nowUsec() - waitStart + 999) / 1000;
+	}
+
+	return (C55x_nowUsec() - start);
+}
+
+/**
+ *
+ * \brief Copies the accumulated transfer statistics
+ *
+ */
+void AIC3206_getSeqStats(AIC3206_SeqStats *stats)
+{
+	*stats = seqStats;
+}
+
+/**
+ *
+ * \brief Clears the transfer statistics
+ *
+ */
+void AIC3206_clearSeqStats(void)
+{
+	memset(&seqStats, 0, sizeof(seqStats));
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file aic3206_seq.h
+*
+*   \brief AIC3206 register sequences written as auto-increment I2C bursts.
+*
+*/
+
+#ifndef _AIC3206_SEQ_H_
+#define _AIC3206_SEQ_H_
+
+#include "audio_common.h"
+
+/* Longest auto-increment burst, in data bytes */
+#define AIC3206_SEQ_MAX_BURST   (16)
+
+/* Longest wait for the async I2C queue, a full queue at 100 kHz */
+#define AIC3206_BUS_TIMEOUT_USEC    (20000)
+
+/**
+ * \brief One register write. 'delayMs' is waited after the write and ends
+ *        any burst; page selects are generated by the writer and must not
+ *        appear in a sequence.
+ */
+typedef struct
+{
+	Uint8   page;
+	Uint8   reg;
+	Uint8   value;
+	Uint8   delayMs;
+} AIC3206_RegSeq;
+
+typedef struct
+{
+	Uint32  writes;         /* register writes requested              */
+	Uint32  transactions;   /* I2C transactions issued                */
+	Uint32  bytes;          /* bytes on the bus, address included     */
+	Uint32  delayMs;        /* explicit waits                         */
+	Uint32  busTimeUs;      /* estimated bus time at the I2C rate     */
+} AIC3206_SeqStats;
+
+TEST_STATUS AIC3206_writeSeq(const AIC3206_RegSeq *seq, Uint16 count);
+TEST_STATUS AIC3206_writeSeqNoWait(const AIC3206_RegSeq *seq, Uint16 count);
+Uint32 AIC3206_seqWait(void);
+TEST_STATUS AIC3206_busWrite(Uint16 reg, const Uint16 *values, Uint16 count);
+TEST_STATUS AIC3206_busRead(Uint16 reg, Uint16 *value);
+TEST_STATUS AIC3206_busDrain(void);
+void AIC3206_getSeqStats(AIC3206_SeqStats *stats);
+void AIC3206_clearSeqStats(void);
+
+#endif /* _AIC3206_SEQ_H_ */
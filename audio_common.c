@@ -39,66 +39,75 @@
 */
 
 #include "audio_common.h"
+#include "aic3206_cache.h"
+#include "aic3206_seq.h"
+#include "cmd_queue.h"
+#include "i2c_clock.h"
+#include "timebase.h"
+#include "bin_log.h"
+#include "gpio_event.h"
+
+/* Button selectable tones. These are the pitches the 48-sample sine table
+ * used to give when MDAC was re-clocked to 7, 16, 19 and 22. */
+#define TONE_FREQ_DEFAULT   (1000)
+#define TONE_FREQ_SW4       (438)
+#define TONE_FREQ_SW3       (368)
+#define TONE_FREQ_SW3_SW4   (318)
 
 CSL_I2sHandle   hI2s = 0;
 volatile Uint16  sw3Pressed = 0;
 volatile Uint16  sw3Pressed_reworked = 0;
 volatile Uint16  sw4Pressed = 0;
+/* Playback tone, changed by the button handlers */
+volatile Uint16  toneFreqHz = TONE_FREQ_DEFAULT;
+/* I2S_POLLED by default, switched by the DMA and interrupt driven modes */
+Uint16           i2sOpMode = I2S_POLLED;
 
 /**
- *  \brief  GPIO Interrupt Service Routine
+ *  \brief  SW3 press, from GPIO_eventDispatch()
  *
- *  \param testArgs   [IN]   Test arguments
+ *  Every other press selects the SW3 tone, combined with SW4 if that is
+ *  also on.
+ *
+ *  \param event   [IN]   Debounced edge
+ *  \param arg     [IN]   Unused
  *
  *  \return none
  */
-interrupt void gpioISR(void)
+static void sw3Handler(const GPIO_Event *event, void *arg)
 {
-   	Int16 retVal;
-
-	IRQ_globalDisable();
-	/* Disable all the interrupts */
-	IRQ_disableAll();
+    C55x_msgWrite("SW3 is pressed\n\r");
 
-    /* Check for GPIO Interrupt Flag Register */
-	if((1 == GPIO_statusBit(gpioHandle,CSL_GPIO_PIN13,&retVal)))
-    {
-	    C55x_msgWrite("SW3 is pressed\n\r");
-        /* Clear GPIO Interrupt Flag Register */
-        GPIO_clearInt(gpioHandle,CSL_GPIO_PIN13);
+    sw3Pressed_reworked = sw3Pressed_reworked + 1;
 
-        sw3Pressed_reworked = sw3Pressed_reworked + 1;
+    if(sw3Pressed_reworked%2==1 && sw4Pressed%2==1){
+        toneFreqHz = TONE_FREQ_SW3_SW4;
+    }
+    else if(sw3Pressed_reworked%2==1 && sw4Pressed%2==0){
+        toneFreqHz = TONE_FREQ_SW3;
+    }
+}
 
-        if(sw3Pressed_reworked%2==1 && sw4Pressed%2==1){
-            AIC3206_write( 12, 0x96 );
-        }
-        else if(sw3Pressed_reworked%2==1 && sw4Pressed%2==0){
-            AIC3206_write( 12, 0x93 );
-        }
+/**
+ *  \brief  SW4 press, from GPIO_eventDispatch()
+ *
+ *  \param event   [IN]   Debounced edge
+ *  \param arg     [IN]   Unused
+ *
+ *  \return none
+ */
+static void sw4Handler(const GPIO_Event *event, void *arg)
+{
+    C55x_msgWrite("SW4 is pressed\n\r");
 
+    sw4Pressed = sw4Pressed + 1;
 
+    if(sw3Pressed_reworked%2==0 && sw4Pressed%2==1){
+        toneFreqHz = TONE_FREQ_SW4;
     }
-    /* Check for GPIO Interrupt Flag Register */
-    if((1 == GPIO_statusBit(gpioHandle,CSL_GPIO_PIN14,&retVal)))
-    {
-        C55x_msgWrite("SW4 is pressed\n\r");
-        /* Clear GPIO Interrupt Flag Register */
-        GPIO_clearInt(gpioHandle,CSL_GPIO_PIN14);
-        sw4Pressed = sw4Pressed + 1;
-
-        if(sw3Pressed_reworked%2==0 && sw4Pressed%2==1){
-                    AIC3206_write( 12, 0x90 );
-                }
-        else{
-             AIC3206_write( 12, 0x87 );
-        }
+    else{
+        toneFreqHz = TONE_FREQ_DEFAULT;
     }
-	IRQ_clear(GPIO_EVENT);
-    IRQ_plug(GPIO_EVENT,&gpioISR);
-
-    /* Enabling Interrupt */
-    IRQ_enable(GPIO_EVENT);
-    IRQ_globalEnable();
 }
 
 TEST_STATUS gpio_interrupt_initiliastion(void)
@@ -106,8 +115,6 @@ TEST_STATUS gpio_interrupt_initiliastion(void)
 
 	Int16 retVal;
 
-	CSL_GpioPinConfig    config;
-	volatile Uint32 	 loop;
 	sw3Pressed = 0;
 
 	/* Set Bus for GPIOs */
@@ -136,55 +143,23 @@ TEST_STATUS gpio_interrupt_initiliastion(void)
 	/* Reset the GPIO module */
     GPIO_reset(gpioHandle);
 
-    for (loop=0; loop < 0x5F5E10; loop++){}
+    /* Let the button inputs settle after the reset */
+    C55x_delay_msec(1);
 
     C55x_msgWrite("Press SW3 on the BoosterPack for exiting from the test\n\n\r");
 
-    /** test GPIO_config API to make PIN13 as i/p */
-       config.pinNum    = CSL_GPIO_PIN13;
-       config.direction = CSL_GPIO_DIR_INPUT;
-       config.trigger   = CSL_GPIO_TRIG_RISING_EDGE;
-       retVal = GPIO_configBit(gpioHandle,&config);
-       if(CSL_SOK != retVal)
-       {
-           C55x_msgWrite("test failed - GPIO_configBit\n");
-            return (TEST_FAIL);
-       }
-
-       /** test GPIO_config API to make PIN14 as i/p */
-       config.pinNum    = CSL_GPIO_PIN14;
-       config.direction = CSL_GPIO_DIR_INPUT;
-       config.trigger   = CSL_GPIO_TRIG_RISING_EDGE;
-       retVal = GPIO_configBit(gpioHandle,&config);
-       if(CSL_SOK != retVal)
-       {
-           C55x_msgWrite("test failed - GPIO_configBit\n");
-            return (TEST_FAIL);
-       }
-
-       /* Enable GPIO interrupts */
-       retVal = GPIO_enableInt(gpioHandle,CSL_GPIO_PIN14);
-       if(CSL_SOK != retVal)
-       {
-           C55x_msgWrite("test failed- GPIO_enableInt\n");
-            return (TEST_FAIL);
-       }
-
-       /* Enable GPIO interrupts */
-       retVal = GPIO_enableInt(gpioHandle,CSL_GPIO_PIN13);
-       if(CSL_SOK != retVal)
-       {
-           C55x_msgWrite("test failed- GPIO_enableInt\n");
-           return(retVal);
-       }
-
-	/* Clear any pending Interrupt */
-    IRQ_clear(GPIO_EVENT);
-
-    IRQ_plug(GPIO_EVENT,&gpioISR);
-
-     /* Enabling Interrupt */
-    IRQ_enable(GPIO_EVENT);
+    CMD_queueInit();
+    CMD_setClock(C55x_nowCycles);
+
+    /* A press is the rising edge as before, now debounced */
+    if ( (GPIO_eventOpen(GPIO_DEBOUNCE_USEC_DEFAULT) != TEST_PASS) ||
+         (GPIO_eventRegister(CSL_GPIO_PIN13, GPIO_EDGE_RISING, sw3Handler, NULL) != TEST_PASS) ||
+         (GPIO_eventRegister(CSL_GPIO_PIN14, GPIO_EDGE_RISING, sw4Handler, NULL) != TEST_PASS) )
+    {
+        C55x_msgWrite("test failed - GPIO_eventRegister\n");
+        return (TEST_FAIL);
+    }
+
     IRQ_globalEnable();
 
 	return (TEST_PASS);
@@ -208,7 +183,7 @@ TEST_STATUS initialise_i2s_interface(void)
 	Int16           result = 0;
 
 	/* Open the device with instance 0 */
-	hI2s = I2S_open(I2S_INSTANCE2, I2S_POLLED, I2S_CHAN_STEREO);
+	hI2s = I2S_open(I2S_INSTANCE2, i2sOpMode, I2S_CHAN_STEREO);
 
 	/* Set the value for the configure structure */
 	hwConfig.dataType           = I2S_STEREO_ENABLE;
@@ -308,7 +283,8 @@ void I2S_writeRight(Int16 data)
 /**
  *
  * \brief This function used to Enable and initalize the I2C module
- *		   The I2C clk is set to run at 100 KHz
+ *		   The I2C clk is derived from the system clock for the rate
+ *		   selected with I2C_clockSetBusRate(), 400 KHz by default
  *
  * \param    testArgs   [IN]   Test arguments
  *
@@ -321,18 +297,26 @@ TEST_STATUS initialise_i2c_interface(void *testArgs)
 {
 	CSL_Status         status;
 	CSL_I2cConfig         i2cConfig;
+	I2C_ClockParams       clkParams;
 
 	status = I2C_init(CSL_I2C0);
 
+	if (I2C_clockCompute(C55x_getSysClk(), I2C_clockGetBusRate(),
+	                     &clkParams) != TEST_PASS)
+	{
+		C55x_msgWrite("I2C clock out of range\n\r");
+		return (TEST_FAIL);
+	}
+
 	/* Configure I2C module for write */
 	i2cConfig.icoar  = CSL_I2C_ICOAR_DEFVAL;
 	i2cConfig.icimr  = CSL_I2C_ICIMR_DEFVAL;
-	i2cConfig.icclkl = 20;
-	i2cConfig.icclkh = 20;
+	i2cConfig.icclkl = clkParams.icclkl;
+	i2cConfig.icclkh = clkParams.icclkh;
 	i2cConfig.icsar  = CSL_I2C_ICSAR_DEFVAL;
 	i2cConfig.icmdr  = CSL_I2C_ICMDR_WRITE_DEFVAL;
 	i2cConfig.icemdr = CSL_I2C_ICEMDR_DEFVAL;
-	i2cConfig.icpsc  = 20;
+	i2cConfig.icpsc  = clkParams.icpsc;
 
 	status |= I2C_config(&i2cConfig);
 
@@ -342,7 +326,8 @@ TEST_STATUS initialise_i2c_interface(void *testArgs)
 
 /**
  *
- * \brief This function used to write into the audio codec registers
+ * \brief This function used to write into the audio codec registers.
+ *        Writes the register shadow already holds are skipped.
  *
  * \param testArgs  regnum - register number
  *                  regVal - register data
@@ -354,22 +339,21 @@ TEST_STATUS initialise_i2c_interface(void *testArgs)
  */
 TEST_STATUS AIC3206_write(Uint16 regnum, Uint16 regval)
 {
-	Int16 retVal;
-	Uint16 startStop            = ((CSL_I2C_START) | (CSL_I2C_STOP));
-	Uint16 cmd[2];
-    cmd[0] = regnum & 0x007F;       // 7-bit Device Register
-    cmd[1] = regval;                // 8-bit Register Data
-
-    C55x_delay_msec(3);
-
-    /* I2C Write */
-    retVal = I2C_write(cmd, 2, AIC3206_I2C_ADDR,
-    		 TRUE, startStop, CSL_I2C_MAX_TIMEOUT);
-     if(retVal != 0)
-     {
-    	C55x_msgWrite("I2C Write failed\n\r");
- 		//return -1;
-     }
-
-     return (0);
+	Uint16 page;
+
+	page = AIC3206_cachePage();
+	if (!AIC3206_cacheNeedsWrite(page, regnum, regval))
+	{
+		return (TEST_PASS);
+	}
+
+	/* Queued when the async I2C driver is open */
+	if (AIC3206_busWrite(regnum, &regval, 1) != TEST_PASS)
+	{
+		return (TEST_FAIL);
+	}
+
+	AIC3206_cacheWritten(page, regnum, regval);
+
+	return (TEST_PASS);
 }
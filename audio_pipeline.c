@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file audio_pipeline.c
+*
+*   \brief Full-duplex capture -> process -> playback streaming pipeline.
+*
+*   Capture and playback run on the interrupt driven I2S rings. When the
+*   pipeline is opened the transmit ring is primed with silence, so that
+*   every captured frame is played back a fixed number of frames later:
+*
+*       latency = prime
+*
+*   A frame does wait in the RX ring for its block to complete, but the TX
+*   ring drains by the same amount meanwhile, so the block size does not
+*   add to the latency. It does eat into the slack: when a block completes
+*   the TX ring only holds 'prime - blockFrames' frames, which is how long
+*   the main loop has to call AUDIO_pipelineService(). The lowest TX level
+*   seen is reported as the pipeline headroom.
+*
+*   Blocks alternate between two buffers so a block offered to the UART
+*   stream tap stays intact for a whole block period while it goes out.
+*
+*/
+
+#include "audio_pipeline.h"
+#include "timebase.h"
+#include "uart_stream.h"
+
+static AUDIO_PipelineConfig  pipeConfig;
+static AUDIO_PipelineStats   pipeStats;
+
+static Int16 pipeBlocks[2][2 * AUDIO_PIPELINE_MAX_BLOCK];
+static Uint16 pipeBlockIdx;
+
+/**
+ *
+ * \brief This function opens I2S in full-duplex interrupt mode and primes
+ *        the playback side for the requested latency
+ *
+ * \param  config - pipeline configuration
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS AUDIO_pipelineOpen(const AUDIO_PipelineConfig *config)
+{
+	if ((config->blockFrames == 0) ||
+	    (config->blockFrames > AUDIO_PIPELINE_MAX_BLOCK))
+	{
+		C55x_msgWrite("Pipeline block size out of range\n\r");
+		return (TEST_FAIL);
+	}
+
+	/* A prime of two blocks leaves one block period of slack to absorb
+	 * service jitter, and the whole prime has to fit in the TX ring */
+	if ((config->latencyFrames < (2 * config->blockFrames)) ||
+	    (config->latencyFrames > AUDIO_PIPELINE_TX_FRAMES))
+	{
+		C55x_msgWrite("Pipeline latency out of range\n\r");
+		return (TEST_FAIL);
+	}
+
+	pipeConfig = *config;
+
+	pipeStats.blocks        = 0;
+	pipeStats.latencyFrames = config->latencyFrames;
+	pipeStats.minTxFrames   = AUDIO_PIPELINE_TX_FRAMES;
+	pipeStats.underruns     = 0;
+	pipeStats.overruns      = 0;
+	pipeStats.lastCycles    = 0;
+	pipeStats.worstCycles   = 0;
+
+	pipeBlockIdx = 0;
+
+	/* The playback side is primed with silence before its ISR runs */
+	if (I2S_ringOpen(I2S_RING_TX | I2S_RING_RX,
+	                 config->latencyFrames) != TEST_PASS)
+	{
+		return (TEST_FAIL);
+	}
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Tells whether a captured block waits for
+ *        AUDIO_pipelineService(). Safe with interrupts disabled.
+ *
+ */
+Bool AUDIO_pipelineReady(void)
+{
+	return ((I2S_ringRxCountFrames() >= pipeConfig.blockFrames) ?
+	        TRUE : FALSE);
+}
+
+/**
+ *
+ * \brief Processes every complete block waiting in the capture ring and
+ *        queues the result for playback. Called from the main loop.
+ *
+ * \return Number of blocks processed
+ *
+ */
+Uint16 AUDIO_pipelineService(void)
+{
+	Uint16 blocks = 0;
+	Uint16 txFrames;
+	Uint16 frames;
+	Uint32 start;
+	Int16 *pipeBlock;
+
+	frames = pipeConfig.blockFrames;
+
+	while (I2S_ringRxCountFrames() >= frames)
+	{
+		txFrames = AUDIO_PIPELINE_TX_FRAMES - I2S_ringTxSpaceFrames();
+		if (txFrames < pipeStats.minTxFrames)
+		{
+			pipeStats.minTxFrames = txFrames;
+		}
+
+		start = C55x_nowCycles();
+
+		pipeBlockIdx ^= 1;
+		pipeBlock = pipeBlocks[pipeBlockIdx];
+
+		STREAM_release(pipeBlock);
+		I2S_ringReadFrames(pipeBlock, frames);
+
+		if (pipeConfig.processFxn != NULL)
+		{
+			pipeConfig.processFxn(pipeBlock, pipeBlock, frames,
+			                      pipeConfig.arg);
+		}
+
+		/* Frames the TX ring has no room for are lost */
+		pipeStats.overruns += frames -
+		                      I2S_ringWriteFrames(pipeBlock, frames);
+
+		STREAM_tap(STREAM_TAP_PIPE_OUT, pipeBlock, frames, 2);
+
+		pipeStats.lastCycles = C55x_nowCycles() - start;
+		if (pipeStats.lastCycles > pipeStats.worstCycles)
+		{
+			pipeStats.worstCycles = pipeStats.lastCycles;
+		}
+
+		pipeStats.blocks++;
+		blocks++;
+	}
+
+	return (blocks);
+}
+
+/**
+ *
+ * \brief Stops capture and playback
+ *
+ * \return void
+ *
+ */
+void AUDIO_pipelineClose(void)
+{
+	I2S_ringClose();
+}
+
+/**
+ *
+ * \brief Copies the pipeline counters, including the I2S ring errors
+ *
+ * \param  stats - destination
+ *
+ * \return void
+ *
+ */
+void AUDIO_pipelineGetStats(AUDIO_PipelineStats *stats)
+{
+	I2S_RingStats ringStats;
+
+	I2S_ringGetStats(&ringStats);
+
+	*stats = pipeStats;
+	stats->underruns = ringStats.underruns;
+	stats->overruns  = ringStats.overruns + pipeStats.overruns;
+}
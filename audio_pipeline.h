@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file audio_pipeline.h
+*
+*   \brief Full-duplex capture -> process -> playback streaming pipeline.
+*
+*/
+
+#ifndef _AUDIO_PIPELINE_H_
+#define _AUDIO_PIPELINE_H_
+
+#include "audio_common.h"
+#include "i2s_ring.h"
+
+/* Largest processing block in stereo frames */
+#define AUDIO_PIPELINE_MAX_BLOCK    (64)
+
+/* Frames the transmit ring can hold */
+#define AUDIO_PIPELINE_TX_FRAMES    (I2S_RING_TX_SIZE / 2)
+
+/**
+ * \brief Processing stage, called once per block from
+ *        AUDIO_pipelineService(). 'in' and 'out' hold interleaved L/R
+ *        samples and may be the same buffer.
+ */
+typedef void (*AUDIO_ProcessFxn)(const Int16 *in, Int16 *out,
+                                 Uint16 frames, void *arg);
+
+typedef struct
+{
+	Uint16            blockFrames;    /* frames per processing block      */
+	Uint16            latencyFrames;  /* end-to-end latency, i.e. prime   */
+	AUDIO_ProcessFxn  processFxn;     /* NULL for a straight pass-through */
+	void             *arg;
+} AUDIO_PipelineConfig;
+
+typedef struct
+{
+	Uint32 blocks;          /* blocks processed                          */
+	Uint16 latencyFrames;   /* end-to-end latency in sample periods      */
+	Uint16 minTxFrames;     /* lowest TX ring level seen, i.e. headroom  */
+	Uint32 underruns;       /* TX ISR ran dry                            */
+	Uint32 overruns;        /* frames lost: RX ring full, or no room in
+	                           the TX ring for a processed block         */
+	Uint32 lastCycles;      /* cycles to read, process and queue the
+	                           last block                                */
+	Uint32 worstCycles;     /* most cycles for one block                 */
+} AUDIO_PipelineStats;
+
+TEST_STATUS AUDIO_pipelineOpen(const AUDIO_PipelineConfig *config);
+Uint16 AUDIO_pipelineService(void);
+Bool AUDIO_pipelineReady(void);
+void AUDIO_pipelineClose(void);
+void AUDIO_pipelineGetStats(AUDIO_PipelineStats *stats);
+
+#endif /* _AUDIO_PIPELINE_H_ */
@@ -40,9 +40,487 @@
 
 #include "audio_playback_test.h"
 #include "audio_common.h"
+#include "i2s_dma.h"
+#include "i2s_ring.h"
+#include "i2s_block.h"
+#include "dsp_kernels.h"
+#include "audio_pipeline.h"
+#include "dds_osc.h"
+#include "audio_rate.h"
+#include "aic3206_seq.h"
+#include "aic3206_init.h"
+#include "cmd_queue.h"
+#include "cpu_idle.h"
+#include "boot_trace.h"
+#include "uart_log.h"
+#include "bin_log.h"
+#include "uart_stream.h"
+#include "shell.h"
+#include "gpio_event.h"
+#include "aic3206_cache.h"
+#include "i2c_async.h"
+#include "i2c_probe.h"
+#include "timebase.h"
+#include "synth_voice.h"
+#include "adpcm.h"
+#include "prompt_chime.h"
+#include "wav_stream.h"
+#include "sd_card.h"
 
 extern TEST_STATUS audio_playback_test(void *testArgs);
+extern volatile Uint16 toneFreqHz;
 int freq_change = 0x90;
+
+#define PLAYBACK_SAMPLE_RATE    (48000)
+#define PLAYBACK_BLOCK_FRAMES   (48)
+
+/* Polled mode plays the tone with line in mixed under it, both at -6dB */
+#define PLAYBACK_TONE_GAIN      (0x4000)
+#define PLAYBACK_LINE_GAIN      (0x4000)
+
+static DDS_Osc  toneOsc;
+static Uint16   toneOscFreq;
+/* Rate the tone and the synth run at, the shell may change it */
+static Uint32   toneSampleRate = PLAYBACK_SAMPLE_RATE;
+
+/* DAC digital volume in 0.5dB steps, page 0 register 65 */
+static Int16    dacVolume;
+
+#ifdef USE_SYNTH
+/* DMA mode plays a chord on the synth instead of the plain tone */
+#define PLAYBACK_SYNTH_VOICES   (8)
+#define PLAYBACK_SYNTH_LEVEL    (0x2000)
+
+static const SYNTH_Adsr synthAdsr = { 20, 200, 0x6000, 300 };
+#endif
+
+#ifdef USE_ADPCM_PROMPT
+/* DMA mode plays the start-up chime before the tone */
+static ADPCM_Stream promptStream;
+#endif
+
+#ifdef USE_WAV_PLAYBACK
+/* DMA mode plays a 16-bit PCM WAV file written raw to the microSD card
+ * from this sector on, e.g. dd if=file.wav of=/dev/sdX seek=2048 */
+#define PLAYBACK_WAV_SECTOR     (2048)
+#define PLAYBACK_WAV_DEPTH      (3)
+
+static const WAV_BlockDevice wavCardDev = { SDCARD_read, NULL };
+#endif
+
+/**
+ *
+ * \brief Retunes the tone oscillator when the GPIO ISR or the shell has
+ *        changed toneFreqHz
+ *
+ * \return void
+ *
+ */
+static void tone_update(void)
+{
+    Uint16 freq = toneFreqHz;
+
+    if ( freq != toneOscFreq )
+    {
+        DDS_setFreq(&toneOsc, freq, toneSampleRate);
+        toneOscFreq = freq;
+    }
+}
+
+/**
+ *
+ * \brief Block fill callback for the I2S DMA engine, runs the tone
+ *        oscillator
+ *
+ * \param  left   - left channel destination
+ * \param  right  - right channel destination
+ * \param  frames - number of frames to generate
+ * \param  arg    - unused
+ *
+ * \return void
+ *
+ */
+static void tone_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg)
+{
+    tone_update();
+    DDS_generate(&toneOsc, left, frames);
+    memcpy(right, left, frames * sizeof(Int16));
+}
+
+#ifdef USE_ADPCM_PROMPT
+/**
+ *
+ * \brief Block fill callback for the I2S DMA engine, decodes the chime
+ *        and hands over to the tone once it has played out
+ *
+ * \param  left   - left channel destination
+ * \param  right  - right channel destination
+ * \param  frames - number of frames to generate
+ * \param  arg    - unused
+ *
+ * \return void
+ *
+ */
+static void prompt_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg)
+{
+    if ( ADPCM_streamDone(&promptStream) )
+    {
+        tone_fill(left, right, frames, arg);
+    }
+    else
+    {
+        ADPCM_fill(left, right, frames, &promptStream);
+    }
+}
+#endif
+
+#if (defined(USE_I2S_INTERRUPT) || defined(USE_I2S_POLLED))
+/**
+ *
+ * \brief Runs the tone oscillator into an interleaved stereo block
+ *
+ * \param  block  - interleaved L/R destination
+ * \param  frames - number of frames, at most PLAYBACK_BLOCK_FRAMES
+ *
+ * \return void
+ *
+ */
+static void tone_fill_interleaved(Int16 *block, Uint16 frames)
+{
+    Int16  mono[PLAYBACK_BLOCK_FRAMES];
+    Uint16 frame;
+
+    tone_update();
+    DDS_generate(&toneOsc, mono, frames);
+
+    for ( frame = 0 ; frame < frames ; frame++ )
+    {
+        block[2 * frame]     = mono[frame];
+        block[2 * frame + 1] = mono[frame];
+    }
+}
+#endif
+
+/* Wait checks of the play loops, run with interrupts disabled */
+#if defined(USE_I2S_INTERRUPT)
+static Bool tone_block_fits(void *arg)
+{
+    return ( (I2S_ringTxSpaceFrames() >= PLAYBACK_BLOCK_FRAMES) ?
+             TRUE : FALSE );
+}
+#elif defined(USE_LINE_IN_PIPELINE)
+static Bool line_in_ready(void *arg)
+{
+    return ( AUDIO_pipelineReady() );
+}
+#elif !defined(USE_I2S_POLLED)
+static Bool dma_half_free(void *arg)
+{
+    return ( I2S_dmaPending() );
+}
+#endif
+
+#ifdef USE_SERIAL_CONSOLE
+static Int32 shell_get_volume(void)
+{
+    return (dacVolume);
+}
+
+static TEST_STATUS shell_set_volume(Int32 value)
+{
+    AIC3206_write( 0, 0x00 );  // Select page 0
+    if ( AIC3206_write( 65, value & 0xFF ) != TEST_PASS )  // Left DAC, right tracks
+    {
+        return (TEST_FAIL);
+    }
+
+    dacVolume = (Int16)value;
+
+    return (TEST_PASS);
+}
+
+static Int32 shell_get_rate(void)
+{
+    return (audio_get_sample_rate());
+}
+
+static TEST_STATUS shell_set_rate(Int32 value)
+{
+    /* The tone would alias; lower freq first */
+    if ( toneFreqHz >= ((Uint32)value / 2) )
+    {
+        C55x_msgWrite("Tone at or above rate/2\n\r");
+        return (TEST_FAIL);
+    }
+
+    if ( audio_set_sample_rate(value) != TEST_PASS )
+    {
+        return (TEST_FAIL);
+    }
+
+    /* Same pitch at the new rate */
+    toneSampleRate = value;
+    DDS_setFreq(&toneOsc, toneOscFreq, toneSampleRate);
+#ifdef USE_SYNTH
+    SYNTH_setSampleRate(toneSampleRate);
+#endif
+
+    return (TEST_PASS);
+}
+
+static Int32 shell_get_freq(void)
+{
+    return (toneFreqHz);
+}
+
+static TEST_STATUS shell_set_freq(Int32 value)
+{
+    if ( (Uint32)value >= (toneSampleRate / 2) )
+    {
+        return (TEST_FAIL);
+    }
+
+    toneFreqHz = (Uint16)value;
+
+    return (TEST_PASS);
+}
+
+static Int32 shell_get_cpu(void)
+{
+    C55x_IdleStats idleStats;
+
+    C55x_idleGetStats(&idleStats);
+
+    return (idleStats.activePercent);
+}
+
+/* reg <page> <reg> [value] */
+static TEST_STATUS shell_cmd_reg(Uint16 argc, char *argv[])
+{
+    Int32  page;
+    Int32  reg;
+    Int32  value;
+    Uint16 regval;
+
+    if ( (argc < 3) || !SHELL_parseInt(argv[1], &page) ||
+         !SHELL_parseInt(argv[2], &reg) || (page > 255) || (reg > 127) ||
+         (page < 0) || (reg < 1) )
+    {
+        C55x_msgWrite("Usage: reg <page> <1..127> [value]\n\r");
+        return (TEST_FAIL);
+    }
+
+    AIC3206_write( 0, page );  // Select page
+    if ( argc > 3 )
+    {
+        if ( !SHELL_parseInt(argv[3], &value) || (value < 0) || (value > 255) )
+        {
+            C55x_msgWrite("Value 0..255\n\r");
+            return (TEST_FAIL);
+        }
+        if ( AIC3206_write( reg, value ) != TEST_PASS )
+        {
+            return (TEST_FAIL);
+        }
+    }
+
+    if ( AIC3206_read( reg, &regval ) != TEST_PASS )
+    {
+        return (TEST_FAIL);
+    }
+    C55x_msgWrite("page %ld reg %ld = 0x%02x\n\r", page, reg, regval);
+
+    return (TEST_PASS);
+}
+
+#ifdef USE_SYNTH
+/* note <Hz> [pan] */
+static TEST_STATUS shell_cmd_note(Uint16 argc, char *argv[])
+{
+    Int32 freq;
+    Int32 pan = SYNTH_PAN_CENTER;
+
+    if ( (argc < 2) || !SHELL_parseInt(argv[1], &freq) ||
+         (freq < 20) || ((Uint32)freq >= (toneSampleRate / 2)) ||
+         ((argc > 2) && (!SHELL_parseInt(argv[2], &pan) ||
+                         (pan < SYNTH_PAN_LEFT) || (pan > SYNTH_PAN_RIGHT))) )
+    {
+        C55x_msgWrite("Usage: note <Hz> [pan 0..32767]\n\r");
+        return (TEST_FAIL);
+    }
+
+    C55x_msgWrite("note %d\n\r",
+                  SYNTH_noteOn(freq, PLAYBACK_SYNTH_LEVEL, pan, &synthAdsr));
+
+    return (TEST_PASS);
+}
+
+/* off [note], every note without one */
+static TEST_STATUS shell_cmd_off(Uint16 argc, char *argv[])
+{
+    Int32 note;
+
+    if ( argc < 2 )
+    {
+        SYNTH_allOff();
+        return (TEST_PASS);
+    }
+
+    if ( !SHELL_parseInt(argv[1], &note) || (note < 0) || (note > 0x7FFF) )
+    {
+        C55x_msgWrite("Usage: off [note]\n\r");
+        return (TEST_FAIL);
+    }
+
+    SYNTH_noteOff(note);
+
+    return (TEST_PASS);
+}
+#endif
+
+static TEST_STATUS shell_cmd_stats(Uint16 argc, char *argv[])
+{
+    C55x_IdleStats      idleStats;
+    AIC3206_CacheStats  cacheStats;
+    UART_LogStats       logStats;
+    GPIO_EventStats     gpioStats;
+    CMD_QueueStats      cmdStats;
+#ifdef USE_LINE_IN_PIPELINE
+    AUDIO_PipelineStats pipeStats;
+#elif !(defined(USE_I2S_INTERRUPT) || defined(USE_I2S_POLLED))
+    I2S_DmaStats        dmaStats;
+#endif
+#ifdef USE_SYNTH
+    SYNTH_Stats         synthStats;
+#endif
+
+    C55x_idleGetStats(&idleStats);
+    C55x_msgWrite("CPU: %d%% active, %d%% idle\n\r",
+                  idleStats.activePercent, idleStats.idlePercent);
+
+#ifdef USE_LINE_IN_PIPELINE
+    AUDIO_pipelineGetStats(&pipeStats);
+    C55x_msgWrite("Pipeline: %lu blocks, %lu underruns, %lu overruns, "
+                  "worst block %lu cycles\n\r",
+                  pipeStats.blocks, pipeStats.underruns,
+                  pipeStats.overruns, pipeStats.worstCycles);
+#elif !(defined(USE_I2S_INTERRUPT) || defined(USE_I2S_POLLED))
+    I2S_dmaGetStats(&dmaStats);
+    C55x_msgWrite("DMA: %lu played, %lu filled, %lu underruns\n\r",
+                  dmaStats.blocksPlayed, dmaStats.blocksFilled,
+                  dmaStats.underruns);
+#endif
+
+#ifdef USE_SYNTH
+    SYNTH_getStats(&synthStats);
+    C55x_msgWrite("Synth: %d voices, peak %d, %lu cycles per block, "
+                  "worst %lu\n\r",
+                  synthStats.activeVoices, synthStats.peakVoices,
+                  synthStats.lastCycles, synthStats.worstCycles);
+#endif
+
+    AIC3206_getCacheStats(&cacheStats);
+    C55x_msgWrite("Codec: %lu writes, %lu skipped, %lu reads cached\n\r",
+                  cacheStats.writesIssued, cacheStats.writesSkipped,
+                  cacheStats.readHits);
+
+    UART_logGetStats(&logStats);
+    C55x_msgWrite("Console: %lu messages, %lu dropped, %lu truncated\n\r",
+                  logStats.messages, logStats.dropped, logStats.truncated);
+
+    GPIO_eventGetStats(&gpioStats);
+    C55x_msgWrite("Buttons: %lu edges, %lu debounced, %lu bursts filtered\n\r",
+                  gpioStats.edges, gpioStats.events, gpioStats.filtered);
+
+    CMD_getStats(&cmdStats);
+    C55x_msgWrite("Commands: %lu posted, %lu dropped, depth %d, max %d, "
+                  "worst ISR %lu cycles\n\r",
+                  cmdStats.posted, cmdStats.dropped, cmdStats.depth,
+                  cmdStats.maxDepth, cmdStats.isrWorst);
+
+    return (TEST_PASS);
+}
+
+static const SHELL_Param shellParams[] =
+{
+    /* name      help                         min    max    get / set */
+    { "volume", "DAC gain, 0.5dB steps",     -127,  48,    shell_get_volume, shell_set_volume },
+    { "rate",   "sample rate, Hz",           8000,  96000, shell_get_rate,   shell_set_rate   },
+    { "freq",   "tone frequency, Hz",        20,    20000, shell_get_freq,   shell_set_freq   },
+    { "cpu",    "CPU load, %",               0,     100,   shell_get_cpu,    NULL             }
+};
+
+static const SHELL_Command shellCmds[] =
+{
+    { "reg",    "reg <page> <reg> [value], codec register", shell_cmd_reg   },
+#ifdef USE_SYNTH
+    { "note",   "note <Hz> [pan], start a synth note",     shell_cmd_note  },
+    { "off",    "off [note], release synth notes",         shell_cmd_off   },
+#endif
+    { "stats",  "counters",                                shell_cmd_stats }
+};
+
+/**
+ *
+ * \brief Registers the playback parameters and commands with the shell
+ *
+ * \return void
+ *
+ */
+static void shell_setup(void)
+{
+    Uint16 i;
+
+    SHELL_init();
+
+    for ( i = 0 ; i < (sizeof(shellParams) / sizeof(shellParams[0])) ; i++ )
+    {
+        SHELL_registerParam(&shellParams[i]);
+    }
+
+    for ( i = 0 ; i < (sizeof(shellCmds) / sizeof(shellCmds[0])) ; i++ )
+    {
+        SHELL_registerCommand(&shellCmds[i]);
+    }
+
+    C55x_msgWrite("Shell ready, type help\n\r");
+}
+#endif
+
+/**
+ *
+ * \brief Undoes what AIC3206_playback_config() set up, at the end of the
+ *        run or on a failure: stream, card and console closed, the I2C
+ *        back on the polled CSL calls for the caller and the codec reset
+ *
+ * \return void
+ *
+ */
+static void playback_release(void)
+{
+#ifdef USE_UART_STREAM
+    STREAM_close();
+#endif
+#ifdef USE_WAV_PLAYBACK
+    SDCARD_close();
+#endif
+#ifdef USE_SERIAL_CONSOLE
+    BLOG_setMode(BLOG_MODE_TEXT);
+    UART_logClose();
+#endif
+
+    /* Bounded, a stuck bus is reset; the codec reset then goes out on
+     * the polled calls */
+    if ( I2C_asyncIsOpen() )
+    {
+        I2C_asyncClose(I2C_ASYNC_CLOSE_USEC);
+    }
+
+    AIC3206_write( 0,  0x00 );  // Select page 0
+    AIC3206_write( 1,  0x01 );  // Reset codec
+    audio_invalidate_sample_rate();
+}
+
 /**
  *
  * \brief This function configures all audio codec registers for
@@ -57,115 +535,418 @@ int freq_change = 0x90;
  */
 static TEST_STATUS AIC3206_playback_config(void *testArgs)
 {
-    /* Pre-generated sine wave data, 16-bit signed samples */
-    Int16 sinetable[48] = {
-        0x0000, 0x10b4, 0x2120, 0x30fb, 0x3fff, 0x4dea, 0x5a81, 0x658b,
-        0x6ed8, 0x763f, 0x7ba1, 0x7ee5, 0x7ffd, 0x7ee5, 0x7ba1, 0x76ef,
-        0x6ed8, 0x658b, 0x5a81, 0x4dea, 0x3fff, 0x30fb, 0x2120, 0x10b4,
-        0x0000, 0xef4c, 0xdee0, 0xcf06, 0xc002, 0xb216, 0xa57f, 0x9a75,
-        0x9128, 0x89c1, 0x845f, 0x811b, 0x8002, 0x811b, 0x845f, 0x89c1,
-        0x9128, 0x9a76, 0xa57f, 0xb216, 0xc002, 0xcf06, 0xdee0, 0xef4c
-    };
-    Int16 sec, msec;
-    Int16 sample;
-
-    /* Configure AIC3206 */
-    AIC3206_write( 0,  0x00 );  // Select page 0
-    AIC3206_write( 1,  0x01 );  // Reset codec
-    C55x_delay_msec(1);  			// Wait 1ms after reset
-    AIC3206_write( 0,  0x01 );  // Select page 1
-    AIC3206_write( 1,  0x08 );  // Disable crude AVDD generation from DVDD
-    AIC3206_write( 2,  0x01 );  // Enable Analog Blocks, use LDO power
-    AIC3206_write( 123,0x05 );  // Force reference to power up in 40ms
-    C55x_delay_msec(40); 			// Wait at least 40ms
-    AIC3206_write( 0,  0x00 );  // Select page 0
+#if (defined(USE_I2S_INTERRUPT) || defined(USE_I2S_POLLED))
+    Int16  block[2 * PLAYBACK_BLOCK_FRAMES];
+#endif
+#ifdef USE_I2S_POLLED
+    Int16  lineIn[2 * PLAYBACK_BLOCK_FRAMES];
+    Uint16 frame;
+#endif
+#ifdef USE_LINE_IN_PIPELINE
+    AUDIO_PipelineConfig pipeConfig;
+    AUDIO_PipelineStats  pipeStats;
+#endif
+    C55x_IdleStats idleStats;
+    CMD_QueueStats cmdStats;
+#ifdef USE_UART_STREAM
+    STREAM_Stats   streamStats;
+    Uint32         counters[4];
+    Bool           streaming = FALSE;
+#endif
+#ifdef USE_SYNTH
+    SYNTH_Stats    synthStats;
+#endif
+#ifdef USE_WAV_PLAYBACK
+    WAV_Info       wavInfo;
+    WAV_Stats      wavStats;
+#endif
 
-    /* PLL and Clocks config and Power Up  */
-    AIC3206_write( 27, 0x0d );  // BCLK and WCLK are set as o/p; AIC3206(Master)
-    AIC3206_write( 28, 0x00 );  // Data ofset = 0
-    AIC3206_write( 4,  0x03 );  // PLL setting: PLLCLK <- MCLK, CODEC_CLKIN <-PLL CLK
-    AIC3206_write( 6,  0x07 );  // PLL setting: J=7
-    AIC3206_write( 7,  0x06 );  // PLL setting: HI_BYTE(D=1680)
-    AIC3206_write( 8,  0x90 );  // PLL setting: LO_BYTE(D=1680)
-    AIC3206_write( 30, 0x88 );  // For 32 bit clocks per frame in Master mode ONLY
-    							// BCLK=DAC_CLK/N =(12288000/8) = 1.536MHz = 32*fs
-    AIC3206_write( 5,  0x91 );  // PLL setting: Power up PLL, P=1 and R=1
-    C55x_delay_msec(10); 		// Wait for PLL to come up
-    AIC3206_write( 13, 0x00 );  // Hi_Byte(DOSR) for DOSR = 128 decimal or 0x0080 DAC oversamppling
-    AIC3206_write( 14, 0x80 );  // Lo_Byte(DOSR) for DOSR = 128 decimal or 0x0080
-    AIC3206_write( 20, 0x80 );  // AOSR for AOSR = 128 decimal or 0x0080 for decimation filters 1 to 6
-    AIC3206_write( 11, 0x82 );  // Power up NDAC and set NDAC value to 2
-    AIC3206_write( 12, 0x87 );  // Power up MDAC and set MDAC value to 7
-    AIC3206_write( 18, 0x87 );  // Power up NADC and set NADC value to 7
-    AIC3206_write( 19, 0x82 );  // Power up MADC and set MADC value to 2
-
-    /* DAC ROUTING and Power Up */
-    AIC3206_write( 0,  0x01 );  // Select page 1
-    AIC3206_write( 12, 0x08 );  // LDAC AFIR routed to HPL
-    AIC3206_write( 13, 0x08 );  // RDAC AFIR routed to HPR
-    AIC3206_write( 0,  0x00 );  // Select page 0
-    AIC3206_write( 64, 0x02 );  // Left vol=right vol
-    AIC3206_write( 65, 0x00 );  // Left DAC gain to 0dB VOL; Right tracks Left
-    AIC3206_write( 63, 0xd4 );  // Power up left,right data paths and set channel
-    AIC3206_write( 0,  0x01 );  // Select page 1
-    AIC3206_write( 16, 0x00 );  // Unmute HPL , 0dB gain
-    AIC3206_write( 17, 0x00 );  // Unmute HPR , 0dB gain
-    AIC3206_write( 9 , 0x30 );  // Power up HPL,HPR
-    C55x_delay_msec(1);         // Wait 1 msec
-
-    /* ADC ROUTING and Power Up */
-    AIC3206_write( 0,  0x01 );  // Select page 1
-    AIC3206_write( 52, 0x30 );  // STEREO 1 Jack
-    							// IN2_L to LADC_P through 40 kohm
-    AIC3206_write( 55, 0x30 );  // IN2_R to RADC_P through 40 kohmm
-    AIC3206_write( 54, 0x03 );  // CM_1 (common mode) to LADC_M through 40 kohm
-    AIC3206_write( 57, 0xc0 );  // CM_1 (common mode) to RADC_M through 40 kohm
-    AIC3206_write( 59, 0x00 );  // MIC_PGA_L unmute
-    AIC3206_write( 60, 0x00 );  // MIC_PGA_R unmute
-    AIC3206_write( 0,  0x00 );  // Select page 0
-    AIC3206_write( 81, 0xc0 );  // Powerup Left and Right ADC
-    AIC3206_write( 82, 0x00 );  // Unmute Left and Right ADC
-    AIC3206_write( 0,  0x00 );  // Select page 0
-    C55x_delay_msec(1);         // Wait 1 msec
+    /* Configure AIC3206, the reference powers up in the background */
+    audio_invalidate_sample_rate();
+    if ( AIC3206_writeSeqNoWait(aic3206PowerUpSeq, aic3206PowerUpLen) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+    BOOT_traceMark("codec power up");
+
+    /* PLL, NDAC/MDAC, NADC/MADC, DOSR/AOSR and BCLK from the rate table;
+     * the 10ms PLL wait overlaps the reference wait */
+    if ( audio_set_sample_rate(PLAYBACK_SAMPLE_RATE) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+    BOOT_traceMark("codec clocks");
+
+    /* Tone at 48 kHz, pitch follows the buttons and the shell */
+    toneSampleRate = PLAYBACK_SAMPLE_RATE;
+    toneOscFreq    = toneFreqHz;
+    DDS_init(&toneOsc, toneOscFreq, toneSampleRate, 0x7FFF);
+
+    /* GPIO init resets the vector table, so it has to come before the
+     * I2S and DMA interrupts are plugged */
+    gpio_interrupt_initiliastion();
+
+    /* Codec writes from here on are queued and moved by the I2C ISR */
+    I2C_asyncSetClock(C55x_nowCycles);
+    if ( I2C_asyncOpen() != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+
+    /* Wait loops idle from here on, GPT1 wakes the delays */
+    C55x_idleInit();
+
+#ifdef USE_SERIAL_CONSOLE
+    /* Console output no longer blocks the audio loops */
+    if ( UART_logOpen() != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+    shell_setup();
+
+#ifdef USE_BINARY_LOG
+    /* The format table goes out first so a capture decodes on its own */
+    BLOG_dumpFormats();
+    BLOG_setMode(BLOG_MODE_BINARY);
+#endif
+#endif
+
+#ifdef USE_UART_STREAM
+    /* The UART carries stream frames from here, console text in frames
+     * of its own */
+    if ( STREAM_open(STREAM_DEFAULT_BAUD) == TEST_PASS )
+    {
+        streaming = TRUE;
+#ifdef USE_LINE_IN_PIPELINE
+        STREAM_tapSelect(STREAM_TAP_PIPE_OUT, 1, 1);
+#else
+        STREAM_tapSelect(STREAM_TAP_DMA_LEFT, 1, 1);
+#endif
+    }
+#endif
 
+    BOOT_traceMark("gpio");
+
+    /* The analog routing needs the reference */
+    AIC3206_seqWait();
+    BOOT_traceMark("codec reference");
+
+    /* DAC and ADC routing and power up */
+    if ( AIC3206_writeSeq(aic3206RoutingSeq, aic3206RoutingLen) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+    BOOT_traceMark("codec routing");
+
+#ifdef USE_I2S_INTERRUPT
+    /* Initialize I2S in interrupt mode, the ISR drains the TX ring. One
+     * block of silence covers the first tone block being computed. */
+    if ( I2S_ringOpen(I2S_RING_TX, PLAYBACK_BLOCK_FRAMES) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+
+    /* Play Tone until SW3 is pressed, produced a block at a time */
+    while ( sw3Pressed != TRUE )
+    {
+        CMD_dispatch();
+        GPIO_eventDispatch();
+        SHELL_service();
+        BOOT_traceService();
+
+        /* The TX ISR wakes the CPU on every frame; go back to sleep
+         * until a whole block fits rather than running the dispatchers
+         * at the frame rate */
+        while ( C55x_idleUnless(tone_block_fits, NULL) )
+        {
+            ;
+        }
+
+        tone_fill_interleaved(block, PLAYBACK_BLOCK_FRAMES);
+        I2S_ringWriteFrames(block, PLAYBACK_BLOCK_FRAMES);
+        BOOT_traceFirstSample();
+    }
+
+    I2S_ringClose();  // Disable I2S
+#elif defined(USE_I2S_POLLED)
     /* Initialize I2S */
     initialise_i2s_interface();
+    memset(lineIn, 0, sizeof(lineIn));
 
-    gpio_interrupt_initiliastion();
-    /* Play Tone for 5 seconds*/
-    for (;;)
+    /* Play Tone with line in (IN2) mixed in until SW3 is pressed. Both
+     * directions run off the same frame clock, so the frames are moved
+     * one at a time in lockstep; the line in captured during one block is
+     * mixed into the next. */
+    while ( sw3Pressed != TRUE )
+    {
+        CMD_dispatch();
+        GPIO_eventDispatch();
+        SHELL_service();
+        BOOT_traceService();
+        tone_fill_interleaved(block, PLAYBACK_BLOCK_FRAMES);
+        DSP_mix(block, lineIn, block, 2 * PLAYBACK_BLOCK_FRAMES,
+                PLAYBACK_TONE_GAIN, PLAYBACK_LINE_GAIN);
+
+        for ( frame = 0 ; frame < PLAYBACK_BLOCK_FRAMES ; frame++ )
+        {
+            I2S_writeBlock(&block[2 * frame], 1);
+            I2S_readBlock(&lineIn[2 * frame], 1);
+        }
+        BOOT_traceFirstSample();
+    }
+
+    I2S_close(hI2s);    // Disble I2S
+#elif defined(USE_LINE_IN_PIPELINE)
+    /* Line in (IN2) is captured, passed through and played on HEADPHONE */
+    pipeConfig.blockFrames   = PLAYBACK_BLOCK_FRAMES;
+    /* One block above the minimum, the shell may hold the loop up */
+    pipeConfig.latencyFrames = 3 * PLAYBACK_BLOCK_FRAMES;
+    pipeConfig.processFxn    = NULL;
+    pipeConfig.arg           = NULL;
+
+    if ( AUDIO_pipelineOpen(&pipeConfig) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+    BOOT_traceFirstSample();
+
+    while ( sw3Pressed != TRUE )
     {
-        for ( msec = 0 ; msec < 5000 ; msec++ )
+        CMD_dispatch();
+        GPIO_eventDispatch();
+        SHELL_service();
+        BOOT_traceService();
+
+        /* Nothing captured yet, the RX ISR wakes the CPU */
+        if ( AUDIO_pipelineService() == 0 )
         {
-            for ( sample = 0 ; sample < 48 ; sample++ )
-            {
+            C55x_idleUnless(line_in_ready, NULL);
+        }
+    }
+
+    AUDIO_pipelineClose();  // Disable I2S
+
+    AUDIO_pipelineGetStats(&pipeStats);
+    BLOG6(BLOG_ID_PIPE_STATS,
+          pipeStats.blocks, pipeStats.latencyFrames,
+          pipeStats.minTxFrames, pipeStats.underruns,
+          pipeStats.overruns, pipeStats.worstCycles);
+#else
+#ifdef USE_SYNTH
+    /* Root, major third and fifth of the tone frequency across the
+     * stereo field; the shell adds and releases notes */
+    SYNTH_init(toneSampleRate, PLAYBACK_SYNTH_VOICES);
+    SYNTH_noteOn(toneFreqHz, PLAYBACK_SYNTH_LEVEL, SYNTH_PAN_LEFT, &synthAdsr);
+    SYNTH_noteOn(toneFreqHz * 5UL / 4, PLAYBACK_SYNTH_LEVEL, SYNTH_PAN_CENTER,
+                 &synthAdsr);
+    SYNTH_noteOn(toneFreqHz * 3UL / 2, PLAYBACK_SYNTH_LEVEL, SYNTH_PAN_RIGHT,
+                 &synthAdsr);
+
+    /* Initialize I2S in DMA mode, both halves are pre-filled */
+    if ( I2S_dmaOpen(SYNTH_fill, NULL) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+#elif defined(USE_ADPCM_PROMPT)
+    ADPCM_streamInit(&promptStream, promptChimeCodes, PROMPT_CHIME_SAMPLES,
+                     &promptChimeStart, FALSE);
+
+    /* Initialize I2S in DMA mode, both halves are pre-filled */
+    if ( I2S_dmaOpen(prompt_fill, NULL) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+#elif defined(USE_WAV_PLAYBACK)
+    /* The read-ahead is filled before the DMA starts */
+    if ( SDCARD_open() != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+    WAV_setClock(C55x_nowCycles);
+    if ( WAV_open(&wavCardDev, PLAYBACK_WAV_SECTOR, PLAYBACK_WAV_DEPTH,
+                  &wavInfo) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+
+    /* The codec follows the file, the DMA does not care about the rate */
+    if ( audio_set_sample_rate(wavInfo.sampleRate) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+    C55x_msgWrite("WAV: %lu Hz, %d channels, %lu frames\n\r",
+                  wavInfo.sampleRate, wavInfo.channels, wavInfo.dataFrames);
 
-                /* Write 16-bit left channel Data */
-                I2S_writeLeft( sinetable[sample]);
+    /* Initialize I2S in DMA mode, both halves are pre-filled */
+    if ( I2S_dmaOpen(WAV_fill, NULL) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+#else
+    /* Initialize I2S in DMA mode, both halves are pre-filled */
+    if ( I2S_dmaOpen(tone_fill, NULL) != TEST_PASS )
+    {
+        playback_release();
+        return (TEST_FAIL);
+    }
+#endif
 
-                /* Write 16-bit right channel Data */
-                I2S_writeRight(sinetable[sample]);
-            }
+    if ( I2S_dmaStart() != TEST_PASS )
+    {
+        I2S_dmaStop();
+        playback_release();
+        return (TEST_FAIL);
+    }
+    BOOT_traceFirstSample();
+
+    /* Play Tone until SW3 is pressed, the DMA feeds the I2S in the
+     * background and the CPU only refills the finished half */
+    while ( sw3Pressed != TRUE )
+    {
+        CMD_dispatch();
+        GPIO_eventDispatch();
+        SHELL_service();
+        BOOT_traceService();
 
-            if(sw3Pressed == TRUE)
-            {
-            	break;
-            }
+#ifdef USE_WAV_PLAYBACK
+        /* Tops up the read-ahead; the file ends the run as SW3 does */
+        WAV_service();
+        if ( WAV_done() )
+        {
+            break;
         }
-        if(sw3Pressed == TRUE)
+#endif
+
+        /* Both halves full, the DMA interrupt wakes the CPU */
+        if ( I2S_dmaService() == 0 )
         {
-        	break;
+            C55x_idleUnless(dma_half_free, NULL);
         }
+    }
+
+    I2S_dmaStop();  // Disable DMA and I2S
 
+#ifdef USE_WAV_PLAYBACK
+    SDCARD_close();
+    WAV_getStats(&wavStats);
+    BLOG5(BLOG_ID_WAV_STATS,
+          wavStats.sectorsRead, wavStats.readErrors, wavStats.underruns,
+          wavStats.minBuffersReady, wavStats.worstReadTime);
+#endif
+
+#ifdef USE_SYNTH
+    SYNTH_getStats(&synthStats);
+    BLOG4(BLOG_ID_SYNTH_STATS,
+          synthStats.blocks, synthStats.peakVoices,
+          synthStats.voicesStolen, synthStats.worstCycles);
+#endif
+#endif
+    C55x_idleGetStats(&idleStats);
+    CMD_getStats(&cmdStats);
+
+#ifdef USE_UART_STREAM
+    if ( streaming )
+    {
+        /* Last frame carries the run counters, then the console is back */
+        STREAM_tapSelect(STREAM_TAP_NONE, 1, 1);
+        STREAM_getStats(&streamStats);
+        counters[0] = idleStats.activePercent;
+        counters[1] = streamStats.framesSent;
+        counters[2] = streamStats.blocksSkipped;
+        counters[3] = streamStats.torn;
+        while ( !STREAM_sendCounters(counters, 4) )
+        {
+            ;
+        }
+        STREAM_close();
     }
-    I2S_close(hI2s);    // Disble I2S
-    AIC3206_write( 0,  0x00 );  // Select page 0
-    AIC3206_write( 1,  0x01 );  // Reset codec
+#endif
+
+    BLOG2(BLOG_ID_CPU_LOAD,
+          idleStats.activePercent, idleStats.idlePercent);
+    BLOG5(BLOG_ID_CMD_STATS,
+          cmdStats.posted, cmdStats.dropped, cmdStats.maxDepth,
+          cmdStats.isrCount, cmdStats.isrWorst);
+
+#ifdef USE_SERIAL_CONSOLE
+    {
+        UART_LogStats logStats;
+#ifdef BLOG_BENCHMARK
+        BLOG_BenchResult bench;
+
+        if ( BLOG_benchmark(8, &bench) == TEST_PASS )
+        {
+            C55x_msgWrite("Log: text %lu cycles %d bytes, "
+                          "binary %lu cycles %d bytes\n\r",
+                          bench.textCycles, bench.textBytes,
+                          bench.binaryCycles, bench.binaryBytes);
+        }
+#endif
+
+        UART_logGetStats(&logStats);
+        BLOG2(BLOG_ID_CONSOLE, logStats.messages, logStats.dropped);
+    }
+#endif
+
+    playback_release();
 
 	return (TEST_PASS);
 
 }
 
+/**
+ *
+ * \brief Scans the I2C bus and lists the devices found. Runs before the
+ *        async driver takes the I2C registers.
+ *
+ * \return
+ * \n      TEST_PASS  - Codec found
+ * \n      TEST_FAIL  - Codec did not answer
+ *
+ */
+static TEST_STATUS i2c_scan_report(void)
+{
+    static I2C_ScanResult scan;
+    Uint16 addr;
+
+    if ( i2cScan(I2C_SCAN_FIRST_ADDR, I2C_SCAN_LAST_ADDR,
+                 I2C_SCAN_TIMEOUT_USEC, &scan) != CSL_SOK )
+    {
+        return (TEST_FAIL);
+    }
+
+    C55x_msgWrite("I2C: %d found, %d timed out:", scan.found, scan.timeouts);
+    for ( addr = I2C_SCAN_FIRST_ADDR; addr <= I2C_SCAN_LAST_ADDR; addr++ )
+    {
+        if ( I2C_SCAN_IS_PRESENT(&scan, addr) )
+        {
+            C55x_msgWrite(" 0x%02x (%dus)", addr, scan.responseTime[addr]);
+        }
+    }
+    C55x_msgWrite("\n\r");
+
+    if ( !I2C_SCAN_IS_PRESENT(&scan, AIC3206_I2C_ADDR) )
+    {
+        C55x_msgWrite("AIC3206 not found at 0x%02x\n\r", AIC3206_I2C_ADDR);
+        return (TEST_FAIL);
+    }
+
+    return (TEST_PASS);
+}
+
 /**
  *
  * \brief This function used to to initialise i2c interface and run
@@ -183,6 +964,8 @@ static TEST_STATUS run_audio_playback_test(void *testArgs)
 	TEST_STATUS retVal;
 	Uint8  c = 0;
 
+    BOOT_traceRunStart();
+
     /* Enable clocks to all peripherals */
     CSL_SYSCTRL_REGS->PCGCR1 = 0x0000;
     CSL_SYSCTRL_REGS->PCGCR2 = 0x0000;
@@ -198,6 +981,13 @@ static TEST_STATUS run_audio_playback_test(void *testArgs)
     	C55x_msgWrite("I2C initialisation failed\n\r");
     	return (TEST_FAIL);
     }
+    BOOT_traceMark("i2c");
+
+    if ( i2c_scan_report() != TEST_PASS )
+    {
+        return (TEST_FAIL);
+    }
+    BOOT_traceMark("i2c scan");
 
     C55x_msgWrite("Test outputs a sine tone on HEADPHONE port of BoosterPack\n\n\r");
 
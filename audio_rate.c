@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file audio_rate.c
+*
+*   \brief Table driven AIC3206 sample rate manager.
+*
+*   All supported rates are precomputed from the 12 MHz MCLK. The 48 kHz
+*   family runs the PLL at 86.016 MHz (J.D = 7.1680) and the 44.1 kHz
+*   family at 90.3168 MHz (J.D = 7.5264). BCLK is kept at about 112 fs, as
+*   in the original 48 kHz bring-up, which is always more than the 64 fs
+*   needed for two 32-bit slots.
+*
+*   The table is the output of the host tool tools/gen_rate_table, which
+*   picks the dividers and validates them with audio_check_rate_config();
+*   regenerate it rather than editing entries by hand.
+*
+*   audio_set_sample_rate() compares the new entry with the one currently
+*   programmed and only writes the registers that differ, as bursts
+*   through AIC3206_writeSeq(). Switching within a family is a handful of
+*   I2C transactions and the PLL is only re-locked when the family
+*   changes.
+*
+*/
+
+#include "audio_rate.h"
+#include "aic3206_seq.h"
+
+/* Clock tree registers written by audio_set_sample_rate() */
+#define AUDIO_RATE_MAX_WRITES       (14)
+
+static const AUDIO_RateConfig audioRateTable[] =
+{
+	/*   fs    P  R  J     D  NDAC MDAC DOSR  NADC MADC AOSR  BCLK */
+	{  8000,   1, 1, 7, 1680,  3,   7,  512,   7,  12,  128,  32 },
+	{ 16000,   1, 1, 7, 1680,  3,   7,  256,   7,   6,  128,  16 },
+	{ 22050,   1, 1, 7, 5264,  2,   8,  256,   8,   4,  128,  18 },
+	{ 32000,   1, 1, 7, 1680,  3,   7,  128,   7,   3,  128,   8 },
+	{ 44100,   1, 1, 7, 5264,  2,   8,  128,   8,   2,  128,   9 },
+	{ 48000,   1, 1, 7, 1680,  2,   7,  128,   7,   2,  128,   8 },
+	{ 96000,   1, 1, 7, 1680,  2,   7,   64,   7,   2,   64,   4 }
+};
+
+#define AUDIO_RATE_TABLE_LEN  (sizeof(audioRateTable) / sizeof(audioRateTable[0]))
+
+/* Entry currently programmed in the codec, NULL when unknown */
+static const AUDIO_RateConfig *currentRate = NULL;
+
+/**
+ *
+ * \brief Looks up the table entry for a sample rate
+ *
+ * \param  fs - sample rate in Hz
+ *
+ * \return Table entry, NULL if the rate is not supported
+ *
+ */
+const AUDIO_RateConfig *audio_find_sample_rate(Uint32 fs)
+{
+	Uint16 i;
+
+	for (i = 0; i < AUDIO_RATE_TABLE_LEN; i++)
+	{
+		if (audioRateTable[i].fs == fs)
+		{
+			return (&audioRateTable[i]);
+		}
+	}
+
+	return (NULL);
+}
+
+/**
+ *
+ * \brief Checks one entry against the AIC3206 clock limits and verifies
+ *        that the dividers produce exactly 'fs' on both DAC and ADC sides.
+ *        Uses integer arithmetic only, so it runs on the target or a host.
+ *
+ * \param  cfg - table entry
+ *
+ * \return
+ * \n      TEST_PASS  - entry is valid
+ * \n      TEST_FAIL  - entry violates a limit
+ *
+ */
+TEST_STATUS audio_check_rate_config(const AUDIO_RateConfig *cfg)
+{
+	Uint32 pllIn;
+	Uint32 pllClk;
+	Uint32 dacClk;
+	Uint32 adcClk;
+	Uint32 dacDiv;
+	Uint32 adcDiv;
+
+	if ((cfg->pllP < 1) || (cfg->pllP > 8) ||
+	    (cfg->pllR < 1) || (cfg->pllR > 4) ||
+	    (cfg->pllJ < 1) || (cfg->pllJ > 63) || (cfg->pllD > 9999))
+	{
+		return (TEST_FAIL);
+	}
+
+	if ((cfg->ndac < 1) || (cfg->ndac > 128) ||
+	    (cfg->mdac < 1) || (cfg->mdac > 128) ||
+	    (cfg->nadc < 1) || (cfg->nadc > 128) ||
+	    (cfg->madc < 1) || (cfg->madc > 128) ||
+	    (cfg->dosr < 1) || (cfg->dosr > 1024) ||
+	    (cfg->aosr < 1) || (cfg->aosr > 256) ||
+	    (cfg->bclkN < 1) || (cfg->bclkN > 128))
+	{
+		return (TEST_FAIL);
+	}
+
+	pllIn = AUDIO_RATE_MCLK_HZ / cfg->pllP;
+
+	if (cfg->pllD != 0)
+	{
+		/* Fractional mode: narrower input range, J limited to 4..11 */
+		if ((pllIn < AUDIO_RATE_PLLIN_MIN_HZ) ||
+		    (pllIn > AUDIO_RATE_PLLIN_MAX_HZ) ||
+		    (cfg->pllJ < 4) || (cfg->pllJ > 11) ||
+		    ((pllIn % 10000) != 0))
+		{
+			return (TEST_FAIL);
+		}
+	}
+
+	/* PLL_CLK = MCLK * R * J.D / P, split so that nothing overflows */
+	pllClk = (pllIn * cfg->pllR * cfg->pllJ) +
+	         ((pllIn / 10000) * cfg->pllR * cfg->pllD);
+
+	if ((pllClk < AUDIO_RATE_PLL_MIN_HZ) || (pllClk > AUDIO_RATE_PLL_MAX_HZ))
+	{
+		return (TEST_FAIL);
+	}
+
+	dacClk = pllClk / cfg->ndac;
+	adcClk = pllClk / cfg->nadc;
+
+	if ((dacClk > AUDIO_RATE_CODEC_CLK_MAX_HZ) ||
+	    (adcClk > AUDIO_RATE_CODEC_CLK_MAX_HZ) ||
+	    ((dacClk / cfg->mdac) > AUDIO_RATE_MOD_CLK_MAX_HZ) ||
+	    ((adcClk / cfg->madc) > AUDIO_RATE_MOD_CLK_MAX_HZ))
+	{
+		return (TEST_FAIL);
+	}
+
+	if ((((Uint32)cfg->dosr * cfg->fs) < AUDIO_RATE_DOSR_FS_MIN_HZ) ||
+	    (((Uint32)cfg->dosr * cfg->fs) > AUDIO_RATE_DOSR_FS_MAX_HZ))
+	{
+		return (TEST_FAIL);
+	}
+
+	/* Both converters must land exactly on fs */
+	dacDiv = (Uint32)cfg->ndac * cfg->mdac * cfg->dosr;
+	adcDiv = (Uint32)cfg->nadc * cfg->madc * cfg->aosr;
+
+	if (((pllClk % dacDiv) != 0) || ((pllClk / dacDiv) != cfg->fs) ||
+	    ((pllClk % adcDiv) != 0) || ((pllClk / adcDiv) != cfg->fs))
+	{
+		return (TEST_FAIL);
+	}
+
+	if ((dacClk / cfg->bclkN) < (AUDIO_RATE_MIN_BCLK_PER_FS * cfg->fs))
+	{
+		return (TEST_FAIL);
+	}
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Runs audio_check_rate_config() over the whole table
+ *
+ * \return
+ * \n      TEST_PASS  - all entries valid
+ * \n      TEST_FAIL  - at least one entry is invalid
+ *
+ */
+TEST_STATUS audio_check_rate_table(void)
+{
+	TEST_STATUS result = TEST_PASS;
+	Uint16      i;
+
+	for (i = 0; i < AUDIO_RATE_TABLE_LEN; i++)
+	{
+		if (audio_check_rate_config(&audioRateTable[i]) != TEST_PASS)
+		{
+			C55x_msgWrite("Invalid clock settings for %lu Hz\n\r",
+			              audioRateTable[i].fs);
+			result = TEST_FAIL;
+		}
+	}
+
+	return (result);
+}
+
+/**
+ *
+ * \brief Appends a page 0 write to 'seq' unless the currently programmed
+ *        entry already has the value
+ *
+ */
+static void audio_rate_add(AIC3206_RegSeq *seq, Uint16 *count, Uint16 reg,
+                           Uint16 value, Uint16 oldValue, Bool force,
+                           Uint16 delayMs)
+{
+	if (force || (value != oldValue))
+	{
+		seq[*count].page    = 0;
+		seq[*count].reg     = reg;
+		seq[*count].value   = value;
+		seq[*count].delayMs = delayMs;
+		(*count)++;
+	}
+}
+
+/**
+ *
+ * \brief This function programs the codec clock tree for 'fs'. The writes
+ *        are ordered so that neighbouring registers go out as bursts:
+ *        PLL J/D (6-8), NDAC/MDAC/DOSR (11-14) and NADC/MADC/AOSR (18-20).
+ *
+ * \param  fs - sample rate in Hz, one of 8000, 16000, 22050, 32000, 44100,
+ *              48000 or 96000
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS audio_set_sample_rate(Uint32 fs)
+{
+	const AUDIO_RateConfig *cfg;
+	const AUDIO_RateConfig *old;
+	AIC3206_RegSeq          seq[AUDIO_RATE_MAX_WRITES];
+	Uint16                  count = 0;
+	Uint16                  pllPR;
+	Bool                    force;
+	Bool                    pllChange;
+
+	cfg = audio_find_sample_rate(fs);
+	if (cfg == NULL)
+	{
+		C55x_msgWrite("Unsupported sample rate %lu Hz\n\r", fs);
+		return (TEST_FAIL);
+	}
+
+	old = currentRate;
+	if (old == cfg)
+	{
+		return (TEST_PASS);
+	}
+
+	/* Nothing to compare against: program everything */
+	force = (old == NULL) ? TRUE : FALSE;
+	if (force)
+	{
+		old = cfg;
+	}
+
+	pllChange = (force ||
+	             (cfg->pllP != old->pllP) || (cfg->pllR != old->pllR) ||
+	             (cfg->pllJ != old->pllJ) || (cfg->pllD != old->pllD));
+
+	pllPR = ((cfg->pllP & 0x7) << 4) | (cfg->pllR & 0xF);
+
+	if (pllChange)
+	{
+		if (force)
+		{
+			// PLLCLK <- MCLK, CODEC_CLKIN <- PLL CLK
+			audio_rate_add(seq, &count, 4, 0x03, 0x03, TRUE, 0);
+		}
+		else
+		{
+			// PLL power down while J/D change
+			audio_rate_add(seq, &count, 5, pllPR, pllPR, TRUE, 0);
+		}
+
+		audio_rate_add(seq, &count, 6, cfg->pllJ, old->pllJ, force, 0);          // PLL J
+		audio_rate_add(seq, &count, 7, (cfg->pllD >> 8) & 0x3F,
+		               (old->pllD >> 8) & 0x3F, force, 0);                     // PLL D MSB
+		audio_rate_add(seq, &count, 8, cfg->pllD & 0xFF, old->pllD & 0xFF,
+		               force, 0);                                              // PLL D LSB
+		audio_rate_add(seq, &count, 5, 0x80 | pllPR, 0x80 | pllPR, TRUE, 10);  // PLL power up, wait 10ms
+	}
+
+	audio_rate_add(seq, &count, 11, 0x80 | (cfg->ndac & 0x7F),
+	               0x80 | (old->ndac & 0x7F), force, 0);                       // NDAC powered up
+	audio_rate_add(seq, &count, 12, 0x80 | (cfg->mdac & 0x7F),
+	               0x80 | (old->mdac & 0x7F), force, 0);                       // MDAC powered up
+	audio_rate_add(seq, &count, 13, (cfg->dosr >> 8) & 0x03,
+	               (old->dosr >> 8) & 0x03, force, 0);                         // DOSR MSB
+	audio_rate_add(seq, &count, 14, cfg->dosr & 0xFF, old->dosr & 0xFF,
+	               force, 0);                                                  // DOSR LSB
+	audio_rate_add(seq, &count, 18, 0x80 | (cfg->nadc & 0x7F),
+	               0x80 | (old->nadc & 0x7F), force, 0);                       // NADC powered up
+	audio_rate_add(seq, &count, 19, 0x80 | (cfg->madc & 0x7F),
+	               0x80 | (old->madc & 0x7F), force, 0);                       // MADC powered up
+	audio_rate_add(seq, &count, 20, cfg->aosr & 0xFF, old->aosr & 0xFF,
+	               force, 0);                                                  // AOSR, 0 = 256
+	audio_rate_add(seq, &count, 30, 0x80 | (cfg->bclkN & 0x7F),
+	               0x80 | (old->bclkN & 0x7F), force, 0);                      // BCLK N powered up
+
+	if (AIC3206_writeSeq(seq, count) != TEST_PASS)
+	{
+		currentRate = NULL;
+		return (TEST_FAIL);
+	}
+
+	currentRate = cfg;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Returns the programmed sample rate, 0 if unknown
+ *
+ */
+Uint32 audio_get_sample_rate(void)
+{
+	return ((currentRate != NULL) ? currentRate->fs : 0);
+}
+
+/**
+ *
+ * \brief Forgets the programmed entry, e.g. after a codec reset, so that
+ *        the next audio_set_sample_rate() writes every register
+ *
+ */
+void audio_invalidate_sample_rate(void)
+{
+	currentRate = NULL;
+}
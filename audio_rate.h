@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file audio_rate.h
+*
+*   \brief Table driven AIC3206 sample rate manager.
+*
+*/
+
+#ifndef _AUDIO_RATE_H_
+#define _AUDIO_RATE_H_
+
+#include "audio_common.h"
+
+/* Codec master clock on the BoosterPack */
+#define AUDIO_RATE_MCLK_HZ      (12000000)
+
+/* Datasheet clock limits */
+#define AUDIO_RATE_PLL_MIN_HZ       (80000000)
+#define AUDIO_RATE_PLL_MAX_HZ       (110000000)
+#define AUDIO_RATE_PLLIN_MIN_HZ     (10000000)   /* D != 0 */
+#define AUDIO_RATE_PLLIN_MAX_HZ     (20000000)
+#define AUDIO_RATE_CODEC_CLK_MAX_HZ (49152000)   /* DAC_CLK and ADC_CLK  */
+#define AUDIO_RATE_MOD_CLK_MAX_HZ   (6758000)    /* DAC/ADC_MOD_CLK      */
+#define AUDIO_RATE_DOSR_FS_MIN_HZ   (2800000)
+#define AUDIO_RATE_DOSR_FS_MAX_HZ   (6200000)
+#define AUDIO_RATE_MIN_BCLK_PER_FS  (64)
+
+typedef struct
+{
+	Uint32  fs;          /* sample rate in Hz                        */
+	Uint16  pllP;        /* PLL pre-divider, 1 to 8                  */
+	Uint16  pllR;        /* PLL multiplier R, 1 to 4                 */
+	Uint16  pllJ;        /* PLL integer multiplier J                 */
+	Uint16  pllD;        /* PLL fractional multiplier D, 0 to 9999   */
+	Uint16  ndac;
+	Uint16  mdac;
+	Uint16  dosr;
+	Uint16  nadc;
+	Uint16  madc;
+	Uint16  aosr;
+	Uint16  bclkN;       /* BCLK = DAC_CLK / bclkN                   */
+} AUDIO_RateConfig;
+
+const AUDIO_RateConfig *audio_find_sample_rate(Uint32 fs);
+TEST_STATUS audio_check_rate_config(const AUDIO_RateConfig *cfg);
+TEST_STATUS audio_check_rate_table(void);
+TEST_STATUS audio_set_sample_rate(Uint32 fs);
+Uint32 audio_get_sample_rate(void);
+void audio_invalidate_sample_rate(void);
+
+#endif /* _AUDIO_RATE_H_ */
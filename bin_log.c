@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file bin_log.c
+*
+*   \brief Deferred binary logging: call sites send a format id and raw
+*          arguments, the text is rebuilt off target.
+*
+*   vsprintf() costs thousands of cycles on the C55x, and a formatted line
+*   of statistics takes over 10 ms to leave at 115200 baud. In binary mode
+*   BLOG_log() writes a compact record into the UART log ring instead:
+*
+*       0xA5, length, id, varint(cycles since previous record),
+*       varint(arg)..., crc
+*
+*   Arguments are zig-zag encoded LEB128 varints, so small values take one
+*   byte. The argument count is not sent; the reader takes it from the
+*   format table in bin_log_formats.h, which BLOG_dumpFormats() prints as
+*   text at the start of a capture. Timestamps are GPT0 timebase cycles;
+*   the reader sums the deltas.
+*
+*   Bytes 0x80-0xFF never occur in the console text, so the reader finds
+*   records by the sync byte and passes everything else through. The sync
+*   byte can occur inside a varint though, so a reader that lost a byte
+*   cannot tell a record start from the middle of one by the sync alone.
+*   'length' counts id to last argument and 'crc' is a CRC-8 (polynomial
+*   0x07) over length to last argument: a reader takes a sync byte as a
+*   record start only if the CRC matches, and otherwise scans on from the
+*   byte after it. tools/blog_decode does that.
+*
+*   In text mode, the default, the same call sites are formatted on target
+*   through C55x_msgWrite() so a plain terminal still works. Binary mode
+*   needs the UART log ring (UART_logOpen()) and falls back to text
+*   without it.
+*
+*/
+
+#include "bin_log.h"
+#include "uart_log.h"
+#include "timebase.h"
+
+typedef struct
+{
+	Uint16       nargs;
+	const char  *fmt;
+} BLOG_Format;
+
+#define BLOG_ENTRY(id, nargs, fmt)  { nargs, fmt },
+static const BLOG_Format blogFormats[BLOG_ID_COUNT] =
+{
+	BLOG_FORMATS(BLOG_ENTRY)
+};
+#undef BLOG_ENTRY
+
+static BLOG_Mode    blogMode = BLOG_MODE_TEXT;
+static Uint32       blogLastCycles;
+static BLOG_Stats   blogStats;
+
+/* LEB128, seven bits per byte, low group first */
+static Uint16 BLOG_putVarint(Uint8 *out, Uint32 value)
+{
+	Uint16 n = 0;
+
+	while (value >= 0x80)
+	{
+		out[n++] = (Uint8)((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	out[n++] = (Uint8)value;
+
+	return (n);
+}
+
+/**
+ *
+ * \brief CRC-8, polynomial 0x07, initial value 0, as the record trailer
+ *
+ * \param  data   - bytes
+ * \param  length - number of bytes
+ *
+ * \return CRC
+ *
+ */
+Uint8 BLOG_crc8(const Uint8 *data, Uint16 length)
+{
+	Uint16 crc = 0;
+	Uint16 i;
+	Uint16 bit;
+
+	for (i = 0; i < length; i++)
+	{
+		crc ^= data[i];
+		for (bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1);
+		}
+		crc &= 0xFF;
+	}
+
+	return ((Uint8)crc);
+}
+
+/**
+ *
+ * \brief Selects how BLOG_log() call sites are emitted
+ *
+ * \param  mode - BLOG_MODE_TEXT, BLOG_MODE_BINARY or BLOG_MODE_OFF
+ *
+ * \return Previous mode
+ *
+ */
+BLOG_Mode BLOG_setMode(BLOG_Mode mode)
+{
+	BLOG_Mode old = blogMode;
+
+	blogMode       = mode;
+	blogLastCycles = C55x_nowCycles();
+
+	return (old);
+}
+
+/**
+ *
+ * \brief Returns the current mode
+ *
+ */
+BLOG_Mode BLOG_getMode(void)
+{
+	return (blogMode);
+}
+
+/**
+ *
+ * \brief Encodes one record
+ *
+ * \param  rec   - output, BLOG_MAX_RECORD bytes
+ * \param  id    - format id
+ * \param  delta - timebase cycles since the previous record
+ * \param  args  - arguments, as many as the format takes
+ *
+ * \return Record length in bytes
+ *
+ */
+Uint16 BLOG_encode(Uint8 *rec, BLOG_Id id, Uint32 delta, const Int32 *args)
+{
+	Uint16 len = 0;
+	Uint16 i;
+
+	rec[len++] = BLOG_SYNC;
+	len++;
+	rec[len++] = (Uint8)id;
+	len += BLOG_putVarint(&rec[len], delta);
+
+	for (i = 0; i < blogFormats[id].nargs; i++)
+	{
+		/* Zig-zag: small negative numbers stay short too */
+		len += BLOG_putVarint(&rec[len],
+		                      ((Uint32)args[i] << 1) ^
+		                      (Uint32)(args[i] >> 31));
+	}
+
+	/* Filled in last: id to last argument, then the check over both */
+	rec[1]     = (Uint8)(len - 2);
+	rec[len]   = BLOG_crc8(&rec[1], len - 1);
+	len++;
+
+	return (len);
+}
+
+/**
+ *
+ * \brief Logs a message from the format table. Use the BLOGn() macros,
+ *        which widen every argument to Int32. Callable from ISRs in
+ *        binary mode.
+ *
+ * \param  id  - format id
+ * \param  ... - Int32 arguments, as many as the format takes
+ *
+ */
+void BLOG_log(BLOG_Id id, ...)
+{
+	Int32   args[BLOG_MAX_ARGS];
+	Uint8   rec[BLOG_MAX_RECORD];
+	Uint16  len;
+	Uint16  i;
+	Uint32  now;
+	Bool    oldIntm;
+	va_list arg_ptr;
+
+	if ((blogMode == BLOG_MODE_OFF) || (id >= BLOG_ID_COUNT))
+	{
+		return;
+	}
+
+	va_start(arg_ptr, id);
+	for (i = 0; i < blogFormats[id].nargs; i++)
+	{
+		args[i] = va_arg(arg_ptr, Int32);
+	}
+	va_end(arg_ptr);
+
+	if ((blogMode == BLOG_MODE_TEXT) || !UART_logActive())
+	{
+		for (; i < BLOG_MAX_ARGS; i++)
+		{
+			args[i] = 0;
+		}
+
+		/* Every conversion is 32 bits wide, unused arguments are ignored */
+		C55x_msgWrite(blogFormats[id].fmt, args[0], args[1], args[2],
+		              args[3], args[4], args[5]);
+		return;
+	}
+
+	/* Timestamp and enqueue together so the deltas stay in stream order */
+	oldIntm = IRQ_globalDisable();
+
+	now = C55x_nowCycles();
+	len = BLOG_encode(rec, id, now - blogLastCycles, args);
+
+	if (UART_logWrite((const char *)rec, len) != 0)
+	{
+		blogLastCycles = now;
+		blogStats.records++;
+		blogStats.bytes += len;
+	}
+	else
+	{
+		blogStats.dropped++;
+	}
+
+	IRQ_globalRestore(oldIntm);
+}
+
+/**
+ *
+ * \brief Prints the format table as text, for the reader of a capture
+ *
+ */
+void BLOG_dumpFormats(void)
+{
+	Uint16 i;
+
+	C55x_msgWrite("BLOG formats %d, timebase %lu kHz\n\r", BLOG_ID_COUNT,
+	              C55x_timebaseGetClock());
+
+	for (i = 0; i < BLOG_ID_COUNT; i++)
+	{
+		/* Formats end in "\n\r" already */
+		C55x_msgWrite("BLOG %d %d ", i, blogFormats[i].nargs);
+		C55x_msgWrite("%s", blogFormats[i].fmt);
+	}
+}
+
+/**
+ *
+ * \brief Copies the binary log statistics
+ *
+ */
+void BLOG_getStats(BLOG_Stats *stats)
+{
+	*stats = blogStats;
+}
+
+/**
+ *
+ * \brief Compares a typical message through C55x_msgWrite() against the
+ *        binary record, both into the UART log ring
+ *
+ * \param  iterations - calls per path, the ring must hold them all
+ * \param  result     - cycles and bytes per call
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS BLOG_benchmark(Uint16 iterations, BLOG_BenchResult *result)
+{
+	static const char *benchFmt = "Bench %lu: %ld %lx\n\r";
+	BLOG_Mode oldMode;
+	Uint32    start;
+	Uint32    bytes;
+	Uint16    i;
+	char      text[UART_LOG_MAX_MSG];
+
+	if (!UART_logActive() || (iterations == 0) || !C55x_timebaseRunning())
+	{
+		return (TEST_FAIL);
+	}
+
+	result->textBytes = (Uint16)sprintf(text, benchFmt, 1000L, -25L,
+	                                    0xBEEFL);
+
+	start = C55x_nowCycles();
+	for (i = 0; i < iterations; i++)
+	{
+		C55x_msgWrite(benchFmt, 1000L + i, -25L, 0xBEEFL);
+	}
+	result->textCycles = (C55x_nowCycles() - start) / iterations;
+
+	UART_logFlush();
+
+	oldMode = BLOG_setMode(BLOG_MODE_BINARY);
+	bytes   = blogStats.bytes;
+
+	start = C55x_nowCycles();
+	for (i = 0; i < iterations; i++)
+	{
+		BLOG3(BLOG_ID_BENCH, 1000L + i, -25L, 0xBEEFL);
+	}
+	result->binaryCycles = (C55x_nowCycles() - start) / iterations;
+
+	result->binaryBytes = (Uint16)((blogStats.bytes - bytes) / iterations);
+
+	BLOG_setMode(oldMode);
+	UART_logFlush();
+
+	return (TEST_PASS);
+}
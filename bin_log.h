@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file bin_log.h
+*
+*   \brief Deferred binary logging: call sites send a format id and raw
+*          arguments, the text is rebuilt off target.
+*
+*/
+
+#ifndef _BIN_LOG_H_
+#define _BIN_LOG_H_
+
+#include "platform_internals.h"
+#include "bin_log_formats.h"
+
+/* First byte of every record, never part of the ASCII console text */
+#define BLOG_SYNC               (0xA5)
+
+#define BLOG_MAX_ARGS           (6)
+
+/* Sync, length, id, timestamp, six arguments at 5 bytes each worst case
+ * and the CRC */
+#define BLOG_MAX_RECORD         (3 + 5 + (BLOG_MAX_ARGS * 5) + 1)
+
+/* Bytes around the body the length byte counts */
+#define BLOG_RECORD_OVERHEAD    (3)
+
+#define BLOG_ENUM(id, nargs, fmt)   id,
+typedef enum
+{
+	BLOG_FORMATS(BLOG_ENUM)
+	BLOG_ID_COUNT
+} BLOG_Id;
+#undef BLOG_ENUM
+
+typedef enum
+{
+	BLOG_MODE_TEXT = 0,     /* format on target through C55x_msgWrite() */
+	BLOG_MODE_BINARY,       /* records into the UART log ring           */
+	BLOG_MODE_OFF
+} BLOG_Mode;
+
+typedef struct
+{
+	Uint32  records;
+	Uint32  bytes;          /* record bytes queued                     */
+	Uint32  dropped;        /* records the UART ring had no room for   */
+} BLOG_Stats;
+
+typedef struct
+{
+	Uint32  textCycles;     /* per call                                */
+	Uint32  binaryCycles;
+	Uint16  textBytes;      /* per call                                */
+	Uint16  binaryBytes;
+} BLOG_BenchResult;
+
+/* Arguments are widened here so the variadic call always sees Int32 */
+#define BLOG0(id) \
+	BLOG_log(id)
+#define BLOG1(id, a) \
+	BLOG_log(id, (Int32)(a))
+#define BLOG2(id, a, b) \
+	BLOG_log(id, (Int32)(a), (Int32)(b))
+#define BLOG3(id, a, b, c) \
+	BLOG_log(id, (Int32)(a), (Int32)(b), (Int32)(c))
+#define BLOG4(id, a, b, c, d) \
+	BLOG_log(id, (Int32)(a), (Int32)(b), (Int32)(c), (Int32)(d))
+#define BLOG5(id, a, b, c, d, e) \
+	BLOG_log(id, (Int32)(a), (Int32)(b), (Int32)(c), (Int32)(d), (Int32)(e))
+#define BLOG6(id, a, b, c, d, e, f) \
+	BLOG_log(id, (Int32)(a), (Int32)(b), (Int32)(c), (Int32)(d), \
+	         (Int32)(e), (Int32)(f))
+
+BLOG_Mode BLOG_setMode(BLOG_Mode mode);
+BLOG_Mode BLOG_getMode(void);
+void BLOG_log(BLOG_Id id, ...);
+Uint16 BLOG_encode(Uint8 *rec, BLOG_Id id, Uint32 delta, const Int32 *args);
+Uint8 BLOG_crc8(const Uint8 *data, Uint16 length);
+void BLOG_dumpFormats(void);
+void BLOG_getStats(BLOG_Stats *stats);
+TEST_STATUS BLOG_benchmark(Uint16 iterations, BLOG_BenchResult *result);
+
+#endif /* _BIN_LOG_H_ */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file bin_log_formats.h
+*
+*   \brief Format table for the deferred binary log.
+*
+*   One line per message: id, argument count, format. Arguments travel
+*   as 32-bit values, so every conversion needs the 'l' modifier (%ld,
+*   %lu, %lx). New messages go at the end; ids are part of the wire format
+*   and must not be renumbered.
+*
+*/
+
+#ifndef _BIN_LOG_FORMATS_H_
+#define _BIN_LOG_FORMATS_H_
+
+#define BLOG_FORMATS(X) \
+	X(BLOG_ID_BENCH,        3, "Bench %lu: %ld %lx\n\r") \
+	X(BLOG_ID_PIPE_STATS,   6, "Pipeline: %lu blocks, latency %ld samples, " \
+	                           "headroom %ld frames, %lu underruns, " \
+	                           "%lu overruns, worst block %lu cycles\n\r") \
+	X(BLOG_ID_CPU_LOAD,     2, "CPU: %ld%% active, %ld%% idle\n\r") \
+	X(BLOG_ID_CONSOLE,      2, "Console: %lu messages, %lu dropped\n\r") \
+	X(BLOG_ID_I2C_WR_FAIL,  0, "I2C Write failed\n\r") \
+	X(BLOG_ID_I2C_RD_FAIL,  0, "I2C Read failed\n\r") \
+	X(BLOG_ID_SYNTH_STATS,  4, "Synth: %lu blocks, peak %ld voices, " \
+	                           "%lu stolen, worst block %lu cycles\n\r") \
+	X(BLOG_ID_CMD_STATS,    5, "Commands: %lu posted, %lu dropped, " \
+	                           "max depth %ld, %lu ISRs, " \
+	                           "worst ISR %lu cycles\n\r") \
+	X(BLOG_ID_WAV_STATS,    5, "WAV: %lu sectors, %lu read errors, " \
+	                           "%lu underruns, min %ld buffers ready, " \
+	                           "worst read %lu cycles\n\r")
+
+#endif /* _BIN_LOG_FORMATS_H_ */
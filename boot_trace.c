@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file boot_trace.c
+*
+*   \brief Boot phase tracer: timestamps init stages up to the first audio
+*          sample.
+*
+*   Each BOOT_traceMark() stores the stage name and the C55x_nowUsec()
+*   time into a small table, which costs a few instructions and no I/O.
+*   BOOT_traceService(), called from the play loop, prints the table once
+*   the first sample is out, with the duration of every stage and the time
+*   to first sample.
+*
+*   BOOT_traceRunStart() begins a run. The first run keeps the marks of
+*   system init and counts from the start of the GPT0 timebase in
+*   ProgramPLL_100MHz(), a few instructions after reset; a later run (the
+*   test started again) clears the table and counts from its own start.
+*
+*/
+
+#include "boot_trace.h"
+#include "timebase.h"
+
+static BOOT_TraceMark  bootMarks[BOOT_TRACE_MAX_MARKS];
+static Uint16          bootMarkCount;
+static Uint16          bootMarksDropped;
+static Uint32          bootOriginUsec;
+static Uint32          bootFirstSampleUsec;
+static Bool            bootFirstSampleSeen;
+static Bool            bootDumpPending;
+static Bool            bootRunStarted;
+
+/**
+ *
+ * \brief Starts a traced run: keeps the system init marks on the first
+ *        call, clears the table and the first sample on later ones
+ *
+ */
+void BOOT_traceRunStart(void)
+{
+	bootFirstSampleUsec = 0;
+	bootFirstSampleSeen = FALSE;
+	bootDumpPending     = FALSE;
+
+	if (!bootRunStarted)
+	{
+		bootRunStarted = TRUE;
+		return;
+	}
+
+	bootMarkCount    = 0;
+	bootMarksDropped = 0;
+	bootOriginUsec   = C55x_nowUsec();
+	BOOT_traceMark("run start");
+}
+
+/**
+ *
+ * \brief Records the end of an init stage
+ *
+ * \param  name - stage name, must stay valid until BOOT_traceDump()
+ *
+ */
+void BOOT_traceMark(const char *name)
+{
+	if (bootMarkCount >= BOOT_TRACE_MAX_MARKS)
+	{
+		bootMarksDropped++;
+		return;
+	}
+
+	bootMarks[bootMarkCount].name = name;
+	bootMarks[bootMarkCount].usec = C55x_nowUsec() - bootOriginUsec;
+	bootMarkCount++;
+}
+
+/**
+ *
+ * \brief Records the first audio sample going out of this run; later
+ *        calls are ignored
+ *
+ */
+void BOOT_traceFirstSample(void)
+{
+	if (!bootFirstSampleSeen)
+	{
+		bootFirstSampleSeen = TRUE;
+		bootFirstSampleUsec = C55x_nowUsec() - bootOriginUsec;
+		BOOT_traceMark("first sample");
+		bootDumpPending = TRUE;
+	}
+}
+
+/**
+ *
+ * \brief Returns the time to first sample in us from the start of the
+ *        run, 0 if not reached yet
+ *
+ */
+Uint32 BOOT_traceFirstSampleUsec(void)
+{
+	return (bootFirstSampleUsec);
+}
+
+/**
+ *
+ * \brief Prints the table once per run, as soon as the first sample is out
+ *
+ */
+void BOOT_traceService(void)
+{
+	if (bootDumpPending)
+	{
+		bootDumpPending = FALSE;
+		BOOT_traceDump();
+	}
+}
+
+/**
+ *
+ * \brief Prints the recorded stages
+ *
+ */
+void BOOT_traceDump(void)
+{
+	Uint32 prev = 0;
+	Uint16 i;
+
+	C55x_msgWrite("Boot trace (us):\n\r");
+
+	for (i = 0; i < bootMarkCount; i++)
+	{
+		C55x_msgWrite("  %8lu  +%7lu  %s\n\r", bootMarks[i].usec,
+		              bootMarks[i].usec - prev, bootMarks[i].name);
+		prev = bootMarks[i].usec;
+	}
+
+	if (bootMarksDropped != 0)
+	{
+		C55x_msgWrite("  %d marks dropped\n\r", bootMarksDropped);
+	}
+
+	if (bootFirstSampleSeen)
+	{
+		C55x_msgWrite("Time to first sample: %lu us\n\r",
+		              bootFirstSampleUsec);
+	}
+}
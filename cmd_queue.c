@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file cmd_queue.c
+*
+*   \brief Deferred command queue. Interrupt service routines post control
+*          requests that the main loop executes.
+*
+*   Codec writes and console messages take milliseconds on the polled I2C
+*   and UART, far too long for an ISR. An ISR posts them here instead and
+*   CMD_dispatch(), called from the main loop, carries them out. The GPIO
+*   ISR posts its edges the same way, for GPIO_eventEdges() to debounce.
+*
+*   The queue is lock-free in the same way as the I2S rings: 'head' is only
+*   written by the producers and 'tail' only by the dispatcher, both run
+*   freely and wrap at 2^16. The producers are ISRs, which do not nest on
+*   the C55x, so they never race each other. Code outside an ISR has to
+*   post with interrupts disabled. The slots are volatile, so the compiler
+*   keeps a command's stores ahead of the 'head' update that publishes it.
+*
+*   ISRs that call CMD_isrEnter() and CMD_isrExit() have their run time
+*   tracked once a time source is registered with CMD_setClock().
+*
+*/
+
+#include "cmd_queue.h"
+#include "gpio_event.h"
+
+#define CMD_QUEUE_MASK      (CMD_QUEUE_SIZE - 1)
+
+static volatile CMD_Entry cmdQueue[CMD_QUEUE_SIZE];
+static volatile Uint16  cmdHead;
+static volatile Uint16  cmdTail;
+
+static CMD_ClockFxn     cmdClock;
+static CMD_QueueStats   cmdStats;
+
+/**
+ *
+ * \brief Empties the queue and clears the statistics
+ *
+ */
+void CMD_queueInit(void)
+{
+	cmdHead = 0;
+	cmdTail = 0;
+	memset(&cmdStats, 0, sizeof(cmdStats));
+}
+
+/**
+ *
+ * \brief Returns the number of commands waiting for the dispatcher
+ *
+ */
+Uint16 CMD_queueDepth(void)
+{
+	return ((Uint16)(cmdHead - cmdTail));
+}
+
+/**
+ *
+ * \brief Producer side: queues a command
+ *
+ * \param  cmd - command, copied into the queue
+ *
+ * \return TRUE if queued, FALSE if the queue was full
+ *
+ */
+Bool CMD_post(const CMD_Entry *cmd)
+{
+	Uint16 head;
+	Uint16 depth;
+
+	head  = cmdHead;
+	depth = (Uint16)(head - cmdTail);
+	if (depth >= CMD_QUEUE_SIZE)
+	{
+		cmdStats.dropped++;
+		return (FALSE);
+	}
+
+	cmdQueue[head & CMD_QUEUE_MASK] = *cmd;
+
+	/* Publish the command only after it has been written */
+	cmdHead = head + 1;
+
+	cmdStats.posted++;
+	if (depth + 1 > cmdStats.maxDepth)
+	{
+		cmdStats.maxDepth = depth + 1;
+	}
+
+	return (TRUE);
+}
+
+/**
+ *
+ * \brief Queues a codec register write
+ *
+ * \param  page  - codec page
+ * \param  reg   - register number
+ * \param  value - register data
+ *
+ * \return TRUE if queued
+ *
+ */
+Bool CMD_postCodecWrite(Uint16 page, Uint16 reg, Uint16 value)
+{
+	CMD_Entry cmd;
+
+	cmd.type  = CMD_CODEC_WRITE;
+	cmd.arg0  = page;
+	cmd.arg1  = reg;
+	cmd.arg2  = value;
+	cmd.stamp = 0;
+	cmd.msg   = NULL;
+	cmd.fxn   = NULL;
+
+	return (CMD_post(&cmd));
+}
+
+/**
+ *
+ * \brief Queues a console message
+ *
+ * \param  msg - C55x_msgWrite() format, must stay valid until dispatched
+ * \param  arg - value for a single conversion in 'msg'
+ *
+ * \return TRUE if queued
+ *
+ */
+Bool CMD_postLog(const char *msg, Uint16 arg)
+{
+	CMD_Entry cmd;
+
+	cmd.type  = CMD_LOG;
+	cmd.arg0  = arg;
+	cmd.arg1  = 0;
+	cmd.arg2  = 0;
+	cmd.stamp = 0;
+	cmd.msg   = msg;
+	cmd.fxn   = NULL;
+
+	return (CMD_post(&cmd));
+}
+
+/**
+ *
+ * \brief Queues a function call
+ *
+ * \param  fxn  - function to call from the main loop
+ * \param  arg0 - first argument
+ * \param  arg1 - second argument
+ *
+ * \return TRUE if queued
+ *
+ */
+Bool CMD_postCall(CMD_Fxn fxn, Uint16 arg0, Uint16 arg1)
+{
+	CMD_Entry cmd;
+
+	cmd.type  = CMD_CALL;
+	cmd.arg0  = arg0;
+	cmd.arg1  = arg1;
+	cmd.arg2  = 0;
+	cmd.stamp = 0;
+	cmd.msg   = NULL;
+	cmd.fxn   = fxn;
+
+	return (CMD_post(&cmd));
+}
+
+/**
+ *
+ * \brief Queues the edges of one GPIO interrupt for GPIO_eventEdges()
+ *
+ * \param  flags1 - IOINTFLG1 bits, pins 0-15
+ * \param  flags2 - IOINTFLG2 bits, pins 16-31
+ * \param  cycles - time of the interrupt
+ *
+ * \return TRUE if queued
+ *
+ */
+Bool CMD_postGpioEdges(Uint16 flags1, Uint16 flags2, Uint32 cycles)
+{
+	CMD_Entry cmd;
+
+	cmd.type  = CMD_GPIO_EDGES;
+	cmd.arg0  = flags1;
+	cmd.arg1  = flags2;
+	cmd.arg2  = 0;
+	cmd.stamp = cycles;
+	cmd.msg   = NULL;
+	cmd.fxn   = NULL;
+
+	return (CMD_post(&cmd));
+}
+
+/**
+ *
+ * \brief Consumer side: executes every queued command. Called from the
+ *        main loop.
+ *
+ * \return Number of commands executed
+ *
+ */
+Uint16 CMD_dispatch(void)
+{
+	CMD_Entry cmd;
+	Uint16    tail;
+	Uint16    count = 0;
+
+	tail = cmdTail;
+	while (tail != cmdHead)
+	{
+		cmd = cmdQueue[tail & CMD_QUEUE_MASK];
+
+		/* Release the slot before running the command, so that an ISR
+		 * firing meanwhile can reuse it */
+		tail++;
+		cmdTail = tail;
+
+		switch (cmd.type)
+		{
+			case CMD_CODEC_WRITE:
+				AIC3206_write(0, cmd.arg0);
+				AIC3206_write(cmd.arg1, cmd.arg2);
+				break;
+
+			case CMD_LOG:
+				C55x_msgWrite(cmd.msg, cmd.arg0);
+				break;
+
+			case CMD_CALL:
+				cmd.fxn(cmd.arg0, cmd.arg1);
+				break;
+
+			case CMD_GPIO_EDGES:
+				GPIO_eventEdges(cmd.arg0, cmd.arg1, cmd.stamp);
+				break;
+
+			default:
+				break;
+		}
+
+		count++;
+	}
+
+	cmdStats.dispatched += count;
+
+	return (count);
+}
+
+/**
+ *
+ * \brief Registers a free running time source for ISR timing
+ *
+ */
+void CMD_setClock(CMD_ClockFxn clockFxn)
+{
+	cmdClock = clockFxn;
+}
+
+/**
+ *
+ * \brief Marks the start of a timed ISR
+ *
+ * \return Start time to pass to CMD_isrExit()
+ *
+ */
+Uint32 CMD_isrEnter(void)
+{
+	return ((cmdClock != NULL) ? cmdClock() : 0);
+}
+
+/**
+ *
+ * \brief Marks the end of a timed ISR and records its run time
+ *
+ * \param  start - value returned by CMD_isrEnter()
+ *
+ */
+void CMD_isrExit(Uint32 start)
+{
+	Uint32 elapsed;
+
+	if (cmdClock == NULL)
+	{
+		return;
+	}
+
+	elapsed = cmdClock() - start;
+
+	cmdStats.isrCount++;
+	if (elapsed > cmdStats.isrWorst)
+	{
+		cmdStats.isrWorst = elapsed;
+	}
+}
+
+/**
+ *
+ * \brief Copies the queue statistics
+ *
+ */
+void CMD_getStats(CMD_QueueStats *stats)
+{
+	*stats = cmdStats;
+	stats->depth = CMD_queueDepth();
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file cmd_queue.h
+*
+*   \brief Deferred command queue. Interrupt service routines post control
+*          requests that the main loop executes.
+*
+*/
+
+#ifndef _CMD_QUEUE_H_
+#define _CMD_QUEUE_H_
+
+#include "audio_common.h"
+
+/* Queue size in commands, must be a power of two */
+#define CMD_QUEUE_SIZE          (16)
+
+/* Command types */
+#define CMD_CODEC_WRITE         (1)
+#define CMD_LOG                 (2)
+#define CMD_CALL                (3)
+#define CMD_GPIO_EDGES          (4)
+
+typedef void (*CMD_Fxn)(Uint16 arg0, Uint16 arg1);
+
+typedef struct
+{
+	Uint16       type;
+	Uint16       arg0;      /* codec page, log argument, call argument,
+	                           IOINTFLG1                               */
+	Uint16       arg1;      /* codec register, call argument,
+	                           IOINTFLG2                               */
+	Uint16       arg2;      /* codec value                             */
+	Uint32       stamp;     /* GPIO edge time                          */
+	const char  *msg;       /* log format, must stay valid             */
+	CMD_Fxn      fxn;       /* function for CMD_CALL                   */
+} CMD_Entry;
+
+typedef struct
+{
+	Uint32  posted;
+	Uint32  dispatched;
+	Uint32  dropped;        /* posts that found the queue full         */
+	Uint16  depth;          /* commands waiting now                    */
+	Uint16  maxDepth;       /* deepest the queue has been              */
+	Uint32  isrCount;       /* ISRs timed through CMD_isrEnter/Exit    */
+	Uint32  isrWorst;       /* longest timed ISR, CMD_ClockFxn units   */
+} CMD_QueueStats;
+
+typedef Uint32 (*CMD_ClockFxn)(void);
+
+void   CMD_queueInit(void);
+Bool   CMD_post(const CMD_Entry *cmd);
+Bool   CMD_postCodecWrite(Uint16 page, Uint16 reg, Uint16 value);
+Bool   CMD_postLog(const char *msg, Uint16 arg);
+Bool   CMD_postCall(CMD_Fxn fxn, Uint16 arg0, Uint16 arg1);
+Bool   CMD_postGpioEdges(Uint16 flags1, Uint16 flags2, Uint32 cycles);
+Uint16 CMD_dispatch(void);
+Uint16 CMD_queueDepth(void);
+void   CMD_setClock(CMD_ClockFxn clockFxn);
+Uint32 CMD_isrEnter(void);
+void   CMD_isrExit(Uint32 start);
+void   CMD_getStats(CMD_QueueStats *stats);
+
+#endif /* _CMD_QUEUE_H_ */
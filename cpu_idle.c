@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file cpu_idle.c
+*
+*   \brief Wait-for-interrupt idle with CPU load accounting.
+*
+*   C55x_idle() puts the CPU domain in IDLE until the next enabled
+*   interrupt; DMA, I2S, I2C, GPIO and the timers keep running and wake it.
+*   Wait loops call C55x_idleUnless() with a check of the state the ISRs
+*   move on. The check and the IDLE run with INTM set: an interrupt raised
+*   in between still ends the IDLE (the C55x wakes on any interrupt
+*   enabled in IER whatever INTM says), and its ISR runs once INTM is
+*   cleared again, so no wake-up is lost between the check and the sleep.
+*
+*   GPT1 is the wake source for delays: C55x_idleDelayUsec() arms it one
+*   shot and idles until the GPT0 timebase says the delay is over. It needs
+*   the vector table, so C55x_idleInit() has to be called after
+*   gpio_interrupt_initiliastion(); until then delays spin.
+*
+*   The time spent in IDLE is measured on the timebase, giving the CPU
+*   load since the last C55x_idleStatsReset(). Both counts are kept in
+*   ticks of 2^C55X_IDLE_TICK_SHIFT cycles with the cycles below a tick
+*   carried, so they outlast the 32-bit cycle count; the total is brought
+*   up to date on every IDLE and has to see one per cycle count wrap.
+*
+*   Off target C55x_idle() waits on a condition variable that
+*   C55x_idleWake() signals, for host threads standing in for interrupts.
+*
+*/
+
+#include "cpu_idle.h"
+#include "timebase.h"
+
+#ifdef __TMS320C55X__
+
+/* Idle configuration register, CPU domain only */
+#define C55X_ICR_ADDR           (0x0001)
+#define C55X_ICR_CPUI           (0x0001)
+
+/* TIAFR flag of GPT1 */
+#define C55X_IDLE_TIAFR_GPT1    (0x0002)
+
+static CSL_GptObj   idleGptObj;
+static CSL_Handle   hIdleGpt;
+
+#else
+
+#include <pthread.h>
+#include <time.h>
+
+static pthread_mutex_t idleLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  idleCond = PTHREAD_COND_INITIALIZER;
+
+#endif
+
+static volatile Bool    idleDelayReady;
+static C55x_IdleStats   idleStats;
+
+/* Cycles not yet counted as ticks: the total up to 'idleLastCycles', and
+ * the idle time below one tick */
+static Uint32           idleLastCycles;
+static Uint32           idleCarry;
+
+/* Brings the total up to 'now', whole ticks only */
+static void C55x_idleCountTotal(Uint32 now)
+{
+	Uint32 ticks;
+
+	ticks = (now - idleLastCycles) >> C55X_IDLE_TICK_SHIFT;
+	idleStats.totalTicks += ticks;
+	idleLastCycles       += ticks << C55X_IDLE_TICK_SHIFT;
+}
+
+#ifdef __TMS320C55X__
+
+/**
+ *  \brief  GPT1 Interrupt Service Routine
+ *
+ *  Only acknowledges the delay timer; waking the CPU is all it is for.
+ *
+ *  \return none
+ */
+interrupt void idleTimerIsr(void)
+{
+	CSL_SYSCTRL_REGS->TIAFR = C55X_IDLE_TIAFR_GPT1;
+}
+
+#endif
+
+/**
+ *
+ * \brief Sets up GPT1 as the delay wake source. Must run after the vector
+ *        table has been set up.
+ *
+ */
+void C55x_idleInit(void)
+{
+#ifdef __TMS320C55X__
+	CSL_Status  status;
+
+	if (hIdleGpt == NULL)
+	{
+		hIdleGpt = GPT_open(GPT_1, &idleGptObj, &status);
+		if ((hIdleGpt == NULL) || (status != CSL_SOK))
+		{
+			hIdleGpt = NULL;
+			return;
+		}
+	}
+
+	GPT_reset(hIdleGpt);
+	CSL_SYSCTRL_REGS->TIAFR = C55X_IDLE_TIAFR_GPT1;
+
+	IRQ_clear(TINT_EVENT);
+	IRQ_plug(TINT_EVENT, &idleTimerIsr);
+	IRQ_enable(TINT_EVENT);
+#endif
+
+	idleDelayReady = TRUE;
+	C55x_idleStatsReset();
+}
+
+/**
+ *
+ * \brief Tells whether delays idle rather than spin
+ *
+ */
+Bool C55x_idleDelayReady(void)
+{
+	return (idleDelayReady && C55x_timebaseRunning());
+}
+
+/**
+ *
+ * \brief Idles the CPU until the next interrupt. Interrupts disabled by
+ *        the caller still end the IDLE, their ISRs run once they are
+ *        enabled again.
+ *
+ */
+void C55x_idle(void)
+{
+	Uint32 start;
+	Uint32 end;
+
+	start = C55x_nowCycles();
+
+#ifdef __TMS320C55X__
+	*(volatile ioport Uint16 *)C55X_ICR_ADDR = C55X_ICR_CPUI;
+	asm(" IDLE");
+#else
+	{
+		struct timespec ts;
+
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_nsec += 1000000;
+		if (ts.tv_nsec >= 1000000000)
+		{
+			ts.tv_nsec -= 1000000000;
+			ts.tv_sec++;
+		}
+
+		pthread_mutex_lock(&idleLock);
+		pthread_cond_timedwait(&idleCond, &idleLock, &ts);
+		pthread_mutex_unlock(&idleLock);
+	}
+#endif
+
+	end = C55x_nowCycles();
+
+	idleCarry            += end - start;
+	idleStats.idleTicks  += idleCarry >> C55X_IDLE_TICK_SHIFT;
+	idleCarry            &= (1 << C55X_IDLE_TICK_SHIFT) - 1;
+	idleStats.wakeups++;
+	C55x_idleCountTotal(end);
+}
+
+/**
+ *
+ * \brief Idles until the next interrupt unless 'workFxn' finds work. The
+ *        check and the IDLE run with interrupts disabled, so an interrupt
+ *        after the check still ends the IDLE.
+ *
+ * \param  workFxn - check of the state the ISRs update
+ * \param  arg     - argument for 'workFxn'
+ *
+ * \return TRUE if the CPU idled, FALSE if there was work
+ *
+ */
+Bool C55x_idleUnless(C55x_IdleWorkFxn workFxn, void *arg)
+{
+	Bool oldIntm;
+	Bool idled = FALSE;
+
+	oldIntm = IRQ_globalDisable();
+
+	if (!workFxn(arg))
+	{
+		C55x_idle();
+		idled = TRUE;
+	}
+
+	/* The ISR of the interrupt that woke the CPU runs here */
+	IRQ_globalRestore(oldIntm);
+
+	return (idled);
+}
+
+/**
+ *
+ * \brief Wakes C55x_idle(). Interrupts do this by themselves on the
+ *        target, so it only matters to host threads.
+ *
+ */
+void C55x_idleWake(void)
+{
+#ifndef __TMS320C55X__
+	pthread_mutex_lock(&idleLock);
+	pthread_cond_broadcast(&idleCond);
+	pthread_mutex_unlock(&idleLock);
+#endif
+}
+
+/* Delay over, the GPT1 interrupt has gone or is about to */
+static Bool C55x_idleDelayDone(void *arg)
+{
+	return (C55x_deadlinePassed(*(Uint32 *)arg));
+}
+
+/**
+ *
+ * \brief Waits 'usec' microseconds, idling on GPT1 when it is set up
+ *
+ * \param    usec - number of microseconds
+ *
+ * \return   void
+ */
+void C55x_idleDelayUsec(Uint32 usec)
+{
+	Uint32 deadline;
+#ifdef __TMS320C55X__
+	CSL_Config hwConfig;
+	Uint32     ticks;
+#endif
+
+	if (!C55x_idleDelayReady() || (usec < C55X_IDLE_MIN_USEC))
+	{
+		C55x_delay_usec(usec);
+		return;
+	}
+
+	deadline = C55x_deadline(usec);
+
+#ifdef __TMS320C55X__
+	/* One shot at half the system clock, like the timebase */
+	ticks = C55x_usecToCycles(usec) / C55X_TIMEBASE_PRESCALE;
+
+	hwConfig.autoLoad    = 0;
+	hwConfig.ctrlTim     = GPT_TIMER_ENABLE;
+	hwConfig.preScaleDiv = GPT_PRE_SC_DIV_0;
+	hwConfig.prdLow      = (Uint16)(ticks & 0xFFFF);
+	hwConfig.prdHigh     = (Uint16)(ticks >> 16);
+
+	GPT_config(hIdleGpt, &hwConfig);
+	GPT_start(hIdleGpt);
+#endif
+
+	while (C55x_idleUnless(C55x_idleDelayDone, &deadline))
+	{
+		;
+	}
+
+#ifdef __TMS320C55X__
+	GPT_stop(hIdleGpt);
+#endif
+}
+
+/**
+ *
+ * \brief Starts a new CPU load measurement
+ *
+ */
+void C55x_idleStatsReset(void)
+{
+	memset(&idleStats, 0, sizeof(idleStats));
+	idleCarry      = 0;
+	idleLastCycles = C55x_nowCycles();
+}
+
+/**
+ *
+ * \brief Returns the CPU load since C55x_idleStatsReset()
+ *
+ */
+void C55x_idleGetStats(C55x_IdleStats *stats)
+{
+	Uint32 total;
+	Uint32 idle;
+	Bool   oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+	C55x_idleCountTotal(C55x_nowCycles());
+	*stats = idleStats;
+	IRQ_globalRestore(oldIntm);
+
+	if (stats->totalTicks < stats->idleTicks)
+	{
+		stats->totalTicks = stats->idleTicks;
+	}
+
+	/* Scaled down until the product fits 32 bits */
+	total = stats->totalTicks;
+	idle  = stats->idleTicks;
+	while (total > 0x00FFFFFF)
+	{
+		total >>= 1;
+		idle  >>= 1;
+	}
+
+	stats->idlePercent = 0;
+	if (total != 0)
+	{
+		stats->idlePercent = (Uint16)((idle * 100) / total);
+	}
+	if (stats->idlePercent > 100)
+	{
+		stats->idlePercent = 100;
+	}
+	stats->activePercent = 100 - stats->idlePercent;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file cpu_idle.h
+*
+*   \brief Wait-for-interrupt idle with CPU load accounting.
+*
+*/
+
+#ifndef _CPU_IDLE_H_
+#define _CPU_IDLE_H_
+
+#include "platform_internals.h"
+
+/* Delays shorter than this spin rather than idle on GPT1 */
+#define C55X_IDLE_MIN_USEC      (50)
+
+/* Load is counted in ticks of 2^8 cycles: 2.56us at 100 MHz, wrapping
+ * after 3 hours rather than the 43 s of the cycle count */
+#define C55X_IDLE_TICK_SHIFT    (8)
+
+typedef struct
+{
+	Uint32  totalTicks;     /* since C55x_idleStatsReset()           */
+	Uint32  idleTicks;      /* spent in IDLE                         */
+	Uint32  wakeups;
+	Uint16  idlePercent;
+	Uint16  activePercent;
+} C55x_IdleStats;
+
+/**
+ * \brief Tells whether a wait loop has something to do. Called with
+ *        interrupts disabled, so it must only look at state.
+ *
+ * \param arg - argument given to C55x_idleUnless()
+ */
+typedef Bool (*C55x_IdleWorkFxn)(void *arg);
+
+void C55x_idleInit(void);
+void C55x_idle(void);
+Bool C55x_idleUnless(C55x_IdleWorkFxn workFxn, void *arg);
+void C55x_idleWake(void);
+void C55x_idleDelayUsec(Uint32 usec);
+Bool C55x_idleDelayReady(void);
+void C55x_idleStatsReset(void);
+void C55x_idleGetStats(C55x_IdleStats *stats);
+
+#endif /* _CPU_IDLE_H_ */
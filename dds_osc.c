@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file dds_osc.c
+*
+*   \brief Fixed-point phase accumulator (DDS) sine oscillator.
+*
+*   The top DDS_TABLE_BITS of the phase select a sine table entry and the
+*   next 15 bits linearly interpolate towards the following entry. Any
+*   frequency below Nyquist can be generated at a fixed sample rate with a
+*   resolution of fs / 2^32, without touching the codec clocks.
+*
+*/
+
+#include "dds_osc.h"
+
+/* One sine cycle in Q15, with a guard entry so that interpolation at the
+ * last index does not need to wrap */
+static const Int16 ddsSineTable[DDS_TABLE_LEN + 1] = {
+	     0,    804,   1608,   2410,   3212,   4011,   4808,   5602,
+	  6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+	 12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+	 18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+	 23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,
+	 27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+	 30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,
+	 32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+	 32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+	 32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+	 30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,
+	 27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+	 23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,
+	 18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+	 12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+	  6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+	     0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,
+	 -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+	-12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+	-18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+	-23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+	-27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+	-30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+	-32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+	-32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+	-32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+	-30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+	-27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+	-23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+	-18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+	-12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,
+	 -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804,
+	     0
+};
+
+/**
+ *
+ * \brief Computes the phase increment for 'freqHz' at 'sampleRate', i.e.
+ *        freqHz * 2^32 / sampleRate, without 64-bit arithmetic
+ *
+ * \param  freqHz     - output frequency, must be below 'sampleRate'
+ * \param  sampleRate - sample rate in Hz
+ *
+ * \return Phase increment per sample
+ *
+ */
+Uint32 DDS_phaseInc(Uint32 freqHz, Uint32 sampleRate)
+{
+	Uint32 rem;
+	Uint32 inc = 0;
+	Uint16 bit;
+
+	if ((sampleRate == 0) || (freqHz >= sampleRate))
+	{
+		return (0);
+	}
+
+	/* Binary long division of the fraction freqHz / sampleRate */
+	rem = freqHz;
+	for (bit = 0; bit < 32; bit++)
+	{
+		rem <<= 1;
+		inc <<= 1;
+		if (rem >= sampleRate)
+		{
+			rem -= sampleRate;
+			inc |= 1;
+		}
+	}
+
+	return (inc);
+}
+
+/**
+ *
+ * \brief Initializes an oscillator at phase zero
+ *
+ * \param  osc        - oscillator
+ * \param  freqHz     - output frequency
+ * \param  sampleRate - sample rate in Hz
+ * \param  amplitude  - Q15 output gain
+ *
+ * \return void
+ *
+ */
+void DDS_init(DDS_Osc *osc, Uint32 freqHz, Uint32 sampleRate, Int16 amplitude)
+{
+	osc->phase     = 0;
+	osc->phaseInc  = DDS_phaseInc(freqHz, sampleRate);
+	osc->amplitude = amplitude;
+}
+
+/**
+ *
+ * \brief Changes the oscillator frequency; the phase is kept so there is
+ *        no discontinuity in the output
+ *
+ * \param  osc        - oscillator
+ * \param  freqHz     - output frequency
+ * \param  sampleRate - sample rate in Hz
+ *
+ * \return void
+ *
+ */
+void DDS_setFreq(DDS_Osc *osc, Uint32 freqHz, Uint32 sampleRate)
+{
+	osc->phaseInc = DDS_phaseInc(freqHz, sampleRate);
+}
+
+/**
+ *
+ * \brief Generates a block of Q15 samples
+ *
+ * \param  osc   - oscillator
+ * \param  out   - destination
+ * \param  count - number of samples
+ *
+ * \return void
+ *
+ */
+void DDS_generate(DDS_Osc *osc, Int16 *out, Uint16 count)
+{
+	Uint32 phase;
+	Uint32 phaseInc;
+	Int16  amplitude;
+	Uint16 index;
+	Int16  frac;
+	Int16  s0;
+	Int32  sample;
+
+	phase     = osc->phase;
+	phaseInc  = osc->phaseInc;
+	amplitude = osc->amplitude;
+
+	while (count--)
+	{
+		index = (Uint16)(phase >> (32 - DDS_TABLE_BITS));
+		frac  = (Int16)((phase >> (32 - DDS_TABLE_BITS - 15)) & 0x7FFF);
+
+		s0     = ddsSineTable[index];
+		sample = s0 + ((((Int32)(ddsSineTable[index + 1] - s0)) * frac) >> 15);
+
+		*out++ = (Int16)((sample * amplitude) >> 15);
+
+		phase += phaseInc;
+	}
+
+	osc->phase = phase;
+}
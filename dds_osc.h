@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file dds_osc.h
+*
+*   \brief Fixed-point phase accumulator (DDS) sine oscillator.
+*
+*/
+
+#ifndef _DDS_OSC_H_
+#define _DDS_OSC_H_
+
+#include "audio_common.h"
+
+/* Sine table has 2^DDS_TABLE_BITS entries plus one guard entry */
+#define DDS_TABLE_BITS      (8)
+#define DDS_TABLE_LEN       (1 << DDS_TABLE_BITS)
+
+typedef struct
+{
+	Uint32  phase;        /* 32-bit phase accumulator, 2^32 = one cycle */
+	Uint32  phaseInc;     /* phase step per sample                      */
+	Int16   amplitude;    /* Q15 output gain                            */
+} DDS_Osc;
+
+void DDS_init(DDS_Osc *osc, Uint32 freqHz, Uint32 sampleRate, Int16 amplitude);
+void DDS_setFreq(DDS_Osc *osc, Uint32 freqHz, Uint32 sampleRate);
+Uint32 DDS_phaseInc(Uint32 freqHz, Uint32 sampleRate);
+void DDS_generate(DDS_Osc *osc, Int16 *out, Uint16 count);
+
+#endif /* _DDS_OSC_H_ */
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file dsp_kernels.c
+*
+*   \brief Q15 block processing kernels: FIR, biquad cascade, gain, mix
+*          and stereo interleave/deinterleave.
+*
+*   The kernels are portable C with 40-bit accumulation. Only DSP_gain()
+*   has a C55x fast path, built with the C55x compiler or on a host that
+*   defines DSP_FAST_PATHS and models the intrinsics; it is bit-exact with
+*   DSP_gainRef(). The fractional MAC intrinsics saturate every product
+*   and every partial sum to 32 bits, so they cannot reproduce the 40-bit
+*   sums of the FIR, biquad and mix, and the compiler offers no intrinsic
+*   for the dual MAC. Those kernels are written so that the compiler can
+*   pair the MACs itself.
+*
+*   The FIR computes two outputs per pass so that each coefficient load
+*   serves two MACs. Whether that maps onto both MAC units has to be
+*   checked in the generated assembly; it is not forced here.
+*
+*   The FIR keeps its history linearly in front of the current block
+*   instead of in a circular buffer: the two-output loop needs two
+*   consecutive input windows, which circular addressing from C does not
+*   give, and the cost is a copy of taps-1 samples per block. Blocks
+*   longer than DSP_FIR_MAX_BLOCK are filtered in pieces of that size.
+*
+*/
+
+#include "dsp_kernels.h"
+
+#ifdef __TMS320C55X__
+#define DSP_FAST_PATHS
+#endif
+
+/**
+ *
+ * \brief Saturates a 32-bit value to 16 bits
+ *
+ */
+Int16 DSP_sat16(Int32 value)
+{
+	if (value > 32767)
+	{
+		return (32767);
+	}
+	if (value < -32768)
+	{
+		return (-32768);
+	}
+	return ((Int16)value);
+}
+
+/* Q30 accumulator -> rounded, saturated Q15 */
+static Int16 DSP_accToQ15(DSP_Acc acc, Uint16 shift)
+{
+	acc = (acc + ((DSP_Acc)1 << (shift - 1))) >> shift;
+
+	if (acc > 32767)
+	{
+		return (32767);
+	}
+	if (acc < -32768)
+	{
+		return (-32768);
+	}
+	return ((Int16)acc);
+}
+
+/**
+ *
+ * \brief Initializes a FIR filter and clears its history
+ *
+ * \param  fir   - filter object
+ * \param  coefs - Q15 coefficients
+ * \param  work  - DSP_FIR_WORK_LEN(taps) samples of scratch/history
+ * \param  taps  - number of coefficients, 1 to 256
+ *
+ * \return void
+ *
+ */
+void DSP_firInit(DSP_Fir *fir, const Int16 *coefs, Int16 *work, Uint16 taps)
+{
+	fir->coefs = coefs;
+	fir->work  = work;
+	fir->taps  = taps;
+
+	memset(work, 0, DSP_FIR_WORK_LEN(taps) * sizeof(Int16));
+}
+
+/* Appends at most DSP_FIR_MAX_BLOCK samples behind the history, returns
+ * how many were taken */
+static Uint16 DSP_firLoad(DSP_Fir *fir, const Int16 *in, Uint16 count)
+{
+	if (count > DSP_FIR_MAX_BLOCK)
+	{
+		count = DSP_FIR_MAX_BLOCK;
+	}
+
+	memcpy(&fir->work[fir->taps - 1], in, count * sizeof(Int16));
+
+	return (count);
+}
+
+/* Keeps the last taps-1 inputs as history for the next block */
+static void DSP_firSave(DSP_Fir *fir, Uint16 count)
+{
+	memmove(fir->work, &fir->work[count], (fir->taps - 1) * sizeof(Int16));
+}
+
+/**
+ *
+ * \brief FIR filter: out[n] = sum(h[k] * x[n-k]), rounded to Q15
+ *
+ * \param  fir   - filter object
+ * \param  in    - input samples
+ * \param  out   - output samples, may not alias 'in'
+ * \param  count - number of samples
+ *
+ * \return void
+ *
+ */
+void DSP_firBlock(DSP_Fir *fir, const Int16 *in, Int16 *out, Uint16 count)
+{
+	const Int16 * restrict h = fir->coefs;
+	const Int16 * restrict x;
+	DSP_Acc      acc0;
+	DSP_Acc      acc1;
+	Uint16       taps = fir->taps;
+	Uint16       chunk;
+	Uint16       n;
+	Uint16       k;
+
+	while (count)
+	{
+		chunk = DSP_firLoad(fir, in, count);
+
+		/* Two outputs per pass share every coefficient load */
+		for (n = 0; n + 1 < chunk; n += 2)
+		{
+			x    = &fir->work[taps - 1 + n];
+			acc0 = 0;
+			acc1 = 0;
+			#pragma MUST_ITERATE(1, 256)
+			for (k = 0; k < taps; k++)
+			{
+				acc0 += (Int32)h[k] * x[-(Int16)k];
+				acc1 += (Int32)h[k] * x[1 - (Int16)k];
+			}
+			out[n]     = DSP_accToQ15(acc0, 15);
+			out[n + 1] = DSP_accToQ15(acc1, 15);
+		}
+
+		/* Odd block length */
+		if (n < chunk)
+		{
+			x    = &fir->work[taps - 1 + n];
+			acc0 = 0;
+			for (k = 0; k < taps; k++)
+			{
+				acc0 += (Int32)h[k] * x[-(Int16)k];
+			}
+			out[n] = DSP_accToQ15(acc0, 15);
+		}
+
+		DSP_firSave(fir, chunk);
+
+		in    += chunk;
+		out   += chunk;
+		count -= chunk;
+	}
+}
+
+/**
+ *
+ * \brief Initializes a direct form I biquad cascade and clears its state
+ *
+ * \param  bq       - filter object
+ * \param  coefs    - b0, b1, b2, a1, a2 per section in Q14; the feedback
+ *                    terms are subtracted (y = b*x - a*y)
+ * \param  state    - DSP_BIQUAD_NUM_STATE samples per section
+ * \param  sections - number of second order sections
+ *
+ * \return void
+ *
+ */
+void DSP_biquadInit(DSP_Biquad *bq, const Int16 *coefs, Int16 *state,
+                    Uint16 sections)
+{
+	bq->coefs    = coefs;
+	bq->state    = state;
+	bq->sections = sections;
+
+	memset(state, 0, sections * DSP_BIQUAD_NUM_STATE * sizeof(Int16));
+}
+
+/**
+ *
+ * \brief Runs a block through the biquad cascade. Each section output is
+ *        rounded and saturated to Q15 before feeding the next one.
+ *
+ * \param  bq    - filter object
+ * \param  in    - input samples
+ * \param  out   - output samples, may alias 'in'
+ * \param  count - number of samples
+ *
+ * \return void
+ *
+ */
+void DSP_biquadBlock(DSP_Biquad *bq, const Int16 *in, Int16 *out,
+                     Uint16 count)
+{
+	const Int16 *c;
+	Int16       *s;
+	DSP_Acc      acc;
+	Int16        x;
+	Int16        y;
+	Uint16       n;
+	Uint16       sec;
+
+	for (n = 0; n < count; n++)
+	{
+		x = in[n];
+		c = bq->coefs;
+		s = bq->state;
+
+		for (sec = 0; sec < bq->sections; sec++)
+		{
+			acc  = (Int32)c[0] * x;
+			acc += (Int32)c[1] * s[0];
+			acc += (Int32)c[2] * s[1];
+			acc -= (Int32)c[3] * s[2];
+			acc -= (Int32)c[4] * s[3];
+
+			y = DSP_accToQ15(acc, DSP_BIQUAD_COEF_SHIFT);
+
+			s[1] = s[0];
+			s[0] = x;
+			s[3] = s[2];
+			s[2] = y;
+
+			x  = y;
+			c += DSP_BIQUAD_NUM_COEFS;
+			s += DSP_BIQUAD_NUM_STATE;
+		}
+
+		out[n] = x;
+	}
+}
+
+/**
+ *
+ * \brief Reference gain: out = sat(in * gain * 2^shift), gain in Q15
+ *
+ * \param  in    - input samples
+ * \param  out   - output samples, may alias 'in'
+ * \param  count - number of samples
+ * \param  gain  - Q15 gain mantissa
+ * \param  shift - extra left shift, 0 to 15
+ *
+ * \return void
+ *
+ */
+void DSP_gainRef(const Int16 *in, Int16 *out, Uint16 count,
+                 Int16 gain, Uint16 shift)
+{
+	Uint16 n;
+
+	for (n = 0; n < count; n++)
+	{
+		out[n] = DSP_sat16(((Int32)in[n] * gain) >> (15 - shift));
+	}
+}
+
+/**
+ *
+ * \brief Gain with saturation, see DSP_gainRef()
+ *
+ */
+void DSP_gain(const Int16 *in, Int16 *out, Uint16 count,
+              Int16 gain, Uint16 shift)
+{
+#ifdef DSP_FAST_PATHS
+	Uint16 n;
+
+	#pragma MUST_ITERATE(1)
+	for (n = 0; n < count; n++)
+	{
+		out[n] = (Int16)(_lsshl(_lsmpy(in[n], gain), shift) >> 16);
+	}
+#else
+	DSP_gainRef(in, out, count, gain, shift);
+#endif
+}
+
+/**
+ *
+ * \brief Saturating two input mix: out = sat(a * gainA + b * gainB), gains
+ *        in Q15. Both products go into one 40-bit accumulator and only the
+ *        sum is saturated.
+ *
+ * \param  a     - first input
+ * \param  b     - second input
+ * \param  out   - output, may alias either input
+ * \param  count - number of samples
+ * \param  gainA - Q15 gain for 'a'
+ * \param  gainB - Q15 gain for 'b'
+ *
+ * \return void
+ *
+ */
+void DSP_mix(const Int16 *a, const Int16 *b, Int16 *out, Uint16 count,
+             Int16 gainA, Int16 gainB)
+{
+	DSP_Acc acc;
+	Uint16  n;
+
+	#pragma MUST_ITERATE(1)
+	for (n = 0; n < count; n++)
+	{
+		acc    = (DSP_Acc)((Int32)a[n] * gainA) + (Int32)b[n] * gainB;
+		out[n] = DSP_sat16((Int32)(acc >> 15));
+	}
+}
+
+/**
+ *
+ * \brief Builds an interleaved L/R block from two channel buffers
+ *
+ */
+void DSP_interleave(const Int16 *left, const Int16 *right, Int16 *out,
+                    Uint16 frames)
+{
+	while (frames--)
+	{
+		*out++ = *left++;
+		*out++ = *right++;
+	}
+}
+
+/**
+ *
+ * \brief Splits an interleaved L/R block into two channel buffers
+ *
+ */
+void DSP_deinterleave(const Int16 *in, Int16 *left, Int16 *right,
+                      Uint16 frames)
+{
+	while (frames--)
+	{
+		*left++  = *in++;
+		*right++ = *in++;
+	}
+}
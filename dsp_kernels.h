@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file dsp_kernels.h
+*
+*   \brief Q15 block processing kernels: FIR, biquad cascade, gain, mix
+*          and stereo interleave/deinterleave.
+*
+*/
+
+#ifndef _DSP_KERNELS_H_
+#define _DSP_KERNELS_H_
+
+#include "audio_common.h"
+
+/* 40-bit accumulator on the C55x, wide enough for 256 Q30 products */
+typedef long long DSP_Acc;
+
+/* Largest block DSP_firBlock() filters in one piece */
+#define DSP_FIR_MAX_BLOCK       (64)
+
+/* Work buffer length needed by a FIR with 'taps' coefficients */
+#define DSP_FIR_WORK_LEN(taps)  ((taps) - 1 + DSP_FIR_MAX_BLOCK)
+
+/* Biquad coefficients are Q14 so that |a1| up to 2 can be represented */
+#define DSP_BIQUAD_COEF_SHIFT   (14)
+#define DSP_BIQUAD_NUM_COEFS    (5)    /* b0, b1, b2, a1, a2 */
+#define DSP_BIQUAD_NUM_STATE    (4)    /* x1, x2, y1, y2     */
+
+typedef struct
+{
+	const Int16 *coefs;   /* Q15 coefficients h[0..taps-1]                */
+	Int16       *work;    /* DSP_FIR_WORK_LEN(taps) samples: history+block */
+	Uint16       taps;
+} DSP_Fir;
+
+typedef struct
+{
+	const Int16 *coefs;    /* DSP_BIQUAD_NUM_COEFS per section, Q14        */
+	Int16       *state;    /* DSP_BIQUAD_NUM_STATE per section             */
+	Uint16       sections;
+} DSP_Biquad;
+
+Int16 DSP_sat16(Int32 value);
+
+void DSP_firInit(DSP_Fir *fir, const Int16 *coefs, Int16 *work, Uint16 taps);
+void DSP_firBlock(DSP_Fir *fir, const Int16 *in, Int16 *out, Uint16 count);
+
+void DSP_biquadInit(DSP_Biquad *bq, const Int16 *coefs, Int16 *state,
+                    Uint16 sections);
+void DSP_biquadBlock(DSP_Biquad *bq, const Int16 *in, Int16 *out,
+                     Uint16 count);
+
+void DSP_gain(const Int16 *in, Int16 *out, Uint16 count,
+              Int16 gain, Uint16 shift);
+void DSP_gainRef(const Int16 *in, Int16 *out, Uint16 count,
+                 Int16 gain, Uint16 shift);
+void DSP_mix(const Int16 *a, const Int16 *b, Int16 *out, Uint16 count,
+             Int16 gainA, Int16 gainB);
+
+void DSP_interleave(const Int16 *left, const Int16 *right, Int16 *out,
+                    Uint16 frames);
+void DSP_deinterleave(const Int16 *in, Int16 *left, Int16 *right,
+                      Uint16 frames);
+
+#endif /* _DSP_KERNELS_H_ */
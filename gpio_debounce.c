@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file gpio_debounce.c
+*
+*   \brief Input debouncer driven by edge timestamps.
+*
+*   Every edge restarts the input's quiet window. Once a window has passed
+*   without edges the caller's level reading is accepted, and it counts as
+*   a change only if it differs from the last accepted level. A bounce
+*   burst that settles where it started is dropped.
+*
+*/
+
+#include "gpio_debounce.h"
+
+/**
+ *
+ * \brief Starts a debouncer at a known level
+ *
+ */
+void GPIO_debounceInit(GPIO_Debounce *db, Uint16 level)
+{
+	db->stable    = level;
+	db->pending   = FALSE;
+	db->bounces   = 0;
+	db->firstEdge = 0;
+	db->lastEdge  = 0;
+}
+
+/**
+ *
+ * \brief Records an edge and restarts the quiet window
+ *
+ * \param  db     - debouncer
+ * \param  cycles - time of the edge
+ *
+ */
+void GPIO_debounceEdge(GPIO_Debounce *db, Uint32 cycles)
+{
+	if (!db->pending)
+	{
+		db->pending   = TRUE;
+		db->bounces   = 0;
+		db->firstEdge = cycles;
+	}
+
+	db->bounces++;
+	db->lastEdge = cycles;
+}
+
+/**
+ *
+ * \brief Accepts the level once the quiet window has passed
+ *
+ * \param  db          - debouncer
+ * \param  now         - current time
+ * \param  quietCycles - time without edges before a level counts
+ * \param  level       - pin level now
+ *
+ * \return TRUE if the accepted level changed, db->stable holds it
+ *
+ */
+Bool GPIO_debouncePoll(GPIO_Debounce *db, Uint32 now, Uint32 quietCycles,
+                       Uint16 level)
+{
+	if (!db->pending || ((Uint32)(now - db->lastEdge) < quietCycles))
+	{
+		return (FALSE);
+	}
+
+	db->pending = FALSE;
+
+	if (level == db->stable)
+	{
+		return (FALSE);
+	}
+
+	db->stable = level;
+
+	return (TRUE);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file gpio_debounce.h
+*
+*   \brief Input debouncer driven by edge timestamps. Depends on nothing
+*          but the TI standard types, so bounce traces can be replayed
+*          off target.
+*
+*/
+
+#ifndef _GPIO_DEBOUNCE_H_
+#define _GPIO_DEBOUNCE_H_
+
+#include "tistdtypes.h"
+
+/**
+ * \brief Debounce state of one input. Times are in any free running unit
+ *        that wraps at 2^32, the caller's clock decides.
+ */
+typedef struct
+{
+	Uint16  stable;         /* last accepted level                      */
+	Bool    pending;        /* edges seen, waiting for the quiet time   */
+	Uint16  bounces;
+	Uint32  firstEdge;
+	Uint32  lastEdge;
+} GPIO_Debounce;
+
+void GPIO_debounceInit(GPIO_Debounce *db, Uint16 level);
+void GPIO_debounceEdge(GPIO_Debounce *db, Uint32 cycles);
+Bool GPIO_debouncePoll(GPIO_Debounce *db, Uint32 now, Uint32 quietCycles,
+                       Uint16 level);
+
+#endif /* _GPIO_DEBOUNCE_H_ */
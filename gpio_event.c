@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file gpio_event.c
+*
+*   \brief GPIO event dispatcher: per-pin callbacks and timer based
+*          debouncing of the edges the GPIO ISR posts to the command queue.
+*
+*   gpioEventIsr() reads and clears the interrupt flags of the registered
+*   pins and, when any is set, posts the flag bits with a C55x_nowCycles()
+*   timestamp as a CMD_GPIO_EDGES command. That is all it does, so it runs in a few dozen
+*   cycles and never touches the codec or the console.
+*
+*   CMD_dispatch() hands the flags to GPIO_eventEdges(), which feeds them
+*   to a debouncer per pin (see gpio_debounce.c); every edge restarts the
+*   pin's quiet window on the GPT0 timebase. GPIO_eventDispatch(), called
+*   from the main loop right after CMD_dispatch(), reads the level of each
+*   pin whose window has expired, and a callback fires only if the level
+*   differs from the last accepted one. It accepts nothing while an edge
+*   is still flagged or queued, as that edge may restart a window.
+*
+*   The C55x GPIO interrupts on one edge per pin, so after each accepted
+*   level the trigger is turned to the opposite edge. A mechanical bounce
+*   always contains both edges, so the window is restarted either way.
+*
+*   The main loops wake at least once per audio block, which is far
+*   shorter than the debounce time, so no timer of its own is needed.
+*
+*/
+
+#include "gpio_event.h"
+#include "timebase.h"
+#include "cmd_queue.h"
+
+typedef struct
+{
+	Uint16         pin;
+	GPIO_Debounce  db;
+} GPIO_PinSlot;
+
+typedef struct
+{
+	Uint16         pin;
+	Uint16         edges;
+	GPIO_EventFxn  fxn;
+	void          *arg;
+} GPIO_Handler;
+
+static volatile Uint16      gpioIntMask1;
+static volatile Uint16      gpioIntMask2;
+
+static GPIO_PinSlot         gpioPins[GPIO_EVENT_MAX_PINS];
+static Uint16               gpioPinCount;
+static GPIO_Handler         gpioHandlers[GPIO_EVENT_MAX_HANDLERS];
+static Uint16               gpioHandlerCount;
+
+static Uint32               gpioDebounceUsec;
+static volatile GPIO_EventStats gpioStats;
+
+/* CMD_GPIO_EDGES posted by the ISR and not yet fed to the debouncers */
+static volatile Uint16      gpioEdgesQueued;
+
+/**
+ *  \brief  GPIO Interrupt Service Routine
+ *
+ *  Clears the flags of the registered pins and posts them to the
+ *  command queue with a timestamp.
+ *
+ *  \return none
+ */
+interrupt void gpioEventIsr(void)
+{
+	Uint16 flags1;
+	Uint16 flags2;
+	Uint32 start;
+
+	start = CMD_isrEnter();
+
+	flags1 = CSL_GPIO_REGS->IOINTFLG1 & gpioIntMask1;
+	flags2 = CSL_GPIO_REGS->IOINTFLG2 & gpioIntMask2;
+
+	/* Write 1 to clear */
+	CSL_GPIO_REGS->IOINTFLG1 = flags1;
+	CSL_GPIO_REGS->IOINTFLG2 = flags2;
+
+	gpioStats.interrupts++;
+
+	if ((flags1 | flags2) != 0)
+	{
+		if (CMD_postGpioEdges(flags1, flags2, C55x_nowCycles()))
+		{
+			gpioEdgesQueued++;
+		}
+		else
+		{
+			gpioStats.dropped++;
+		}
+	}
+
+	IRQ_clear(GPIO_EVENT);
+
+	CMD_isrExit(start);
+}
+
+/* Points the pin's interrupt at the edge leaving 'level' */
+static void GPIO_eventArm(Uint16 pin, Uint16 level)
+{
+	CSL_GpioPinConfig config;
+
+	config.pinNum    = (CSL_GpioPinNum)pin;
+	config.direction = CSL_GPIO_DIR_INPUT;
+	config.trigger   = level ? CSL_GPIO_TRIG_FALLING_EDGE :
+	                           CSL_GPIO_TRIG_RISING_EDGE;
+	GPIO_configBit(gpioHandle, &config);
+}
+
+static Uint16 GPIO_eventLevel(Uint16 pin)
+{
+	Uint16 level = 0;
+
+	GPIO_read(gpioHandle, (CSL_GpioPinNum)pin, &level);
+
+	return (level ? 1 : 0);
+}
+
+/**
+ *
+ * \brief Clears the registry and plugs gpioEventIsr(). GPIO_open() must
+ *        have been called.
+ *
+ * \param  debounceUsec - quiet time before a level counts
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS GPIO_eventOpen(Uint32 debounceUsec)
+{
+	Bool oldIntm;
+
+	if (gpioHandle == NULL)
+	{
+		return (TEST_FAIL);
+	}
+
+	oldIntm = IRQ_globalDisable();
+
+	gpioIntMask1     = 0;
+	gpioIntMask2     = 0;
+	gpioPinCount     = 0;
+	gpioHandlerCount = 0;
+	gpioEdgesQueued  = 0;
+	memset((void *)&gpioStats, 0, sizeof(gpioStats));
+
+	gpioDebounceUsec = debounceUsec;
+
+	IRQ_clear(GPIO_EVENT);
+	IRQ_plug(GPIO_EVENT, &gpioEventIsr);
+	IRQ_enable(GPIO_EVENT);
+
+	IRQ_globalRestore(oldIntm);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Calls 'fxn' from GPIO_eventDispatch() on the debounced 'edges' of
+ *        'pin'. The first handler for a pin sets it up as an interrupting
+ *        input.
+ *
+ * \param  pin   - GPIO pin, CSL_GPIO_PIN0 to CSL_GPIO_PIN31
+ * \param  edges - GPIO_EDGE_RISING, GPIO_EDGE_FALLING or GPIO_EDGE_BOTH
+ * \param  fxn   - callback
+ * \param  arg   - handed back to 'fxn'
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS GPIO_eventRegister(Uint16 pin, Uint16 edges, GPIO_EventFxn fxn,
+                               void *arg)
+{
+	GPIO_PinSlot *slot = NULL;
+	Uint16        level;
+	Uint16        i;
+	Bool          oldIntm;
+
+	if ((fxn == NULL) || (pin >= CSL_GPIO_NUM_PIN) ||
+	    ((edges & GPIO_EDGE_BOTH) == 0) ||
+	    (gpioHandlerCount >= GPIO_EVENT_MAX_HANDLERS))
+	{
+		return (TEST_FAIL);
+	}
+
+	for (i = 0; i < gpioPinCount; i++)
+	{
+		if (gpioPins[i].pin == pin)
+		{
+			slot = &gpioPins[i];
+		}
+	}
+
+	if (slot == NULL)
+	{
+		if (gpioPinCount >= GPIO_EVENT_MAX_PINS)
+		{
+			return (TEST_FAIL);
+		}
+
+		slot = &gpioPins[gpioPinCount];
+		slot->pin = pin;
+
+		level = GPIO_eventLevel(pin);
+		GPIO_debounceInit(&slot->db, level);
+		GPIO_eventArm(pin, level);
+		GPIO_clearInt(gpioHandle, (CSL_GpioPinNum)pin);
+		if (GPIO_enableInt(gpioHandle, (CSL_GpioPinNum)pin) != CSL_SOK)
+		{
+			return (TEST_FAIL);
+		}
+
+		oldIntm = IRQ_globalDisable();
+		if (pin < 16)
+		{
+			gpioIntMask1 |= (1 << pin);
+		}
+		else
+		{
+			gpioIntMask2 |= (1 << (pin - 16));
+		}
+		gpioPinCount++;
+		IRQ_globalRestore(oldIntm);
+	}
+
+	gpioHandlers[gpioHandlerCount].pin   = pin;
+	gpioHandlers[gpioHandlerCount].edges = edges;
+	gpioHandlers[gpioHandlerCount].fxn   = fxn;
+	gpioHandlers[gpioHandlerCount].arg   = arg;
+	gpioHandlerCount++;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Feeds the edges of one GPIO interrupt to the pin debouncers.
+ *        Called by CMD_dispatch() for a CMD_GPIO_EDGES command.
+ *
+ * \param  flags1 - IOINTFLG1 bits, pins 0-15
+ * \param  flags2 - IOINTFLG2 bits, pins 16-31
+ * \param  cycles - C55x_nowCycles() in the ISR
+ *
+ */
+void GPIO_eventEdges(Uint16 flags1, Uint16 flags2, Uint32 cycles)
+{
+	GPIO_PinSlot *slot;
+	Uint16        flags;
+	Uint16        i;
+	Bool          oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+	if (gpioEdgesQueued != 0)
+	{
+		gpioEdgesQueued--;
+	}
+	IRQ_globalRestore(oldIntm);
+
+	for (i = 0; i < gpioPinCount; i++)
+	{
+		slot  = &gpioPins[i];
+		flags = (slot->pin < 16) ? flags1 : flags2;
+		if (flags & (1 << (slot->pin & 0xF)))
+		{
+			GPIO_debounceEdge(&slot->db, cycles);
+			gpioStats.edges++;
+		}
+	}
+}
+
+/**
+ *
+ * \brief Accepts the levels whose quiet window has passed and runs the
+ *        callbacks. Called from the main loop after CMD_dispatch(), so
+ *        each pin's window starts from its last edge.
+ *
+ * \return Number of events delivered
+ *
+ */
+Uint16 GPIO_eventDispatch(void)
+{
+	GPIO_PinSlot *slot;
+	GPIO_Event    event;
+	Uint16        level;
+	Uint16        delivered = 0;
+	Uint16        i;
+	Uint16        h;
+	Uint32        now;
+	Uint32        quietCycles;
+
+	/* Converted on every call: the timebase may be started or the CPU
+	 * clock changed after GPIO_eventOpen(). Without the timebase every
+	 * level counts at once. */
+	quietCycles = C55x_usecToCycles(gpioDebounceUsec);
+
+	/* An edge raised after CMD_dispatch() ran is not in the debouncers
+	 * yet and would restart its pin's window; accept nothing until the
+	 * next CMD_dispatch() has fed it */
+	if ((gpioEdgesQueued != 0) ||
+	    ((CSL_GPIO_REGS->IOINTFLG1 & gpioIntMask1) != 0) ||
+	    ((CSL_GPIO_REGS->IOINTFLG2 & gpioIntMask2) != 0))
+	{
+		return (0);
+	}
+
+	now = C55x_nowCycles();
+
+	for (i = 0; i < gpioPinCount; i++)
+	{
+		slot = &gpioPins[i];
+		if (!slot->db.pending)
+		{
+			continue;
+		}
+
+		level = GPIO_eventLevel(slot->pin);
+		if (!GPIO_debouncePoll(&slot->db, now, quietCycles, level))
+		{
+			if (!slot->db.pending)
+			{
+				gpioStats.filtered++;
+			}
+			continue;
+		}
+
+		event.pin     = slot->pin;
+		event.edge    = level ? GPIO_EDGE_RISING : GPIO_EDGE_FALLING;
+		event.cycles  = slot->db.firstEdge;
+		event.bounces = slot->db.bounces;
+		gpioStats.events++;
+
+		/* Wait for the way back, then catch a change that beat the re-arm */
+		GPIO_eventArm(slot->pin, level);
+		if (GPIO_eventLevel(slot->pin) != level)
+		{
+			GPIO_debounceEdge(&slot->db, C55x_nowCycles());
+		}
+
+		for (h = 0; h < gpioHandlerCount; h++)
+		{
+			if ((gpioHandlers[h].pin == event.pin) &&
+			    (gpioHandlers[h].edges & event.edge))
+			{
+				gpioHandlers[h].fxn(&event, gpioHandlers[h].arg);
+				delivered++;
+			}
+		}
+	}
+
+	return (delivered);
+}
+
+/**
+ *
+ * \brief Copies the dispatcher statistics
+ *
+ */
+void GPIO_eventGetStats(GPIO_EventStats *stats)
+{
+	*stats = gpioStats;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file gpio_event.h
+*
+*   \brief GPIO event dispatcher: per-pin callbacks and timer based
+*          debouncing of the edges the GPIO ISR posts to the command queue.
+*
+*/
+
+#ifndef _GPIO_EVENT_H_
+#define _GPIO_EVENT_H_
+
+#include "audio_common.h"
+#include "gpio_debounce.h"
+
+#define GPIO_EVENT_MAX_PINS         (4)
+#define GPIO_EVENT_MAX_HANDLERS     (8)
+
+/* Quiet time before a level counts, long enough for the BoosterPack
+ * push buttons */
+#define GPIO_DEBOUNCE_USEC_DEFAULT  (20000)
+
+/* Edges, may be or'ed together */
+#define GPIO_EDGE_RISING            (1)
+#define GPIO_EDGE_FALLING           (2)
+#define GPIO_EDGE_BOTH              (GPIO_EDGE_RISING | GPIO_EDGE_FALLING)
+
+typedef struct
+{
+	Uint16  pin;
+	Uint16  edge;           /* GPIO_EDGE_RISING or GPIO_EDGE_FALLING    */
+	Uint32  cycles;         /* C55x_nowCycles() at the first edge       */
+	Uint16  bounces;        /* edges seen before the level settled      */
+} GPIO_Event;
+
+typedef void (*GPIO_EventFxn)(const GPIO_Event *event, void *arg);
+
+typedef struct
+{
+	Uint32  interrupts;
+	Uint32  edges;          /* raw edges seen on registered pins        */
+	Uint32  events;         /* debounced edges delivered                */
+	Uint32  filtered;       /* edge bursts that settled where they began */
+	Uint32  dropped;        /* interrupts lost, command queue full      */
+} GPIO_EventStats;
+
+TEST_STATUS GPIO_eventOpen(Uint32 debounceUsec);
+TEST_STATUS GPIO_eventRegister(Uint16 pin, Uint16 edges, GPIO_EventFxn fxn,
+                               void *arg);
+void GPIO_eventEdges(Uint16 flags1, Uint16 flags2, Uint32 cycles);
+Uint16 GPIO_eventDispatch(void);
+void GPIO_eventGetStats(GPIO_EventStats *stats);
+interrupt void gpioEventIsr(void);
+
+#endif /* _GPIO_EVENT_H_ */
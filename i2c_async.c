@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2c_async.c
+*
+*   \brief Interrupt driven I2C master with a transaction queue.
+*
+*   I2C_write() with CSL_I2C_MAX_TIMEOUT spins on the status register for
+*   every byte, around 90us per byte at 100 kHz. Here transactions are
+*   queued and the I2C interrupt moves the bytes, so the CPU only spends
+*   a few instructions per byte. The C5545 I2C has a single byte data
+*   register in each direction rather than a FIFO, so the ISR runs once per
+*   byte; transactions follow each other without CPU involvement beyond
+*   the stop interrupt.
+*
+*   Transactions complete in the order they were submitted. The queue is
+*   lock-free: 'head' is only written by the submitter in the main loop and
+*   'tail' only by the ISR.
+*
+*   The polled CSL calls must not be used while the driver is open: the
+*   ISR would take their status flags. AIC3206_busWrite() and
+*   AIC3206_busRead() pick whichever path is active, so the codec code
+*   works either way. gpio_interrupt_initiliastion() resets the vector
+*   table, so I2C_asyncOpen() has to be called after it.
+*
+*/
+
+#include "i2c_async.h"
+#include "timebase.h"
+
+#define I2C_ASYNC_QUEUE_MASK    (I2C_ASYNC_QUEUE_SIZE - 1)
+
+/* ICMDR: FREE, STT, STP, MST, TRX and IRS */
+#define I2C_ASYNC_MDR_TX_START       (0x6620)
+#define I2C_ASYNC_MDR_TX_START_STOP  (0x6E20)
+#define I2C_ASYNC_MDR_RX_START_STOP  (0x6C20)
+#define I2C_ASYNC_MDR_STP            (0x0800)
+#define I2C_ASYNC_MDR_IDLE           (0x4020)
+
+/* ICIMR: AL, NACK, ARDY, ICRRDY, ICXRDY and SCD */
+#define I2C_ASYNC_IMR_ALL            (0x003F)
+
+/* ICIVR interrupt codes */
+#define I2C_ASYNC_IV_NONE            (0)
+#define I2C_ASYNC_IV_AL              (1)
+#define I2C_ASYNC_IV_NACK            (2)
+#define I2C_ASYNC_IV_ARDY            (3)
+#define I2C_ASYNC_IV_ICRRDY          (4)
+#define I2C_ASYNC_IV_ICXRDY          (5)
+#define I2C_ASYNC_IV_SCD             (6)
+
+static I2C_AsyncTxn       asyncQueue[I2C_ASYNC_QUEUE_SIZE];
+static volatile Uint16    asyncHead;
+static volatile Uint16    asyncTail;
+static volatile Bool      asyncBusy;
+static Bool               asyncOpen;
+
+/* Progress of the transaction at 'asyncTail' */
+static Uint16             txIdx;
+static Uint16             txTotal;
+static Uint16             rxIdx;
+static Bool               rxPhase;
+static CSL_Status         txnStatus;
+
+static I2C_AsyncClockFxn  asyncClock;
+static I2C_AsyncStats     asyncStats;
+
+/* Starts the transaction at 'asyncTail' */
+static void I2C_asyncStart(void)
+{
+	CSL_I2cRegsOvly i2cReg = CSL_I2C_0_REGS;
+	I2C_AsyncTxn   *txn;
+
+	txn = &asyncQueue[asyncTail & I2C_ASYNC_QUEUE_MASK];
+
+	txIdx     = 0;
+	rxIdx     = 0;
+	txnStatus = CSL_SOK;
+	txTotal   = txn->txLen + ((txn->type == I2C_TXN_BURST) ? 1 : 0);
+	asyncBusy = TRUE;
+
+	i2cReg->ICSAR = txn->slaveAddr;
+
+	if (txTotal != 0)
+	{
+		rxPhase = FALSE;
+		i2cReg->ICCNT = txTotal;
+		i2cReg->ICMDR = (txn->type == I2C_TXN_WRITE_READ) ?
+		                I2C_ASYNC_MDR_TX_START : I2C_ASYNC_MDR_TX_START_STOP;
+	}
+	else
+	{
+		rxPhase = TRUE;
+		i2cReg->ICCNT = txn->rxLen;
+		i2cReg->ICMDR = I2C_ASYNC_MDR_RX_START_STOP;
+	}
+}
+
+/* Retires the transaction at 'asyncTail' and starts the next one */
+static void I2C_asyncComplete(void)
+{
+	I2C_AsyncTxn *txn;
+	Uint32        latency;
+
+	txn = &asyncQueue[asyncTail & I2C_ASYNC_QUEUE_MASK];
+
+	if (asyncClock != NULL)
+	{
+		latency = asyncClock() - txn->submitTime;
+		asyncStats.lastLatency   = latency;
+		asyncStats.totalLatency += latency;
+		if (latency > asyncStats.worstLatency)
+		{
+			asyncStats.worstLatency = latency;
+		}
+	}
+
+	asyncStats.completed++;
+
+	if (txn->doneFxn != NULL)
+	{
+		txn->doneFxn(txnStatus, txn->arg);
+	}
+
+	/* Release the slot only after the callback is done with it */
+	asyncTail++;
+
+	if (asyncTail != asyncHead)
+	{
+		I2C_asyncStart();
+	}
+	else
+	{
+		asyncBusy = FALSE;
+	}
+}
+
+/**
+ *  \brief  I2C Interrupt Service Routine
+ *
+ *  Moves one byte per data event and moves on to the next transaction
+ *  once the stop condition has gone out.
+ *
+ *  \return none
+ */
+interrupt void i2cAsyncIsr(void)
+{
+	CSL_I2cRegsOvly i2cReg = CSL_I2C_0_REGS;
+	I2C_AsyncTxn   *txn;
+	Uint16          iv;
+
+	/* Reading ICIVR acknowledges the highest priority pending event */
+	while ((iv = (i2cReg->ICIVR & 0x7)) != I2C_ASYNC_IV_NONE)
+	{
+		if (!asyncBusy)
+		{
+			continue;
+		}
+
+		txn = &asyncQueue[asyncTail & I2C_ASYNC_QUEUE_MASK];
+
+		switch (iv)
+		{
+			case I2C_ASYNC_IV_ICXRDY:
+				if (txIdx < txTotal)
+				{
+					if (txn->type == I2C_TXN_BURST)
+					{
+						i2cReg->ICDXR = (txIdx == 0) ? txn->reg :
+						                txn->txBuf[txIdx - 1];
+					}
+					else
+					{
+						i2cReg->ICDXR = txn->txBuf[txIdx];
+					}
+					txIdx++;
+				}
+				break;
+
+			case I2C_ASYNC_IV_ICRRDY:
+				if (rxIdx < txn->rxLen)
+				{
+					txn->rxBuf[rxIdx++] = i2cReg->ICDRR & 0xFF;
+				}
+				break;
+
+			case I2C_ASYNC_IV_ARDY:
+				/* Write phase of a write-read done: repeated start */
+				if (!rxPhase && (txnStatus == CSL_SOK) &&
+				    (txn->type == I2C_TXN_WRITE_READ))
+				{
+					rxPhase = TRUE;
+					i2cReg->ICCNT = txn->rxLen;
+					i2cReg->ICMDR = I2C_ASYNC_MDR_RX_START_STOP;
+				}
+				break;
+
+			case I2C_ASYNC_IV_NACK:
+				/* End the transfer, completion follows at the stop */
+				txnStatus = CSL_I2C_NACK_ERR;
+				asyncStats.nacks++;
+				i2cReg->ICMDR |= I2C_ASYNC_MDR_STP;
+				break;
+
+			case I2C_ASYNC_IV_AL:
+				/* Lost the bus, the module fell back to slave mode and
+				 * no stop interrupt will come */
+				txnStatus = CSL_I2C_BUS_BUSY_ERR;
+				asyncStats.arbLost++;
+				I2C_asyncComplete();
+				break;
+
+			case I2C_ASYNC_IV_SCD:
+				I2C_asyncComplete();
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+/**
+ *
+ * \brief Enables the I2C interrupts and empties the queue. The module
+ *        must already be set up by initialise_i2c_interface().
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS I2C_asyncOpen(void)
+{
+	CSL_I2cRegsOvly i2cReg = CSL_I2C_0_REGS;
+	Bool            oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+
+	asyncHead = 0;
+	asyncTail = 0;
+	asyncBusy = FALSE;
+	asyncOpen = TRUE;
+	memset(&asyncStats, 0, sizeof(asyncStats));
+
+	i2cReg->ICIMR = I2C_ASYNC_IMR_ALL;
+
+	IRQ_clear(I2C_EVENT);
+	IRQ_plug(I2C_EVENT, &i2cAsyncIsr);
+	IRQ_enable(I2C_EVENT);
+
+	IRQ_globalRestore(oldIntm);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Waits for the pending transactions, then hands the module back
+ *        to the polled CSL calls. If they have not completed within
+ *        'timeoutUsec' (a device holding SCL low, a lost interrupt), the
+ *        module is reset and the remaining transactions complete with
+ *        CSL_I2C_TIMEOUT_ERROR.
+ *
+ * \param  timeoutUsec - longest wait for the queue to drain
+ *
+ * \return
+ * \n      TEST_PASS  - Queue drained
+ * \n      TEST_FAIL  - Timed out, transactions were aborted
+ *
+ */
+TEST_STATUS I2C_asyncClose(Uint32 timeoutUsec)
+{
+	CSL_I2cRegsOvly i2cReg = CSL_I2C_0_REGS;
+	TEST_STATUS     status = TEST_PASS;
+	I2C_AsyncTxn   *txn;
+	Uint32          deadline;
+	Bool            oldIntm;
+
+	deadline = C55x_deadline(timeoutUsec);
+	while (asyncBusy && !C55x_deadlinePassed(deadline))
+	{
+		;
+	}
+
+	oldIntm = IRQ_globalDisable();
+
+	IRQ_disable(I2C_EVENT);
+	i2cReg->ICIMR = 0;
+	IRQ_clear(I2C_EVENT);
+
+	if (asyncBusy)
+	{
+		/* Reset drops the bus; the module comes back idle */
+		i2cReg->ICMDR = 0;
+		i2cReg->ICMDR = I2C_ASYNC_MDR_IDLE;
+
+		while (asyncTail != asyncHead)
+		{
+			txn = &asyncQueue[asyncTail & I2C_ASYNC_QUEUE_MASK];
+			if (txn->doneFxn != NULL)
+			{
+				txn->doneFxn(CSL_I2C_TIMEOUT_ERROR, txn->arg);
+			}
+			asyncStats.aborted++;
+			asyncTail++;
+		}
+
+		asyncBusy = FALSE;
+		status    = TEST_FAIL;
+	}
+
+	asyncOpen = FALSE;
+
+	IRQ_globalRestore(oldIntm);
+
+	return (status);
+}
+
+/**
+ *
+ * \brief Tells whether the driver owns the module
+ *
+ */
+Bool I2C_asyncIsOpen(void)
+{
+	return (asyncOpen);
+}
+
+/**
+ *
+ * \brief Queues a transaction and starts it if the bus is idle
+ *
+ * \param  txn - transaction, copied into the queue
+ *
+ * \return
+ * \n      TEST_PASS  - Queued
+ * \n      TEST_FAIL  - Queue full, or nothing to transfer
+ *
+ */
+TEST_STATUS I2C_asyncSubmit(const I2C_AsyncTxn *txn)
+{
+	I2C_AsyncTxn *slot;
+	Uint16        head;
+	Bool          oldIntm;
+
+	/* ICCNT = 0 is not an empty transfer but 65536 bytes */
+	if (((txn->txLen == 0) && (txn->type != I2C_TXN_BURST) &&
+	     (txn->rxLen == 0)) ||
+	    ((txn->type == I2C_TXN_WRITE_READ) && (txn->rxLen == 0)))
+	{
+		asyncStats.rejected++;
+		return (TEST_FAIL);
+	}
+
+	head = asyncHead;
+	if ((Uint16)(head - asyncTail) >= I2C_ASYNC_QUEUE_SIZE)
+	{
+		asyncStats.queueFull++;
+		return (TEST_FAIL);
+	}
+
+	slot  = &asyncQueue[head & I2C_ASYNC_QUEUE_MASK];
+	*slot = *txn;
+	slot->submitTime = (asyncClock != NULL) ? asyncClock() : 0;
+
+	asyncStats.submitted++;
+
+	/* Publish and kick with the ISR held off, so it cannot retire the last
+	 * transaction between the publish and the idle check */
+	oldIntm = IRQ_globalDisable();
+	asyncHead = head + 1;
+	if (!asyncBusy)
+	{
+		I2C_asyncStart();
+	}
+	IRQ_globalRestore(oldIntm);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Queues a plain write
+ *
+ * \param  slaveAddr - 7-bit slave address
+ * \param  buf       - bytes to send, one per word
+ * \param  len       - number of bytes
+ * \param  doneFxn   - completion callback, may be NULL
+ * \param  arg       - callback argument
+ *
+ * \return TEST_PASS if queued
+ *
+ */
+TEST_STATUS I2C_asyncWrite(Uint16 slaveAddr, const Uint16 *buf, Uint16 len,
+                           I2C_AsyncDoneFxn doneFxn, void *arg)
+{
+	I2C_AsyncTxn txn;
+
+	txn.type      = I2C_TXN_WRITE;
+	txn.slaveAddr = slaveAddr;
+	txn.reg       = 0;
+	txn.txBuf     = buf;
+	txn.txLen     = len;
+	txn.rxBuf     = NULL;
+	txn.rxLen     = 0;
+	txn.doneFxn   = doneFxn;
+	txn.arg       = arg;
+
+	return (I2C_asyncSubmit(&txn));
+}
+
+/**
+ *
+ * \brief Queues an auto-increment register burst: the register address
+ *        followed by 'len' data bytes
+ *
+ * \param  slaveAddr - 7-bit slave address
+ * \param  reg       - first register
+ * \param  buf       - register data, one byte per word
+ * \param  len       - number of registers
+ * \param  doneFxn   - completion callback, may be NULL
+ * \param  arg       - callback argument
+ *
+ * \return TEST_PASS if queued
+ *
+ */
+TEST_STATUS I2C_asyncBurst(Uint16 slaveAddr, Uint16 reg, const Uint16 *buf,
+                           Uint16 len, I2C_AsyncDoneFxn doneFxn, void *arg)
+{
+	I2C_AsyncTxn txn;
+
+	txn.type      = I2C_TXN_BURST;
+	txn.slaveAddr = slaveAddr;
+	txn.reg       = reg;
+	txn.txBuf     = buf;
+	txn.txLen     = len;
+	txn.rxBuf     = NULL;
+	txn.rxLen     = 0;
+	txn.doneFxn   = doneFxn;
+	txn.arg       = arg;
+
+	return (I2C_asyncSubmit(&txn));
+}
+
+/**
+ *
+ * \brief Queues a write followed by a repeated start and a read
+ *
+ * \param  slaveAddr - 7-bit slave address
+ * \param  txBuf     - bytes to send, one per word
+ * \param  txLen     - number of bytes to send
+ * \param  rxBuf     - destination, one byte per word
+ * \param  rxLen     - number of bytes to read
+ * \param  doneFxn   - completion callback, may be NULL
+ * \param  arg       - callback argument
+ *
+ * \return TEST_PASS if queued
+ *
+ */
+TEST_STATUS I2C_asyncWriteRead(Uint16 slaveAddr, const Uint16 *txBuf,
+                               Uint16 txLen, Uint16 *rxBuf, Uint16 rxLen,
+                               I2C_AsyncDoneFxn doneFxn, void *arg)
+{
+	I2C_AsyncTxn txn;
+
+	txn.type      = I2C_TXN_WRITE_READ;
+	txn.slaveAddr = slaveAddr;
+	txn.reg       = 0;
+	txn.txBuf     = txBuf;
+	txn.txLen     = txLen;
+	txn.rxBuf     = rxBuf;
+	txn.rxLen     = rxLen;
+	txn.doneFxn   = doneFxn;
+	txn.arg       = arg;
+
+	return (I2C_asyncSubmit(&txn));
+}
+
+/**
+ *
+ * \brief Returns the number of transactions not yet completed
+ *
+ */
+Uint16 I2C_asyncPending(void)
+{
+	return ((Uint16)(asyncHead - asyncTail));
+}
+
+/**
+ *
+ * \brief Registers a free running time source for latency stats
+ *
+ */
+void I2C_asyncSetClock(I2C_AsyncClockFxn clockFxn)
+{
+	asyncClock = clockFxn;
+}
+
+/**
+ *
+ * \brief Copies the transaction statistics
+ *
+ */
+void I2C_asyncGetStats(I2C_AsyncStats *stats)
+{
+	*stats = asyncStats;
+}
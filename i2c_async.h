@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2c_async.h
+*
+*   \brief Interrupt driven I2C master with a transaction queue.
+*
+*/
+
+#ifndef _I2C_ASYNC_H_
+#define _I2C_ASYNC_H_
+
+#include "audio_common.h"
+
+/* Queue size in transactions, must be a power of two */
+#define I2C_ASYNC_QUEUE_SIZE    (8)
+
+/* I2C_asyncClose() wait, a full queue of codec bursts at 100 kHz */
+#define I2C_ASYNC_CLOSE_USEC    (20000)
+
+/* Transaction types */
+#define I2C_TXN_WRITE           (1)     /* txBuf                          */
+#define I2C_TXN_BURST           (2)     /* register address, then txBuf   */
+#define I2C_TXN_WRITE_READ      (3)     /* txBuf, repeated start, rxBuf   */
+
+/**
+ * \brief Completion callback, called from the I2C ISR once the stop
+ *        condition has been sent
+ *
+ * \param status - CSL_SOK, CSL_I2C_NACK_ERR or CSL_I2C_BUS_BUSY_ERR
+ *                 (arbitration lost)
+ * \param arg    - argument given with the transaction
+ */
+typedef void (*I2C_AsyncDoneFxn)(CSL_Status status, void *arg);
+
+/**
+ * \brief Queued transaction. The buffers belong to the caller and must
+ *        stay valid until the completion callback.
+ */
+typedef struct
+{
+	Uint16            type;
+	Uint16            slaveAddr;
+	Uint16            reg;        /* I2C_TXN_BURST only               */
+	const Uint16     *txBuf;      /* one byte per word                */
+	Uint16            txLen;
+	Uint16           *rxBuf;      /* I2C_TXN_WRITE_READ only          */
+	Uint16            rxLen;
+	I2C_AsyncDoneFxn  doneFxn;    /* may be NULL                      */
+	void             *arg;
+	Uint32            submitTime; /* set by I2C_asyncSubmit()         */
+} I2C_AsyncTxn;
+
+typedef struct
+{
+	Uint32  submitted;
+	Uint32  completed;
+	Uint32  nacks;
+	Uint32  arbLost;
+	Uint32  queueFull;      /* submits refused, queue full            */
+	Uint32  rejected;       /* submits refused, nothing to transfer   */
+	Uint32  aborted;        /* dropped by a timed out I2C_asyncClose() */
+	Uint32  lastLatency;    /* submit to completion, I2C_AsyncClockFxn */
+	Uint32  worstLatency;   /* units, 0 without a clock               */
+	Uint32  totalLatency;
+} I2C_AsyncStats;
+
+typedef Uint32 (*I2C_AsyncClockFxn)(void);
+
+TEST_STATUS I2C_asyncOpen(void);
+TEST_STATUS I2C_asyncClose(Uint32 timeoutUsec);
+Bool I2C_asyncIsOpen(void);
+TEST_STATUS I2C_asyncSubmit(const I2C_AsyncTxn *txn);
+TEST_STATUS I2C_asyncWrite(Uint16 slaveAddr, const Uint16 *buf, Uint16 len,
+                           I2C_AsyncDoneFxn doneFxn, void *arg);
+TEST_STATUS I2C_asyncBurst(Uint16 slaveAddr, Uint16 reg, const Uint16 *buf,
+                           Uint16 len, I2C_AsyncDoneFxn doneFxn, void *arg);
+TEST_STATUS I2C_asyncWriteRead(Uint16 slaveAddr, const Uint16 *txBuf,
+                               Uint16 txLen, Uint16 *rxBuf, Uint16 rxLen,
+                               I2C_AsyncDoneFxn doneFxn, void *arg);
+Uint16 I2C_asyncPending(void);
+void I2C_asyncSetClock(I2C_AsyncClockFxn clockFxn);
+void I2C_asyncGetStats(I2C_AsyncStats *stats);
+interrupt void i2cAsyncIsr(void);
+
+#endif /* _I2C_ASYNC_H_ */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2c_clock.c
+*
+*   \brief I2C prescaler and SCL timing derived from the system clock.
+*
+*   The I2C module clock is the system clock divided by ICPSC + 1. The SCL
+*   period is then (ICCLKL + d) + (ICCLKH + d) module clocks, where d is 7
+*   for ICPSC = 0, 6 for ICPSC = 1 and 5 otherwise.
+*
+*   The prescaler is chosen for a module clock as close to 12 MHz as the
+*   system clock allows (13.3 MHz for fast mode plus, which needs the
+*   extra resolution), and the low/high counts for the fastest rate not
+*   above the requested one. Above standard mode the low time gets two
+*   thirds of the period to meet the 1.3us (fast mode) and 0.5us (fast mode
+*   plus) minimum low times.
+*
+*   I2C_clockRetime() re-derives the timing from C55x_getSysClk(), so it
+*   has to be called whenever the PLL is reprogrammed.
+*
+*/
+
+#include "i2c_clock.h"
+
+/* ICMDR I2C module reset bit, 0 holds the module in reset */
+#define I2C_CLOCK_MDR_IRS       (0x0020)
+
+static Uint32           i2cBusHz = I2C_BUS_RATE_400K;
+static I2C_ClockParams  i2cParams;
+
+/**
+ *
+ * \brief Computes the prescaler and SCL low/high counts for a bus rate
+ *
+ * \param  sysClkKhz - system clock in kHz, as from C55x_getSysClk()
+ * \param  busHz     - requested bus rate
+ * \param  params    - returns the register values and the rate obtained
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Rate not reachable from this system clock
+ *
+ */
+TEST_STATUS I2C_clockCompute(Uint32 sysClkKhz, Uint32 busHz,
+                             I2C_ClockParams *params)
+{
+	Uint32 modClkHz;
+	Uint32 period;
+	Uint32 sum;
+	Uint32 modMaxKhz;
+	Uint16 psc;
+	Uint16 d;
+
+	if ((sysClkKhz == 0) || (busHz == 0) || (busHz > I2C_BUS_RATE_1M))
+	{
+		return (TEST_FAIL);
+	}
+
+	modMaxKhz = (busHz > I2C_BUS_RATE_400K) ? I2C_CLOCK_MODULE_MAX_KHZ :
+	                                          I2C_CLOCK_MODULE_KHZ;
+
+	psc = (Uint16)((sysClkKhz + modMaxKhz - 1) / modMaxKhz) - 1;
+
+	/* Just above the target the next divider drops below the minimum,
+	   one less still keeps the module clock under the maximum */
+	if ((psc != 0) &&
+	    ((sysClkKhz / (psc + 1)) < I2C_CLOCK_MODULE_MIN_KHZ) &&
+	    ((sysClkKhz / psc) <= I2C_CLOCK_MODULE_MAX_KHZ))
+	{
+		psc--;
+	}
+
+	if ((sysClkKhz / (psc + 1)) < I2C_CLOCK_MODULE_MIN_KHZ)
+	{
+		return (TEST_FAIL);
+	}
+
+	d = (psc == 0) ? 7 : ((psc == 1) ? 6 : 5);
+
+	modClkHz = (sysClkKhz / (psc + 1)) * 1000;
+
+	/* Shortest period not faster than requested */
+	period = (modClkHz + busHz - 1) / busHz;
+	if (period < (2 * d + 2))
+	{
+		return (TEST_FAIL);
+	}
+
+	sum = period - 2 * d;
+
+	params->icpsc = psc;
+	if (busHz > I2C_BUS_RATE_100K)
+	{
+		params->icclkl = (Uint16)((sum * 2 + 2) / 3);
+	}
+	else
+	{
+		params->icclkl = (Uint16)((sum + 1) / 2);
+	}
+	params->icclkh = (Uint16)(sum - params->icclkl);
+	if (params->icclkh == 0)
+	{
+		params->icclkh = 1;
+		params->icclkl = (Uint16)(sum - 1);
+	}
+
+	params->busHz = modClkHz / (params->icclkl + params->icclkh + 2 * d);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Selects the bus rate and reprograms the I2C module for it
+ *
+ * \param  busHz - I2C_BUS_RATE_100K, I2C_BUS_RATE_400K or I2C_BUS_RATE_1M
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS I2C_clockSetBusRate(Uint32 busHz)
+{
+	Uint32 oldBusHz;
+
+	oldBusHz = i2cBusHz;
+	i2cBusHz = busHz;
+
+	if (I2C_clockRetime() != TEST_PASS)
+	{
+		i2cBusHz = oldBusHz;
+		return (TEST_FAIL);
+	}
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Re-derives the I2C timing from the current system clock. The bus
+ *        must be idle.
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS I2C_clockRetime(void)
+{
+	CSL_I2cRegsOvly  i2cReg = CSL_I2C_0_REGS;
+	I2C_ClockParams  params;
+	Uint16           mdr;
+
+	if (I2C_clockCompute(C55x_getSysClk(), i2cBusHz, &params) != TEST_PASS)
+	{
+		return (TEST_FAIL);
+	}
+
+	i2cParams = params;
+
+	/* The prescaler may only change with the module held in reset */
+	mdr = i2cReg->ICMDR;
+	i2cReg->ICMDR  = mdr & ~I2C_CLOCK_MDR_IRS;
+	i2cReg->ICPSC  = params.icpsc;
+	i2cReg->ICCLKL = params.icclkl;
+	i2cReg->ICCLKH = params.icclkh;
+	i2cReg->ICMDR  = mdr | I2C_CLOCK_MDR_IRS;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Returns the selected bus rate
+ *
+ */
+Uint32 I2C_clockGetBusRate(void)
+{
+	return (i2cBusHz);
+}
+
+/**
+ *
+ * \brief Returns the register values last computed for the bus rate
+ *
+ */
+void I2C_clockGetParams(I2C_ClockParams *params)
+{
+	if (i2cParams.busHz == 0)
+	{
+		I2C_clockCompute(C55x_getSysClk(), i2cBusHz, &i2cParams);
+	}
+
+	*params = i2cParams;
+}
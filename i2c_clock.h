@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2c_clock.h
+*
+*   \brief I2C prescaler and SCL timing derived from the system clock.
+*
+*/
+
+#ifndef _I2C_CLOCK_H_
+#define _I2C_CLOCK_H_
+
+#include "audio_common.h"
+
+/* Bus rates */
+#define I2C_BUS_RATE_100K       (100000)    /* standard mode              */
+#define I2C_BUS_RATE_400K       (400000)    /* fast mode, AIC3206 maximum */
+#define I2C_BUS_RATE_1M         (1000000)   /* fast mode plus             */
+
+/* The module clock after the prescaler has to stay in 6.7 - 13.3 MHz */
+#define I2C_CLOCK_MODULE_KHZ        (12000)
+#define I2C_CLOCK_MODULE_MAX_KHZ    (13300)
+#define I2C_CLOCK_MODULE_MIN_KHZ    (6700)
+
+typedef struct
+{
+	Uint16  icpsc;
+	Uint16  icclkl;
+	Uint16  icclkh;
+	Uint32  busHz;          /* rate actually obtained */
+} I2C_ClockParams;
+
+TEST_STATUS I2C_clockCompute(Uint32 sysClkKhz, Uint32 busHz,
+                             I2C_ClockParams *params);
+TEST_STATUS I2C_clockSetBusRate(Uint32 busHz);
+TEST_STATUS I2C_clockRetime(void);
+Uint32 I2C_clockGetBusRate(void);
+void I2C_clockGetParams(I2C_ClockParams *params);
+
+#endif /* _I2C_CLOCK_H_ */
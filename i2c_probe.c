@@ -35,10 +35,18 @@
 *
 *   \brief Functions to probe the I2C devices on the board
 *
+*   i2cScan() drives the I2C registers directly and so runs at bring-up,
+*   before I2C_asyncOpen(). i2cProbe() queues its write on the interrupt
+*   driven driver once that is open, and uses the polled CSL call before.
+*   Both time out on the timebase.
+*
 */
 
 #include "platform_internals.h"
 #include "cslr_i2c.h"
+#include "i2c_probe.h"
+#include "i2c_async.h"
+#include "timebase.h"
 
 // Register values for specific	purpose
 #define	I2C_VAL_REG_MDR_RESET		 (0x4000)
@@ -48,10 +56,14 @@
 #define	I2C_VAL_REG_MDR_MSTXMT		 (0x46A0)
 #define	I2C_VAL_REG_MDR_MSTXMTSTRT	 (0x66A0)
 #define	I2C_VAL_REG_MDR_MSTXMTSTOP	 (0x4CA0)
+#define	I2C_VAL_REG_MDR_MSTXMTONE	 (0x6E20)  // Start, 1 byte, stop
+#define	I2C_VAL_REG_MDR_MSTRCVONE	 (0x6C20)  // Start, read 1 byte, NACK, stop
+#define	I2C_VAL_REG_MDR_STP			 (0x0800)
 
 #define	I2C_VAL_REG_STR_RESET		 (0x0410)
 #define	I2C_VAL_REG_STR_ON_FAIL		 (0x1002)  // Clear bus busy, clear nack
 #define	I2C_VAL_REG_STR_CLR_BUSY	 (0x1000)  // Clear busy
+#define	I2C_VAL_REG_STR_CLR_FLAGS	 (0x0027)  // Clear AL, NACK, ARDY, SCD
 
 //I2C_DELAY
 #define DELAY_CONST 10
@@ -59,25 +71,102 @@
 
 //Return Value
 #define	I2C_MAX_MASTER_RECEIVE_TIMEOUT	 (24)
-#define	I2C_RET_NO_ACK_READ			 (8)
-#define	I2C_RET_IDLE_TIMEOUT		 (3)
 
 
 // Bit field definitions
+#define	I2C_REG_STR_FIELD_AL         (1<<0)
 #define	I2C_REG_STR_FIELD_NACK       (1<<1)
+#define	I2C_REG_STR_FIELD_SCD        (1<<5)
+#define	I2C_REG_STR_FIELD_BB         (1<<12)
+
+/* Completion of a probe queued on the async driver. probeBusy holds
+ * probeBuf from the submit to its completion, which the driver always
+ * calls, aborts included. */
+static Uint16              probeBuf[I2C_PROBE_MAX_BYTES];
+static Uint16              probeSeq;
+static volatile Bool       probeBusy;
+static volatile Bool       probeDone;
+static volatile CSL_Status probeStatus;
+
+static void i2cProbeDone (CSL_Status status, void *arg)
+{
+	/* A probe that timed out completes here too; only the one still
+	 * waited for takes the status */
+	if ((Uint16)(size_t)arg == probeSeq)
+	{
+		probeStatus = status;
+		probeDone   = TRUE;
+	}
+	probeBusy = FALSE;
+}
+
+/* Probe write queued behind any pending transactions of the driver */
+static CSL_Status i2cProbeAsync (Uint16 slaveAddress, Uint16 *pData,
+                                 Uint16 numBytes)
+{
+	Uint32 deadline;
+
+	if (numBytes > I2C_PROBE_MAX_BYTES)
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	deadline = C55x_deadline(I2C_PROBE_TIMEOUT_USEC);
+
+	/* An earlier probe that timed out may still be sending from
+	 * probeBuf */
+	while (probeBusy)
+	{
+		if (C55x_deadlinePassed(deadline))
+		{
+			return (I2C_RET_IDLE_TIMEOUT);
+		}
+	}
+
+	memcpy(probeBuf, pData, numBytes * sizeof(Uint16));
+	probeSeq++;
+	probeDone = FALSE;
+	probeBusy = TRUE;
+
+	while (I2C_asyncWrite(slaveAddress, probeBuf, numBytes, i2cProbeDone,
+	                      (void *)(size_t)probeSeq) != TEST_PASS)
+	{
+		if (C55x_deadlinePassed(deadline))
+		{
+			probeBusy = FALSE;
+			return (I2C_RET_IDLE_TIMEOUT);
+		}
+	}
+
+	while (!probeDone)
+	{
+		if (C55x_deadlinePassed(deadline))
+		{
+			return (I2C_RET_IDLE_TIMEOUT);
+		}
+	}
+
+	if (probeStatus == CSL_I2C_NACK_ERR)
+	{
+		return (I2C_RET_NO_ACK_READ);
+	}
 
-CSL_Status i2cProbe (Uint16 slaveAddress,Uint16 *pData, Uint16 numBytes);
+	return (probeStatus);
+}
 
 /**
  * \brief Function to probe I2C devices
  *
  * \param    slaveAddress  - i2c slave device address
  * \param	 pData        - Pointer to the buffer base address
- * \param	 numBytes      - Number of bytes in 'pData'
+ * \param	 numBytes      - Number of bytes in 'pData', 1 to
+ *                          I2C_PROBE_MAX_BYTES with the async driver open
  *
  * \return
- * \n      TEST_PASS  - Test Passed
- * \n      TEST_FAIL  - Test Failed
+ * \n      CSL_SOK               - Address and data acknowledged
+ * \n      I2C_RET_NO_ACK_READ   - Not acknowledged
+ * \n      I2C_RET_IDLE_TIMEOUT  - No answer within I2C_PROBE_TIMEOUT_USEC
+ * \n      other                 - CSL error of the transfer
  *
  */
 CSL_Status i2cProbe (Uint16 slaveAddress,Uint16 *pData, Uint16 numBytes)
@@ -87,16 +176,23 @@ CSL_Status i2cProbe (Uint16 slaveAddress,Uint16 *pData, Uint16 numBytes)
 	CSL_Status   returnValue;
     Uint16 startStopFlag = ((CSL_I2C_START) | (CSL_I2C_STOP));
 
-    statusReg = i2cReg->ICSTR;
+	if ((pData == NULL) || (numBytes == 0))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
 
-	returnValue = I2C_write(pData, numBytes, slaveAddress,
-	                TRUE, startStopFlag, CSL_I2C_MAX_TIMEOUT);
-	if (returnValue != CSL_SOK)
+	/* The registers belong to the I2C ISR once the driver is open */
+	if (I2C_asyncIsOpen())
 	{
-		C55x_msgWrite("i2cProbe: I2C Slave Address Write Failed\n\r");
-		return (returnValue);
+		return (i2cProbeAsync(slaveAddress, pData, numBytes));
 	}
 
+	returnValue = I2C_write(pData, numBytes, slaveAddress,
+	                TRUE, startStopFlag, CSL_I2C_MAX_TIMEOUT);
+
+	/* The NACK flag is only meaningful once the transfer is over */
+    statusReg = i2cReg->ICSTR;
+
 	/* On Nack return failure */
 	if ((statusReg)&(I2C_REG_STR_FIELD_NACK))
 	{
@@ -106,5 +202,153 @@ CSL_Status i2cProbe (Uint16 slaveAddress,Uint16 *pData, Uint16 numBytes)
 
 		return (I2C_RET_NO_ACK_READ);
 	}
+
+	if (returnValue != CSL_SOK)
+	{
+		C55x_msgWrite("i2cProbe: I2C Slave Address Write Failed\n\r");
+		return (returnValue);
+	}
+	return (CSL_SOK);
+}
+
+/**
+ * \brief Probes one address with a single byte read and a bounded wait
+ *
+ * \param    i2cReg       - I2C registers
+ * \param    addr         - 7-bit slave address
+ * \param    timeoutUsec  - wait for an answer before giving up
+ * \param    usec         - returns the time from the start to the answer
+ *
+ * \return
+ * \n      CSL_SOK               - Address acknowledged
+ * \n      I2C_RET_NO_ACK_READ   - Address not acknowledged
+ * \n      I2C_RET_IDLE_TIMEOUT  - No answer within 'timeoutUsec'
+ *
+ */
+static CSL_Status i2cScanAddr (CSL_I2cRegsOvly i2cReg, Uint16 addr,
+                               Uint32 timeoutUsec, Uint32 *usec)
+{
+	Uint16 statusReg;
+	Uint32 start;
+	Uint32 deadline;
+
+	*usec = 0;
+
+	/* Wait for the previous stop to clear the bus */
+	deadline = C55x_deadline(timeoutUsec);
+	while ((i2cReg->ICSTR & I2C_REG_STR_FIELD_BB) != 0)
+	{
+		if (C55x_deadlinePassed(deadline))
+		{
+			return (I2C_RET_IDLE_TIMEOUT);
+		}
+	}
+
+	i2cReg->ICSTR = I2C_VAL_REG_STR_CLR_FLAGS;
+	i2cReg->ICSAR = addr;
+	i2cReg->ICCNT = 1;
+
+	/* The C55x master cannot send a start without data (ICCNT = 0 means
+	 * 65536 bytes). A one byte read leaves the device untouched: the
+	 * master NACKs the byte and stops, and a NACK on the address stops
+	 * the transfer before it. */
+	start    = C55x_nowUsec();
+	deadline = C55x_deadline(timeoutUsec);
+	i2cReg->ICMDR = I2C_VAL_REG_MDR_MSTRCVONE;
+
+	do
+	{
+		statusReg = i2cReg->ICSTR;
+
+		if (statusReg & (I2C_REG_STR_FIELD_NACK | I2C_REG_STR_FIELD_AL))
+		{
+			*usec = C55x_nowUsec() - start;
+
+			/* Send the stop and clear nack; the next address waits for
+			 * the stop to free the bus */
+			i2cReg->ICMDR |= I2C_VAL_REG_MDR_STP;
+			i2cReg->ICSTR = I2C_REG_STR_FIELD_NACK | I2C_REG_STR_FIELD_AL;
+			return (I2C_RET_NO_ACK_READ);
+		}
+
+		if (statusReg & I2C_REG_STR_FIELD_SCD)
+		{
+			*usec = C55x_nowUsec() - start;
+			(void)i2cReg->ICDRR;    // drop the byte, clears RRDY
+			i2cReg->ICSTR = I2C_REG_STR_FIELD_SCD;
+			return (CSL_SOK);
+		}
+	} while (!C55x_deadlinePassed(deadline));
+
+	/* Nothing came back: reset the module to release the bus */
+	i2cReg->ICMDR = I2C_VAL_REG_MDR_RESET;
+	i2cReg->ICMDR = I2C_VAL_REG_MDR_SLVRCV;
+
+	return (I2C_RET_IDLE_TIMEOUT);
+}
+
+/**
+ * \brief Function to scan a range of I2C addresses. Drives the registers
+ *        directly, so it has to run before I2C_asyncOpen().
+ *
+ * \param    firstAddr    - first 7-bit address, I2C_SCAN_FIRST_ADDR
+ * \param    lastAddr     - last 7-bit address, I2C_SCAN_LAST_ADDR
+ * \param    timeoutUsec  - wait per address, I2C_SCAN_TIMEOUT_USEC
+ * \param    result       - returns the responders and response times
+ *
+ * \return
+ * \n      CSL_SOK            - Scan done, see 'result'
+ * \n      CSL_ESYS_INVPARAMS - Bad address range or timeout
+ * \n      CSL_ESYS_BADHANDLE - The async driver owns the registers
+ *
+ */
+CSL_Status i2cScan (Uint16 firstAddr, Uint16 lastAddr, Uint32 timeoutUsec,
+                    I2C_ScanResult *result)
+{
+	CSL_I2cRegsOvly i2cReg = CSL_I2C_0_REGS;
+	CSL_Status      status;
+	Uint16          addr;
+	Uint32          usec;
+	Uint32          deadline;
+
+	if ((firstAddr > lastAddr) || (lastAddr >= I2C_SCAN_ADDR_COUNT) ||
+	    (timeoutUsec == 0) || (timeoutUsec > I2C_SCAN_MAX_TIMEOUT_USEC))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	if (I2C_asyncIsOpen())
+	{
+		return (CSL_ESYS_BADHANDLE);
+	}
+
+	memset(result, 0, sizeof(I2C_ScanResult));
+
+	for (addr = firstAddr; addr <= lastAddr; addr++)
+	{
+		status = i2cScanAddr(i2cReg, addr, timeoutUsec, &usec);
+
+		result->responseTime[addr] = (Uint16)usec;
+
+		if (status == CSL_SOK)
+		{
+			result->present[addr >> 4] |= (1 << (addr & 0xF));
+			result->found++;
+		}
+		else if (status == I2C_RET_IDLE_TIMEOUT)
+		{
+			result->timeouts++;
+		}
+	}
+
+	/* Let the last stop finish, then leave the module as the CSL calls
+	 * expect it */
+	deadline = C55x_deadline(timeoutUsec);
+	while (((i2cReg->ICSTR & I2C_REG_STR_FIELD_BB) != 0) &&
+	       !C55x_deadlinePassed(deadline))
+	{
+	}
+	i2cReg->ICMDR = I2C_VAL_REG_MDR_SLVRCV;
+
 	return (CSL_SOK);
 }
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2c_probe.h
+*
+*   \brief Functions to probe the I2C devices on the board
+*
+*/
+
+#ifndef _I2C_PROBE_H_
+#define _I2C_PROBE_H_
+
+#include "platform_internals.h"
+
+#define I2C_SCAN_ADDR_COUNT     (128)
+
+/* Addresses scanned by default, reserved addresses excluded */
+#define I2C_SCAN_FIRST_ADDR     (0x08)
+#define I2C_SCAN_LAST_ADDR      (0x77)
+
+/* Wait for an answer before an address is given up; a one byte read
+ * with stop takes 210us at 100 kHz */
+#define I2C_SCAN_TIMEOUT_USEC       (1000)
+#define I2C_SCAN_MAX_TIMEOUT_USEC   (65535)
+
+/* i2cProbe() wait, and most bytes it takes with the async driver open */
+#define I2C_PROBE_TIMEOUT_USEC  (20000)
+#define I2C_PROBE_MAX_BYTES     (16)
+
+/* i2cProbe() and i2cScan() results besides the CSL ones */
+#define I2C_RET_NO_ACK_READ     (8)
+#define I2C_RET_IDLE_TIMEOUT    (3)
+
+typedef struct
+{
+	/* Responders, bit (addr & 0xF) of word (addr >> 4) */
+	Uint16  present[I2C_SCAN_ADDR_COUNT / 16];
+	/* Microseconds until the address was acknowledged or refused,
+	 * 0 for addresses not probed or timed out */
+	Uint16  responseTime[I2C_SCAN_ADDR_COUNT];
+	Uint16  found;
+	Uint16  timeouts;
+} I2C_ScanResult;
+
+#define I2C_SCAN_IS_PRESENT(result, addr) \
+	(((result)->present[(addr) >> 4] >> ((addr) & 0xF)) & 1)
+
+CSL_Status i2cProbe (Uint16 slaveAddress,Uint16 *pData, Uint16 numBytes);
+CSL_Status i2cScan (Uint16 firstAddr, Uint16 lastAddr, Uint32 timeoutUsec,
+                    I2C_ScanResult *result);
+
+#endif /* _I2C_PROBE_H_ */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2s_block.c
+*
+*   \brief Polled block transfers on the I2S2 data registers.
+*
+*   One status poll per frame and direction, both words of a frame moved
+*   together. I2S2 must have been opened in polled mode by
+*   initialise_i2s_interface().
+*
+*/
+
+#include "i2s_block.h"
+
+/**
+ *
+ * \brief This function writes 'frames' interleaved stereo frames to the
+ *        I2S transmitter. The transmit flag is polled once per frame and
+ *        the left and right words of a frame are always written together.
+ *
+ * \param  data   - interleaved L/R samples
+ * \param  frames - number of frames
+ *
+ * \return void
+ *
+ */
+void I2S_writeBlock(const Int16 *data, Uint16 frames)
+{
+    ioport  CSL_I2sRegs   *regs;
+
+    regs = hI2s->hwRegs;
+    while(frames--)
+    {
+        while((CSL_I2S_I2SINTFL_XMITSTFL_MASK & regs->I2SINTFL) == 0);  // Wait for transmit interrupt to be pending
+        regs->I2STXLT1 = *data++;           // 16 bit left channel transmit audio data
+        regs->I2STXRT1 = *data++;           // 16 bit right channel transmit audio data
+    }
+}
+
+/**
+ *
+ * \brief This function reads 'frames' interleaved stereo frames from the
+ *        I2S receiver. The receive flag is polled once per frame and both
+ *        words of the frame are read together.
+ *
+ * \param  data   - destination for interleaved L/R samples
+ * \param  frames - number of frames
+ *
+ * \return void
+ *
+ */
+void I2S_readBlock(Int16 *data, Uint16 frames)
+{
+    ioport  CSL_I2sRegs   *regs;
+
+    regs = hI2s->hwRegs;
+    while(frames--)
+    {
+        while((CSL_I2S_I2SINTFL_RCVSTFL_MASK & regs->I2SINTFL) == 0);  // Wait for receive interrupt to be pending
+        *data++ = regs->I2SRXLT1;           // 16 bit left channel receive audio data
+        *data++ = regs->I2SRXRT1;           // 16 bit right channel receive audio data
+    }
+}
@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2s_dma.c
+*
+*   \brief Ping-pong DMA transmit engine for the I2S2 instance.
+*
+*   Two DMA1 channels move the left and right samples from a double
+*   buffer into the I2S2 transmit registers. Each channel runs in
+*   auto-reload ping-pong mode, so the DMA raises an interrupt every
+*   time one half has been played out and carries on with the other
+*   half. The interrupt only marks the finished half as free; the refill
+*   is done from the main loop by I2S_dmaService(), which calls the
+*   application's block fill callback.
+*
+*/
+
+#include "i2s_dma.h"
+#include "uart_stream.h"
+
+#define I2S_DMA_PING            (0)
+#define I2S_DMA_PONG            (1)
+
+/* DMA moves 32-bit words; the 16-bit sample goes to the MSW (I2STXxT1),
+ * the same register the polled I2S_writeLeft()/I2S_writeRight() use */
+#define I2S_DMA_SLOT(sample)    (((Uint32)(Uint16)(sample)) << 16)
+
+/* DMAIFR flags of the two transmit channels; the other channels belong to
+ * other drivers, so only these are ever cleared */
+#define I2S_DMA_IFR_MASK        ((1 << I2S_DMA_TX_LEFT_CHAN) | \
+                                 (1 << I2S_DMA_TX_RIGHT_CHAN))
+
+static CSL_DMA_ChannelObj  dmaTxLeftObj;
+static CSL_DMA_ChannelObj  dmaTxRightObj;
+static CSL_DMA_Handle      hDmaTxLeft;
+static CSL_DMA_Handle      hDmaTxRight;
+
+#pragma DATA_ALIGN(dmaTxLeftBuf, 4)
+static Uint32 dmaTxLeftBuf[2 * I2S_DMA_BLOCK_FRAMES];
+#pragma DATA_ALIGN(dmaTxRightBuf, 4)
+static Uint32 dmaTxRightBuf[2 * I2S_DMA_BLOCK_FRAMES];
+
+static Int16 fillLeft[I2S_DMA_BLOCK_FRAMES];
+static Int16 fillRight[I2S_DMA_BLOCK_FRAMES];
+
+static I2S_DmaFillFxn  dmaFillFxn;
+static void           *dmaFillArg;
+
+/* Set by the ISR when a half is free, cleared once it has been refilled.
+ * One flag per half so that neither side needs a read-modify-write. */
+static volatile Uint16 dmaHalfFree[2];
+static volatile I2S_DmaStats dmaStats;
+
+/**
+ *
+ * \brief Calls the fill callback for one half and packs the result into
+ *        the DMA buffers.
+ *
+ * \param half - I2S_DMA_PING or I2S_DMA_PONG
+ *
+ * \return void
+ *
+ */
+static void I2S_dmaFillHalf(Uint16 half)
+{
+	Uint32 *left;
+	Uint32 *right;
+	Uint16  frame;
+
+	left  = &dmaTxLeftBuf[half * I2S_DMA_BLOCK_FRAMES];
+	right = &dmaTxRightBuf[half * I2S_DMA_BLOCK_FRAMES];
+
+	STREAM_release(fillLeft);
+	STREAM_release(fillRight);
+
+	dmaFillFxn(fillLeft, fillRight, I2S_DMA_BLOCK_FRAMES, dmaFillArg);
+
+	for (frame = 0; frame < I2S_DMA_BLOCK_FRAMES; frame++)
+	{
+		left[frame]  = I2S_DMA_SLOT(fillLeft[frame]);
+		right[frame] = I2S_DMA_SLOT(fillRight[frame]);
+	}
+
+	STREAM_tap(STREAM_TAP_DMA_LEFT, fillLeft, I2S_DMA_BLOCK_FRAMES, 1);
+	STREAM_tap(STREAM_TAP_DMA_RIGHT, fillRight, I2S_DMA_BLOCK_FRAMES, 1);
+}
+
+/**
+ *
+ * \brief Opens one transmit DMA channel in auto-reload ping-pong mode
+ *
+ * \param chan     - DMA channel number
+ * \param chanObj  - channel object
+ * \param buffer   - ping-pong buffer (ping followed by pong)
+ * \param destAddr - I2S transmit register address
+ * \param intEnable - raise the DMA interrupt on this channel
+ *
+ * \return DMA handle, NULL on failure
+ *
+ */
+static CSL_DMA_Handle I2S_dmaOpenChannel(CSL_DMAChanNum chan,
+                                         CSL_DMA_ChannelObj *chanObj,
+                                         Uint32 *buffer, Uint32 destAddr,
+                                         Bool intEnable)
+{
+	CSL_DMA_Config  dmaConfig;
+	CSL_DMA_Handle  hDma;
+	CSL_Status      status;
+
+	hDma = DMA_open(chan, chanObj, &status);
+	if ((NULL == hDma) || (CSL_SOK != status))
+	{
+		return (NULL);
+	}
+
+	dmaConfig.pingPongMode = CSL_DMA_PING_PONG_ENABLE;
+	dmaConfig.autoMode     = CSL_DMA_AUTORELOAD_ENABLE;
+	dmaConfig.burstLen     = CSL_DMA_TXBURST_1WORD;
+	dmaConfig.trigger      = CSL_DMA_EVENT_TRIGGER;
+	dmaConfig.dmaEvt       = CSL_DMA_EVT_I2S2_TX;
+	dmaConfig.dmaInt       = (intEnable == TRUE) ? CSL_DMA_INTERRUPT_ENABLE :
+	                                               CSL_DMA_INTERRUPT_DISABLE;
+	dmaConfig.chanDir      = CSL_DMA_WRITE;
+	dmaConfig.trfType      = CSL_DMA_TRANSFER_IO_MEMORY;
+	/* Length in bytes of ping and pong together */
+	dmaConfig.dataLen      = 2 * I2S_DMA_BLOCK_FRAMES * 4;
+	dmaConfig.srcAddr      = (Uint32)buffer;
+	dmaConfig.destAddr     = destAddr;
+
+	status = DMA_config(hDma, &dmaConfig);
+	if (CSL_SOK != status)
+	{
+		DMA_close(hDma);
+		return (NULL);
+	}
+
+	return (hDma);
+}
+
+/**
+ *  \brief  DMA Interrupt Service Routine
+ *
+ *  Only the left channel raises the interrupt; the right channel runs
+ *  off the same I2S frame events and is always on the same half.
+ *
+ *  \return none
+ */
+interrupt void i2sDmaIsr(void)
+{
+	Uint16      ifrValue;
+	Uint16      half;
+	CSL_Status  status;
+
+	ifrValue = CSL_SYSCTRL_REGS->DMAIFR & I2S_DMA_IFR_MASK;
+	/* Write 1 to clear, only the flags handled here: a read-modify-write
+	 * would also clear whatever else was pending */
+	CSL_SYSCTRL_REGS->DMAIFR = ifrValue;
+
+	if (0 == (ifrValue & (1 << I2S_DMA_TX_LEFT_CHAN)))
+	{
+		return;
+	}
+
+	/* Half that has just been played out */
+	half = DMA_getLastTransferType(hDmaTxLeft, &status) ?
+	       I2S_DMA_PONG : I2S_DMA_PING;
+
+	dmaStats.blocksPlayed++;
+
+	if (dmaHalfFree[half])
+	{
+		/* Not refilled since it was last played, the DMA repeats it */
+		dmaStats.underruns++;
+	}
+
+	dmaHalfFree[half] = 1;
+}
+
+/**
+ *
+ * \brief Closes whatever I2S_dmaOpen() got open: the transmit channels
+ *        and the I2S handle. Safe to call on a partial open.
+ *
+ * \return void
+ *
+ */
+static void I2S_dmaRelease(void)
+{
+	if (NULL != hI2s)
+	{
+		I2S_transEnable(hI2s, FALSE);
+	}
+
+	if (NULL != hDmaTxLeft)
+	{
+		DMA_stop(hDmaTxLeft);
+		DMA_close(hDmaTxLeft);
+		hDmaTxLeft = NULL;
+	}
+
+	if (NULL != hDmaTxRight)
+	{
+		DMA_stop(hDmaTxRight);
+		DMA_close(hDmaTxRight);
+		hDmaTxRight = NULL;
+	}
+
+	if (NULL != hI2s)
+	{
+		I2S_close(hI2s);
+		hI2s = NULL;
+	}
+
+	i2sOpMode = I2S_POLLED;
+}
+
+/**
+ *
+ * \brief This function initializes the I2S interface in DMA mode and opens
+ *        the ping-pong transmit channels. Both halves are filled once
+ *        through 'fillFxn' before returning.
+ *
+ * \param  fillFxn - block fill callback
+ * \param  arg     - argument handed back to 'fillFxn'
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS I2S_dmaOpen(I2S_DmaFillFxn fillFxn, void *arg)
+{
+	CSL_Status status;
+
+	if (NULL == fillFxn)
+	{
+		return (TEST_FAIL);
+	}
+
+	dmaFillFxn = fillFxn;
+	dmaFillArg = arg;
+
+	dmaStats.blocksPlayed = 0;
+	dmaStats.blocksFilled = 0;
+	dmaStats.underruns    = 0;
+
+	i2sOpMode = DMA_INTERRUPT;
+	if (initialise_i2s_interface() != 0)
+	{
+		C55x_msgWrite("I2S init for DMA failed\n\r");
+		return (TEST_FAIL);
+	}
+
+	/* Keep the transmitter off until the DMA is running */
+	I2S_transEnable(hI2s, FALSE);
+
+	status = DMA_init();
+	if (CSL_SOK != status)
+	{
+		C55x_msgWrite("DMA_init failed\n\r");
+		I2S_dmaRelease();
+		return (TEST_FAIL);
+	}
+
+	hDmaTxLeft  = I2S_dmaOpenChannel(I2S_DMA_TX_LEFT_CHAN, &dmaTxLeftObj,
+	                                 dmaTxLeftBuf, I2S_DMA_I2S2_TXLT0_ADDR,
+	                                 TRUE);
+	hDmaTxRight = I2S_dmaOpenChannel(I2S_DMA_TX_RIGHT_CHAN, &dmaTxRightObj,
+	                                 dmaTxRightBuf, I2S_DMA_I2S2_TXRT0_ADDR,
+	                                 FALSE);
+	if ((NULL == hDmaTxLeft) || (NULL == hDmaTxRight))
+	{
+		C55x_msgWrite("DMA_open for I2S transmit failed\n\r");
+		I2S_dmaRelease();
+		return (TEST_FAIL);
+	}
+
+	I2S_dmaFillHalf(I2S_DMA_PING);
+	I2S_dmaFillHalf(I2S_DMA_PONG);
+	dmaHalfFree[I2S_DMA_PING] = 0;
+	dmaHalfFree[I2S_DMA_PONG] = 0;
+
+	IRQ_clear(DMA_EVENT);
+	IRQ_plug(DMA_EVENT, &i2sDmaIsr);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Starts the transmit DMA channels and the I2S transmitter
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS I2S_dmaStart(void)
+{
+	CSL_Status status;
+
+	/* Clear stale flags of our channels before enabling the interrupt */
+	CSL_SYSCTRL_REGS->DMAIFR = I2S_DMA_IFR_MASK;
+	IRQ_enable(DMA_EVENT);
+
+	status  = DMA_start(hDmaTxRight);
+	status |= DMA_start(hDmaTxLeft);
+	if (CSL_SOK != status)
+	{
+		C55x_msgWrite("DMA_start failed\n\r");
+		return (TEST_FAIL);
+	}
+
+	I2S_transEnable(hI2s, TRUE);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Refills every half the DMA has finished with. Meant to be called
+ *        from the main loop; all application processing happens here,
+ *        outside interrupt context.
+ *
+ * \return Number of halves refilled
+ *
+ */
+Uint16 I2S_dmaService(void)
+{
+	Uint16 half;
+	Uint16 filled = 0;
+
+	for (half = I2S_DMA_PING; half <= I2S_DMA_PONG; half++)
+	{
+		if (dmaHalfFree[half])
+		{
+			I2S_dmaFillHalf(half);
+			dmaHalfFree[half] = 0;
+			dmaStats.blocksFilled++;
+			filled++;
+		}
+	}
+
+	return (filled);
+}
+
+/**
+ *
+ * \brief Tells whether a half waits for I2S_dmaService(), without
+ *        filling it. Safe with interrupts disabled.
+ *
+ */
+Bool I2S_dmaPending(void)
+{
+	return ((dmaHalfFree[I2S_DMA_PING] || dmaHalfFree[I2S_DMA_PONG]) ?
+	        TRUE : FALSE);
+}
+
+/**
+ *
+ * \brief Stops the transmit DMA channels and closes the I2S interface.
+ *        Also cleans up after a failed I2S_dmaStart().
+ *
+ * \return void
+ *
+ */
+void I2S_dmaStop(void)
+{
+	IRQ_disable(DMA_EVENT);
+
+	I2S_dmaRelease();
+}
+
+/**
+ *
+ * \brief Copies the engine counters
+ *
+ * \param  stats - destination
+ *
+ * \return void
+ *
+ */
+void I2S_dmaGetStats(I2S_DmaStats *stats)
+{
+	Bool oldIntState;
+
+	oldIntState = IRQ_globalDisable();
+	stats->blocksPlayed = dmaStats.blocksPlayed;
+	stats->blocksFilled = dmaStats.blocksFilled;
+	stats->underruns    = dmaStats.underruns;
+	IRQ_globalRestore(oldIntState);
+}
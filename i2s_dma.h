@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2s_dma.h
+*
+*   \brief Ping-pong DMA transmit engine for the I2S2 instance.
+*
+*/
+
+#ifndef _I2S_DMA_H_
+#define _I2S_DMA_H_
+
+#include "audio_common.h"
+
+/* Number of stereo frames in one ping (or pong) half */
+#define I2S_DMA_BLOCK_FRAMES    (48)
+
+/* I2S2 transmit data registers seen by the DMA (I/O space word addresses) */
+#define I2S_DMA_I2S2_TXLT0_ADDR (0x2A08)
+#define I2S_DMA_I2S2_TXRT0_ADDR (0x2A0C)
+
+/* DMA1 channels serving the I2S2 transmit events */
+#define I2S_DMA_TX_LEFT_CHAN    (CSL_DMA_CHAN4)
+#define I2S_DMA_TX_RIGHT_CHAN   (CSL_DMA_CHAN5)
+
+/**
+ * \brief Block fill callback, called from I2S_dmaService() whenever a half
+ *        of the ping-pong buffer has been played out.
+ *
+ * \param left   - destination for 'frames' left channel samples
+ * \param right  - destination for 'frames' right channel samples
+ * \param frames - number of frames to produce
+ * \param arg    - user argument passed to I2S_dmaOpen()
+ */
+typedef void (*I2S_DmaFillFxn)(Int16 *left, Int16 *right,
+                               Uint16 frames, void *arg);
+
+typedef struct
+{
+    Uint32 blocksPlayed;   /* halves completed by the DMA            */
+    Uint32 blocksFilled;   /* halves refilled by I2S_dmaService()    */
+    Uint32 underruns;      /* halves replayed because no refill came */
+} I2S_DmaStats;
+
+/* I2S open mode used by initialise_i2s_interface(), see audio_common.c */
+extern Uint16 i2sOpMode;
+
+TEST_STATUS I2S_dmaOpen(I2S_DmaFillFxn fillFxn, void *arg);
+TEST_STATUS I2S_dmaStart(void);
+Uint16 I2S_dmaService(void);
+Bool I2S_dmaPending(void);
+void I2S_dmaStop(void);
+void I2S_dmaGetStats(I2S_DmaStats *stats);
+interrupt void i2sDmaIsr(void);
+
+#endif /* _I2S_DMA_H_ */
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2s_ring.c
+*
+*   \brief Interrupt driven I2S2 mode backed by single-producer /
+*          single-consumer sample ring buffers.
+*
+*   In this mode the I2S ISR takes one stereo frame from the TX ring on
+*   every frame event and stores one frame into the RX ring. The application only has to keep the rings topped up in blocks
+*   and is decoupled from the frame clock by the ring depth.
+*
+*   The ring functions do not touch any hardware and can be built and
+*   exercised on their own.
+*
+*/
+
+#include "i2s_ring.h"
+#include "i2s_dma.h"
+
+/* The C55x is a single in-order core: ISR and main loop see each other's
+ * volatile accesses in program order and no fence is needed. Hosts that
+ * run the ISR side on another thread get real acquire/release fences. */
+#ifdef __TMS320C55X__
+#define I2S_RING_ACQUIRE()
+#define I2S_RING_RELEASE()
+#else
+#define I2S_RING_ACQUIRE()      __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define I2S_RING_RELEASE()      __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+static Int16   txRingBuf[I2S_RING_TX_SIZE];
+static Int16   rxRingBuf[I2S_RING_RX_SIZE];
+
+static I2S_Ring  txRing;
+static I2S_Ring  rxRing;
+static Uint16    ringDirection;
+
+static volatile I2S_RingStats ringStats;
+
+/**
+ *
+ * \brief Initializes an empty ring over 'buf'
+ *
+ * \param  ring - ring to initialize
+ * \param  buf  - sample storage
+ * \param  size - number of samples in 'buf', must be a power of two
+ *
+ * \return void
+ *
+ */
+void I2S_ringInit(I2S_Ring *ring, Int16 *buf, Uint16 size)
+{
+	ring->buf  = buf;
+	ring->mask = size - 1;
+	ring->head = 0;
+	ring->tail = 0;
+}
+
+/**
+ *
+ * \brief Returns the number of samples stored in the ring
+ *
+ */
+Uint16 I2S_ringCount(const I2S_Ring *ring)
+{
+	return ((Uint16)(ring->head - ring->tail));
+}
+
+/**
+ *
+ * \brief Returns the number of samples that can still be stored
+ *
+ */
+Uint16 I2S_ringSpace(const I2S_Ring *ring)
+{
+	return ((ring->mask + 1) - I2S_ringCount(ring));
+}
+
+/**
+ *
+ * \brief Producer side: copies up to 'count' samples into the ring
+ *
+ * \param  ring  - ring
+ * \param  data  - samples to store
+ * \param  count - number of samples
+ *
+ * \return Number of samples actually stored
+ *
+ */
+Uint16 I2S_ringPut(I2S_Ring *ring, const Int16 *data, Uint16 count)
+{
+	Uint16 head;
+	Uint16 space;
+	Uint16 i;
+
+	space = I2S_ringSpace(ring);
+	if (count > space)
+	{
+		count = space;
+	}
+
+	/* The consumer is done with the slots 'tail' gave back */
+	I2S_RING_ACQUIRE();
+
+	head = ring->head;
+	for (i = 0; i < count; i++)
+	{
+		ring->buf[(head + i) & ring->mask] = data[i];
+	}
+
+	/* Publish the samples only after they have been written */
+	I2S_RING_RELEASE();
+	ring->head = head + count;
+
+	return (count);
+}
+
+/**
+ *
+ * \brief Consumer side: copies up to 'count' samples out of the ring
+ *
+ * \param  ring  - ring
+ * \param  data  - destination
+ * \param  count - number of samples
+ *
+ * \return Number of samples actually read
+ *
+ */
+Uint16 I2S_ringGet(I2S_Ring *ring, Int16 *data, Uint16 count)
+{
+	Uint16 tail;
+	Uint16 avail;
+	Uint16 i;
+
+	avail = I2S_ringCount(ring);
+	if (count > avail)
+	{
+		count = avail;
+	}
+
+	/* The samples 'head' published are complete */
+	I2S_RING_ACQUIRE();
+
+	tail = ring->tail;
+	for (i = 0; i < count; i++)
+	{
+		data[i] = ring->buf[(tail + i) & ring->mask];
+	}
+
+	/* Release the slots only after they have been read */
+	I2S_RING_RELEASE();
+	ring->tail = tail + count;
+
+	return (count);
+}
+
+/**
+ *  \brief  I2S2 Interrupt Service Routine, for both the transmit and the
+ *          receive event
+ *
+ *  Reading I2SINTFL acknowledges both flags, so the register is read once
+ *  here and every direction it shows is served: one stereo frame from the
+ *  TX ring, or silence when it is empty, and one frame into the RX ring,
+ *  dropped when it is full. The other event then finds no flag.
+ *
+ *  \return none
+ */
+interrupt void i2sRingIsr(void)
+{
+	ioport  CSL_I2sRegs   *regs;
+	Uint16  flags;
+	Int16   frame[2];
+
+	regs  = hI2s->hwRegs;
+	flags = regs->I2SINTFL;
+
+	if ((ringDirection & I2S_RING_RX) &&
+	    (flags & CSL_I2S_I2SINTFL_RCVSTFL_MASK))
+	{
+		frame[0] = regs->I2SRXLT1;
+		frame[1] = regs->I2SRXRT1;
+
+		if (I2S_ringSpace(&rxRing) < 2)
+		{
+			ringStats.overruns++;
+		}
+		else
+		{
+			I2S_ringPut(&rxRing, frame, 2);
+			ringStats.rxFrames++;
+		}
+	}
+
+	if ((ringDirection & I2S_RING_TX) &&
+	    (flags & CSL_I2S_I2SINTFL_XMITSTFL_MASK))
+	{
+		if (I2S_ringGet(&txRing, frame, 2) != 2)
+		{
+			frame[0] = 0;
+			frame[1] = 0;
+			ringStats.underruns++;
+		}
+		else
+		{
+			ringStats.txFrames++;
+		}
+
+		regs->I2STXLT1 = frame[0];
+		regs->I2STXRT1 = frame[1];
+	}
+}
+
+/* Closes the interface opened by I2S_ringOpen() */
+static void I2S_ringRelease(void)
+{
+	if (NULL != hI2s)
+	{
+		I2S_transEnable(hI2s, FALSE);
+		I2S_close(hI2s);
+		hI2s = NULL;
+	}
+
+	i2sOpMode = I2S_POLLED;
+}
+
+/**
+ *
+ * \brief This function opens the I2S interface in interrupt mode and
+ *        hooks the ring ISRs for the requested directions
+ *
+ * \param  direction   - I2S_RING_TX and/or I2S_RING_RX
+ * \param  primeFrames - frames of silence queued for transmit before the
+ *                       TX ISR is enabled
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS I2S_ringOpen(Uint16 direction, Uint16 primeFrames)
+{
+	ioport  CSL_I2sRegs   *regs;
+	Uint16  intMask = 0;
+	Uint16  i;
+
+	if (primeFrames > (I2S_RING_TX_SIZE / 2))
+	{
+		C55x_msgWrite("I2S ring prime too long\n\r");
+		return (TEST_FAIL);
+	}
+
+	I2S_ringInit(&txRing, txRingBuf, I2S_RING_TX_SIZE);
+	I2S_ringInit(&rxRing, rxRingBuf, I2S_RING_RX_SIZE);
+
+	/* Queued while the TX ISR cannot run yet, so the first frame it sends
+	 * is the first primed one rather than an underrun */
+	for (i = 0; i < (primeFrames << 1); i++)
+	{
+		txRingBuf[i] = 0;
+	}
+	txRing.head = primeFrames << 1;
+
+	ringStats.txFrames  = 0;
+	ringStats.rxFrames  = 0;
+	ringStats.underruns = 0;
+	ringStats.overruns  = 0;
+
+	ringDirection = direction;
+
+	i2sOpMode = I2S_INTERRUPT;
+	if (initialise_i2s_interface() != 0)
+	{
+		C55x_msgWrite("I2S init for interrupt mode failed\n\r");
+		I2S_ringRelease();
+		return (TEST_FAIL);
+	}
+
+	if (direction & I2S_RING_TX)
+	{
+		IRQ_clear(I2S_RING_TX_EVENT);
+		IRQ_plug(I2S_RING_TX_EVENT, &i2sRingIsr);
+		IRQ_enable(I2S_RING_TX_EVENT);
+		intMask |= CSL_I2S_I2SINTMASK_XMITST_MASK;
+	}
+
+	if (direction & I2S_RING_RX)
+	{
+		IRQ_clear(I2S_RING_RX_EVENT);
+		IRQ_plug(I2S_RING_RX_EVENT, &i2sRingIsr);
+		IRQ_enable(I2S_RING_RX_EVENT);
+		intMask |= CSL_I2S_I2SINTMASK_RCVST_MASK;
+	}
+
+	regs = hI2s->hwRegs;
+	regs->I2SINTMASK = intMask;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Queues interleaved stereo frames for transmission
+ *
+ * \param  data   - interleaved L/R samples
+ * \param  frames - number of frames
+ *
+ * \return Number of frames queued
+ *
+ */
+Uint16 I2S_ringWriteFrames(const Int16 *data, Uint16 frames)
+{
+	Uint16 space;
+
+	/* Only whole frames, so the ISR never sees half a frame */
+	space = I2S_ringSpace(&txRing) >> 1;
+	if (frames > space)
+	{
+		frames = space;
+	}
+
+	return (I2S_ringPut(&txRing, data, frames << 1) >> 1);
+}
+
+/**
+ *
+ * \brief Fetches received interleaved stereo frames
+ *
+ * \param  data   - destination for interleaved L/R samples
+ * \param  frames - maximum number of frames
+ *
+ * \return Number of frames read
+ *
+ */
+Uint16 I2S_ringReadFrames(Int16 *data, Uint16 frames)
+{
+	Uint16 avail;
+
+	avail = I2S_ringCount(&rxRing) >> 1;
+	if (frames > avail)
+	{
+		frames = avail;
+	}
+
+	return (I2S_ringGet(&rxRing, data, frames << 1) >> 1);
+}
+
+/**
+ *
+ * \brief Returns the number of frames that can be queued for transmit
+ *
+ */
+Uint16 I2S_ringTxSpaceFrames(void)
+{
+	return (I2S_ringSpace(&txRing) >> 1);
+}
+
+/**
+ *
+ * \brief Returns the number of received frames waiting to be read
+ *
+ */
+Uint16 I2S_ringRxCountFrames(void)
+{
+	return (I2S_ringCount(&rxRing) >> 1);
+}
+
+/**
+ *
+ * \brief Disables the ring ISRs and closes the I2S interface
+ *
+ * \return void
+ *
+ */
+void I2S_ringClose(void)
+{
+	ioport  CSL_I2sRegs   *regs;
+
+	regs = hI2s->hwRegs;
+	regs->I2SINTMASK = 0;
+
+	if (ringDirection & I2S_RING_TX)
+	{
+		IRQ_disable(I2S_RING_TX_EVENT);
+	}
+	if (ringDirection & I2S_RING_RX)
+	{
+		IRQ_disable(I2S_RING_RX_EVENT);
+	}
+
+	I2S_ringRelease();
+}
+
+/**
+ *
+ * \brief Copies the ring counters
+ *
+ * \param  stats - destination
+ *
+ * \return void
+ *
+ */
+void I2S_ringGetStats(I2S_RingStats *stats)
+{
+	Bool oldIntState;
+
+	oldIntState = IRQ_globalDisable();
+	stats->txFrames  = ringStats.txFrames;
+	stats->rxFrames  = ringStats.rxFrames;
+	stats->underruns = ringStats.underruns;
+	stats->overruns  = ringStats.overruns;
+	IRQ_globalRestore(oldIntState);
+}
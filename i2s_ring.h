@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file i2s_ring.h
+*
+*   \brief Interrupt driven I2S2 mode backed by single-producer /
+*          single-consumer sample ring buffers.
+*
+*/
+
+#ifndef _I2S_RING_H_
+#define _I2S_RING_H_
+
+#include "audio_common.h"
+
+/* Ring sizes in 16-bit samples (interleaved L/R), must be a power of two */
+#define I2S_RING_TX_SIZE        (512)
+#define I2S_RING_RX_SIZE        (512)
+
+/* I2S2 transmit / receive interrupt events */
+#define I2S_RING_TX_EVENT       (PROG1_EVENT)
+#define I2S_RING_RX_EVENT       (PROG0_EVENT)
+
+/* Directions passed to I2S_ringOpen() */
+#define I2S_RING_TX             (0x1)
+#define I2S_RING_RX             (0x2)
+
+/**
+ * \brief Lock-free sample ring. 'head' is only written by the producer and
+ *        'tail' only by the consumer; both run freely and wrap at 2^16, the
+ *        fill level is their difference. The samples are volatile too, so
+ *        the compiler keeps them on their side of the index that publishes
+ *        them.
+ */
+typedef struct
+{
+	volatile Int16  *buf;
+	Uint16           mask;
+	volatile Uint16  head;
+	volatile Uint16  tail;
+} I2S_Ring;
+
+typedef struct
+{
+	Uint32 txFrames;    /* frames sent by the ISR                    */
+	Uint32 rxFrames;    /* frames stored by the ISR                  */
+	Uint32 underruns;   /* ISR found the TX ring empty               */
+	Uint32 overruns;    /* ISR found the RX ring full                */
+} I2S_RingStats;
+
+void   I2S_ringInit(I2S_Ring *ring, Int16 *buf, Uint16 size);
+Uint16 I2S_ringCount(const I2S_Ring *ring);
+Uint16 I2S_ringSpace(const I2S_Ring *ring);
+Uint16 I2S_ringPut(I2S_Ring *ring, const Int16 *data, Uint16 count);
+Uint16 I2S_ringGet(I2S_Ring *ring, Int16 *data, Uint16 count);
+
+TEST_STATUS I2S_ringOpen(Uint16 direction, Uint16 primeFrames);
+Uint16 I2S_ringWriteFrames(const Int16 *data, Uint16 frames);
+Uint16 I2S_ringReadFrames(Int16 *data, Uint16 frames);
+Uint16 I2S_ringTxSpaceFrames(void);
+Uint16 I2S_ringRxCountFrames(void);
+void I2S_ringClose(void);
+void I2S_ringGetStats(I2S_RingStats *stats);
+interrupt void i2sRingIsr(void);
+
+#endif /* _I2S_RING_H_ */
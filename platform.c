@@ -40,6 +40,11 @@
  *****************************************************************************/
 
 #include "platform_internals.h"
+#include "timebase.h"
+#include "cpu_idle.h"
+#include "uart_log.h"
+#include "uart_stream.h"
+#include "platform_uart.h"
 #include <time.h>
 
 static WRITE_info	write_type;
@@ -47,12 +52,26 @@ READ_info	read_type = PLATFORM_READ_SCANF;
 
 #define MAX_WRITE_LEN (200)
 
+/* Transmitter empty: FIFO and shift register both drained */
+#define UART_LSR_TEMT (0x40)
+
+#define UART_DEFAULT_BAUD        (115200)
+/* Largest line rate error the receiver can absorb */
+#define UART_BAUD_TOLERANCE_PCT  (2)
+
+/* Console line rate, changed by uart_setBaud() */
+static Uint32		uartBaud = UART_DEFAULT_BAUD;
+
 CSL_UartObj       uartObj;
 static char	write_buffer[MAX_WRITE_LEN];
 
 /**
  * \brief    This function used to generate time delay in milliseconds
  *
+ *           Idles on GPT1 once C55x_idleInit() has run, spins on the GPT0
+ *           timebase once C55x_timebaseInit() has run; before that the
+ *           loop below, calibrated for 100 MHz, is used.
+ *
  * \param    numOfmsec - number of milliseconds
  *
  * \return   void
@@ -63,7 +82,18 @@ void C55x_delay_msec(int numOfmsec)
 
 	while(numOfmsec)
 	{
-		for(delay = 0; delay < 6250; delay++ );
+		if (C55x_idleDelayReady())
+		{
+			C55x_idleDelayUsec(1000);
+		}
+		else if (C55x_timebaseRunning())
+		{
+			C55x_delay_usec(1000);
+		}
+		else
+		{
+			for(delay = 0; delay < 6250; delay++ );
+		}
 		numOfmsec--;
 	}
 }
@@ -82,7 +112,7 @@ void C55x_delay_msec(int numOfmsec)
 Int32 platform_uart_set_params(CSL_UartSetup *args)
 {
 	args->clkInput = 60000000;
-	args->baud     = 115200;
+	args->baud     = uartBaud;
 	args->wordLength=CSL_UART_WORD8;
 	args->stopBits=0;
 	args->parity=CSL_UART_DISABLE_PARITY;
@@ -211,6 +241,27 @@ Int32 C55x_msgWrite(const char *fmt, ...)
 		return (-1);
 	}
 
+	/* Serial console through the ring: no polling, safe from ISRs */
+	if ((write_type == PLATFORM_WRITE_UART) && UART_logActive())
+	{
+		va_start( arg_ptr, fmt );
+		length = UART_logVPrintf(fmt, arg_ptr);
+		va_end( arg_ptr );
+
+		return (CSL_SOK);
+	}
+
+	/* The UART is streaming: text goes out in frames, never between bytes
+	 * of one */
+	if ((write_type == PLATFORM_WRITE_UART) && STREAM_active())
+	{
+		va_start( arg_ptr, fmt );
+		length = STREAM_vprintf(fmt, arg_ptr);
+		va_end( arg_ptr );
+
+		return (CSL_SOK);
+	}
+
 	va_start( arg_ptr, fmt );
 	length = vsprintf( (char *)write_buffer, fmt, arg_ptr );
 	va_end( arg_ptr );
@@ -320,7 +371,7 @@ Uint32 C55x_getSysClk(void)
 	if ((PLL_CNTL4 & 0x0020) == 0)	/* OutDiv2 */
 		sysClk = sysClk / ( 2*(OD2+1));
 
-	/* Return the value of system clock in Hz */
+	/* Return the value of system clock in KHz */
 	return(sysClk);
 }
 
@@ -461,3 +512,124 @@ Platform_STATUS uart_initialisation(void)
 
 }
 
+/**
+ *
+ * \brief This function waits until the UART has sent every queued byte,
+ *        the log ring included
+ *
+ * \param    void
+ *
+ * \return   void
+ */
+void uart_drain(void)
+{
+	CSL_UartHandle    hUart;
+
+	hUart = (CSL_UartHandle)(&uartObj);
+
+	UART_logFlush();
+
+	while ((hUart->uartRegs->LSR & UART_LSR_TEMT) == 0)
+	{
+		;
+	}
+}
+
+/**
+ *
+ * \brief This function re-derives the UART divisor for a new system clock
+ *
+ * \param    sysClkKhz - system clock in KHz
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+Platform_STATUS uart_retime(Uint32 sysClkKhz)
+{
+	CSL_UartHandle    hUart;
+	CSL_UartSetup     uartSetup;
+
+	platform_uart_set_params(&uartSetup);
+
+	hUart = (CSL_UartHandle)(&uartObj);
+
+	return (UART_setupBaudRate(hUart, sysClkKhz * 1000, uartSetup.baud));
+}
+
+/**
+ *
+ * \brief This function checks that the nearest UART divisor for 'baud'
+ *        at the given system clock is within UART_BAUD_TOLERANCE_PCT
+ *
+ * \param    sysClkKhz - system clock in KHz
+ * \param    baud      - line rate
+ *
+ * \return   TRUE if the rate is usable
+ */
+static Bool uart_baudValid(Uint32 sysClkKhz, Uint32 baud)
+{
+	Uint32 clk;
+	Uint32 divisor;
+	Uint32 actual;
+	Uint32 error;
+
+	if (baud == 0)
+	{
+		return (FALSE);
+	}
+
+	clk     = sysClkKhz * 1000;
+	divisor = (clk + (8 * baud)) / (16 * baud);
+	if ((divisor == 0) || (divisor > 0xFFFF))
+	{
+		return (FALSE);
+	}
+
+	actual = clk / (16 * divisor);
+	error  = (actual > baud) ? (actual - baud) : (baud - actual);
+
+	return ((error * 100) <= (baud * UART_BAUD_TOLERANCE_PCT));
+}
+
+/**
+ *
+ * \brief This function changes the console line rate. The divisor is
+ *        derived from C55x_getSysClk() and kept across clock changes.
+ *
+ * \param    baud - line rate
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+Platform_STATUS uart_setBaud(Uint32 baud)
+{
+	Uint32 sysClk;
+
+	sysClk = C55x_getSysClk();
+	if (!uart_baudValid(sysClk, baud))
+	{
+		return (TEST_FAIL);
+	}
+
+	uart_drain();
+	uartBaud = baud;
+
+	return (uart_retime(sysClk));
+}
+
+/**
+ *
+ * \brief This function returns the console line rate
+ *
+ * \param    void
+ *
+ * \return   Line rate in baud
+ */
+Uint32 uart_getBaud(void)
+{
+	return (uartBaud);
+}
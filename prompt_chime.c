@@ -0,0 +1,309 @@
+/* Generated by tools/adpcm_encode from chime.wav, do not edit */
+
+#include "prompt_chime.h"
+
+const ADPCM_State promptChimeStart = { 0, 0 };
+
+const Uint16 promptChimeCodes[ADPCM_WORDS(PROMPT_CHIME_SAMPLES)] =
+{
+	0x7770, 0x3347, 0x2434, 0x8112, 0xCDB9, 0xBCCC, 0xACBC, 0xABBB,
+	0x88AA, 0x4220, 0x3344, 0x2434, 0x2222, 0x1121, 0x3422, 0x4446,
+	0x4353, 0x3334, 0x2224, 0xB900, 0xBDCE, 0xBBCD, 0xBBBD, 0xBABC,
+	0x098A, 0x5432, 0x4344, 0x4343, 0x2332, 0x1213, 0xA980, 0xBCCC,
+	0xCBBD, 0xBBBB, 0x9AAC, 0x888A, 0x3211, 0x3434, 0x3234, 0x2223,
+	0x1122, 0x2211, 0x4444, 0x4344, 0x2424, 0x2223, 0xA801, 0xDCCD,
+	0xCCCB, 0xCBBB, 0xACBB, 0x89A9, 0x4310, 0x3444, 0x3335, 0x2325,
+	0x2223, 0x9810, 0xBCCA, 0xBCBD, 0xBBBC, 0xBBBB, 0x89AA, 0x3118,
+	0x4344, 0x3433, 0x2232, 0x2122, 0x1111, 0x3633, 0x5345, 0x2533,
+	0x2243, 0x8011, 0xCEBA, 0xBCCC, 0xCACC, 0xBABA, 0xA9AB, 0x3108,
+	0x4454, 0x4343, 0x2343, 0x3233, 0x8111, 0xCCA9, 0xBDBC, 0xBBCB,
+	0xABAC, 0x99AA, 0x1008, 0x3432, 0x3244, 0x2333, 0x2123, 0x1211,
+	0x4422, 0x3444, 0x3435, 0x3334, 0x0132, 0xECA8, 0xBCCC, 0xCBCC,
+	0xACBB, 0x9ABB, 0x108A, 0x5352, 0x3344, 0x3244, 0x3333, 0x0213,
+	0xBB90, 0xCBCE, 0xBBBC, 0xBBBC, 0x9ABB, 0x188A, 0x3421, 0x3344,
+	0x3243, 0x1222, 0x1021, 0x3212, 0x6345, 0x4343, 0x3334, 0x2233,
+	0xCA80, 0xCCCE, 0xCCBC, 0xBACA, 0xBABB, 0x88A9, 0x5431, 0x3534,
+	0x3434, 0x4333, 0x1122, 0x9900, 0xCBDB, 0xBCBC, 0xBABC, 0xABBB,
+	0x88A9, 0x3211, 0x5335, 0x3332, 0x2333, 0x1122, 0x2221, 0x4444,
+	0x3534, 0x3434, 0x2333, 0xA812, 0xCDDC, 0xBDBC, 0xCADB, 0xABAA,
+	0x89AA, 0x3218, 0x4346, 0x3434, 0x3324, 0x2323, 0x9001, 0xDBC9,
+	0xBCBC, 0xCBBC, 0xAABA, 0x89AA, 0x2108, 0x4342, 0x3324, 0x3233,
+	0x2122, 0x2111, 0x4532, 0x4435, 0x4334, 0x2433, 0x8112, 0xCEB9,
+	0xDBCC, 0xCBCB, 0xCBBB, 0x9AAA, 0x1188, 0x5344, 0x3434, 0x4334,
+	0x2322, 0x0021, 0xCB99, 0xBCCC, 0xCBCB, 0xABAB, 0x9AAB, 0x1088,
+	0x3432, 0x2344, 0x2224, 0x1122, 0x1111, 0x4221, 0x3444, 0x4435,
+	0x2432, 0x1122, 0xDA98, 0xDBCD, 0xBCBC, 0xBBCB, 0xBBBB, 0x1899,
+	0x4542, 0x3534, 0x4343, 0x2332, 0x1122, 0xB990, 0xCBDC, 0xCBBC,
+	0xCBBB, 0x9AAA, 0x0899, 0x3221, 0x3344, 0x3324, 0x2232, 0x0121,
+	0x3212, 0x3454, 0x3535, 0x3334, 0x2224, 0xB900, 0xCCDD, 0xCCBC,
+	0xBCBB, 0xAACA, 0x8999, 0x4320, 0x3535, 0x3244, 0x2324, 0x1223,
+	0x9881, 0xCCCB, 0xBBDB, 0xCABC, 0xAAAA, 0x8999, 0x2110, 0x3443,
+	0x2433, 0x2323, 0x1112, 0x2211, 0x5352, 0x3534, 0x3344, 0x3333,
+	0x9813, 0xCCFB, 0xBCCC, 0xBBDB, 0xABCB, 0x99AB, 0x4208, 0x5363,
+	0x3343, 0x3325, 0x2232, 0x8812, 0xCCB9, 0xCBCC, 0xABCB, 0xAACB,
+	0x89A9, 0x1008, 0x3432, 0x4334, 0x3232, 0x1212, 0x1111, 0x4432,
+	0x3444, 0x4344, 0x2433, 0x0112, 0xDCA9, 0xBDBD, 0xBBCC, 0xBBBC,
+	0xABBB, 0x2089, 0x3544, 0x4435, 0x3242, 0x3232, 0x0112, 0xCB98,
+	0xDBCC, 0xBCBB, 0xCBBB, 0x99AA, 0x0089, 0x3331, 0x3435, 0x3333,
+	0x2223, 0x1112, 0x4322, 0x5345, 0x4434, 0x4333, 0x1222, 0xCB80,
+	0xDBDD, 0xBCBC, 0xBBBC, 0xAAAC, 0x089A, 0x4522, 0x3534, 0x2443,
+	0x3333, 0x1222, 0xB980, 0xCCCC, 0xCBCB, 0xBBBB, 0xABBB, 0x089A,
+	0x4320, 0x3434, 0x3324, 0x1322, 0x1212, 0x3120, 0x4444, 0x3453,
+	0x4334, 0x1332, 0xA902, 0xCDCD, 0xCBDB, 0xBBBC, 0xBBAC, 0x999A,
+	0x5220, 0x3444, 0x4244, 0x2332, 0x1323, 0x9811, 0xCCCB, 0xBCCB,
+	0xBBAC, 0x9ACB, 0x899A, 0x2100, 0x4433, 0x2433, 0x2323, 0x1112,
+	0x1211, 0x4533, 0x3444, 0x3344, 0x2324, 0x8012, 0xDDCA, 0xBCDB,
+	0xBCBC, 0xBCBB, 0x9AAA, 0x2108, 0x5345, 0x5334, 0x2423, 0x2232,
+	0x0011, 0xDBA9, 0xCCBC, 0xCBBB, 0xBBBB, 0x99BA, 0x2009, 0x4342,
+	0x3334, 0x3243, 0x1212, 0x1111, 0x5322, 0x5344, 0x3434, 0x3343,
+	0x0222, 0xECA8, 0xCBEB, 0xBCBC, 0xBBBC, 0xBABB, 0x2889, 0x4453,
+	0x4344, 0x3343, 0x2433, 0x0112, 0xBA88, 0xCCCC, 0xBCBB, 0xABAC,
+	0x9AAB, 0x0099, 0x4321, 0x4334, 0x3333, 0x2223, 0x2112, 0x4221,
+	0x4444, 0x4434, 0x2433, 0x1233, 0xCA81, 0xBDCD, 0xBCBD, 0xCBBC,
+	0xABAB, 0x099A, 0x5421, 0x3534, 0x3353, 0x2433, 0x1123, 0x9981,
+	0xBCDB, 0xBBCC, 0xBBBC, 0xBABB, 0x889A, 0x3220, 0x4435, 0x3332,
+	0x2323, 0x1212, 0x2211, 0x6344, 0x4353, 0x4343, 0x2323, 0xA811,
+	0xCDCC, 0xCBCC, 0xCBBC, 0xBBBA, 0x99AB, 0x4210, 0x3445, 0x3344,
+	0x4324, 0x2122, 0x8801, 0xBCB9, 0xBBCD, 0xBACC, 0xABBA, 0x89AA,
+	0x2108, 0x3443, 0x3343, 0x2243, 0x1121, 0x1101, 0x4432, 0x5344,
+	0x4253, 0x2232, 0x8122, 0xCEBA, 0xCCCC, 0xBBCB, 0xBBBC, 0x99AC,
+	0x2009, 0x4453, 0x5334, 0x4333, 0x3232, 0x0021, 0xDB99, 0xCBDB,
+	0xBBBC, 0xBACB, 0x9AAA, 0x1009, 0x3431, 0x3244, 0x3333, 0x2223,
+	0x1121, 0x5322, 0x4444, 0x3434, 0x3334, 0x1223, 0xDC98, 0xDBDC,
+	0xBBDB, 0xBBBC, 0xAACB, 0x0099, 0x5532, 0x3443, 0x4334, 0x3323,
+	0x0222, 0xBA80, 0xBCDC, 0xBCBC, 0xACBB, 0x9AAB, 0x0899, 0x4221,
+	0x4343, 0x3332, 0x2233, 0x1121, 0x3221, 0x4445, 0x5353, 0x3242,
+	0x2232, 0xB981, 0xCCDD, 0xCBCC, 0xBBCB, 0xBBBB, 0x88AB, 0x4520,
+	0x5344, 0x4433, 0x2332, 0x1223, 0xA801, 0xDBDA, 0xCADB, 0xBBBA,
+	0xABBB, 0x899A, 0x3210, 0x3534, 0x3343, 0x2323, 0x1122, 0x2211,
+	0x5443, 0x3534, 0x3434, 0x3333, 0x9822, 0xCCFB, 0xCDBC, 0xBBCA,
+	0xACBB, 0x99AB, 0x3208, 0x4445, 0x3443, 0x2433, 0x2323, 0x8811,
+	0xBDA9, 0xBCCC, 0xBBCB, 0xACBB, 0x999A, 0x1108, 0x4432, 0x4333,
+	0x3233, 0x2122, 0x1111, 0x4432, 0x4354, 0x3434, 0x3234, 0x8213,
+	0xCEB8, 0xCCCC, 0xCBCB, 0xBBBB, 0xAAAC, 0x1088, 0x4453, 0x4353,
+	0x4333, 0x2333, 0x0122, 0xDAA8, 0xCBDB, 0xCBBC, 0xBBBA, 0x9ABA,
+	0x1089, 0x3431, 0x4244, 0x2322, 0x2122, 0x1111, 0x4211, 0x4534,
+	0x3434, 0x4334, 0x1222, 0xCA90, 0xDBDD, 0xBBDB, 0xCBBC, 0xABAB,
+	0x198A, 0x4531, 0x4344, 0x3334, 0x3234, 0x1222, 0xA980, 0xCCCC,
+	0xBBCB, 0xBBBC, 0xBABB, 0x8899, 0x4221, 0x3434, 0x3433, 0x2222,
+	0x1112, 0x2211, 0x3444, 0x5345, 0x2433, 0x2333, 0xB801, 0xCCEC,
+	0xCBCC, 0xBBCB, 0xABAC, 0x89AA, 0x4310, 0x5345, 0x3343, 0x3334,
+	0x2232, 0x9811, 0xCCCB, 0xCCBC, 0xCBBA, 0xABAA, 0x8999, 0x2208,
+	0x3533, 0x3334, 0x3233, 0x1222, 0x2121, 0x5443, 0x3453, 0x3434,
+	0x2324, 0x8012, 0xCDCA, 0xBBDC, 0xBCBD, 0xACBB, 0x99BA, 0x2288,
+	0x5354, 0x3353, 0x3343, 0x2224, 0x0011, 0xDBA9, 0xCBDB, 0xBCBB,
+	0xAACB, 0x99AA, 0x1008, 0x5332, 0x3433, 0x2333, 0x2223, 0x1111,
+	0x4432, 0x4444, 0x3353, 0x3334, 0x1132, 0xECA9, 0xBCCC, 0xBCBD,
+	0xBBCB, 0xAABB, 0x108A, 0x5452, 0x5343, 0x3242, 0x2323, 0x0213,
+	0xBB88, 0xBCCD, 0xABCC, 0xABAC, 0xAAAA, 0x0089, 0x3321, 0x3435,
+	0x4333, 0x2122, 0x1111, 0x3211, 0x3544, 0x3435, 0x3244, 0x1232,
+	0xC991, 0xCCCD, 0xBDBC, 0xADBB, 0xABAB, 0x889A, 0x4431, 0x3354,
+	0x4335, 0x2333, 0x1233, 0xA900, 0xBCCC, 0xDBBD, 0xBBBA, 0xAABB,
+	0x88AA, 0x4211, 0x4343, 0x3243, 0x1322, 0x0212, 0x2211, 0x4543,
+	0x5353, 0x3433, 0x3333, 0xA802, 0xCDDC, 0xBDBC, 0xACBC, 0xAACB,
+	0x8A9A, 0x3200, 0x4436, 0x4334, 0x3243, 0x2223, 0x8811, 0xCDBA,
+	0xBCCB, 0xBBCB, 0xAAAC, 0x999A, 0x1100, 0x4433, 0x3433, 0x3232,
+	0x1122, 0x1211, 0x4532, 0x5344, 0x4343, 0x3333, 0x8122, 0xCDCA,
+	0xCBCD, 0xBCBC, 0xABCB, 0xAAAB, 0x2188, 0x3544, 0x4344, 0x3433,
+	0x2323, 0x0022, 0xBC99, 0xCBCD, 0xBBCB, 0xBACB, 0x99AA, 0x1089,
+	0x5332, 0x3343, 0x3333, 0x2233, 0x1121, 0x6332, 0x4453, 0x3353,
+	0x2434, 0x0222, 0xEAA0, 0xDBCC, 0xBCBC, 0xBBBC, 0xBBBB, 0x088A,
+	0x4543, 0x4344, 0x3343, 0x2433, 0x0122, 0xB980, 0xBCCC, 0xACAD,
+	0xBBBB, 0xABAB, 0x0899, 0x5321, 0x3343, 0x3234, 0x1323, 0x1212,
+	0x3211, 0x3445, 0x4345, 0x3343, 0x1224, 0xA981, 0xCDCD, 0xBCCB,
+	0xACBC, 0xABBB, 0x89AA, 0x6321, 0x4344, 0x2434, 0x2243, 0x1213,
+	0xA801, 0xBCCA, 0xBCBD, 0xBBCB, 0xABBA, 0x88AA, 0x3200, 0x4344,
+	0x4333, 0x1322, 0x1122, 0x1210, 0x4443, 0x4534, 0x3433, 0x2324,
+	0x9011, 0xCDDA, 0xBDBC, 0xBCBC, 0xACBB, 0x8AAA, 0x3108, 0x4445,
+	0x4343, 0x4333, 0x2223, 0x8011, 0xCCAA, 0xCCBC, 0xACBB, 0xABBB,
+	0x9AAA, 0x2108, 0x3533, 0x2434, 0x3233, 0x1212, 0x2111, 0x4422,
+	0x4444, 0x4343, 0x2243, 0x0113, 0xCDA9, 0xBDBD, 0xCBBD, 0xBACB,
+	0xAAAB, 0x1009, 0x3553, 0x4344, 0x3343, 0x2333, 0x0122, 0xCB98,
+	0xCBCD, 0xCBCB, 0xABBA, 0x9AAB, 0x1889, 0x3422, 0x3434, 0x2433,
+	0x2122, 0x1101, 0x3221, 0x4445, 0x3443, 0x3334, 0x1124, 0xCB80,
+	0xCCCD, 0xBCBC, 0xCBBC, 0xAABA, 0x089A, 0x4531, 0x4344, 0x3343,
+	0x3324, 0x0222, 0xAA81, 0xDBCC, 0xBBBC, 0xABAD, 0x9BAB, 0x089A,
+	0x4220, 0x3533, 0x2433, 0x1223, 0x1112, 0x2211, 0x3634, 0x3444,
+	0x2434, 0x2333, 0xA901, 0xCDCD, 0xBDBC, 0xCBCB, 0xBBAB, 0x89AA,
+	0x5310, 0x3444, 0x3335, 0x2434, 0x1222, 0x8801, 0xCBCA, 0xBBCC,
+	0xAACC, 0xAABB, 0x899A, 0x2118, 0x3353, 0x3334, 0x2224, 0x1212,
+	0x2110, 0x4532, 0x4344, 0x3434, 0x2243, 0x9112, 0xDCCA, 0xBCCC,
+	0xBCBC, 0xBBAC, 0x9AAA, 0x3109, 0x3445, 0x3435, 0x3343, 0x3333,
+	0x8012, 0xDCA9, 0xBCCB, 0xACBC, 0xBABB, 0x9AAA, 0x1188, 0x4433,
+	0x3343, 0x3333, 0x1233, 0x2112, 0x4432, 0x4535, 0x3443, 0x3433,
+	0x0122, 0xDCA8, 0xCCCC, 0xCBBC, 0xBBAC, 0xABAB, 0x1099, 0x4453,
+	0x4434, 0x3433, 0x2333, 0x0123, 0xBB88, 0xCBCE, 0xACCB, 0xBBBB,
+	0xAAAB, 0x0099, 0x5331, 0x4343, 0x3332, 0x1232, 0x1112, 0x3321,
+	0x5355, 0x3353, 0x3335, 0x2233, 0xCA80, 0xCCCE, 0xBCBC, 0xBCBC,
+	0xABBA, 0x099A, 0x5421, 0x3534, 0x3434, 0x3333, 0x1233, 0xB881,
+	0xCCCC, 0xCADB, 0xABBA, 0xABBB, 0x8999, 0x3211, 0x3435, 0x3243,
+	0x2223, 0x1122, 0x3111, 0x4453, 0x3534, 0x3434, 0x3333, 0xA811,
+	0xCDDC, 0xBCDB, 0xBADB, 0xABAC, 0x89AA, 0x4218, 0x3444, 0x3344,
+	0x3334, 0x2333, 0x9002, 0xCCCA, 0xCBDB, 0xACBB, 0xABBB, 0x99AA,
+	0x2100, 0x3443, 0x2424, 0x2232, 0x1121, 0x1111, 0x6332, 0x4344,
+	0x4434, 0x3232, 0x8022, 0xDEB9, 0xBCDB, 0xBBCC, 0xBBCB, 0xAAAB,
+	0x3009, 0x6354, 0x3533, 0x3433, 0x3333, 0x8112, 0xDBA8, 0xBCCC,
+	0xCBCB, 0xABBA, 0xA9AB, 0x1088, 0x3432, 0x3344, 0x3333, 0x2232,
+	0x1211, 0x4422, 0x5344, 0x4434, 0x2432, 0x1122, 0xDA98, 0xDBCD,
+	0xDBBC, 0xBBBB, 0x9BAC, 0x088A, 0x4442, 0x3453, 0x3343, 0x3234,
+	0x0122, 0xBA80, 0xCCCC, 0xBBCB, 0xABBC, 0xAABB, 0x0899, 0x4321,
+	0x3434, 0x4333, 0x2222, 0x1111, 0x3211, 0x4444, 0x3534, 0x3253,
+	0x2323, 0xB900, 0xBDCE, 0xCCBD, 0xBCBB, 0xBBAB, 0x899B, 0x5420,
+	0x3534, 0x3434, 0x3243, 0x1222, 0xA801, 0xCCCA, 0xBBDB, 0xACAC,
+	0xAAAA, 0x8999, 0x2110, 0x3443, 0x2433, 0x2323, 0x1112, 0x2211,
+	0x4443, 0x3444, 0x3344, 0x3333, 0x9813, 0xCCFB, 0xDBCC, 0xBCBB,
+	0xBBAC, 0x8AAA, 0x4108, 0x5344, 0x4334, 0x3243, 0x2233, 0x8011,
+	0xDCB9, 0xBCCB, 0xBBCB, 0xABAC, 0x8A9A, 0x2008, 0x3532, 0x3343,
+	0x3333, 0x1232, 0x2121, 0x4532, 0x3444, 0x5335, 0x3332, 0x8123,
+	0xCEA9, 0xCBDC, 0xBCBC, 0xABCB, 0xAABB, 0x2089, 0x3463, 0x3435,
+	0x2434, 0x2323, 0x0122, 0xCAA8, 0xDBCC, 0xBCBB, 0xCBBB, 0x99AA,
+	0x0089, 0x4331, 0x4343, 0x3323, 0x2222, 0x1121, 0x4321, 0x4444,
+	0x4434, 0x4333, 0x1222, 0xCA90, 0xDBDD, 0xBCBC, 0xBBBC, 0xAACB,
+	0x888A, 0x5432, 0x4434, 0x3343, 0x2324, 0x1222, 0xB980, 0xCBEB,
+	0xDBBC, 0xABBA, 0xAABB, 0x089A, 0x3320, 0x3435, 0x2343, 0x1323,
+	0x2112, 0x2211, 0x4444, 0x3534, 0x2353, 0x2333, 0xA902, 0xCCDD,
+	0xCBCC, 0xBBBC, 0xABAC, 0x999B, 0x4320, 0x3445, 0x3434, 0x3234,
+	0x2223, 0x9801, 0xCCCA, 0xBBDB, 0xCBBC, 0xABAA, 0x89A9, 0x3100,
+	0x4343, 0x3343, 0x2323, 0x1222, 0x2211, 0x4442, 0x3444, 0x3344,
+	0x2343, 0x8012, 0xDDCA, 0xBCDB, 0xBCBC, 0xACBB, 0x9AAB, 0x3108,
+	0x5354, 0x5334, 0x2432, 0x2232, 0x8011, 0xDBA8, 0xCCBC, 0xCBBB,
+	0xBBBB, 0x99BA, 0x2009, 0x3532, 0x3434, 0x2332, 0x1223, 0x1211,
+	0x4422, 0x3634, 0x2534, 0x2324, 0x0222, 0xDCA8, 0xCCCC, 0xBCCB,
+	0xBCBB, 0xAABA, 0x108A, 0x4452, 0x4353, 0x3343, 0x3333, 0x1123,
+	0xCA98, 0xCBDC, 0xCBCB, 0xBBBA, 0xAAAB, 0x0889, 0x5322, 0x3343,
+	0x3234, 0x1322, 0x1112, 0x3221, 0x3536, 0x4435, 0x3433, 0x1232,
+	0xCA81, 0xBDCD, 0xBCBD, 0xCBBC, 0xABAB, 0x099A, 0x4431, 0x3535,
+	0x4334, 0x3333, 0x1323, 0xA900, 0xCCCC, 0xCBCB, 0xACBB, 0xAAAB,
+	0x0999, 0x3110, 0x4434, 0x3332, 0x2323, 0x1212, 0x3211, 0x3553,
+	0x3535, 0x3434, 0x2332, 0xA812, 0xBDDC, 0xCBCD, 0xCBBC, 0xBBBA,
+	0x99AB, 0x5210, 0x4363, 0x3434, 0x3433, 0x2232, 0x8811, 0xCDBA,
+	0xBBDB, 0xBACC, 0xABBA, 0x8A9A, 0x2108, 0x3443, 0x3343, 0x3333,
+	0x1223, 0x2121, 0x4633, 0x3453, 0x4335, 0x3333, 0x0113, 0xDDCA,
+	0xDBCC, 0xBBCB, 0xBBBC, 0xAABB, 0x3009, 0x4454, 0x3353, 0x2434,
+	0x2233, 0x8112, 0xCBA8, 0xCCBD, 0xBCBB, 0xACBB, 0x99AA, 0x0088,
+	0x4332, 0x3334, 0x3234, 0x2132, 0x2111, 0x5321, 0x5344, 0x3434,
+	0x3334, 0x1223, 0xDC98, 0xDBDC, 0xBBDB, 0xBADB, 0xABAB, 0x1899,
+	0x4442, 0x4344, 0x3343, 0x2324, 0x0222, 0xB990, 0xBCCC, 0xCBBD,
+	0xBBBB, 0xABAB, 0x0899, 0x5321, 0x4343, 0x3332, 0x2233, 0x1112,
+	0x3312, 0x4445, 0x3453, 0x3343, 0x1243, 0xA981, 0xBCDD, 0xCBCD,
+	0xBCBB, 0xAAAC, 0x88AA, 0x5320, 0x5344, 0x3433, 0x3234, 0x1223,
+	0xA801, 0xCCCB, 0xBCBC, 0xBABC, 0x9AAC, 0x889A, 0x2110, 0x4343,
+	0x2433, 0x2223, 0x1212, 0x2111, 0x4443, 0x5344, 0x3343, 0x2324,
+	0x9011, 0xDCDB, 0xCBCC, 0xCBBC, 0xBBBB, 0x9ABB, 0x4218, 0x5354,
+	0x3443, 0x4333, 0x2223, 0x8812, 0xCCB9, 0xBDBC, 0xBBCB, 0xBBBB,
+	0x9AAB, 0x2108, 0x4443, 0x3242, 0x3323, 0x2122, 0x1111, 0x3532,
+	0x3445, 0x4344, 0x3333, 0x8222, 0xEDB9, 0xCDBC, 0xCBCB, 0xBBBB,
+	0xAAAC, 0x1088, 0x4453, 0x3353, 0x3325, 0x2243, 0x0021, 0xBB88,
+	0xCBCD, 0xBBBC, 0xABBC, 0xAAAB, 0x1098, 0x3422, 0x2425, 0x2323,
+	0x1223, 0x1112, 0x4321, 0x4444, 0x3434, 0x4334, 0x1222, 0xCA90,
+	0xDBDD, 0xBCCB, 0xCBAC, 0xABAA, 0x0899, 0x3531, 0x4345, 0x3334,
+	0x3234, 0x1132, 0xA980, 0xCCCC, 0xBBCB, 0xBBBC, 0xAABB, 0x089A,
+	0x3320, 0x4336, 0x3333, 0x2333, 0x2122, 0x3311, 0x4445, 0x5353,
+	0x2433, 0x2333, 0xB911, 0xCDCD, 0xCBCC, 0xBBCB, 0xABAC, 0x89AA,
+	0x4310, 0x5345, 0x3343, 0x2334, 0x2233, 0x9811, 0xCCCB, 0xCCBC,
+	0xCBBA, 0xBAAA, 0x8999, 0x2118, 0x3533, 0x3334, 0x2333, 0x2222,
+	0x2211, 0x5443, 0x3534, 0x3434, 0x2324, 0x8012, 0xCDCA, 0xBBDC,
+	0xBCBD, 0xCBBB, 0x9AAA, 0x3008, 0x5354, 0x3443, 0x3243, 0x3233,
+	0x8012, 0xCCA9, 0xBDBC, 0xCBCB, 0xBABA, 0x99AA, 0x2088, 0x4432,
+	0x3433, 0x2333, 0x2223, 0x1211, 0x4432, 0x3535, 0x4344, 0x2433,
+	0x0213, 0xDCA8, 0xBCCC, 0xBCBD, 0xBBCB, 0xAABB, 0x108A, 0x4453,
+	0x3344, 0x3335, 0x2243, 0x0113, 0xBA90, 0xBDBD, 0xCBAD, 0xBBBA,
+	0x9ABA, 0x0889, 0x4331, 0x3434, 0x4333, 0x1222, 0x1111, 0x3221,
+	0x5354, 0x3434, 0x3325, 0x2233, 0xCA80, 0xBCDD, 0xBBCD, 0xBCBC,
+	0xBABB, 0x099A, 0x5431, 0x4344, 0x4334, 0x3323, 0x1233, 0xA900,
+	0xBCCC, 0xCBBD, 0xABAC, 0xAABB, 0x0999, 0x3210, 0x3344, 0x3334,
+	0x3333, 0x1122, 0x3212, 0x4444, 0x5344, 0x3433, 0x3333, 0xA812,
+	0xCDCD, 0xBDBC, 0xACBC, 0xAACB, 0x999A, 0x3200, 0x4445, 0x3343,
+	0x2434, 0x2222, 0x9001, 0xCCB9, 0xCCBC, 0xAACA, 0xAABB, 0x89AA,
+	0x2108, 0x3533, 0x4334, 0x2232, 0x1212, 0x1111, 0x4433, 0x3535,
+	0x3344, 0x3343, 0x8022, 0xDCC9, 0xBCCC, 0xCBBD, 0xCBBB, 0x9AAA,
+	0x2009, 0x3444, 0x2535, 0x3243, 0x3233, 0x8112, 0xDBA8, 0xBDBC,
+	0xCBBC, 0xBBBA, 0x9AAA, 0x1189, 0x6332, 0x4333, 0x3333, 0x1232,
+	0x2112, 0x5322, 0x3535, 0x5344, 0x3332, 0x1223, 0xCCA0, 0xDBDD,
+	0xCBCB, 0xBBCB, 0xABAB, 0x009A, 0x3733, 0x3435, 0x3244, 0x3333,
+	0x1132, 0xBA88, 0xBCCD, 0xBBCC, 0xBACB, 0xAAAB, 0x0899, 0x4321,
+	0x3443, 0x2242, 0x2222, 0x1111, 0x3211, 0x5363, 0x3434, 0x4235,
+	0x2222, 0xB900, 0xBDCD, 0xBBCD, 0xABCC, 0xAAAC, 0x099A, 0x5310,
+	0x4344, 0x4334, 0x2433, 0x1222, 0x9901, 0xBCCA, 0xBCBD, 0xBBCB,
+	0xABBA, 0x88AA, 0x3110, 0x4335, 0x3324, 0x3232, 0x1212, 0x2211,
+	0x3543, 0x3445, 0x3353, 0x2343, 0x9011, 0xCDDB, 0xBCDB, 0xBCBC,
+	0xACBB, 0x8AAA, 0x3108, 0x4445, 0x4343, 0x4333, 0x2232, 0x8011,
+	0xCCB9, 0xCCBC, 0xCBBB, 0xABBB, 0x8AAA, 0x2188, 0x4533, 0x3242,
+	0x2332, 0x1222, 0x2111, 0x4432, 0x4444, 0x4343, 0x3243, 0x0112,
+	0xCDA9, 0xDBDC, 0xBDBB, 0xACBB, 0x9BAB, 0x2089, 0x4453, 0x2534,
+	0x3324, 0x3333, 0x0122, 0xCBA8, 0xCBCD, 0xCBCB, 0xABBA, 0x9AAB,
+	0x0089, 0x5332, 0x3343, 0x2324, 0x1223, 0x1112, 0x4231, 0x3444,
+	0x4336, 0x3343, 0x2223, 0xDB90, 0xCCCD, 0xBCBC, 0xCBBC, 0xAABA,
+	0x089A, 0x4531, 0x4344, 0x3343, 0x3324, 0x1122, 0xB900, 0xBCCC,
+	0xBBCC, 0xBABC, 0xBABB, 0x8899, 0x4221, 0x4334, 0x3243, 0x1232,
+	0x0212, 0x2212, 0x5363, 0x4434, 0x3433, 0x1224, 0xA911, 0xCDCC,
+	0xBDBC, 0xCBCB, 0xBBAB, 0x89AA, 0x4320, 0x4445, 0x3433, 0x3234,
+	0x2233, 0x9801, 0xCCCB, 0xCBDB, 0xBACA, 0xAABA, 0x899A, 0x3118,
+	0x5343, 0x3333, 0x2224, 0x1122, 0x2111, 0x5342, 0x5344, 0x3343,
+	0x3324, 0x8012, 0xDCDA, 0xBCDB, 0xBACC, 0xBBAC, 0x9AAA, 0x3109,
+	0x3445, 0x3435, 0x3343, 0x3333, 0x8021, 0xDCA9, 0xBCCB, 0xACBC,
+	0xBABB, 0x9AAA, 0x1188, 0x4433, 0x3343, 0x2243, 0x1222, 0x1111,
+	0x5321, 0x5344, 0x3443, 0x3433, 0x0222, 0xDCA8, 0xCBDC, 0xCACC,
+	0xCBBA, 0xAAAA, 0x1089, 0x4442, 0x4434, 0x3433, 0x3233, 0x0213,
+	0xCB88, 0xDBCC, 0xBBCB, 0xABCB, 0x9AAB, 0x0099, 0x5321, 0x3433,
+	0x2324, 0x1223, 0x1112, 0x3221, 0x4445, 0x4353, 0x3433, 0x1233,
+	0xCA81, 0xBCDD, 0xBCBD, 0xBCBC, 0xABBA, 0x08AA, 0x3521, 0x4436,
+	0x3433, 0x2324, 0x1223, 0xA900, 0xBCDB, 0xCBBD, 0xBCBB, 0xABAA,
+	0x0999, 0x3210, 0x3344, 0x3334, 0x2333, 0x1222, 0x3211, 0x4444,
+	0x3534, 0x3244, 0x2243, 0x9801, 0xCCEB, 0xBCDB, 0xACCB, 0xBBBB,
+	0x8AAB, 0x4318, 0x3445, 0x4335, 0x4333, 0x1232, 0x9002, 0xCCBA,
+	0xCBCC, 0xBCBB, 0xABBA, 0x99AA, 0x2100, 0x3353, 0x3434, 0x3232,
+	0x2122, 0x1111, 0x4533, 0x4363, 0x4334, 0x3243, 0x0021, 0xDDBA,
+	0xBCCC, 0xADBC, 0xACBB, 0x9AAA, 0x2088, 0x3634, 0x3344, 0x3325,
+	0x2333, 0x8113, 0xBCA8, 0xBCBE, 0xBCBC, 0xBBBA, 0xAAAB, 0x1088,
+	0x4342, 0x4343, 0x3232, 0x1222, 0x1112, 0x4331, 0x3544, 0x4344,
+	0x3433, 0x1222, 0xCC98, 0xBCDC, 0xDBBD, 0xBBBB, 0x9BAC, 0x088A,
+	0x4442, 0x4434, 0x3433, 0x2224, 0x1122, 0xB988, 0xDBCC, 0xBBCB,
+	0xBBBC, 0xAABA, 0x088A, 0x4321, 0x3434, 0x3243, 0x2222, 0x1121,
+	0x3211, 0x4444, 0x3534, 0x3334, 0x1324, 0xBA01, 0xCCDD, 0xCBDB,
+	0xBBCB, 0xBAAC, 0x88A9, 0x5320, 0x3444, 0x3434, 0x3243, 0x1222,
+	0xA801, 0xCCCA, 0xCBBC, 0xABCB, 0xBABB, 0x099A, 0x3218, 0x3534,
+	0x3243, 0x3223, 0x1212, 0x2211, 0x5443, 0x5353, 0x3433, 0x2324,
+	0x9011, 0xDCDB, 0xBDBC, 0xBBDB, 0xABCB, 0x9AAA, 0x4118, 0x5363,
+	0x3343, 0x2434, 0x2223, 0x9011, 0xCCA9, 0xCBDB, 0xBACB, 0xBBBB,
+	0x99AB, 0x2188, 0x3353, 0x3335, 0x2433, 0x1212, 0x1111, 0x6322,
+	0x5353, 0x4343, 0x2433, 0x0122, 0xCDB9, 0xCCCC, 0xACCB, 0xBACB,
+	0xA9BA, 0x2089, 0x4453, 0x4353, 0x3243, 0x2333, 0x0113, 0xCB98,
+	0xBDBD, 0xBADB, 0xAACB, 0x9A9B, 0x0089, 0x4322, 0x3253, 0x2433,
+	0x2122, 0x1111, 0x3221, 0x4445, 0x3443, 0x3334, 0x1333, 0xDB90,
+	0xBEBE, 0xBDBC, 0xBCBB, 0xBBBB, 0x089A, 0x4632, 0x3534, 0x2443,
+	0x2333, 0x0223, 0xAA81, 0xCCCC, 0xCBCB, 0xBBBB, 0xABBB, 0x089A,
+	0x5311, 0x3343, 0x3334, 0x3333, 0x1212, 0x3221, 0x6354, 0x3443,
+	0x4334, 0x2233, 0xA902, 0xCDCD, 0xDBDB, 0xBACA, 0xBABB, 0x89AB,
+	0x4410, 0x5344, 0x4343, 0x4323, 0x2122, 0x9000, 0xBDBA, 0xBCBD,
+	0xBBCB, 0xABBB, 0x99AA, 0x3200, 0x4344, 0x2433, 0x2233, 0x1222,
+	0x2111, 0x3633, 0x5345, 0x3343, 0x2324, 0x8013, 0xCDCB, 0xBDBD,
+	0xBCBC, 0xBCBB, 0x9AAA, 0x2108, 0x5345, 0x5334, 0x2432, 0x2232,
+	0x8011, 0xBCA8, 0xCCBD, 0xCBBB, 0xBBBB, 0x9AAB, 0x2008, 0x3442,
+	0x4343, 0x2332, 0x1222, 0x1211, 0x5322, 0x3444, 0x3435, 0x2334,
+	0x1133, 0xDCA9, 0xDBCD, 0xCADB, 0xBBBA, 0xABBB, 0x108A, 0x3553,
+	0x4435, 0x4333, 0x3233, 0x0222, 0xBA98, 0xBDBE, 0xCBBC, 0xACBB,
+	0x9AAA, 0x0889, 0x4321, 0x3343, 0x2334, 0x2233, 0x1211, 0x3321,
+	0x5355, 0x3353, 0x3335, 0x1333, 0xDA81, 0xCCDC, 0xCBDB, 0xBCBB,
+	0xABBB, 0x09AA, 0x4531, 0x3444, 0x2353, 0x2324, 0x1222, 0x9981,
+	0xDCBC, 0xCCBB, 0xBBBA, 0x9AAC, 0x098A, 0x2210, 0x5334, 0x3323,
+	0x3333, 0x1212, 0x3212, 0x4273, 0x3434, 0x4335, 0x2323, 0xA812,
+	0xBCFB, 0xBCBE, 0xBCBC, 0xBBBB, 0x8ABB, 0x5318, 0x3535, 0x3344,
+	0x3343, 0x2333, 0x9811, 0xBEBA, 0xBCBD, 0xBADB, 0xABBA, 0x99AA,
+	0x3100, 0x5343, 0x2433, 0x2323, 0x2122, 0x2111, 0x4532, 0x3453,
+	0x5335, 0x3232, 0x8122, 0xDCC9, 0xDBCC, 0xBBCB, 0xBBBC, 0x99AC,
+	0x2189, 0x4453, 0x3353, 0x2434, 0x2323, 0x8112, 0xCBA8, 0xCCBD,
+	0xBCBB, 0xAACB, 0xA9AA, 0x1088, 0x5332, 0x3433, 0x4333, 0x1212,
+	0x1111, 0x4312, 0x6344, 0x4343, 0x2433, 0x1123, 0xEB90, 0xCCCC,
+	0xBCCB, 0xBBCB, 0xABBB, 0x088A, 0x4543, 0x4353, 0x4324, 0x2232,
+	0x0222, 0xB990, 0xCCCC, 0xADBB, 0xCBBB, 0xA9AA, 0x0889, 0x4220,
+	0x2533, 0x3333, 0x2124, 0x1111, 0x3211, 0x3553, 0x5344, 0x4333,
+	0x2233, 0xC901, 0xBCDC, 0xCBCD, 0xBBCB, 0xBBBB, 0x89AB, 0x5421,
+	0x5344, 0x3343, 0x2343, 0x2223, 0xA800, 0xBCDA, 0xBBCC, 0xACBC,
+	0xAAAB, 0x889A, 0x3200, 0x3353, 0x2325, 0x2233, 0x1212, 0x2112,
+	0x5353, 0x5353, 0x3433, 0x3224, 0x9011, 0xDDCB, 0xBCDB, 0xCADB,
+	0xBBAA, 0x99AA, 0x3208, 0x4355, 0x3434, 0x3343, 0x3233, 0x8011,
+	0xDCBA, 0xCBDB, 0xBCBB, 0xABBB, 0x99AB, 0x2108, 0x3633, 0x3343,
+	0x2243, 0x1122, 0x1111, 0x7323, 0x3532, 0x2534, 0x2243, 0x0122,
+	0xCDA9, 0xCCCC, 0xCBCB, 0xCBBB, 0xAAAA, 0x1189, 0x4453, 0x4353
+};
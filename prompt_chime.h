@@ -0,0 +1,14 @@
+/* Generated by tools/adpcm_encode from chime.wav, do not edit */
+
+#ifndef _PROMPT_CHIME_H_
+#define _PROMPT_CHIME_H_
+
+#include "adpcm.h"
+
+#define PROMPT_CHIME_SAMPLES (9600UL)
+#define PROMPT_CHIME_RATE    (48000UL)
+
+extern const Uint16      promptChimeCodes[ADPCM_WORDS(PROMPT_CHIME_SAMPLES)];
+extern const ADPCM_State promptChimeStart;
+
+#endif /* _PROMPT_CHIME_H_ */
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file sd_card.c
+*
+*   \brief Polled sector reads from the microSD card on MMCSD0, as a block
+*          device for the WAV player.
+*
+*   SDCARD_open() runs the CSL card identification in polled mode: reset,
+*   operating conditions, CID, relative address and CSD at the slow clock,
+*   then 512 byte blocks at the transfer clock. Reads are little endian,
+*   so every 16-bit word holds two file bytes, low byte first, which is
+*   the layout WAV_BlockDevice expects.
+*
+*   Standard capacity cards are addressed in bytes, SDHC/SDXC cards in
+*   sectors; SDCARD_read() takes sectors either way.
+*
+*   A read is a polled MMC_read() of up to SDCARD_MAX_SECTORS sectors and
+*   blocks the main loop for as long as the card takes; the WAV read-ahead
+*   is what keeps the DMA fed meanwhile.
+*
+*/
+
+#include "sd_card.h"
+
+static CSL_MMCControllerObj  sdContObj;
+static CSL_MMCCardObj        sdCardObj;
+static CSL_MMCCardIdObj      sdCardIdObj;
+static CSL_MMCCardCsdObj     sdCardCsdObj;
+static CSL_MmcsdHandle       hSd;
+static SDCARD_Info           sdInfo;
+
+/* Smallest divider that keeps the card clock at or below 'maxKhz' */
+static Uint16 SDCARD_clockDiv(Uint32 maxKhz)
+{
+	Uint32 div;
+
+	div = (C55x_getSysClk() + 2 * maxKhz - 1) / (2 * maxKhz);
+	div = (div > 0) ? div - 1 : 0;
+
+	return ((div > 0xFF) ? 0xFF : (Uint16)div);
+}
+
+/**
+ *
+ * \brief Identifies the card on MMCSD0 and sets it up for sector reads
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS SDCARD_open(void)
+{
+	CSL_Status status;
+	Uint16     rca;
+
+	memset(&sdInfo, 0, sizeof(sdInfo));
+
+	/* Serial port 0 pins carry MMC/SD0 */
+	SYS_setEBSR(CSL_EBSR_FIELD_SP0MODE, CSL_EBSR_SP0MODE_0);
+
+	hSd = MMC_open(&sdContObj, CSL_MMCSD0_INST, CSL_MMCSD_OPMODE_POLLED,
+	               &status);
+	if ((hSd == NULL) || (status != CSL_SOK))
+	{
+		C55x_msgWrite("SD: MMC_open failed\n\r");
+		hSd = NULL;
+		return (TEST_FAIL);
+	}
+
+	status = MMC_sendGoIdle(hSd);
+	if (status == CSL_SOK)
+	{
+		status = MMC_selectCard(hSd, &sdCardObj);
+	}
+	if ((status != CSL_SOK) || (sdCardObj.cardType != CSL_SD_CARD))
+	{
+		C55x_msgWrite("SD: no card\n\r");
+		SDCARD_close();
+		return (TEST_FAIL);
+	}
+
+	status = MMC_sendOpCond(hSd, SDCARD_clockDiv(SDCARD_INIT_CLK_KHZ));
+	if (status == CSL_SOK)
+	{
+		status = SD_sendAllCID(hSd, &sdCardIdObj);
+	}
+	if (status == CSL_SOK)
+	{
+		status = SD_sendRca(hSd, &sdCardObj, &rca);
+	}
+	if (status == CSL_SOK)
+	{
+		status = SD_getCardCsd(hSd, &sdCardCsdObj);
+	}
+	if (status == CSL_SOK)
+	{
+		status = MMC_setCardType(&sdCardObj, CSL_SD_CARD);
+	}
+	if (status == CSL_SOK)
+	{
+		status = MMC_setCardPtr(hSd, &sdCardObj);
+	}
+	if (status == CSL_SOK)
+	{
+		status = MMC_getNumberOfBlocks(hSd, &sdInfo.sectors);
+	}
+	if (status == CSL_SOK)
+	{
+		status = MMC_sendOpCond(hSd, SDCARD_clockDiv(SDCARD_XFER_CLK_KHZ));
+	}
+	if (status == CSL_SOK)
+	{
+		status = MMC_setEndianMode(hSd, CSL_MMCSD_ENDIAN_LITTLE,
+		                           CSL_MMCSD_ENDIAN_LITTLE);
+	}
+	if (status == CSL_SOK)
+	{
+		status = MMC_setBlockLength(hSd, SDCARD_SECTOR_BYTES);
+	}
+	if (status != CSL_SOK)
+	{
+		C55x_msgWrite("SD: card set up failed (%d)\n\r", status);
+		SDCARD_close();
+		return (TEST_FAIL);
+	}
+
+	sdInfo.highCapacity = sdCardObj.sdHcDetected ? TRUE : FALSE;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief WAV_BlockDevice read from the open card
+ *
+ * \param  ctx    - unused
+ * \param  sector - first sector
+ * \param  count  - number of sectors
+ * \param  buf    - destination, SDCARD_SECTOR_BYTES / 2 words per sector
+ *
+ * \return 0 on success, -1 if the card is not open or a read failed
+ *
+ */
+Int16 SDCARD_read(void *ctx, Uint32 sector, Uint16 count, Uint16 *buf)
+{
+	Uint32 addr;
+	Uint16 chunk;
+
+	if (hSd == NULL)
+	{
+		return (-1);
+	}
+
+	while (count)
+	{
+		chunk = (count > SDCARD_MAX_SECTORS) ? SDCARD_MAX_SECTORS : count;
+		addr  = sdInfo.highCapacity ? sector : sector * SDCARD_SECTOR_BYTES;
+
+		sdInfo.reads++;
+		if (MMC_read(hSd, addr, chunk * SDCARD_SECTOR_BYTES, buf) != CSL_SOK)
+		{
+			sdInfo.readErrors++;
+			return (-1);
+		}
+
+		sector += chunk;
+		count  -= chunk;
+		buf    += chunk * (SDCARD_SECTOR_BYTES / 2);
+	}
+
+	return (0);
+}
+
+/**
+ *
+ * \brief Releases MMCSD0
+ *
+ */
+void SDCARD_close(void)
+{
+	if (hSd != NULL)
+	{
+		MMC_close(hSd);
+		hSd = NULL;
+	}
+}
+
+/**
+ *
+ * \brief Copies the card details and read counters
+ *
+ */
+void SDCARD_getInfo(SDCARD_Info *info)
+{
+	*info = sdInfo;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file sd_card.h
+*
+*   \brief Polled sector reads from the microSD card on MMCSD0, as a block
+*          device for the WAV player.
+*
+*/
+
+#ifndef _SD_CARD_H_
+#define _SD_CARD_H_
+
+#include "audio_common.h"
+#include "csl_mmcsd.h"
+
+#define SDCARD_SECTOR_BYTES     (512)
+
+/* Card clock limits: identification at up to 400 kHz, default speed
+ * transfers at up to 25 MHz. The MMCSD clock is the system clock /
+ * (2 * (div + 1)). */
+#define SDCARD_INIT_CLK_KHZ     (400)
+#define SDCARD_XFER_CLK_KHZ     (25000)
+
+/* Most sectors one SDCARD_read() call moves per MMC_read() */
+#define SDCARD_MAX_SECTORS      (8)
+
+typedef struct
+{
+	Bool    highCapacity;   /* SDHC/SDXC, addressed in sectors          */
+	Uint32  sectors;        /* card size                                */
+	Uint32  reads;          /* MMC_read() calls                         */
+	Uint32  readErrors;
+} SDCARD_Info;
+
+TEST_STATUS SDCARD_open(void);
+Int16 SDCARD_read(void *ctx, Uint32 sector, Uint16 count, Uint16 *buf);
+void SDCARD_close(void);
+void SDCARD_getInfo(SDCARD_Info *info);
+
+#endif /* _SD_CARD_H_ */
@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file shell.c
+*
+*   \brief Non-blocking line command shell with a parameter registry.
+*
+*   SHELL_service() is called from the main loop next to CMD_dispatch().
+*   It takes whatever the UART interrupt has put into the receive ring,
+*   echoes it and feeds it to SHELL_input() one character at a time, so the
+*   audio loop never waits for a key. A complete line is run by
+*   SHELL_execute():
+*
+*       help                  commands and parameters
+*       list                  every parameter with its value
+*       get <param>
+*       set <param> <value>   decimal or 0x hex, range checked; a leading
+*                             zero is still decimal
+*
+*   plus whatever the application adds with SHELL_registerCommand().
+*   Parameters are registered by the code that owns them, as get/set
+*   callbacks with a range. Setters run in the main loop.
+*
+*   Only SHELL_service() touches the UART; the parser and the registry
+*   build and run on a host as they are.
+*
+*/
+
+#include "shell.h"
+#include "uart_log.h"
+#include <stdlib.h>
+#include <ctype.h>
+#include <errno.h>
+
+static const SHELL_Param    *shellParams[SHELL_MAX_PARAMS];
+static Uint16                shellParamCount;
+static const SHELL_Command  *shellCmds[SHELL_MAX_COMMANDS];
+static Uint16                shellCmdCount;
+
+static char                  shellLine[SHELL_LINE_MAX + 1];
+static Uint16                shellLineLen;
+static Bool                  shellOverflow;
+
+static const SHELL_Param *SHELL_findParam(const char *name)
+{
+	Uint16 i;
+
+	for (i = 0; i < shellParamCount; i++)
+	{
+		if (strcmp(shellParams[i]->name, name) == 0)
+		{
+			return (shellParams[i]);
+		}
+	}
+
+	return (NULL);
+}
+
+static void SHELL_help(void)
+{
+	Uint16 i;
+
+	C55x_msgWrite("help | list | get <param> | set <param> <value>\n\r");
+
+	for (i = 0; i < shellCmdCount; i++)
+	{
+		C55x_msgWrite("%-8s %s\n\r", shellCmds[i]->name, shellCmds[i]->help);
+	}
+
+	for (i = 0; i < shellParamCount; i++)
+	{
+		C55x_msgWrite("%-8s %s [%ld..%ld]%s\n\r", shellParams[i]->name,
+		              shellParams[i]->help, shellParams[i]->min,
+		              shellParams[i]->max,
+		              (shellParams[i]->set == NULL) ? " ro" : "");
+	}
+}
+
+/**
+ *
+ * \brief Clears the registry and the line buffer
+ *
+ */
+void SHELL_init(void)
+{
+	shellParamCount = 0;
+	shellCmdCount   = 0;
+	shellLineLen    = 0;
+	shellOverflow   = FALSE;
+}
+
+/**
+ *
+ * \brief Adds a parameter; the descriptor must stay valid
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS SHELL_registerParam(const SHELL_Param *param)
+{
+	if ((shellParamCount >= SHELL_MAX_PARAMS) || (param->get == NULL) ||
+	    (SHELL_findParam(param->name) != NULL))
+	{
+		return (TEST_FAIL);
+	}
+
+	shellParams[shellParamCount++] = param;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Adds a command; the descriptor must stay valid
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS SHELL_registerCommand(const SHELL_Command *cmd)
+{
+	if ((shellCmdCount >= SHELL_MAX_COMMANDS) || (cmd->fxn == NULL))
+	{
+		return (TEST_FAIL);
+	}
+
+	shellCmds[shellCmdCount++] = cmd;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Parses a decimal or 0x prefixed hex number, with optional sign.
+ *        A leading zero does not make it octal, "010" is ten. Hex takes
+ *        any 32-bit pattern, 0xFFFFFFFF is -1; decimal must fit an Int32.
+ *
+ * \param  text  - digits
+ * \param  value - result
+ *
+ * \return TRUE if the whole string was a number
+ *
+ */
+Bool SHELL_parseInt(const char *text, Int32 *value)
+{
+	const char    *digits;
+	char          *end;
+	Bool           negative = FALSE;
+	unsigned long  magnitude;
+
+	if (text == NULL)
+	{
+		return (FALSE);
+	}
+
+	digits = text;
+	if ((*digits == '-') || (*digits == '+'))
+	{
+		negative = (*digits == '-');
+		digits++;
+	}
+
+	errno = 0;
+	if ((digits[0] == '0') && ((digits[1] == 'x') || (digits[1] == 'X')))
+	{
+		digits += 2;
+		if (!isxdigit((unsigned char)*digits))
+		{
+			return (FALSE);
+		}
+		magnitude = strtoul(digits, &end, 16);
+		if ((errno != 0) || (magnitude > 0xFFFFFFFFUL))
+		{
+			return (FALSE);
+		}
+	}
+	else
+	{
+		if (!isdigit((unsigned char)*digits))
+		{
+			return (FALSE);
+		}
+		magnitude = strtoul(digits, &end, 10);
+		if ((errno != 0) ||
+		    (magnitude > (negative ? 0x80000000UL : 0x7FFFFFFFUL)))
+		{
+			return (FALSE);
+		}
+	}
+
+	if (*end != '\0')
+	{
+		return (FALSE);
+	}
+
+	*value = (Int32)(Uint32)magnitude;
+	if (negative)
+	{
+		*value = (Int32)(0 - (Uint32)magnitude);
+	}
+
+	return (TRUE);
+}
+
+/**
+ *
+ * \brief Runs one command line. The line is split in place.
+ *
+ * \param  line - command text without the line end
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS SHELL_execute(char *line)
+{
+	char              *argv[SHELL_MAX_ARGS];
+	Uint16             argc = 0;
+	Uint16             i;
+	Int32              value;
+	const SHELL_Param *param;
+
+	/* Split on blanks */
+	while (*line != '\0')
+	{
+		while ((*line == ' ') || (*line == '\t'))
+		{
+			*line++ = '\0';
+		}
+		if (*line == '\0')
+		{
+			break;
+		}
+		if (argc >= SHELL_MAX_ARGS)
+		{
+			C55x_msgWrite("Too many arguments\n\r");
+			return (TEST_FAIL);
+		}
+		argv[argc++] = line;
+		while ((*line != '\0') && (*line != ' ') && (*line != '\t'))
+		{
+			line++;
+		}
+	}
+
+	if (argc == 0)
+	{
+		return (TEST_PASS);
+	}
+
+	if (strcmp(argv[0], "help") == 0)
+	{
+		SHELL_help();
+		return (TEST_PASS);
+	}
+
+	if (strcmp(argv[0], "list") == 0)
+	{
+		for (i = 0; i < shellParamCount; i++)
+		{
+			C55x_msgWrite("%-8s %ld\n\r", shellParams[i]->name,
+			              shellParams[i]->get());
+		}
+		return (TEST_PASS);
+	}
+
+	if ((strcmp(argv[0], "get") == 0) || (strcmp(argv[0], "set") == 0))
+	{
+		param = (argc > 1) ? SHELL_findParam(argv[1]) : NULL;
+		if (param == NULL)
+		{
+			C55x_msgWrite("Unknown parameter\n\r");
+			return (TEST_FAIL);
+		}
+
+		if (argv[0][0] == 's')
+		{
+			if ((argc != 3) || !SHELL_parseInt(argv[2], &value))
+			{
+				C55x_msgWrite("Usage: set <param> <value>\n\r");
+				return (TEST_FAIL);
+			}
+			if (param->set == NULL)
+			{
+				C55x_msgWrite("%s is read-only\n\r", param->name);
+				return (TEST_FAIL);
+			}
+			if ((value < param->min) || (value > param->max))
+			{
+				C55x_msgWrite("%s range %ld..%ld\n\r", param->name,
+				              param->min, param->max);
+				return (TEST_FAIL);
+			}
+			if (param->set(value) != TEST_PASS)
+			{
+				C55x_msgWrite("%s: set failed\n\r", param->name);
+				return (TEST_FAIL);
+			}
+		}
+
+		C55x_msgWrite("%s = %ld\n\r", param->name, param->get());
+		return (TEST_PASS);
+	}
+
+	for (i = 0; i < shellCmdCount; i++)
+	{
+		if (strcmp(argv[0], shellCmds[i]->name) == 0)
+		{
+			return (shellCmds[i]->fxn(argc, argv));
+		}
+	}
+
+	C55x_msgWrite("Unknown command, try help\n\r");
+
+	return (TEST_FAIL);
+}
+
+/**
+ *
+ * \brief Feeds one received character to the line editor. CR or LF runs
+ *        the line, backspace and DEL erase, ESC drops the line.
+ *
+ * \param  c - character
+ *
+ */
+void SHELL_input(char c)
+{
+	c &= 0xFF;
+
+	if ((c == '\r') || (c == '\n'))
+	{
+		if (shellOverflow)
+		{
+			C55x_msgWrite("Line too long\n\r");
+		}
+		else if (shellLineLen != 0)
+		{
+			shellLine[shellLineLen] = '\0';
+			SHELL_execute(shellLine);
+		}
+		shellLineLen  = 0;
+		shellOverflow = FALSE;
+		return;
+	}
+
+	if ((c == 0x08) || (c == 0x7F))
+	{
+		if (shellLineLen != 0)
+		{
+			shellLineLen--;
+		}
+		return;
+	}
+
+	if (c == 0x1B)
+	{
+		shellLineLen  = 0;
+		shellOverflow = FALSE;
+		return;
+	}
+
+	if ((c < ' ') || (c > '~'))
+	{
+		return;
+	}
+
+	if (shellLineLen >= SHELL_LINE_MAX)
+	{
+		shellOverflow = TRUE;
+		return;
+	}
+
+	shellLine[shellLineLen++] = c;
+}
+
+/**
+ *
+ * \brief Handles the characters received since the last call, never
+ *        waits. Called from the main loop.
+ *
+ * \return Number of characters handled
+ *
+ */
+Uint16 SHELL_service(void)
+{
+	Uint16 count = 0;
+	char   c;
+
+	while (UART_logReadChar(&c))
+	{
+		/* Echo, with a full line end for the terminal */
+		if (c == '\r')
+		{
+			C55x_msgWrite("\n\r");
+		}
+		else if ((c == 0x08) || (c == 0x7F))
+		{
+			C55x_msgWrite("\b \b");
+		}
+		else
+		{
+			C55x_msgWrite("%c", c);
+		}
+
+		SHELL_input(c);
+		count++;
+	}
+
+	return (count);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file shell.h
+*
+*   \brief Non-blocking line command shell with a parameter registry.
+*
+*/
+
+#ifndef _SHELL_H_
+#define _SHELL_H_
+
+#include "platform_internals.h"
+
+#define SHELL_LINE_MAX          (48)
+#define SHELL_MAX_ARGS          (4)
+#define SHELL_MAX_PARAMS        (12)
+#define SHELL_MAX_COMMANDS      (8)
+
+typedef Int32 (*SHELL_GetFxn)(void);
+typedef TEST_STATUS (*SHELL_SetFxn)(Int32 value);
+typedef TEST_STATUS (*SHELL_CmdFxn)(Uint16 argc, char *argv[]);
+
+typedef struct
+{
+	const char    *name;
+	const char    *help;
+	Int32          min;
+	Int32          max;
+	SHELL_GetFxn   get;
+	SHELL_SetFxn   set;        /* NULL for a read-only parameter */
+} SHELL_Param;
+
+typedef struct
+{
+	const char    *name;
+	const char    *help;
+	SHELL_CmdFxn   fxn;
+} SHELL_Command;
+
+void SHELL_init(void);
+TEST_STATUS SHELL_registerParam(const SHELL_Param *param);
+TEST_STATUS SHELL_registerCommand(const SHELL_Command *cmd);
+void SHELL_input(char c);
+TEST_STATUS SHELL_execute(char *line);
+Uint16 SHELL_service(void);
+Bool SHELL_parseInt(const char *text, Int32 *value);
+
+#endif /* _SHELL_H_ */
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file synth_voice.c
+*
+*   \brief Polyphonic voice engine: DDS oscillator, ADSR envelope and pan
+*          per voice, mixed into one stereo block per call.
+*
+*   Each active voice renders its oscillator into a scratch block, applies
+*   the envelope per sample and adds the panned result into 32-bit left
+*   and right accumulators. The accumulators are saturated to Q15 once at
+*   the end of the block, so the mix never wraps however many voices
+*   overlap.
+*
+*   The per-block CPU budget is expressed as the number of voices allowed
+*   to sound at once. A note-on that would exceed it takes over the
+*   quietest voice instead, so the cost of SYNTH_render() is bounded by
+*   voiceBudget oscillator+envelope passes per block. The cycles each
+*   block really took are kept in the stats.
+*
+*   Note handles carry the voice number in the low bits and a generation
+*   count above it. Once a voice has been stolen the old handle no longer
+*   matches, so a late note-off cannot cut the note that took it over.
+*
+*/
+
+#include "synth_voice.h"
+#include "dsp_kernels.h"
+#include "timebase.h"
+
+#define SYNTH_ENV_MAX       (0x7FFFFFFFL)
+
+/* Handle = generation << SYNTH_VOICE_BITS | voice, kept positive */
+#define SYNTH_VOICE_BITS    (4)
+#define SYNTH_VOICE_MASK    ((1 << SYNTH_VOICE_BITS) - 1)
+#define SYNTH_GEN_MASK      (0x7FFF >> SYNTH_VOICE_BITS)
+
+typedef enum
+{
+	SYNTH_ENV_IDLE = 0,
+	SYNTH_ENV_ATTACK,
+	SYNTH_ENV_DECAY,
+	SYNTH_ENV_SUSTAIN,
+	SYNTH_ENV_RELEASE
+} SYNTH_EnvStage;
+
+typedef struct
+{
+	DDS_Osc         osc;
+	SYNTH_EnvStage  stage;
+	Int32           level;        /* envelope, Q31              */
+	Int32           attackInc;
+	Int32           decayDec;
+	Int32           sustainLevel;
+	Int32           releaseDec;
+	Int16           gainLeft;     /* Q15 pan gains              */
+	Int16           gainRight;
+	Uint16          generation;   /* bumped by every note-on    */
+	Uint32          freqHz;       /* kept for a rate change     */
+	SYNTH_Adsr      adsr;
+} SYNTH_Voice;
+
+static SYNTH_Voice  synthVoices[SYNTH_MAX_VOICES];
+static Uint32       synthSampleRate;
+static SYNTH_Stats  synthStats;
+
+static Int16  synthScratch[SYNTH_MAX_BLOCK];
+static Int32  synthAccLeft[SYNTH_MAX_BLOCK];
+static Int32  synthAccRight[SYNTH_MAX_BLOCK];
+
+/* Per-sample envelope step to cover 'range' in 'ms' milliseconds */
+static Int32 SYNTH_envStep(Int32 range, Uint16 ms)
+{
+	Uint32 samples;
+
+	/* ms * fs / 1000 in two parts, the product alone overflows 32 bits
+	 * from 65535 ms at 65.5 kHz */
+	samples = ((Uint32)ms * (synthSampleRate / 1000)) +
+	          (((Uint32)ms * (synthSampleRate % 1000)) / 1000);
+	if (samples == 0)
+	{
+		return (range);
+	}
+
+	return ((Int32)((Uint32)range / samples));
+}
+
+/* Envelope steps of the voice at the current rate */
+static void SYNTH_envSteps(SYNTH_Voice *voice)
+{
+	voice->attackInc  = SYNTH_envStep(SYNTH_ENV_MAX, voice->adsr.attackMs);
+	voice->decayDec   = SYNTH_envStep(SYNTH_ENV_MAX - voice->sustainLevel,
+	                                  voice->adsr.decayMs);
+	voice->releaseDec = SYNTH_envStep(SYNTH_ENV_MAX, voice->adsr.releaseMs);
+}
+
+/**
+ *
+ * \brief Initializes the engine with all voices silent
+ *
+ * \param  sampleRate  - output sample rate in Hz
+ * \param  voiceBudget - voices that may sound at once, 1 to SYNTH_MAX_VOICES
+ *
+ * \return void
+ *
+ */
+void SYNTH_init(Uint32 sampleRate, Uint16 voiceBudget)
+{
+	if ((voiceBudget == 0) || (voiceBudget > SYNTH_MAX_VOICES))
+	{
+		voiceBudget = SYNTH_MAX_VOICES;
+	}
+
+	synthSampleRate = sampleRate;
+
+	memset(synthVoices, 0, sizeof(synthVoices));
+	memset(&synthStats, 0, sizeof(synthStats));
+	synthStats.voiceBudget = voiceBudget;
+}
+
+/**
+ *
+ * \brief Starts a note
+ *
+ * \param  freqHz   - oscillator frequency
+ * \param  velocity - Q15 peak amplitude
+ * \param  pan      - Q15 pan position, SYNTH_PAN_LEFT to SYNTH_PAN_RIGHT
+ * \param  adsr     - envelope
+ *
+ * \return Note handle to pass to SYNTH_noteOff()
+ *
+ */
+Int16 SYNTH_noteOn(Uint32 freqHz, Int16 velocity, Int16 pan,
+                   const SYNTH_Adsr *adsr)
+{
+	SYNTH_Voice *voice;
+	Int16        slot = -1;
+	Int16        quietest = 0;
+	Uint16       active = 0;
+	Uint16       i;
+
+	for (i = 0; i < SYNTH_MAX_VOICES; i++)
+	{
+		if (synthVoices[i].stage == SYNTH_ENV_IDLE)
+		{
+			if (slot < 0)
+			{
+				slot = i;
+			}
+		}
+		else
+		{
+			active++;
+			if (synthVoices[i].level < synthVoices[quietest].level ||
+			    synthVoices[quietest].stage == SYNTH_ENV_IDLE)
+			{
+				quietest = i;
+			}
+		}
+	}
+
+	/* Out of voices or out of budget: take over the quietest one */
+	if ((slot < 0) || (active >= synthStats.voiceBudget))
+	{
+		slot = quietest;
+		synthStats.voicesStolen++;
+	}
+
+	voice = &synthVoices[slot];
+
+	DDS_init(&voice->osc, freqHz, synthSampleRate, velocity);
+
+	voice->freqHz       = freqHz;
+	voice->adsr         = *adsr;
+	voice->level        = 0;
+	voice->sustainLevel = (Int32)adsr->sustain << 16;
+	SYNTH_envSteps(voice);
+	voice->gainRight    = pan;
+	voice->gainLeft     = 0x7FFF - pan;
+	voice->stage        = SYNTH_ENV_ATTACK;
+	voice->generation   = (voice->generation + 1) & SYNTH_GEN_MASK;
+
+	return ((Int16)((voice->generation << SYNTH_VOICE_BITS) | slot));
+}
+
+/**
+ *
+ * \brief Changes the output sample rate. Sounding voices keep their pitch
+ *        and envelope times; those at or above the new Nyquist frequency
+ *        are cut.
+ *
+ * \param  sampleRate  - output sample rate in Hz
+ *
+ * \return void
+ *
+ */
+void SYNTH_setSampleRate(Uint32 sampleRate)
+{
+	SYNTH_Voice *voice;
+	Uint16       i;
+
+	synthSampleRate = sampleRate;
+
+	for (i = 0; i < SYNTH_MAX_VOICES; i++)
+	{
+		voice = &synthVoices[i];
+		if (voice->stage == SYNTH_ENV_IDLE)
+		{
+			continue;
+		}
+
+		if (voice->freqHz >= (sampleRate / 2))
+		{
+			voice->stage = SYNTH_ENV_IDLE;
+			voice->level = 0;
+			continue;
+		}
+
+		DDS_setFreq(&voice->osc, voice->freqHz, sampleRate);
+		SYNTH_envSteps(voice);
+	}
+}
+
+/**
+ *
+ * \brief Moves a note into its release stage. Nothing happens if its
+ *        voice has since been given to another note.
+ *
+ * \param  note - handle returned by SYNTH_noteOn()
+ *
+ * \return void
+ *
+ */
+void SYNTH_noteOff(Int16 note)
+{
+	SYNTH_Voice *voice;
+
+	if (note < 0)
+	{
+		return;
+	}
+
+	voice = &synthVoices[note & SYNTH_VOICE_MASK];
+	if ((voice->generation == ((Uint16)note >> SYNTH_VOICE_BITS)) &&
+	    (voice->stage != SYNTH_ENV_IDLE))
+	{
+		voice->stage = SYNTH_ENV_RELEASE;
+	}
+}
+
+/**
+ *
+ * \brief Releases every sounding voice
+ *
+ */
+void SYNTH_allOff(void)
+{
+	Uint16 i;
+
+	for (i = 0; i < SYNTH_MAX_VOICES; i++)
+	{
+		if (synthVoices[i].stage != SYNTH_ENV_IDLE)
+		{
+			synthVoices[i].stage = SYNTH_ENV_RELEASE;
+		}
+	}
+}
+
+/* Advances the envelope by one sample and returns it in Q15 */
+static Int16 SYNTH_envNext(SYNTH_Voice *voice)
+{
+	switch (voice->stage)
+	{
+		case SYNTH_ENV_ATTACK:
+			if (voice->level >= SYNTH_ENV_MAX - voice->attackInc)
+			{
+				voice->level = SYNTH_ENV_MAX;
+				voice->stage = SYNTH_ENV_DECAY;
+			}
+			else
+			{
+				voice->level += voice->attackInc;
+			}
+		break;
+
+		case SYNTH_ENV_DECAY:
+			if (voice->level <= voice->sustainLevel + voice->decayDec)
+			{
+				voice->level = voice->sustainLevel;
+				voice->stage = SYNTH_ENV_SUSTAIN;
+			}
+			else
+			{
+				voice->level -= voice->decayDec;
+			}
+		break;
+
+		case SYNTH_ENV_RELEASE:
+			if (voice->level <= voice->releaseDec)
+			{
+				voice->level = 0;
+				voice->stage = SYNTH_ENV_IDLE;
+			}
+			else
+			{
+				voice->level -= voice->releaseDec;
+			}
+		break;
+
+		default:
+		break;
+	}
+
+	return ((Int16)(voice->level >> 16));
+}
+
+/**
+ *
+ * \brief Mixes all sounding voices into one stereo block
+ *
+ * \param  left   - left channel output
+ * \param  right  - right channel output
+ * \param  frames - number of frames, at most SYNTH_MAX_BLOCK
+ *
+ * \return void
+ *
+ */
+void SYNTH_render(Int16 *left, Int16 *right, Uint16 frames)
+{
+	SYNTH_Voice *voice;
+	Int16        sample;
+	Uint16       active = 0;
+	Uint16       i;
+	Uint16       n;
+	Uint32       start;
+
+	start = C55x_nowCycles();
+
+	if (frames > SYNTH_MAX_BLOCK)
+	{
+		frames = SYNTH_MAX_BLOCK;
+	}
+
+	memset(synthAccLeft, 0, frames * sizeof(Int32));
+	memset(synthAccRight, 0, frames * sizeof(Int32));
+
+	for (i = 0; i < SYNTH_MAX_VOICES; i++)
+	{
+		voice = &synthVoices[i];
+		if (voice->stage == SYNTH_ENV_IDLE)
+		{
+			continue;
+		}
+
+		active++;
+		DDS_generate(&voice->osc, synthScratch, frames);
+
+		for (n = 0; n < frames; n++)
+		{
+			sample = (Int16)(((Int32)synthScratch[n] * SYNTH_envNext(voice)) >> 15);
+
+			/* Q15 products, 16 voices stay well inside 32 bits */
+			synthAccLeft[n]  += ((Int32)sample * voice->gainLeft) >> 15;
+			synthAccRight[n] += ((Int32)sample * voice->gainRight) >> 15;
+		}
+	}
+
+	for (n = 0; n < frames; n++)
+	{
+		left[n]  = DSP_sat16(synthAccLeft[n]);
+		right[n] = DSP_sat16(synthAccRight[n]);
+	}
+
+	synthStats.blocks++;
+	synthStats.activeVoices = active;
+	synthStats.voiceBlocks += active;
+	if (active > synthStats.peakVoices)
+	{
+		synthStats.peakVoices = active;
+	}
+
+	synthStats.lastCycles = C55x_nowCycles() - start;
+	if (synthStats.lastCycles > synthStats.worstCycles)
+	{
+		synthStats.worstCycles = synthStats.lastCycles;
+	}
+}
+
+/**
+ *
+ * \brief I2S_DmaFillFxn compatible wrapper around SYNTH_render()
+ *
+ */
+void SYNTH_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg)
+{
+	SYNTH_render(left, right, frames);
+}
+
+/**
+ *
+ * \brief Copies the engine counters
+ *
+ */
+void SYNTH_getStats(SYNTH_Stats *stats)
+{
+	*stats = synthStats;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file synth_voice.h
+*
+*   \brief Polyphonic voice engine: DDS oscillator, ADSR envelope and pan
+*          per voice, mixed into one stereo block per call.
+*
+*/
+
+#ifndef _SYNTH_VOICE_H_
+#define _SYNTH_VOICE_H_
+
+#include "audio_common.h"
+#include "dds_osc.h"
+
+#define SYNTH_MAX_VOICES    (16)
+#define SYNTH_MAX_BLOCK     (64)
+
+/* Pan positions, Q15 */
+#define SYNTH_PAN_LEFT      (0)
+#define SYNTH_PAN_CENTER    (0x4000)
+#define SYNTH_PAN_RIGHT     (0x7FFF)
+
+typedef struct
+{
+	Uint16  attackMs;
+	Uint16  decayMs;
+	Int16   sustain;      /* Q15 sustain level */
+	Uint16  releaseMs;
+} SYNTH_Adsr;
+
+typedef struct
+{
+	Uint32  blocks;         /* blocks rendered                              */
+	Uint16  voiceBudget;    /* voices that may sound at once                */
+	Uint16  activeVoices;   /* voices rendered in the last block            */
+	Uint16  peakVoices;     /* most voices rendered in one block            */
+	Uint32  voiceBlocks;    /* sum of voices rendered over all blocks       */
+	Uint32  voicesStolen;   /* note-ons that had to take over a live voice  */
+	Uint32  lastCycles;     /* SYNTH_render() cycles for the last block     */
+	Uint32  worstCycles;    /* most SYNTH_render() cycles for one block     */
+} SYNTH_Stats;
+
+void  SYNTH_init(Uint32 sampleRate, Uint16 voiceBudget);
+void  SYNTH_setSampleRate(Uint32 sampleRate);
+Int16 SYNTH_noteOn(Uint32 freqHz, Int16 velocity, Int16 pan,
+                   const SYNTH_Adsr *adsr);
+void  SYNTH_noteOff(Int16 note);
+void  SYNTH_allOff(void);
+void  SYNTH_render(Int16 *left, Int16 *right, Uint16 frames);
+void  SYNTH_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg);
+void  SYNTH_getStats(SYNTH_Stats *stats);
+
+#endif /* _SYNTH_VOICE_H_ */
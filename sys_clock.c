@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file sys_clock.c
+*
+*   \brief Run time system clock (PLL) changes with peripheral re-timing.
+*
+*   C55x_pllSearch() finds the PLL settings closest to a requested clock
+*   for the chip selected at build time, the inverse of C55x_getSysClk():
+*
+*   C5504/05/14/15/35/45:
+*       sysClk = CLKIN / (RD + 4) * (M + 4) / (OD + 1)
+*       RD is bypassed for a 32 kHz CLKIN, OD only when OUTDIVEN is set.
+*       The reference after RD has to be 30 - 170 kHz and the PLL output
+*       60 - 120 MHz.
+*
+*   C5517:
+*       sysClk = 12 MHz / (RD + 1) * (1 + N / 256) / (OD + 1)
+*       with the second output divider bypassed.
+*
+*   C55x_setSysClk() runs the system from CLKIN while the PLL is
+*   reprogrammed, waits for lock and switches back. Neither PLL has a lock
+*   flag, so lock is waited for on the GPT0 timebase, which runs through
+*   the change and is re-scaled before anything else. Registered notifiers
+*   are then called to re-derive their dividers;
+*   C55x_clkRegisterDefaultNotifiers() registers the I2C and the UART.
+*
+*/
+
+#include "sys_clock.h"
+#include "timebase.h"
+#include "i2c_clock.h"
+#include "platform_uart.h"
+
+#if (defined(CHIP_C5505_C5515) || defined(CHIP_C5504_C5514) || defined(CHIP_C5535) || defined(CHIP_C5545))
+
+#define C55X_PLL_M_MAX          (0x0FFF)
+#define C55X_PLL_RD_MAX         (0x3F)
+#define C55X_PLL_OD_MAX         (0x3F)
+#define C55X_PLL_REF_MIN_HZ     (30000)
+#define C55X_PLL_REF_MAX_HZ     (170000)
+#define C55X_PLL_OUT_MIN_HZ     (60000000)
+#define C55X_PLL_OUT_MAX_HZ     (120000000)
+
+#define C55X_CGCR1_CLR_CNTL     (0x8000)
+#define C55X_CGCR2_RDBYPASS     (0x8000)
+#define C55X_CGCR3_INIT         (0x0806)
+#define C55X_CGCR4_OUTDIVEN     (0x0200)
+
+#elif (defined(CHIP_C5517))
+
+#define C55X_PLL_CLKIN_HZ       (12000000)
+#define C55X_PLL_RD_MAX         (0x3F)
+#define C55X_PLL_OD_MAX         (0x7)
+#define C55X_PLL_N_MAX          (0x1FFFF)
+#define C55X_PLL_OUT_MIN_HZ     (60000000)
+#define C55X_PLL_OUT_MAX_HZ     (200000000)
+
+#define C55X_PLL_CNTL3_BYPASS   (0x8000)
+#define C55X_PLL_CNTL4_OUTDIV2  (0x0020)    /* 1 bypasses the /2(OD2+1) */
+
+#endif
+
+static C55x_ClkNotifyFxn clkNotifiers[C55X_CLK_MAX_NOTIFIERS];
+static Uint16            clkNotifierCount;
+
+/* Calls every notifier for 'event' */
+static void C55x_clkNotify(Uint16 event, Uint32 sysClkKhz)
+{
+	Uint16 i;
+
+	for (i = 0; i < clkNotifierCount; i++)
+	{
+		clkNotifiers[i](event, sysClkKhz);
+	}
+}
+
+/**
+ *
+ * \brief Finds the PLL settings giving the clock closest to 'targetKhz'
+ *
+ * \param  clkInHz   - PLL input clock (CSL_PLL_CLOCKIN)
+ * \param  targetKhz - requested system clock
+ * \param  params    - returns the register values and resulting clock
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - No valid setting, or chip not supported
+ *
+ */
+TEST_STATUS C55x_pllSearch(Uint32 clkInHz, Uint32 targetKhz,
+                           C55x_PllParams *params)
+{
+#if (defined(CHIP_C5505_C5515) || defined(CHIP_C5504_C5514) || defined(CHIP_C5535) || defined(CHIP_C5545))
+	Uint32 targetHz;
+	Uint32 refHz;
+	Uint32 outHz;
+	Uint32 sysHz;
+	Uint32 err;
+	Uint32 bestErr = 0xFFFFFFFF;
+	Uint32 m;
+	Uint16 rd;
+	Uint16 rdFirst;
+	Uint16 rdLast;
+	Uint16 od;
+
+	targetHz = targetKhz * 1000;
+
+	/* A low CLKIN goes straight in (RD bypassed, flagged as RD_MAX + 1) */
+	if (clkInHz <= C55X_PLL_REF_MAX_HZ)
+	{
+		rdFirst = C55X_PLL_RD_MAX + 1;
+		rdLast  = C55X_PLL_RD_MAX + 1;
+	}
+	else
+	{
+		rdFirst = 0;
+		rdLast  = C55X_PLL_RD_MAX;
+	}
+
+	for (rd = rdFirst; rd <= rdLast; rd++)
+	{
+		refHz = (rd > C55X_PLL_RD_MAX) ? clkInHz : clkInHz / (rd + 4);
+		if ((refHz < C55X_PLL_REF_MIN_HZ) || (refHz > C55X_PLL_REF_MAX_HZ))
+		{
+			continue;
+		}
+
+		for (od = 0; od <= C55X_PLL_OD_MAX; od++)
+		{
+			/* Nearest multiplier for this divider */
+			m = (targetHz / refHz) * (od + 1) +
+			    (((targetHz % refHz) * (od + 1) + refHz / 2) / refHz);
+			if ((m < 4) || ((m - 4) > C55X_PLL_M_MAX))
+			{
+				continue;
+			}
+
+			outHz = refHz * m;
+			if ((outHz < C55X_PLL_OUT_MIN_HZ) ||
+			    (outHz > C55X_PLL_OUT_MAX_HZ))
+			{
+				continue;
+			}
+
+			sysHz = outHz / (od + 1);
+			err   = (sysHz > targetHz) ? (sysHz - targetHz) :
+			                             (targetHz - sysHz);
+			if (err < bestErr)
+			{
+				bestErr = err;
+
+				params->reg[0] = C55X_CGCR1_CLR_CNTL | (Uint16)(m - 4);
+				params->reg[1] = (rd > C55X_PLL_RD_MAX) ?
+				                 C55X_CGCR2_RDBYPASS : rd;
+				params->reg[2] = C55X_CGCR3_INIT;
+				params->reg[3] = (od == 0) ? 0 :
+				                 (C55X_CGCR4_OUTDIVEN | od);
+				params->sysClkKhz = sysHz / 1000;
+			}
+		}
+	}
+
+	return ((bestErr != 0xFFFFFFFF) ? TEST_PASS : TEST_FAIL);
+
+#elif (defined(CHIP_C5517))
+	Uint32 targetHz;
+	Uint32 refHz;
+	Uint32 outHz;
+	Uint32 sysHz;
+	Uint32 err;
+	Uint32 bestErr = 0xFFFFFFFF;
+	Uint32 n;
+	Uint16 rd;
+	Uint16 od;
+
+	targetHz = targetKhz * 1000;
+	clkInHz  = C55X_PLL_CLKIN_HZ;
+
+	for (rd = 0; rd <= C55X_PLL_RD_MAX; rd++)
+	{
+		refHz = clkInHz / (rd + 1);
+
+		for (od = 0; od <= C55X_PLL_OD_MAX; od++)
+		{
+			/* Multiplier 1 + N/256 for an output of target * (OD + 1) */
+			outHz = targetHz * (od + 1);
+			if ((outHz < C55X_PLL_OUT_MIN_HZ) ||
+			    (outHz > C55X_PLL_OUT_MAX_HZ) || (outHz < refHz))
+			{
+				continue;
+			}
+
+			n = ((outHz - refHz) / refHz) * 256 +
+			    ((((outHz - refHz) % refHz) * 256 + refHz / 2) / refHz);
+			if (n > C55X_PLL_N_MAX)
+			{
+				continue;
+			}
+
+			outHz = refHz + (Uint32)(((unsigned long long)refHz * n) / 256);
+			sysHz = outHz / (od + 1);
+			err   = (sysHz > targetHz) ? (sysHz - targetHz) :
+			                             (targetHz - sysHz);
+			if (err < bestErr)
+			{
+				bestErr = err;
+
+				params->reg[0] = (Uint16)(n & 0xFFFF);
+				params->reg[1] = (Uint16)(((n >> 16) & 0x1) << 15) | rd;
+				params->reg[2] = 0;
+				params->reg[3] = C55X_PLL_CNTL4_OUTDIV2 | od;
+				params->sysClkKhz = sysHz / 1000;
+			}
+		}
+	}
+
+	return ((bestErr != 0xFFFFFFFF) ? TEST_PASS : TEST_FAIL);
+
+#else
+	/* The VP/VS PLL is not searched */
+	return (TEST_FAIL);
+#endif
+}
+
+/**
+ *
+ * \brief Reprograms the PLL for the clock closest to 'targetKhz' and lets
+ *        the registered peripherals re-time themselves
+ *
+ * \param  targetKhz - requested system clock in kHz
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS C55x_setSysClk(Uint32 targetKhz)
+{
+	C55x_PllParams params;
+	Uint32         oldClkKhz;
+	Uint32         newClkKhz;
+
+	if (C55x_pllSearch(CSL_PLL_CLOCKIN, targetKhz, &params) != TEST_PASS)
+	{
+		return (TEST_FAIL);
+	}
+
+	oldClkKhz = C55x_getSysClk();
+	C55x_clkNotify(C55X_CLK_PRE_CHANGE, oldClkKhz);
+
+#if (defined(CHIP_C5517))
+	/* Run from the PLL reference while it relocks */
+	PLL_CNTL3 |= C55X_PLL_CNTL3_BYPASS;
+	C55x_timebaseSetClock(C55X_PLL_CLKIN_HZ / 1000);
+
+	PLL_CNTL1 = params.reg[0];
+	PLL_CNTL2 = params.reg[1];
+	PLL_CNTL4 = params.reg[3];
+
+	C55x_delay_usec(C55X_PLL_LOCK_USEC);
+
+	PLL_CNTL3 &= ~C55X_PLL_CNTL3_BYPASS;
+#elif (defined(CHIP_C5505_C5515) || defined(CHIP_C5504_C5514) || defined(CHIP_C5535) || defined(CHIP_C5545))
+	/* Run from CLKIN while the PLL relocks */
+	CSL_SYSCTRL_REGS->CCR2 = 0x0;
+	C55x_timebaseSetClock((CSL_PLL_CLOCKIN + 999) / 1000);
+
+	/* Set CLR_CNTL = 0 */
+	CSL_SYSCTRL_REGS->CGCR1 = ((CSL_SYSCTRL_REGS->CGCR1) & (0x7FFF));
+
+	CSL_SYSCTRL_REGS->CGCR1 = params.reg[0];
+	CSL_SYSCTRL_REGS->CGCR2 = params.reg[1];
+	CSL_SYSCTRL_REGS->CGCR3 = params.reg[2];
+	CSL_SYSCTRL_REGS->CGCR4 = params.reg[3];
+
+	C55x_delay_usec(C55X_PLL_LOCK_USEC);
+
+	/* Switch to PLL clk */
+	CSL_SYSCTRL_REGS->CCR2 = 0x1;
+#endif
+
+	newClkKhz = C55x_getSysClk();
+	C55x_timebaseSetClock(newClkKhz);
+
+	C55x_clkNotify(C55X_CLK_POST_CHANGE, newClkKhz);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Adds a clock change notifier
+ *
+ * \param  notifyFxn - called before and after every clock change
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Notifier table full
+ *
+ */
+TEST_STATUS C55x_clkRegisterNotifier(C55x_ClkNotifyFxn notifyFxn)
+{
+	Uint16 i;
+
+	for (i = 0; i < clkNotifierCount; i++)
+	{
+		if (clkNotifiers[i] == notifyFxn)
+		{
+			return (TEST_PASS);
+		}
+	}
+
+	if (clkNotifierCount >= C55X_CLK_MAX_NOTIFIERS)
+	{
+		return (TEST_FAIL);
+	}
+
+	clkNotifiers[clkNotifierCount++] = notifyFxn;
+
+	return (TEST_PASS);
+}
+
+/* I2C prescaler and SCL timing */
+static void C55x_clkI2cNotify(Uint16 event, Uint32 sysClkKhz)
+{
+	if (event == C55X_CLK_POST_CHANGE)
+	{
+		I2C_clockRetime();
+	}
+}
+
+#ifdef USE_SERIAL_CONSOLE
+/* UART divisor, the FIFO is drained before the clock goes */
+static void C55x_clkUartNotify(Uint16 event, Uint32 sysClkKhz)
+{
+	if (event == C55X_CLK_PRE_CHANGE)
+	{
+		uart_drain();
+	}
+	else
+	{
+		uart_retime(sysClkKhz);
+	}
+}
+#endif
+
+/**
+ *
+ * \brief Registers the I2C and UART re-timing notifiers
+ *
+ */
+void C55x_clkRegisterDefaultNotifiers(void)
+{
+	C55x_clkRegisterNotifier(C55x_clkI2cNotify);
+#ifdef USE_SERIAL_CONSOLE
+	C55x_clkRegisterNotifier(C55x_clkUartNotify);
+#endif
+}
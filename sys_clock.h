@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file sys_clock.h
+*
+*   \brief Run time system clock (PLL) changes with peripheral re-timing.
+*
+*/
+
+#ifndef _SYS_CLOCK_H_
+#define _SYS_CLOCK_H_
+
+#include "platform_internals.h"
+
+/* Wait for the PLL to lock after it has been reprogrammed */
+#define C55X_PLL_LOCK_USEC      (4000)
+
+/* Most clock change notifiers */
+#define C55X_CLK_MAX_NOTIFIERS  (8)
+
+/* Notifier events */
+#define C55X_CLK_PRE_CHANGE     (0)     /* old clock still running       */
+#define C55X_CLK_POST_CHANGE    (1)     /* new clock running and locked  */
+
+/**
+ * \brief PLL settings. 'reg' holds CGCR1-4 on the C5504/05/14/15/35/45
+ *        and PLL_CNTL1-4 on the C5517.
+ */
+typedef struct
+{
+	Uint16  reg[4];
+	Uint32  sysClkKhz;      /* clock the settings give */
+} C55x_PllParams;
+
+/**
+ * \brief Clock change notifier
+ *
+ * \param event     - C55X_CLK_PRE_CHANGE or C55X_CLK_POST_CHANGE
+ * \param sysClkKhz - clock that is about to be left (PRE) or now runs
+ *                    (POST)
+ */
+typedef void (*C55x_ClkNotifyFxn)(Uint16 event, Uint32 sysClkKhz);
+
+TEST_STATUS C55x_pllSearch(Uint32 clkInHz, Uint32 targetKhz,
+                           C55x_PllParams *params);
+TEST_STATUS C55x_setSysClk(Uint32 targetKhz);
+TEST_STATUS C55x_clkRegisterNotifier(C55x_ClkNotifyFxn notifyFxn);
+void C55x_clkRegisterDefaultNotifiers(void);
+
+#endif /* _SYS_CLOCK_H_ */
@@ -40,6 +40,9 @@
 
 #include "platform_test.h"
 #include "platform_internals.h"
+#include "timebase.h"
+#include "sys_clock.h"
+#include "boot_trace.h"
 
 /**
  *  \brief    This function generates a PLL clock of 100MHZ
@@ -48,8 +51,6 @@
  */
 ProgramPLL_100MHz()
 {
-    int i;
-
     /*Enabling clodk*/
     CSL_CPU_REGS->ST3_55 &= ~0x4;
 
@@ -58,22 +59,34 @@ ProgramPLL_100MHz()
     CSL_SYSCTRL_REGS->PCGCR1 = 0x0;
     CSL_SYSCTRL_REGS->PCGCR2 = 0x0;
 
-    /* For 32KHz input clock */
-    /* Bypass PLL */
-    CSL_SYSCTRL_REGS->CCR2 = 0x0;
-    /* Set CLR_CNTL = 0 */
-    CSL_SYSCTRL_REGS->CGCR1 = ((CSL_SYSCTRL_REGS->CGCR1) & (0x7FFF));
+    /* Start the timebase, C55x_setSysClk() times the lock wait on it */
+    C55x_timebaseInit();
+
+    /* For 32KHz input clock: M = 3048, RD bypassed -> 100 MHz */
+    if (C55x_setSysClk(100000) != TEST_PASS)
+    {
+        /* No PLL search for this chip, fixed settings */
+        /* Bypass PLL */
+        CSL_SYSCTRL_REGS->CCR2 = 0x0;
+        C55x_timebaseSetClock((CSL_PLL_CLOCKIN + 999) / 1000);
+
+        /* Set CLR_CNTL = 0 */
+        CSL_SYSCTRL_REGS->CGCR1 = ((CSL_SYSCTRL_REGS->CGCR1) & (0x7FFF));
 
-    CSL_SYSCTRL_REGS->CGCR1 =  0x8BE8;
-    CSL_SYSCTRL_REGS->CGCR2 =  0x8000;
-    CSL_SYSCTRL_REGS->CGCR3 =  0x0806;
-    CSL_SYSCTRL_REGS->CGCR4 =  0x0000;
+        CSL_SYSCTRL_REGS->CGCR1 =  0x8BE8;
+        CSL_SYSCTRL_REGS->CGCR2 =  0x8000;
+        CSL_SYSCTRL_REGS->CGCR3 =  0x0806;
+        CSL_SYSCTRL_REGS->CGCR4 =  0x0000;
 
-	/* Wait for PLL lock */
-    for(i=0;i<0x0fff;i++);
+        /* Wait for PLL lock */
+        C55x_delay_usec(C55X_PLL_LOCK_USEC);
 
-    /* Switch to PLL clk */
-    CSL_SYSCTRL_REGS->CCR2 = 0x1;
+        /* Switch to PLL clk */
+        CSL_SYSCTRL_REGS->CCR2 = 0x1;
+
+        /* Timebase follows the PLL output from here */
+        C55x_timebaseSetClock(C55x_getSysClk());
+    }
 
     //C55x_msgWrite("PLL Init Done.\n");
 }
@@ -100,6 +113,7 @@ static Platform_STATUS initUserIf(void)
 	Platform_STATUS status = Platform_EOK;
 
 	ProgramPLL_100MHz();
+	BOOT_traceMark("pll");
 
 #ifdef USE_SERIAL_CONSOLE
 	/* Set output console to serial port */
@@ -107,6 +121,10 @@ static Platform_STATUS initUserIf(void)
 	C55x_msgReadConfigure(PLATFORM_READ_UART);
 	uart_initialisation();
 
+	/* Re-time the UART and I2C whenever C55x_setSysClk() runs */
+	C55x_clkRegisterDefaultNotifiers();
+	BOOT_traceMark("uart");
+
 #else
 	/* Set output console to CCS */
 	C55x_msgWriteConfigure(PLATFORM_WRITE_PRINTF);
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file c55x_intrinsics.h
+*
+*   \brief Host models of the C55x fractional intrinsics, so the fast
+*          path of DSP_gain() can be checked bit for bit against its
+*          reference.
+*
+*   They follow the C55x compiler's definitions with fractional mode and
+*   saturation on: a product is doubled and saturated to 32 bits, so
+*   -32768 * -32768 gives 0x7FFFFFFF, and shifts saturate to 32 bits.
+*   Force included by the tests that define DSP_FAST_PATHS.
+*
+*/
+
+#ifndef _C55X_INTRINSICS_H_
+#define _C55X_INTRINSICS_H_
+
+static inline long C55X_sat32(long long value)
+{
+	if (value > 0x7FFFFFFFLL)
+	{
+		return (0x7FFFFFFFL);
+	}
+	if (value < -0x80000000LL)
+	{
+		return (-0x7FFFFFFFL - 1);
+	}
+	return ((long)value);
+}
+
+/* Saturated fractional multiply */
+static inline long _lsmpy(int a, int b)
+{
+	return (C55X_sat32(((long long)(short)a * (short)b) << 1));
+}
+
+/* Saturated left shift */
+static inline long _lsshl(long a, int shift)
+{
+	return (C55X_sat32((long long)(int)a << shift));
+}
+
+#endif /* _C55X_INTRINSICS_H_ */
@@ -0,0 +1,685 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file csl_host.h
+*
+*   \brief Host build of the parts of the C55x CSL and board support the
+*          audio modules use, backed by peripheral models.
+*
+*   The TI headers (audio_common.h, platform_internals.h, cslr_i2c.h) are
+*   replaced by stand-ins that include this file, so the modules compile
+*   unchanged with a host compiler. Host types keep the target widths that
+*   matter: Uint32 is 32 bits so that wrap-around arithmetic behaves as on
+*   the C55x. Uint16 is 16 bits rather than the C55x char width, which the
+*   modules do not depend on.
+*
+*   Register blocks are plain structures. The ones a model has to see
+*   accesses to (write-1-to-clear flags, FIFOs, the I2C bus) are watched:
+*   every load and store the module does traps into the model, see
+*   host_mmio.c. Interrupts are latched and delivered whenever interrupts
+*   are enabled again, see host_irq.c.
+*
+*/
+
+#ifndef _CSL_HOST_H_
+#define _CSL_HOST_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdlib.h>
+
+#define interrupt
+#define ioport
+
+#include "tistdtypes.h"
+
+typedef Int16               CSL_Status;
+
+#define CSL_SOK                 (0)
+#define CSL_ESYS_FAIL           (-1)
+#define CSL_ESYS_BADHANDLE      (-5)
+#define CSL_ESYS_INVPARAMS      (-6)
+#define CSL_I2C_BUS_BUSY_ERR    (-200)
+#define CSL_I2C_TIMEOUT_ERROR   (-201)
+#define CSL_I2C_NACK_ERR        (-202)
+
+typedef Int16 TEST_STATUS;
+typedef Int16 Platform_STATUS;
+
+#define TEST_PASS           (0)
+#define TEST_FAIL           (-1)
+#define Platform_EOK        (0)
+
+typedef enum
+{
+	PLATFORM_WRITE_UART,
+	PLATFORM_WRITE_PRINTF,
+	PLATFORM_WRITE_ALL
+} WRITE_info;
+
+typedef enum
+{
+	PLATFORM_READ_UART,
+	PLATFORM_READ_SCANF
+} READ_info;
+
+#define CSL_FINST(reg, field, val)  ((void)0)
+#define CSL_FEXT(reg, field)        (((reg) & CSL_##field##_MASK) >> \
+                                     CSL_##field##_SHIFT)
+#define CSL_FMK(field, val)         (((val) << CSL_##field##_SHIFT) & \
+                                     CSL_##field##_MASK)
+
+/****************************************************************************
+ * System control and CPU registers
+ ****************************************************************************/
+
+typedef struct
+{
+	volatile Uint16 EBSR;
+	volatile Uint16 PCGCR1;
+	volatile Uint16 PCGCR2;
+	volatile Uint16 CCR2;
+	volatile Uint16 CGCR1;
+	volatile Uint16 CGCR2;
+	volatile Uint16 CGCR3;
+	volatile Uint16 CGCR4;
+	volatile Uint16 CLKSTOP;
+	volatile Uint16 DMAIFR;     /* write 1 to clear */
+	volatile Uint16 DMAIER;
+	volatile Uint16 DMA0CESR1;
+	volatile Uint16 DMA0CESR2;
+	volatile Uint16 DMA1CESR1;
+	volatile Uint16 DMA1CESR2;
+	volatile Uint16 TIAFR;      /* write 1 to clear */
+	volatile Uint16 ICR;
+	volatile Uint16 ISTR;
+	volatile Uint16 PSRCR;
+	volatile Uint16 PRCR;
+} CSL_SysRegs;
+
+typedef struct
+{
+	volatile Uint16 ST3_55;
+} CSL_CpuRegs;
+
+/* PLL fields of the C5504/05/14/15/35/45 */
+#define CSL_SYS_CGCR1_M_MASK            (0x0FFF)
+#define CSL_SYS_CGCR1_M_SHIFT           (0)
+#define CSL_SYS_CGCR2_RDRATIO_MASK      (0x003F)
+#define CSL_SYS_CGCR2_RDRATIO_SHIFT     (0)
+#define CSL_SYS_CGCR2_RDBYPASS_MASK     (0x8000)
+#define CSL_SYS_CGCR2_RDBYPASS_SHIFT    (15)
+#define CSL_SYS_CGCR4_ODRATIO_MASK      (0x003F)
+#define CSL_SYS_CGCR4_ODRATIO_SHIFT     (0)
+#define CSL_SYS_CGCR4_OUTDIVEN_MASK     (0x0200)
+#define CSL_SYS_CGCR4_OUTDIVEN_SHIFT    (9)
+
+extern CSL_SysRegs *CSL_SYSCTRL_REGS;
+extern CSL_CpuRegs *CSL_CPU_REGS;
+
+#define CSL_EBSR_FIELD_PPMODE   (0)
+#define CSL_EBSR_PPMODE_1       (1)
+#define CSL_EBSR_FIELD_SP1MODE  (1)
+#define CSL_EBSR_SP1MODE_1      (1)
+#define CSL_EBSR_FIELD_SP0MODE  (2)
+#define CSL_EBSR_SP0MODE_0      (0)
+
+CSL_Status SYS_setEBSR(int field, int mode);
+
+#define CSL_PLL_CLOCKIN         (32768)
+#define CSL_PLL_DIV_000         (0)
+#define CSL_PLL_DIV_001         (1)
+#define CSL_PLL_DIV_002         (2)
+#define CSL_PLL_DIV_003         (3)
+#define CSL_PLL_DIV_004         (4)
+#define CSL_PLL_DIV_005         (5)
+#define CSL_PLL_DIV_006         (6)
+#define CSL_PLL_DIV_007         (7)
+
+/****************************************************************************
+ * Interrupts
+ ****************************************************************************/
+
+#define GPIO_EVENT              (1)
+#define DMA_EVENT               (2)
+#define PROG1_EVENT             (3)
+#define PROG0_EVENT             (4)
+#define I2S2_TX_EVENT           (5)
+#define I2S2_RX_EVENT           (6)
+#define I2C_EVENT               (7)
+#define UART_EVENT              (8)
+#define TINT_EVENT              (9)
+
+#define HOST_IRQ_EVENTS         (16)
+
+extern int VECSTART;
+
+Bool IRQ_globalDisable(void);
+void IRQ_globalEnable(void);
+Bool IRQ_globalRestore(Bool old);
+void IRQ_disableAll(void);
+void IRQ_clearAll(void);
+void IRQ_setVecs(Uint32 ivpd);
+void IRQ_clear(Uint16 eventId);
+void IRQ_plug(Uint16 eventId, void (*isr)(void));
+void IRQ_enable(Uint16 eventId);
+void IRQ_disable(Uint16 eventId);
+
+/****************************************************************************
+ * I2S
+ ****************************************************************************/
+
+typedef struct
+{
+	volatile Uint16 I2SSCTRL;
+	volatile Uint16 I2SSRATE;
+	volatile Uint16 I2STXLT0;
+	volatile Uint16 I2STXLT1;
+	volatile Uint16 I2STXRT0;
+	volatile Uint16 I2STXRT1;
+	volatile Uint16 I2SINTFL;
+	volatile Uint16 I2SINTMASK;
+	volatile Uint16 I2SRXLT0;
+	volatile Uint16 I2SRXLT1;
+	volatile Uint16 I2SRXRT0;
+	volatile Uint16 I2SRXRT1;
+} CSL_I2sRegs;
+
+typedef struct
+{
+	CSL_I2sRegs *hwRegs;
+	Uint16       opMode;
+} CSL_I2sHandleObj;
+
+typedef CSL_I2sHandleObj *CSL_I2sHandle;
+
+typedef struct
+{
+	int dataType;
+	int loopBackMode;
+	int fsPol;
+	int clkPol;
+	int datadelay;
+	int datapack;
+	int signext;
+	int wordLen;
+	int i2sMode;
+	int FError;
+	int OuError;
+	int clkDiv;
+	int fsDiv;
+} I2S_Config;
+
+#define I2S_INSTANCE2           (2)
+#define I2S_POLLED              (0)
+#define I2S_INTERRUPT           (1)
+#define DMA_POLLED              (2)
+#define DMA_INTERRUPT           (3)
+#define I2S_CHAN_STEREO         (0)
+#define I2S_STEREO_ENABLE       (0)
+#define I2S_LOOPBACK_DISABLE    (0)
+#define I2S_FSPOL_LOW           (0)
+#define I2S_RISING_EDGE         (0)
+#define I2S_DATADELAY_ONEBIT    (0)
+#define I2S_DATAPACK_ENABLE     (0)
+#define I2S_SIGNEXT_DISABLE     (0)
+#define I2S_WORDLEN_32          (0)
+#define I2S_SLAVE               (0)
+#define I2S_FSERROR_ENABLE      (0)
+#define I2S_OUERROR_ENABLE      (0)
+
+#define CSL_I2S_I2SINTFL_XMITSTFL_MASK  (0x20)
+#define CSL_I2S_I2SINTFL_RCVSTFL_MASK   (0x08)
+#define CSL_I2S_I2SINTFL_FERRFL_MASK    (0x02)
+#define CSL_I2S_I2SINTFL_OUERRFL_MASK   (0x01)
+#define CSL_I2S_I2SINTMASK_XMITST_MASK  (0x20)
+#define CSL_I2S_I2SINTMASK_RCVST_MASK   (0x08)
+
+CSL_I2sHandle I2S_open(int instance, int opMode, int chanType);
+CSL_Status I2S_setup(CSL_I2sHandle hI2s, I2S_Config *config);
+CSL_Status I2S_transEnable(CSL_I2sHandle hI2s, Uint16 enable);
+CSL_Status I2S_close(CSL_I2sHandle hI2s);
+CSL_Status I2S_reset(CSL_I2sHandle hI2s);
+
+/****************************************************************************
+ * GPIO
+ ****************************************************************************/
+
+typedef struct
+{
+	volatile Uint16 IODIR1;
+	volatile Uint16 IODIR2;
+	volatile Uint16 IOINDATA1;
+	volatile Uint16 IOINDATA2;
+	volatile Uint16 IODATAOUT1;
+	volatile Uint16 IODATAOUT2;
+	volatile Uint16 IOINTEDG1;
+	volatile Uint16 IOINTEDG2;
+	volatile Uint16 IOINTEN1;
+	volatile Uint16 IOINTEN2;
+	volatile Uint16 IOINTFLG1;  /* write 1 to clear */
+	volatile Uint16 IOINTFLG2;  /* write 1 to clear */
+} CSL_GpioRegs;
+
+extern CSL_GpioRegs *CSL_GPIO_REGS;
+
+typedef struct
+{
+	int x;
+} CSL_GpioObj;
+
+typedef CSL_GpioObj *CSL_GpioHandle;
+typedef int          CSL_GpioPinNum;
+
+typedef struct
+{
+	CSL_GpioPinNum pinNum;
+	int            direction;
+	int            trigger;
+} CSL_GpioPinConfig;
+
+extern CSL_GpioHandle gpioHandle;
+extern CSL_GpioObj    GpioObj;
+
+#define CSL_GPIO_PIN0               (0)
+#define CSL_GPIO_PIN13              (13)
+#define CSL_GPIO_PIN14              (14)
+#define CSL_GPIO_PIN31              (31)
+#define CSL_GPIO_NUM_PIN            (32)
+#define CSL_GPIO_DIR_INPUT          (0)
+#define CSL_GPIO_DIR_OUTPUT         (1)
+#define CSL_GPIO_TRIG_CLEAR_EDGE    (0)
+#define CSL_GPIO_TRIG_RISING_EDGE   (1)
+#define CSL_GPIO_TRIG_FALLING_EDGE  (2)
+
+CSL_GpioHandle GPIO_open(CSL_GpioObj *obj, CSL_Status *status);
+CSL_Status GPIO_reset(CSL_GpioHandle hGpio);
+CSL_Status GPIO_configBit(CSL_GpioHandle hGpio, CSL_GpioPinConfig *config);
+CSL_Status GPIO_enableInt(CSL_GpioHandle hGpio, CSL_GpioPinNum pin);
+CSL_Status GPIO_disableInt(CSL_GpioHandle hGpio, CSL_GpioPinNum pin);
+Int16 GPIO_statusBit(CSL_GpioHandle hGpio, CSL_GpioPinNum pin,
+                     CSL_Status *status);
+CSL_Status GPIO_clearInt(CSL_GpioHandle hGpio, CSL_GpioPinNum pin);
+CSL_Status GPIO_read(CSL_GpioHandle hGpio, CSL_GpioPinNum pin, Uint16 *val);
+
+/****************************************************************************
+ * I2C
+ ****************************************************************************/
+
+typedef struct
+{
+	Uint16 icoar;
+	Uint16 icimr;
+	Uint16 icclkl;
+	Uint16 icclkh;
+	Uint16 icsar;
+	Uint16 icmdr;
+	Uint16 icemdr;
+	Uint16 icpsc;
+	Uint16 iccnt;
+} CSL_I2cConfig;
+
+typedef struct
+{
+	volatile Uint16 ICOAR;
+	volatile Uint16 ICIMR;
+	volatile Uint16 ICSTR;      /* flags write 1 to clear */
+	volatile Uint16 ICCLKL;
+	volatile Uint16 ICCLKH;
+	volatile Uint16 ICCNT;
+	volatile Uint16 ICDRR;
+	volatile Uint16 ICSAR;
+	volatile Uint16 ICDXR;
+	volatile Uint16 ICMDR;
+	volatile Uint16 ICIVR;      /* reading acknowledges an event */
+	volatile Uint16 ICEMDR;
+	volatile Uint16 ICPSC;
+} CSL_I2cRegs;
+
+typedef volatile CSL_I2cRegs *CSL_I2cRegsOvly;
+
+extern CSL_I2cRegsOvly CSL_I2C_0_REGS;
+
+#define CSL_I2C0                    (0)
+#define CSL_I2C_ICOAR_DEFVAL        (0x007F)
+#define CSL_I2C_ICIMR_DEFVAL        (0)
+#define CSL_I2C_ICSAR_DEFVAL        (0x03FF)
+#define CSL_I2C_ICMDR_WRITE_DEFVAL  (0x0620)
+#define CSL_I2C_ICEMDR_DEFVAL       (0)
+#define CSL_I2C_START               (1)
+#define CSL_I2C_STOP                (2)
+#define CSL_I2C_MAX_TIMEOUT         (0xFFFF)
+
+CSL_Status I2C_init(int instance);
+CSL_Status I2C_config(CSL_I2cConfig *config);
+CSL_Status I2C_setup(void *setup);
+CSL_Status I2C_write(Uint16 *i2cWrBuf, Uint16 dataLength, Uint16 slaveAddr,
+                     Bool masterMode, Uint16 startStopFlag, Uint16 timeout);
+CSL_Status I2C_read(Uint16 *i2cRdBuf, Uint16 dataLength, Uint16 slaveAddr,
+                    Uint16 *subAddr, Uint16 subAddrLength, Bool masterMode,
+                    Uint16 startStopFlag, Uint16 timeout, Bool checkBus);
+
+/****************************************************************************
+ * UART
+ ****************************************************************************/
+
+typedef struct
+{
+	Uint32 clkInput;
+	Uint32 baud;
+	int    wordLength;
+	int    stopBits;
+	int    parity;
+	int    fifoControl;
+	int    loopBackEnable;
+	int    afeEnable;
+	int    rtsEnable;
+} CSL_UartSetup;
+
+typedef struct
+{
+	volatile Uint16 THR;
+	volatile Uint16 RBR;
+	volatile Uint16 IER;
+	volatile Uint16 IIR;
+	volatile Uint16 FCR;
+	volatile Uint16 LCR;
+	volatile Uint16 LSR;
+	volatile Uint16 DLL;
+	volatile Uint16 DLH;
+	volatile Uint16 PWREMU_MGMT;
+} CSL_UartRegs;
+
+typedef struct
+{
+	CSL_UartRegs *uartRegs;
+	Uint32        sysClk;
+	Uint32        baud;
+} CSL_UartObj;
+
+typedef CSL_UartObj *CSL_UartHandle;
+
+extern CSL_UartObj uartObj;
+
+#define CSL_UART_WORD8                      (3)
+#define CSL_UART_DISABLE_PARITY             (0)
+#define CSL_UART_FIFO_DMA1_ENABLE_TRIG14    (0xC9)
+#define CSL_UART_NO_LOOPBACK                (0)
+#define CSL_UART_NO_AFE                     (0)
+#define CSL_UART_NO_RTS                     (0)
+#define CSL_UART_INST_0                     (0)
+#define UART_POLLED                         (0)
+#define UART_INTERRUPT                      (1)
+#define CSL_UART_LSR_DR_MASK                (0x01)
+#define CSL_UART_LSR_THRE_MASK              (0x20)
+#define CSL_UART_LSR_TEMT_MASK              (0x40)
+#define CSL_UART_IER_ERBI_MASK              (0x01)
+#define CSL_UART_IER_ETBEI_MASK             (0x02)
+#define CSL_UART_XMITOR_REG_EMPTY_INTERRUPT (1)
+#define CSL_UART_RECVOR_REG_DATA_INTERRUPT  (2)
+
+CSL_Status UART_init(CSL_UartObj *obj, int instance, int opMode);
+CSL_Status UART_setup(CSL_UartHandle hUart, CSL_UartSetup *setup);
+CSL_Status UART_setupBaudRate(CSL_UartHandle hUart, Uint32 clkInput,
+                              Uint32 baudRate);
+CSL_Status UART_read(CSL_UartHandle hUart, char *buf, Uint16 count,
+                     Uint16 timeout);
+CSL_Status UART_write(CSL_UartHandle hUart, char *buf, Uint16 count,
+                      Uint16 timeout);
+CSL_Status UART_fputc(CSL_UartHandle hUart, char c, Uint16 timeout);
+CSL_Status UART_fputs(CSL_UartHandle hUart, const char *s, Uint16 timeout);
+CSL_Status UART_eventEnable(CSL_UartHandle hUart, int event);
+CSL_Status UART_eventDisable(CSL_UartHandle hUart, int event);
+
+/****************************************************************************
+ * DMA
+ ****************************************************************************/
+
+typedef struct
+{
+	int    pingPongMode;
+	int    autoMode;
+	int    burstLen;
+	int    trigger;
+	int    dmaEvt;
+	int    dmaInt;
+	int    chanDir;
+	int    trfType;
+	Uint16 dataLen;
+	Uint32 srcAddr;
+	Uint32 destAddr;
+} CSL_DMA_Config;
+
+typedef int CSL_DMAChanNum;
+
+typedef struct
+{
+	CSL_DMAChanNum  chanNum;
+	CSL_DMA_Config  config;
+	Bool            isOpen;
+	Bool            running;
+	Uint16          pos;        /* next 32-bit word of the transfer   */
+	Uint16          lastHalf;   /* ping-pong half completed last      */
+} CSL_DMA_ChannelObj;
+
+typedef CSL_DMA_ChannelObj *CSL_DMA_Handle;
+
+#define CSL_DMA_CHAN0               (0)
+#define CSL_DMA_CHAN1               (1)
+#define CSL_DMA_CHAN2               (2)
+#define CSL_DMA_CHAN3               (3)
+#define CSL_DMA_CHAN4               (4)
+#define CSL_DMA_CHAN5               (5)
+#define CSL_DMA_CHAN6               (6)
+#define CSL_DMA_CHAN7               (7)
+#define HOST_DMA_CHANNELS           (16)
+#define CSL_DMA_PING_PONG_DISABLE   (0)
+#define CSL_DMA_PING_PONG_ENABLE    (1)
+#define CSL_DMA_AUTORELOAD_DISABLE  (0)
+#define CSL_DMA_AUTORELOAD_ENABLE   (1)
+#define CSL_DMA_TXBURST_1WORD       (0)
+#define CSL_DMA_SOFTWARE_TRIGGER    (0)
+#define CSL_DMA_EVENT_TRIGGER       (1)
+#define CSL_DMA_EVT_NONE            (0)
+#define CSL_DMA_EVT_I2S2_TX         (1)
+#define CSL_DMA_EVT_I2S2_RX         (2)
+#define CSL_DMA_INTERRUPT_DISABLE   (0)
+#define CSL_DMA_INTERRUPT_ENABLE    (1)
+#define CSL_DMA_READ                (0)
+#define CSL_DMA_WRITE               (1)
+#define CSL_DMA_TRANSFER_MEMORY     (0)
+#define CSL_DMA_TRANSFER_IO_MEMORY  (1)
+
+CSL_Status DMA_init(void);
+CSL_DMA_Handle DMA_open(CSL_DMAChanNum chan, CSL_DMA_ChannelObj *obj,
+                        CSL_Status *status);
+CSL_Status DMA_config(CSL_DMA_Handle hDma, CSL_DMA_Config *config);
+CSL_Status DMA_start(CSL_DMA_Handle hDma);
+CSL_Status DMA_stop(CSL_DMA_Handle hDma);
+CSL_Status DMA_close(CSL_DMA_Handle hDma);
+CSL_Status DMA_reset(CSL_DMA_Handle hDma);
+Int16 DMA_getLastTransferType(CSL_DMA_Handle hDma, CSL_Status *status);
+
+/****************************************************************************
+ * MMC/SD
+ ****************************************************************************/
+
+typedef enum
+{
+	CSL_CARD_NONE,
+	CSL_SD_CARD,
+	CSL_MMC_CARD
+} CSL_CardType;
+
+typedef struct
+{
+	CSL_CardType cardType;
+	Uint16       rca;
+	Bool         sdHcDetected;
+	Uint32       blockLength;
+} CSL_MMCCardObj;
+
+typedef struct
+{
+	Uint16 mfgId;
+	Uint16 serialNumber;
+} CSL_MMCCardIdObj;
+
+typedef struct
+{
+	Uint16 csdStruct;
+	Uint16 readBlLen;
+} CSL_MMCCardCsdObj;
+
+typedef struct
+{
+	CSL_MMCCardObj *cardObj;
+	Uint16          clkDiv;
+	Uint32          blockLen;
+	Bool            littleEndian;
+} CSL_MMCControllerObj;
+
+typedef CSL_MMCControllerObj *CSL_MmcsdHandle;
+typedef int CSL_MmcsdInstId;
+typedef int CSL_MMCSDOpMode;
+typedef int CSL_MmcsdEndianModes;
+
+#define CSL_MMCSD0_INST             (0)
+#define CSL_MMCSD1_INST             (1)
+#define CSL_MMCSD_OPMODE_POLLED     (0)
+#define CSL_MMCSD_OPMODE_DMA        (1)
+#define CSL_MMCSD_ENDIAN_LITTLE     (0)
+#define CSL_MMCSD_ENDIAN_BIG        (1)
+
+CSL_MmcsdHandle MMC_open(CSL_MMCControllerObj *pMmcsdContObj,
+                         CSL_MmcsdInstId instId, CSL_MMCSDOpMode opMode,
+                         CSL_Status *status);
+CSL_Status MMC_close(CSL_MmcsdHandle hMmcsd);
+CSL_Status MMC_sendGoIdle(CSL_MmcsdHandle hMmcsd);
+CSL_Status MMC_selectCard(CSL_MmcsdHandle hMmcsd, CSL_MMCCardObj *pCardObj);
+CSL_Status MMC_sendOpCond(CSL_MmcsdHandle hMmcsd, Uint16 clkDivValue);
+CSL_Status SD_sendAllCID(CSL_MmcsdHandle hMmcsd,
+                         CSL_MMCCardIdObj *pSdCardIdObj);
+CSL_Status SD_sendRca(CSL_MmcsdHandle hMmcsd, CSL_MMCCardObj *pSdCardObj,
+                      Uint16 *pRCardAddr);
+CSL_Status SD_getCardCsd(CSL_MmcsdHandle hMmcsd,
+                         CSL_MMCCardCsdObj *pSdCardCsdObj);
+CSL_Status MMC_setCardType(CSL_MMCCardObj *pCardObj, CSL_CardType cardType);
+CSL_Status MMC_setCardPtr(CSL_MmcsdHandle hMmcsd, CSL_MMCCardObj *pCardObj);
+CSL_Status MMC_getNumberOfBlocks(CSL_MmcsdHandle hMmcsd, Uint32 *pNumBlks);
+CSL_Status MMC_setEndianMode(CSL_MmcsdHandle hMmcsd,
+                             CSL_MmcsdEndianModes writeEndianMode,
+                             CSL_MmcsdEndianModes readEndianMode);
+CSL_Status MMC_setBlockLength(CSL_MmcsdHandle hMmcsd, Uint32 blockLen);
+CSL_Status MMC_read(CSL_MmcsdHandle hMmcsd, Uint32 cardAddr,
+                    Uint16 noOfBytes, Uint16 *pReadBuffer);
+
+/****************************************************************************
+ * General purpose timers
+ ****************************************************************************/
+
+typedef struct
+{
+	int x;
+} CSL_GptObj;
+
+typedef CSL_GptObj *CSL_Handle;
+
+typedef struct
+{
+	int    autoLoad;
+	int    ctrlTim;
+	int    preScaleDiv;
+	int    timerEnable;
+	int    emulation_mode;
+	Uint16 prdLow;
+	Uint16 prdHigh;
+} CSL_Config;
+
+typedef int CSL_Instance;
+
+#define GPT_0               (0)
+#define GPT_1               (1)
+#define GPT_2               (2)
+#define GPT_AUTO_ENABLE     (1)
+#define GPT_TIMER_ENABLE    (1)
+#define GPT_TIMER_DISABLE   (0)
+#define GPT_PRE_SC_DIV_0    (0)
+#define GPT_PRE_SC_DIV_1    (1)
+#define GPT_PRE_SC_DIV_2    (2)
+#define GPT_PRE_SC_DIV_3    (3)
+#define GPT_INTR_ENABLE     (1)
+#define GPT_INTR_DISABLE    (0)
+
+CSL_Handle GPT_open(CSL_Instance instance, CSL_GptObj *obj,
+                    CSL_Status *status);
+CSL_Status GPT_reset(CSL_Handle hGpt);
+CSL_Status GPT_config(CSL_Handle hGpt, CSL_Config *config);
+CSL_Status GPT_start(CSL_Handle hGpt);
+CSL_Status GPT_stop(CSL_Handle hGpt);
+CSL_Status GPT_close(CSL_Handle hGpt);
+CSL_Status GPT_getCnt(CSL_Handle hGpt, Uint32 *count);
+
+/****************************************************************************
+ * Board support (audio_common.c, platform.c)
+ ****************************************************************************/
+
+#define AIC3206_I2C_ADDR    (0x18)
+
+extern CSL_I2sHandle     hI2s;
+extern Uint16            i2sOpMode;
+extern volatile Uint16   sw3Pressed;
+extern volatile Uint16   sw4Pressed;
+
+void  C55x_delay_msec(int msec);
+Int32 C55x_msgWrite(const char *fmt, ...);
+Int32 C55x_msgRead(Uint8 *data, Uint32 length);
+Uint32 C55x_getSysClk(void);
+WRITE_info C55x_msgWriteConfigure(WRITE_info writeType);
+READ_info C55x_msgReadConfigure(READ_info readType);
+
+TEST_STATUS AIC3206_write(Uint16 regnum, Uint16 regval);
+TEST_STATUS initialise_i2s_interface(void);
+TEST_STATUS initialise_i2c_interface(void *testArgs);
+TEST_STATUS gpio_interrupt_initiliastion(void);
+void I2S_readLeft(Int16 *data);
+void I2S_writeLeft(Int16 data);
+void I2S_readRight(Int16 *data);
+void I2S_writeRight(Int16 data);
+Platform_STATUS uart_initialisation(void);
+Int32 platform_uart_set_params(CSL_UartSetup *setup);
+
+#include "host_model.h"
+
+#endif /* _CSL_HOST_H_ */
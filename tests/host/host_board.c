@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file host_board.c
+*
+*   \brief Host versions of the board support calls of audio_common.c and
+*          platform.c. They are weak, so a test linking those files gets
+*          the real ones.
+*
+*   C55x_msgWrite() keeps what it prints for HOST_msgTake(), and sends it
+*   through the UART log ring when uart_log.c is linked and open, or in
+*   text frames while uart_stream.c streams, as the target does.
+*
+*/
+
+#include "csl_host.h"
+#include "platform_uart.h"
+#include <stdint.h>
+#include <time.h>
+
+#define HOST_WEAK   __attribute__((weak))
+#define HOST_MSG_SIZE   (65536)
+
+volatile Uint16 sw3Pressed HOST_WEAK;
+volatile Uint16 sw4Pressed HOST_WEAK;
+
+static char     msgBuf[HOST_MSG_SIZE];
+static Uint32   msgCount;
+static Bool     msgEcho;
+
+HOST_WEAK Bool UART_logActive(void)
+{
+	return (FALSE);
+}
+
+HOST_WEAK Int32 UART_logVPrintf(const char *fmt, va_list args)
+{
+	return (0);
+}
+
+HOST_WEAK Bool STREAM_active(void)
+{
+	return (FALSE);
+}
+
+HOST_WEAK Int32 STREAM_vprintf(const char *fmt, va_list args)
+{
+	return (0);
+}
+
+/* The modules print 32-bit values with %ld/%lu, 'int' on the host */
+static void HOST_msgFormat(char *out, Uint32 size, const char *fmt)
+{
+	Uint32 i = 0;
+
+	while ((*fmt != '\0') && (i < size - 1))
+	{
+		out[i++] = *fmt;
+		if (*fmt++ != '%')
+		{
+			continue;
+		}
+
+		while ((*fmt != '\0') && (i < size - 1) &&
+		       (strchr("diouxXcspfeEgG%", *fmt) == NULL))
+		{
+			if (*fmt != 'l')
+			{
+				out[i++] = *fmt;
+			}
+			fmt++;
+		}
+	}
+
+	out[i] = '\0';
+}
+
+HOST_WEAK Int32 C55x_msgWrite(const char *fmt, ...)
+{
+	char    hostFmt[512];
+	char    text[512];
+	va_list args;
+	Int32   length;
+
+	HOST_msgFormat(hostFmt, sizeof(hostFmt), fmt);
+
+	va_start(args, fmt);
+	length = vsnprintf(text, sizeof(text), hostFmt, args);
+	va_end(args);
+
+	if (length < 0)
+	{
+		return (-1);
+	}
+	if (length >= (Int32)sizeof(text))
+	{
+		length = sizeof(text) - 1;
+	}
+
+	if ((msgCount + length) < HOST_MSG_SIZE)
+	{
+		memcpy(&msgBuf[msgCount], text, length);
+		msgCount += length;
+	}
+
+	if (msgEcho)
+	{
+		fputs(text, stdout);
+	}
+
+	if (UART_logActive())
+	{
+		va_start(args, fmt);
+		UART_logVPrintf(hostFmt, args);
+		va_end(args);
+	}
+	else if (STREAM_active())
+	{
+		va_start(args, fmt);
+		STREAM_vprintf(hostFmt, args);
+		va_end(args);
+	}
+
+	return (CSL_SOK);
+}
+
+HOST_WEAK Int32 C55x_msgRead(Uint8 *data, Uint32 length)
+{
+	return (UART_read(&uartObj, (char *)data, (Uint16)length, 0));
+}
+
+HOST_WEAK WRITE_info C55x_msgWriteConfigure(WRITE_info writeType)
+{
+	return (writeType);
+}
+
+HOST_WEAK READ_info C55x_msgReadConfigure(READ_info readType)
+{
+	return (readType);
+}
+
+HOST_WEAK Uint32 C55x_getSysClk(void)
+{
+	return (HOST_sysClkKhz());
+}
+
+HOST_WEAK void C55x_delay_msec(int msec)
+{
+	struct timespec ts;
+
+	ts.tv_sec  = msec / 1000;
+	ts.tv_nsec = (msec % 1000) * 1000000L;
+	nanosleep(&ts, NULL);
+	HOST_irqPoll();
+}
+
+HOST_WEAK TEST_STATUS AIC3206_write(Uint16 regnum, Uint16 regval)
+{
+	Uint16 cmd[2];
+
+	cmd[0] = regnum & 0x007F;
+	cmd[1] = regval;
+
+	I2C_write(cmd, 2, AIC3206_I2C_ADDR, TRUE, CSL_I2C_START | CSL_I2C_STOP,
+	          CSL_I2C_MAX_TIMEOUT);
+
+	return (TEST_PASS);
+}
+
+HOST_WEAK TEST_STATUS initialise_i2s_interface(void)
+{
+	hI2s = I2S_open(I2S_INSTANCE2, i2sOpMode, I2S_CHAN_STEREO);
+	if (hI2s == NULL)
+	{
+		return (TEST_FAIL);
+	}
+
+	return (I2S_transEnable(hI2s, TRUE));
+}
+
+HOST_WEAK TEST_STATUS initialise_i2c_interface(void *testArgs)
+{
+	CSL_I2cConfig config;
+
+	memset(&config, 0, sizeof(config));
+	config.icoar  = CSL_I2C_ICOAR_DEFVAL;
+	config.icsar  = CSL_I2C_ICSAR_DEFVAL;
+	config.icmdr  = CSL_I2C_ICMDR_WRITE_DEFVAL;
+	config.icclkl = 25;
+	config.icclkh = 25;
+	config.icpsc  = 9;
+
+	return (I2C_config(&config));
+}
+
+HOST_WEAK TEST_STATUS gpio_interrupt_initiliastion(void)
+{
+	CSL_Status status;
+
+	IRQ_setVecs((Uint32)(uintptr_t)(&VECSTART));
+	gpioHandle = GPIO_open(&GpioObj, &status);
+
+	return (TEST_PASS);
+}
+
+HOST_WEAK void I2S_readLeft(Int16 *data)
+{
+	*data = (Int16)hI2s->hwRegs->I2SRXLT1;
+}
+
+HOST_WEAK void I2S_writeLeft(Int16 data)
+{
+	hI2s->hwRegs->I2STXLT1 = data;
+}
+
+HOST_WEAK void I2S_readRight(Int16 *data)
+{
+	*data = (Int16)hI2s->hwRegs->I2SRXRT1;
+}
+
+HOST_WEAK void I2S_writeRight(Int16 data)
+{
+	hI2s->hwRegs->I2STXRT1 = data;
+}
+
+HOST_WEAK Int32 platform_uart_set_params(CSL_UartSetup *setup)
+{
+	memset(setup, 0, sizeof(CSL_UartSetup));
+	setup->clkInput = C55x_getSysClk() * 1000;
+	setup->baud     = 115200;
+
+	return (Platform_EOK);
+}
+
+HOST_WEAK Platform_STATUS uart_initialisation(void)
+{
+	CSL_UartSetup setup;
+
+	UART_init(&uartObj, CSL_UART_INST_0, UART_POLLED);
+	platform_uart_set_params(&setup);
+
+	return (UART_setup(&uartObj, &setup));
+}
+
+HOST_WEAK void uart_drain(void)
+{
+}
+
+HOST_WEAK Platform_STATUS uart_retime(Uint32 sysClkKhz)
+{
+	return (UART_setupBaudRate(&uartObj, sysClkKhz * 1000, uartObj.baud));
+}
+
+HOST_WEAK Platform_STATUS uart_setBaud(Uint32 baud)
+{
+	return (UART_setupBaudRate(&uartObj, C55x_getSysClk() * 1000, baud));
+}
+
+HOST_WEAK Uint32 uart_getBaud(void)
+{
+	return ((uartObj.baud != 0) ? uartObj.baud : 115200);
+}
+
+/**
+ *
+ * \brief Takes what C55x_msgWrite() printed so far
+ *
+ */
+Uint32 HOST_msgTake(char *buf, Uint32 max)
+{
+	Uint32 n = (msgCount < max - 1) ? msgCount : (max - 1);
+
+	memcpy(buf, msgBuf, n);
+	buf[n] = '\0';
+	memmove(msgBuf, &msgBuf[n], msgCount - n);
+	msgCount -= n;
+
+	return (n);
+}
+
+void HOST_msgClear(void)
+{
+	msgCount = 0;
+}
+
+void HOST_msgEcho(Bool echo)
+{
+	msgEcho = echo;
+}
+
+Uint32 HOST_nowUsec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((Uint32)((Uint64)ts.tv_sec * 1000000u + ts.tv_nsec / 1000));
+}
@@ -0,0 +1,709 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file host_i2c.c
+*
+*   \brief Host model of the C55x I2C master and the devices on its bus.
+*
+*   The register model follows the bus in real time at the rate ICPSC,
+*   ICCLKL and ICCLKH give: a start sends the address, bytes move only
+*   when ICDXR has been written or ICDRR read, the count ends with a stop
+*   (STP set) or ARDY, and a NACK holds the bus until the master sets
+*   STP. The state advances on every I2C register access and on
+*   HOST_irqPoll(), and flags enabled in ICIMR raise I2C_EVENT.
+*
+*   The polled CSL calls I2C_write()/I2C_read() run the same devices
+*   directly and return as the CSL does. An AIC3206 register file can be
+*   put on the bus at AIC3206_I2C_ADDR.
+*
+*/
+
+#include "csl_host.h"
+#include <stddef.h>
+#include <signal.h>
+
+#define HOST_I2C_MAX_DEVICES    (8)
+
+/* ICMDR */
+#define HOST_I2C_MDR_STT        (0x2000)
+#define HOST_I2C_MDR_STP        (0x0800)
+#define HOST_I2C_MDR_MST        (0x0400)
+#define HOST_I2C_MDR_TRX        (0x0200)
+#define HOST_I2C_MDR_IRS        (0x0020)
+
+/* ICSTR */
+#define HOST_I2C_STR_AL         (0x0001)
+#define HOST_I2C_STR_NACK       (0x0002)
+#define HOST_I2C_STR_ARDY       (0x0004)
+#define HOST_I2C_STR_RRDY       (0x0008)
+#define HOST_I2C_STR_XRDY       (0x0010)
+#define HOST_I2C_STR_SCD        (0x0020)
+#define HOST_I2C_STR_BB         (0x1000)
+#define HOST_I2C_STR_FLAGS      (0x003F)
+#define HOST_I2C_STR_W1C        (HOST_I2C_STR_FLAGS | HOST_I2C_STR_BB)
+
+#define HOST_I2C_REG(field)     ((Uint16)(offsetof(CSL_I2cRegs, field) / 2))
+
+typedef enum
+{
+	HOST_I2C_IDLE,
+	HOST_I2C_ADDR,          /* address byte on the bus                  */
+	HOST_I2C_TX_WAIT,       /* XRDY, waiting for ICDXR                  */
+	HOST_I2C_TX_BYTE,       /* data byte on the bus                     */
+	HOST_I2C_RX_BYTE,
+	HOST_I2C_RX_WAIT,       /* RRDY, waiting for ICDRR to be read       */
+	HOST_I2C_HOLD,          /* count done without stop, or NACK         */
+	HOST_I2C_STOP,
+	HOST_I2C_STUCK          /* a device holds SCL low                   */
+} HOST_I2cPhase;
+
+static Uint16 i2cBlock[HOST_MMIO_BLOCK_SIZE / 2]
+	__attribute__((aligned(HOST_MMIO_BLOCK_SIZE)));
+
+CSL_I2cRegsOvly CSL_I2C_0_REGS = (CSL_I2cRegsOvly)i2cBlock;
+
+static HOST_I2cDevice  *i2cDevices[HOST_I2C_MAX_DEVICES];
+static Uint16           i2cDeviceCount;
+static HOST_I2cStats    i2cStats;
+
+static HOST_I2cPhase    i2cPhase;
+static Uint32           i2cPhaseEnd;
+static Uint32           i2cCount;
+static Bool             i2cRx;
+static Bool             i2cFirst;
+static Bool             i2cTxFull;
+static Uint16           i2cTxByte;
+static HOST_I2cDevice  *i2cDev;
+static Uint32           i2cStartUsec;
+
+#define I2C_REGS    ((CSL_I2cRegs *)i2cBlock)
+
+static Uint16 HOST_i2cGet(volatile Uint16 *reg)
+{
+	return (HOST_regGet(reg));
+}
+
+static void HOST_i2cSet(volatile Uint16 *reg, Uint16 value)
+{
+	HOST_regSet(reg, value);
+}
+
+/**
+ *
+ * \brief Bus rate the prescaler and clock dividers give, in Hz
+ *
+ */
+Uint32 HOST_i2cBusRate(void)
+{
+	Uint32 psc  = HOST_i2cGet(&I2C_REGS->ICPSC);
+	Uint32 clkl = HOST_i2cGet(&I2C_REGS->ICCLKL);
+	Uint32 clkh = HOST_i2cGet(&I2C_REGS->ICCLKH);
+	Uint32 d    = (psc == 0) ? 7 : ((psc == 1) ? 6 : 5);
+
+	if ((clkl == 0) && (clkh == 0))
+	{
+		return (100000);
+	}
+
+	return ((HOST_sysClkKhz() * 1000) / ((psc + 1) * (clkl + d + clkh + d)));
+}
+
+/* Time of 'bits' bit periods, at least 1us */
+static Uint32 HOST_i2cBits(Uint32 bits)
+{
+	Uint32 usec = (bits * 1000000) / HOST_i2cBusRate();
+
+	return ((usec == 0) ? 1 : usec);
+}
+
+static HOST_I2cDevice *HOST_i2cFind(Uint16 addr)
+{
+	Uint16 i;
+
+	for (i = 0; i < i2cDeviceCount; i++)
+	{
+		if (i2cDevices[i]->addr == addr)
+		{
+			return (i2cDevices[i]);
+		}
+	}
+
+	return (NULL);
+}
+
+static void HOST_i2cFlag(Uint16 flags)
+{
+	Uint16 str = HOST_i2cGet(&I2C_REGS->ICSTR) | flags;
+
+	HOST_i2cSet(&I2C_REGS->ICSTR, str);
+
+	if (str & HOST_i2cGet(&I2C_REGS->ICIMR) & HOST_I2C_STR_FLAGS)
+	{
+		HOST_irqRaise(I2C_EVENT);
+	}
+}
+
+static Bool HOST_i2cLevel(void)
+{
+	return ((HOST_i2cGet(&I2C_REGS->ICSTR) & HOST_i2cGet(&I2C_REGS->ICIMR) &
+	         HOST_I2C_STR_FLAGS) ? TRUE : FALSE);
+}
+
+static void HOST_i2cPhase(HOST_I2cPhase phase, Uint32 bits, Uint32 now)
+{
+	i2cPhase    = phase;
+	i2cPhaseEnd = now + ((bits != 0) ? HOST_i2cBits(bits) : 0);
+}
+
+static void HOST_i2cStart(Uint32 now)
+{
+	Uint16 mdr = HOST_i2cGet(&I2C_REGS->ICMDR);
+
+	i2cStats.transactions++;
+	i2cStats.bytes++;
+
+	if (i2cPhase == HOST_I2C_IDLE)
+	{
+		i2cStartUsec = now;
+	}
+
+	i2cCount = HOST_i2cGet(&I2C_REGS->ICCNT);
+	if (i2cCount == 0)
+	{
+		i2cStats.zeroCount++;
+		i2cCount = 65536;
+	}
+
+	i2cRx    = (mdr & HOST_I2C_MDR_TRX) ? FALSE : TRUE;
+	i2cFirst = TRUE;
+	i2cDev   = HOST_i2cFind(HOST_i2cGet(&I2C_REGS->ICSAR) & 0x7F);
+
+	/* STT clears once the start is on the bus */
+	HOST_i2cSet(&I2C_REGS->ICMDR, mdr & ~HOST_I2C_MDR_STT);
+	HOST_i2cSet(&I2C_REGS->ICSTR, HOST_i2cGet(&I2C_REGS->ICSTR) |
+	                              HOST_I2C_STR_BB);
+
+	if ((i2cDev != NULL) && i2cDev->stuck)
+	{
+		i2cPhase = HOST_I2C_STUCK;
+		return;
+	}
+
+	HOST_i2cPhase(HOST_I2C_ADDR, 10, now);
+	if (i2cDev != NULL)
+	{
+		i2cPhaseEnd += i2cDev->ackDelayUsec;
+	}
+}
+
+/* Byte count done: stop or wait for the master */
+static void HOST_i2cCountDone(Uint32 now)
+{
+	if (HOST_i2cGet(&I2C_REGS->ICMDR) & HOST_I2C_MDR_STP)
+	{
+		HOST_i2cPhase(HOST_I2C_STOP, 1, now);
+	}
+	else
+	{
+		HOST_i2cPhase(HOST_I2C_HOLD, 0, now);
+		HOST_i2cFlag(HOST_I2C_STR_ARDY);
+	}
+}
+
+static void HOST_i2cNextTx(Uint32 now)
+{
+	if (i2cTxFull)
+	{
+		i2cTxByte = HOST_i2cGet(&I2C_REGS->ICDXR) & 0xFF;
+		i2cTxFull = FALSE;
+		HOST_i2cPhase(HOST_I2C_TX_BYTE, 9, now);
+	}
+	else
+	{
+		HOST_i2cPhase(HOST_I2C_TX_WAIT, 0, now);
+		HOST_i2cFlag(HOST_I2C_STR_XRDY);
+	}
+}
+
+static void HOST_i2cNack(Uint32 now)
+{
+	i2cStats.nacks++;
+	HOST_i2cPhase(HOST_I2C_HOLD, 0, now);
+	HOST_i2cFlag(HOST_I2C_STR_NACK);
+}
+
+/* Moves the bus on to 'now' */
+static void HOST_i2cAdvance(Uint32 now)
+{
+	Uint16 mdr;
+	Bool   ack;
+
+	while (((Int32)(now - i2cPhaseEnd) >= 0))
+	{
+		switch (i2cPhase)
+		{
+			case HOST_I2C_ADDR:
+				if (i2cDev == NULL)
+				{
+					HOST_i2cNack(i2cPhaseEnd);
+				}
+				else if (i2cRx)
+				{
+					HOST_i2cPhase(HOST_I2C_RX_BYTE, 9, i2cPhaseEnd);
+				}
+				else
+				{
+					HOST_i2cNextTx(i2cPhaseEnd);
+				}
+				break;
+
+			case HOST_I2C_TX_BYTE:
+				i2cStats.bytes++;
+				ack = (i2cDev->writeFxn != NULL) ?
+				      i2cDev->writeFxn(i2cDev, i2cTxByte, i2cFirst) : TRUE;
+				i2cFirst = FALSE;
+				i2cCount--;
+
+				if (!ack)
+				{
+					HOST_i2cNack(i2cPhaseEnd);
+				}
+				else if (i2cCount == 0)
+				{
+					HOST_i2cCountDone(i2cPhaseEnd);
+				}
+				else
+				{
+					HOST_i2cNextTx(i2cPhaseEnd);
+				}
+				break;
+
+			case HOST_I2C_RX_BYTE:
+				i2cStats.bytes++;
+				HOST_i2cSet(&I2C_REGS->ICDRR,
+				            (i2cDev->readFxn != NULL) ?
+				            (i2cDev->readFxn(i2cDev) & 0xFF) : 0xFF);
+				i2cCount--;
+
+				/* Move on before flagging: the ISR may run from the
+				 * flag and its ICDRR read advances the bus again */
+				if (i2cCount == 0)
+				{
+					HOST_i2cCountDone(i2cPhaseEnd);
+				}
+				else
+				{
+					HOST_i2cPhase(HOST_I2C_RX_WAIT, 0, i2cPhaseEnd);
+				}
+				HOST_i2cFlag(HOST_I2C_STR_RRDY);
+				break;
+
+			case HOST_I2C_TX_WAIT:
+				if (!i2cTxFull)
+				{
+					return;
+				}
+				HOST_i2cNextTx(now);
+				break;
+
+			case HOST_I2C_RX_WAIT:
+				if (HOST_i2cGet(&I2C_REGS->ICSTR) & HOST_I2C_STR_RRDY)
+				{
+					return;
+				}
+				HOST_i2cPhase(HOST_I2C_RX_BYTE, 9, now);
+				break;
+
+			case HOST_I2C_STOP:
+				mdr = HOST_i2cGet(&I2C_REGS->ICMDR);
+				HOST_i2cSet(&I2C_REGS->ICMDR,
+				            mdr & ~(HOST_I2C_MDR_STP | HOST_I2C_MDR_MST));
+				HOST_i2cSet(&I2C_REGS->ICSTR,
+				            HOST_i2cGet(&I2C_REGS->ICSTR) & ~HOST_I2C_STR_BB);
+				i2cStats.busTimeUsec += i2cPhaseEnd - i2cStartUsec;
+				i2cPhase = HOST_I2C_IDLE;
+				HOST_i2cFlag(HOST_I2C_STR_SCD);
+				break;
+
+			default:
+				return;
+		}
+	}
+}
+
+static void HOST_i2cRead(Uint16 reg, volatile Uint16 *value)
+{
+	HOST_i2cAdvance(HOST_nowUsec());
+
+	if (reg == HOST_I2C_REG(ICIVR))
+	{
+		Uint16 pending = *(&I2C_REGS->ICSTR) & *(&I2C_REGS->ICIMR) &
+		                 HOST_I2C_STR_FLAGS;
+		Uint16 code;
+
+		*value = 0;
+		for (code = 1; code <= 6; code++)
+		{
+			if (pending & (1 << (code - 1)))
+			{
+				I2C_REGS->ICSTR &= ~(1 << (code - 1));
+				*value = code;
+				break;
+			}
+		}
+	}
+	else if (reg == HOST_I2C_REG(ICDRR))
+	{
+		I2C_REGS->ICSTR &= ~HOST_I2C_STR_RRDY;
+	}
+}
+
+static void HOST_i2cWrite(Uint16 reg, Uint16 old, volatile Uint16 *value)
+{
+	Uint32 now = HOST_nowUsec();
+	Uint16 written = *value;
+
+	/* Catch the bus up on the register as it was before the store, so
+	 * a flag or stop it completes is not lost under the new value */
+	*value = old;
+	HOST_i2cAdvance(now);
+	old    = *value;
+	*value = written;
+
+	if (reg == HOST_I2C_REG(ICSTR))
+	{
+		*value = old & ~(*value & HOST_I2C_STR_W1C);
+	}
+	else if (reg == HOST_I2C_REG(ICDXR))
+	{
+		i2cTxFull = TRUE;
+		I2C_REGS->ICSTR &= ~HOST_I2C_STR_XRDY;
+	}
+	else if (reg == HOST_I2C_REG(ICMDR))
+	{
+		if (!(*value & HOST_I2C_MDR_IRS))
+		{
+			/* Module reset */
+			i2cPhase  = HOST_I2C_IDLE;
+			i2cTxFull = FALSE;
+			I2C_REGS->ICSTR = 0;
+			return;
+		}
+
+		if ((*value & HOST_I2C_MDR_STT) && (*value & HOST_I2C_MDR_MST) &&
+		    ((i2cPhase == HOST_I2C_IDLE) || (i2cPhase == HOST_I2C_HOLD)))
+		{
+			HOST_i2cStart(now);
+		}
+		else if ((*value & HOST_I2C_MDR_STP) && (i2cPhase == HOST_I2C_HOLD))
+		{
+			HOST_i2cPhase(HOST_I2C_STOP, 1, now);
+		}
+	}
+
+	HOST_i2cAdvance(now);
+}
+
+/**
+ *
+ * \brief Moves the bus on to the current time, for HOST_irqPoll()
+ *
+ */
+void HOST_i2cPoll(void)
+{
+	HOST_i2cAdvance(HOST_nowUsec());
+}
+
+Bool HOST_i2cIdle(void)
+{
+	return ((i2cPhase == HOST_I2C_IDLE) ? TRUE : FALSE);
+}
+
+void HOST_i2cReset(void)
+{
+	i2cDeviceCount = 0;
+	i2cPhase       = HOST_I2C_IDLE;
+	i2cTxFull      = FALSE;
+	memset(&i2cStats, 0, sizeof(i2cStats));
+	HOST_i2cSet(&I2C_REGS->ICSTR, 0);
+	HOST_i2cSet(&I2C_REGS->ICMDR, 0);
+}
+
+void HOST_i2cAttach(HOST_I2cDevice *dev)
+{
+	if (i2cDeviceCount < HOST_I2C_MAX_DEVICES)
+	{
+		i2cDevices[i2cDeviceCount++] = dev;
+	}
+}
+
+void HOST_i2cGetStats(HOST_I2cStats *stats)
+{
+	*stats = i2cStats;
+}
+
+void HOST_i2cClearStats(void)
+{
+	memset(&i2cStats, 0, sizeof(i2cStats));
+}
+
+/****************************************************************************
+ * Polled CSL calls
+ ****************************************************************************/
+
+CSL_Status I2C_init(int instance)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status I2C_config(CSL_I2cConfig *config)
+{
+	I2C_REGS->ICMDR  = 0;
+	I2C_REGS->ICOAR  = config->icoar;
+	I2C_REGS->ICIMR  = config->icimr;
+	I2C_REGS->ICCLKL = config->icclkl;
+	I2C_REGS->ICCLKH = config->icclkh;
+	I2C_REGS->ICSAR  = config->icsar;
+	I2C_REGS->ICEMDR = config->icemdr;
+	I2C_REGS->ICPSC  = config->icpsc;
+	I2C_REGS->ICMDR  = config->icmdr;
+
+	return (CSL_SOK);
+}
+
+CSL_Status I2C_setup(void *setup)
+{
+	return (CSL_SOK);
+}
+
+/* Address phase of a polled transfer */
+static CSL_Status HOST_i2cAddress(HOST_I2cDevice *dev, Uint32 *bits)
+{
+	i2cStats.transactions++;
+	i2cStats.bytes++;
+	*bits += 10;
+
+	if (dev == NULL)
+	{
+		i2cStats.nacks++;
+		HOST_i2cSet(&I2C_REGS->ICSTR,
+		            HOST_i2cGet(&I2C_REGS->ICSTR) | HOST_I2C_STR_NACK);
+		return (CSL_I2C_NACK_ERR);
+	}
+
+	if (dev->stuck)
+	{
+		return (CSL_I2C_TIMEOUT_ERROR);
+	}
+
+	return (CSL_SOK);
+}
+
+static void HOST_i2cPolledTime(Uint32 bits, HOST_I2cDevice *dev)
+{
+	i2cStats.busTimeUsec += HOST_i2cBits(bits + 1) +
+	                        ((dev != NULL) ? dev->ackDelayUsec : 0);
+}
+
+CSL_Status I2C_write(Uint16 *i2cWrBuf, Uint16 dataLength, Uint16 slaveAddr,
+                     Bool masterMode, Uint16 startStopFlag, Uint16 timeout)
+{
+	HOST_I2cDevice *dev = HOST_i2cFind(slaveAddr);
+	CSL_Status      status;
+	Uint32          bits = 0;
+	Uint16          i;
+
+	if ((i2cWrBuf == NULL) || (dataLength == 0))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	status = HOST_i2cAddress(dev, &bits);
+
+	for (i = 0; (status == CSL_SOK) && (i < dataLength); i++)
+	{
+		i2cStats.bytes++;
+		bits += 9;
+		if ((dev->writeFxn != NULL) &&
+		    !dev->writeFxn(dev, i2cWrBuf[i] & 0xFF, (i == 0) ? TRUE : FALSE))
+		{
+			i2cStats.nacks++;
+			HOST_i2cSet(&I2C_REGS->ICSTR,
+			            HOST_i2cGet(&I2C_REGS->ICSTR) | HOST_I2C_STR_NACK);
+			status = CSL_I2C_NACK_ERR;
+		}
+	}
+
+	HOST_i2cPolledTime(bits, dev);
+
+	return (status);
+}
+
+CSL_Status I2C_read(Uint16 *i2cRdBuf, Uint16 dataLength, Uint16 slaveAddr,
+                    Uint16 *subAddr, Uint16 subAddrLength, Bool masterMode,
+                    Uint16 startStopFlag, Uint16 timeout, Bool checkBus)
+{
+	HOST_I2cDevice *dev = HOST_i2cFind(slaveAddr);
+	CSL_Status      status;
+	Uint32          bits = 0;
+	Uint16          i;
+
+	if ((i2cRdBuf == NULL) || (dataLength == 0))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	status = HOST_i2cAddress(dev, &bits);
+
+	for (i = 0; (status == CSL_SOK) && (i < subAddrLength); i++)
+	{
+		i2cStats.bytes++;
+		bits += 9;
+		if (dev->writeFxn != NULL)
+		{
+			dev->writeFxn(dev, subAddr[i] & 0xFF, (i == 0) ? TRUE : FALSE);
+		}
+	}
+
+	if ((status == CSL_SOK) && (subAddrLength != 0))
+	{
+		status = HOST_i2cAddress(dev, &bits);
+	}
+
+	for (i = 0; (status == CSL_SOK) && (i < dataLength); i++)
+	{
+		i2cStats.bytes++;
+		bits += 9;
+		i2cRdBuf[i] = (dev->readFxn != NULL) ? (dev->readFxn(dev) & 0xFF) :
+		                                       0xFF;
+	}
+
+	HOST_i2cPolledTime(bits, dev);
+
+	return (status);
+}
+
+/****************************************************************************
+ * AIC3206 register file
+ ****************************************************************************/
+
+static Uint8           aicRegs[HOST_AIC3206_PAGES][HOST_AIC3206_REGS];
+static Uint16          aicPtr;
+static Uint32          aicWrites;
+static HOST_I2cDevice  aicDev;
+
+static Bool HOST_aic3206WriteByte(HOST_I2cDevice *dev, Uint16 byte,
+                                  Bool first)
+{
+	Uint16 page;
+
+	if (first)
+	{
+		aicPtr = byte & 0x7F;
+		return (TRUE);
+	}
+
+	page = aicRegs[0][0];
+	aicWrites++;
+
+	if ((aicPtr == 1) && (page == 0) && (byte & 0x01))
+	{
+		/* Software reset, self clearing */
+		memset(aicRegs, 0, sizeof(aicRegs));
+	}
+	else if (aicPtr == 0)
+	{
+		/* The page register is on every page */
+		aicRegs[0][0] = (Uint8)byte;
+		aicRegs[byte][0] = (Uint8)byte;
+	}
+	else
+	{
+		aicRegs[page][aicPtr] = (Uint8)byte;
+	}
+
+	aicPtr = (aicPtr + 1) & 0x7F;
+
+	return (TRUE);
+}
+
+static Uint16 HOST_aic3206ReadByte(HOST_I2cDevice *dev)
+{
+	Uint16 value = aicRegs[aicRegs[0][0]][aicPtr];
+
+	aicPtr = (aicPtr + 1) & 0x7F;
+
+	return (value);
+}
+
+/**
+ *
+ * \brief Puts a reset AIC3206 on the bus
+ *
+ */
+HOST_I2cDevice *HOST_aic3206Attach(void)
+{
+	memset(aicRegs, 0, sizeof(aicRegs));
+	aicPtr    = 0;
+	aicWrites = 0;
+
+	aicDev.addr     = AIC3206_I2C_ADDR;
+	aicDev.writeFxn = HOST_aic3206WriteByte;
+	aicDev.readFxn  = HOST_aic3206ReadByte;
+	HOST_i2cAttach(&aicDev);
+
+	return (&aicDev);
+}
+
+Uint16 HOST_aic3206Reg(Uint16 page, Uint16 reg)
+{
+	return (aicRegs[page][reg]);
+}
+
+void HOST_aic3206SetReg(Uint16 page, Uint16 reg, Uint16 value)
+{
+	aicRegs[page][reg] = (Uint8)value;
+}
+
+Uint32 HOST_aic3206Writes(void)
+{
+	return (aicWrites);
+}
+
+__attribute__((constructor))
+static void HOST_i2cInit(void)
+{
+	HOST_mmioWatch(i2cBlock, HOST_i2cRead, HOST_i2cWrite);
+	HOST_irqSetLevel(I2C_EVENT, HOST_i2cLevel);
+	HOST_irqAddPoll(HOST_i2cPoll);
+}
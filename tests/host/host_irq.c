@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file host_irq.c
+*
+*   \brief Host model of the C55x interrupt controller.
+*
+*   INTM is a mutex: IRQ_globalDisable() takes it, IRQ_globalRestore()
+*   gives it back, and an ISR runs holding it. Events are latched by
+*   HOST_irqRaise() and delivered, in event number order, by whichever
+*   thread raises them or next re-enables interrupts. A raise from inside
+*   a register trap only latches; the event goes out at the next delivery
+*   point.
+*
+*   HOST_irqTicker() polls the models from SIGALRM, so ISRs preempt the
+*   main thread at any point INTM allows, as on the target. Tests that
+*   start threads of their own do not use it.
+*
+*/
+
+#include "csl_host.h"
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#define HOST_IRQ_MAX_POLL   (8)
+
+int VECSTART;
+
+static pthread_mutex_t   intmLock = PTHREAD_MUTEX_INITIALIZER;
+static __thread Bool     intmHeld;
+static __thread Uint16   trapDepth;
+
+static void            (*irqVector[HOST_IRQ_EVENTS])(void);
+static HOST_IrqLevelFxn  irqLevel[HOST_IRQ_EVENTS];
+static volatile Uint32   irqFlags;
+static volatile Uint32   irqEnables;
+static Uint32            irqDelivered[HOST_IRQ_EVENTS];
+
+static void            (*pollFxns[HOST_IRQ_MAX_POLL])(void);
+static Uint16            pollCount;
+static __thread Bool     polling;
+
+/* Used by host_mmio.c while a trapped access is in progress */
+void HOST_irqTrapEnter(void)
+{
+	trapDepth++;
+}
+
+void HOST_irqTrapExit(void)
+{
+	trapDepth--;
+}
+
+/* Takes the lowest pending enabled event, -1 if there is none */
+static int HOST_irqNext(void)
+{
+	Uint32 pending;
+	int    event;
+
+	pending = irqFlags & irqEnables;
+	for (event = 0; event < HOST_IRQ_EVENTS; event++)
+	{
+		if (pending & (1u << event))
+		{
+			__atomic_and_fetch(&irqFlags, ~(1u << event), __ATOMIC_SEQ_CST);
+			if ((irqLevel[event] != NULL) && !irqLevel[event]())
+			{
+				continue;
+			}
+			return (event);
+		}
+	}
+
+	return (-1);
+}
+
+/* Runs the pending ISRs, on this thread, as long as INTM allows */
+static void HOST_irqDeliver(void)
+{
+	int event;
+
+	if (intmHeld || (trapDepth != 0))
+	{
+		return;
+	}
+
+	while ((irqFlags & irqEnables) != 0)
+	{
+		/* The flag goes up before the lock and down after it, so a
+		 * ticker signal never finds this thread half way */
+		intmHeld = TRUE;
+		pthread_mutex_lock(&intmLock);
+
+		event = HOST_irqNext();
+		if ((event >= 0) && (irqVector[event] != NULL))
+		{
+			irqDelivered[event]++;
+			irqVector[event]();
+		}
+
+		pthread_mutex_unlock(&intmLock);
+		intmHeld = FALSE;
+	}
+}
+
+Bool IRQ_globalDisable(void)
+{
+	if (intmHeld)
+	{
+		return (TRUE);
+	}
+
+	intmHeld = TRUE;
+	pthread_mutex_lock(&intmLock);
+
+	return (FALSE);
+}
+
+Bool IRQ_globalRestore(Bool old)
+{
+	if (!old && intmHeld)
+	{
+		pthread_mutex_unlock(&intmLock);
+		intmHeld = FALSE;
+		HOST_irqDeliver();
+	}
+
+	return (old);
+}
+
+void IRQ_globalEnable(void)
+{
+	IRQ_globalRestore(FALSE);
+}
+
+void IRQ_disableAll(void)
+{
+	irqEnables = 0;
+}
+
+void IRQ_clearAll(void)
+{
+	irqFlags = 0;
+}
+
+void IRQ_setVecs(Uint32 ivpd)
+{
+	memset(irqVector, 0, sizeof(irqVector));
+}
+
+void IRQ_clear(Uint16 eventId)
+{
+	__atomic_and_fetch(&irqFlags, ~(1u << eventId), __ATOMIC_SEQ_CST);
+}
+
+void IRQ_plug(Uint16 eventId, void (*isr)(void))
+{
+	irqVector[eventId] = isr;
+}
+
+void IRQ_enable(Uint16 eventId)
+{
+	__atomic_or_fetch(&irqEnables, 1u << eventId, __ATOMIC_SEQ_CST);
+	HOST_irqDeliver();
+}
+
+void IRQ_disable(Uint16 eventId)
+{
+	__atomic_and_fetch(&irqEnables, ~(1u << eventId), __ATOMIC_SEQ_CST);
+}
+
+/**
+ *
+ * \brief Latches an event and delivers it if interrupts allow
+ *
+ */
+void HOST_irqRaise(Uint16 eventId)
+{
+	__atomic_or_fetch(&irqFlags, 1u << eventId, __ATOMIC_SEQ_CST);
+	HOST_irqDeliver();
+}
+
+/**
+ *
+ * \brief Advances the models and delivers what they raised. Test loops
+ *        call it where the target would be waiting for hardware.
+ *
+ */
+void HOST_irqPoll(void)
+{
+	Uint16 i;
+
+	if (polling)
+	{
+		return;
+	}
+
+	polling = TRUE;
+	for (i = 0; i < pollCount; i++)
+	{
+		pollFxns[i]();
+	}
+	polling = FALSE;
+
+	HOST_irqDeliver();
+}
+
+static void HOST_irqTick(int sig)
+{
+	if (!intmHeld && !polling && (trapDepth == 0))
+	{
+		HOST_irqPoll();
+	}
+}
+
+/**
+ *
+ * \brief Polls the models every 'periodUsec' from SIGALRM, 0 stops
+ *
+ */
+void HOST_irqTicker(Uint32 periodUsec)
+{
+	struct sigaction sa;
+	struct itimerval it;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = HOST_irqTick;
+	sa.sa_flags   = SA_RESTART;
+	sigaction(SIGALRM, &sa, NULL);
+
+	memset(&it, 0, sizeof(it));
+	it.it_interval.tv_usec = periodUsec;
+	it.it_value.tv_usec    = periodUsec;
+	setitimer(ITIMER_REAL, &it, NULL);
+}
+
+/**
+ *
+ * \brief Sets the check done before an event is delivered, for sources
+ *        that can drop their request before the ISR runs
+ *
+ */
+void HOST_irqSetLevel(Uint16 eventId, HOST_IrqLevelFxn levelFxn)
+{
+	irqLevel[eventId] = levelFxn;
+}
+
+/**
+ *
+ * \brief Adds a model step to HOST_irqPoll()
+ *
+ */
+void HOST_irqAddPoll(void (*pollFxn)(void))
+{
+	Uint16 i;
+
+	for (i = 0; i < pollCount; i++)
+	{
+		if (pollFxns[i] == pollFxn)
+		{
+			return;
+		}
+	}
+
+	if (pollCount < HOST_IRQ_MAX_POLL)
+	{
+		pollFxns[pollCount++] = pollFxn;
+	}
+}
+
+Bool HOST_irqEnabled(Uint16 eventId)
+{
+	return ((irqEnables & (1u << eventId)) ? TRUE : FALSE);
+}
+
+Bool HOST_irqMasked(void)
+{
+	return (intmHeld);
+}
+
+Uint32 HOST_irqCount(Uint16 eventId)
+{
+	return (irqDelivered[eventId]);
+}
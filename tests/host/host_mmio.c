@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file host_mmio.c
+*
+*   \brief Register access traps for the host peripheral models.
+*
+*   A watched register block is mapped with no access rights. A load or
+*   store from a module faults (SIGSEGV); the handler opens the block, runs
+*   the read hook for loads and sets the x86 trap flag, so the access
+*   executes as a single step and raises SIGTRAP. That handler runs the
+*   write hook for stores, with the value before and after, and closes the
+*   block again. The page fault error code tells loads from stores, so a
+*   store of the value a register already holds is still seen.
+*
+*   Hooks run in signal context: they may change their own block freely
+*   but must reach other blocks through HOST_regGet()/HOST_regSet(), and
+*   interrupts they raise are only latched. Watched blocks must only be
+*   accessed from one thread.
+*
+*/
+
+#define _GNU_SOURCE
+#include "csl_host.h"
+#include <signal.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#define HOST_MMIO_MAX_BLOCKS    (8)
+#define HOST_MMIO_WORDS         (HOST_MMIO_BLOCK_SIZE / 2)
+
+/* x86 EFLAGS trap flag and page fault error code write bit */
+#define HOST_EFLAGS_TF          (0x100)
+#define HOST_PF_WRITE           (0x2)
+
+typedef struct
+{
+	volatile Uint16   *base;
+	HOST_RegReadFxn    readFxn;
+	HOST_RegWriteFxn   writeFxn;
+	Bool               open;
+} HOST_MmioBlock;
+
+void HOST_irqTrapEnter(void);
+void HOST_irqTrapExit(void);
+
+static HOST_MmioBlock  mmioBlocks[HOST_MMIO_MAX_BLOCKS];
+static Bool            mmioReady;
+static Uint32          mmioTraps;
+
+/* Access being single stepped */
+static HOST_MmioBlock *stepBlock;
+static Uint16          stepReg;
+static Bool            stepWrite;
+static Uint16          stepOld;
+
+static HOST_MmioBlock *HOST_mmioFind(volatile const void *addr)
+{
+	Uint16 i;
+	char  *a = (char *)addr;
+	char  *b;
+
+	for (i = 0; i < HOST_MMIO_MAX_BLOCKS; i++)
+	{
+		b = (char *)mmioBlocks[i].base;
+		if ((b != NULL) && (a >= b) && (a < b + HOST_MMIO_BLOCK_SIZE))
+		{
+			return (&mmioBlocks[i]);
+		}
+	}
+
+	return (NULL);
+}
+
+static void HOST_mmioProtect(HOST_MmioBlock *blk, Bool open)
+{
+	mprotect((void *)blk->base, HOST_MMIO_BLOCK_SIZE,
+	         open ? (PROT_READ | PROT_WRITE) : PROT_NONE);
+	blk->open = open;
+}
+
+static void HOST_mmioFault(int sig, siginfo_t *info, void *context)
+{
+	ucontext_t     *uc = (ucontext_t *)context;
+	HOST_MmioBlock *blk;
+
+	blk = HOST_mmioFind(info->si_addr);
+	if ((blk == NULL) || (stepBlock != NULL))
+	{
+		/* A real crash */
+		signal(SIGSEGV, SIG_DFL);
+		return;
+	}
+
+	mmioTraps++;
+	HOST_irqTrapEnter();
+	HOST_mmioProtect(blk, TRUE);
+
+	stepBlock = blk;
+	stepReg   = (Uint16)(((char *)info->si_addr - (char *)blk->base) / 2);
+	stepWrite = (uc->uc_mcontext.gregs[REG_ERR] & HOST_PF_WRITE) ?
+	            TRUE : FALSE;
+
+	if (!stepWrite && (blk->readFxn != NULL))
+	{
+		blk->readFxn(stepReg, &blk->base[stepReg]);
+	}
+	stepOld = blk->base[stepReg];
+
+	uc->uc_mcontext.gregs[REG_EFL] |= HOST_EFLAGS_TF;
+}
+
+static void HOST_mmioStep(int sig, siginfo_t *info, void *context)
+{
+	ucontext_t     *uc = (ucontext_t *)context;
+	HOST_MmioBlock *blk = stepBlock;
+
+	if (blk == NULL)
+	{
+		signal(SIGTRAP, SIG_DFL);
+		return;
+	}
+
+	uc->uc_mcontext.gregs[REG_EFL] &= ~HOST_EFLAGS_TF;
+
+	if ((stepWrite || (blk->base[stepReg] != stepOld)) &&
+	    (blk->writeFxn != NULL))
+	{
+		blk->writeFxn(stepReg, stepOld, &blk->base[stepReg]);
+	}
+
+	stepBlock = NULL;
+	HOST_mmioProtect(blk, FALSE);
+	HOST_irqTrapExit();
+}
+
+static void HOST_mmioInit(void)
+{
+	struct sigaction sa;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_flags = SA_SIGINFO;
+	sigemptyset(&sa.sa_mask);
+	sigaddset(&sa.sa_mask, SIGALRM);
+
+	sa.sa_sigaction = HOST_mmioFault;
+	sigaction(SIGSEGV, &sa, NULL);
+
+	sa.sa_sigaction = HOST_mmioStep;
+	sigaction(SIGTRAP, &sa, NULL);
+
+	mmioReady = TRUE;
+}
+
+/**
+ *
+ * \brief Starts trapping the accesses to a page aligned register block
+ *
+ */
+void HOST_mmioWatch(volatile void *block, HOST_RegReadFxn readFxn,
+                    HOST_RegWriteFxn writeFxn)
+{
+	HOST_MmioBlock *blk;
+	Uint16          i;
+
+	if (((uintptr_t)block % HOST_MMIO_BLOCK_SIZE) != 0)
+	{
+		fprintf(stderr, "host_mmio: block %p not page aligned\n",
+		        (void *)block);
+		abort();
+	}
+
+	if (!mmioReady)
+	{
+		HOST_mmioInit();
+	}
+
+	blk = HOST_mmioFind(block);
+	for (i = 0; (blk == NULL) && (i < HOST_MMIO_MAX_BLOCKS); i++)
+	{
+		if (mmioBlocks[i].base == NULL)
+		{
+			blk = &mmioBlocks[i];
+		}
+	}
+	if (blk == NULL)
+	{
+		abort();
+	}
+
+	blk->base     = (volatile Uint16 *)block;
+	blk->readFxn  = readFxn;
+	blk->writeFxn = writeFxn;
+	HOST_mmioProtect(blk, FALSE);
+}
+
+/**
+ *
+ * \brief Turns a block back into plain memory
+ *
+ */
+void HOST_mmioUnwatch(volatile void *block)
+{
+	HOST_MmioBlock *blk = HOST_mmioFind(block);
+
+	if (blk != NULL)
+	{
+		HOST_mmioProtect(blk, TRUE);
+		blk->base = NULL;
+	}
+}
+
+Bool HOST_mmioWatched(volatile void *block)
+{
+	return ((HOST_mmioFind(block) != NULL) ? TRUE : FALSE);
+}
+
+/**
+ *
+ * \brief Reads a register without trapping, for the models
+ *
+ */
+Uint16 HOST_regGet(volatile Uint16 *reg)
+{
+	HOST_MmioBlock *blk = HOST_mmioFind(reg);
+	Uint16          value;
+
+	if ((blk == NULL) || blk->open)
+	{
+		return (*reg);
+	}
+
+	HOST_mmioProtect(blk, TRUE);
+	value = *reg;
+	HOST_mmioProtect(blk, FALSE);
+
+	return (value);
+}
+
+/**
+ *
+ * \brief Writes a register without trapping, for the models
+ *
+ */
+void HOST_regSet(volatile Uint16 *reg, Uint16 value)
+{
+	HOST_MmioBlock *blk = HOST_mmioFind(reg);
+
+	if ((blk == NULL) || blk->open)
+	{
+		*reg = value;
+		return;
+	}
+
+	HOST_mmioProtect(blk, TRUE);
+	*reg = value;
+	HOST_mmioProtect(blk, FALSE);
+}
+
+Uint32 HOST_mmioTraps(void)
+{
+	return (mmioTraps);
+}
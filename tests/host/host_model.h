@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file host_model.h
+*
+*   \brief Controls of the host peripheral models, used by the tests to
+*          drive the hardware side.
+*
+*/
+
+#ifndef _HOST_MODEL_H_
+#define _HOST_MODEL_H_
+
+/****************************************************************************
+ * Interrupt controller (host_irq.c)
+ *
+ * One INTM shared by all threads: a thread that disables interrupts, or
+ * runs an ISR, holds it and keeps ISRs raised by other threads out.
+ ****************************************************************************/
+
+/* Tells whether a latched event is still asserted when it is delivered */
+typedef Bool (*HOST_IrqLevelFxn)(void);
+
+void   HOST_irqRaise(Uint16 eventId);
+void   HOST_irqPoll(void);
+void   HOST_irqSetLevel(Uint16 eventId, HOST_IrqLevelFxn levelFxn);
+void   HOST_irqAddPoll(void (*pollFxn)(void));
+Bool   HOST_irqEnabled(Uint16 eventId);
+Bool   HOST_irqMasked(void);
+Uint32 HOST_irqCount(Uint16 eventId);
+/* Polls the models from a timer signal; single threaded tests only */
+void   HOST_irqTicker(Uint32 periodUsec);
+
+/****************************************************************************
+ * Trapped register blocks (host_mmio.c)
+ *
+ * A watched block is kept inaccessible; each load or store the modules do
+ * faults, the model sees it and the access is single stepped. 'reg' is the
+ * 16-bit word offset in the block.
+ ****************************************************************************/
+
+/* Called before a load; may update the value about to be read */
+typedef void (*HOST_RegReadFxn)(Uint16 reg, volatile Uint16 *value);
+
+/* Called after a store; '*value' holds what was written and can be
+ * replaced by what the register really takes */
+typedef void (*HOST_RegWriteFxn)(Uint16 reg, Uint16 old,
+                                 volatile Uint16 *value);
+
+#define HOST_MMIO_BLOCK_SIZE    (4096)
+
+void   HOST_mmioWatch(volatile void *block, HOST_RegReadFxn readFxn,
+                      HOST_RegWriteFxn writeFxn);
+void   HOST_mmioUnwatch(volatile void *block);
+Bool   HOST_mmioWatched(volatile void *block);
+Uint16 HOST_regGet(volatile Uint16 *reg);
+void   HOST_regSet(volatile Uint16 *reg, Uint16 value);
+Uint32 HOST_mmioTraps(void);
+
+/****************************************************************************
+ * I2S2, DMA, GPIO, MMC/SD, UART and system control (host_periph.c)
+ ****************************************************************************/
+
+/* System clock the PLL registers give, kHz; safe in register hooks */
+Uint32 HOST_sysClkKhz(void);
+
+/* Frame clock: 'frames' I2S frame events (DMA or interrupt mode) */
+void   HOST_i2sTick(Uint32 frames);
+/* Interleaved L/R frames the receiver delivers, zeros once used up */
+void   HOST_i2sSetInput(const Int16 *frames, Uint32 count);
+Uint32 HOST_i2sInputUsed(void);
+/* Interleaved L/R frames the transmitter has sent */
+const Int16 *HOST_i2sOutput(Uint32 *frames);
+void   HOST_i2sClearOutput(void);
+Bool   HOST_i2sTxEnabled(void);
+/* Unwatched the I2S registers are plain memory, always ready */
+void   HOST_i2sWatch(Bool watch);
+
+/* Makes the next DMA_open() of 'chan' fail */
+void   HOST_dmaFailOpen(CSL_DMAChanNum chan);
+Bool   HOST_dmaChannelOpen(CSL_DMAChanNum chan);
+Uint16 HOST_dmaOpenCount(void);
+
+void   HOST_gpioSetPin(Uint16 pin, Uint16 level);
+
+/* Card in the MMCSD0 slot holding 'image'; NULL takes it out. Standard
+ * capacity cards are addressed in bytes, high capacity ones in sectors. */
+void   HOST_mmcsdInsert(const Uint8 *image, Uint32 bytes, Bool highCapacity);
+/* Makes the next 'count' MMC_read() calls fail */
+void   HOST_mmcsdFailReads(Uint32 count);
+Uint32 HOST_mmcsdReads(void);
+Uint16 HOST_mmcsdClockDiv(void);
+
+typedef void (*HOST_UartSinkFxn)(Uint8 byte, void *arg);
+
+/* Bytes sent go to 'sinkFxn', or to a buffer HOST_uartTake() empties */
+void   HOST_uartSetSink(HOST_UartSinkFxn sinkFxn, void *arg);
+Uint32 HOST_uartTake(Uint8 *buf, Uint32 max);
+void   HOST_uartReceive(const Uint8 *data, Uint32 length);
+/* A held line keeps THRE clear, as if the far end stopped reading */
+void   HOST_uartHold(Bool hold);
+Uint32 HOST_uartBaud(void);
+
+/****************************************************************************
+ * I2C bus (host_i2c.c)
+ ****************************************************************************/
+
+typedef struct HOST_I2cDevice HOST_I2cDevice;
+
+struct HOST_I2cDevice
+{
+	Uint16  addr;
+	/* Clock stretch before the address is acknowledged */
+	Uint32  ackDelayUsec;
+	/* Holds SCL low forever once addressed */
+	Bool    stuck;
+	/* 'first' is TRUE for the first byte after a start */
+	Bool    (*writeFxn)(HOST_I2cDevice *dev, Uint16 byte, Bool first);
+	Uint16  (*readFxn)(HOST_I2cDevice *dev);
+	void    *arg;
+};
+
+typedef struct
+{
+	Uint32  transactions;   /* starts, repeated starts included        */
+	Uint32  bytes;          /* address and data bytes on the bus        */
+	Uint32  nacks;
+	Uint32  zeroCount;      /* starts with ICCNT = 0 (65536 bytes)      */
+	Uint32  busTimeUsec;    /* at the rate the registers give           */
+} HOST_I2cStats;
+
+void   HOST_i2cReset(void);
+void   HOST_i2cAttach(HOST_I2cDevice *dev);
+void   HOST_i2cPoll(void);
+Bool   HOST_i2cIdle(void);
+Uint32 HOST_i2cBusRate(void);
+void   HOST_i2cGetStats(HOST_I2cStats *stats);
+void   HOST_i2cClearStats(void);
+
+/* AIC3206 register file behind address AIC3206_I2C_ADDR */
+#define HOST_AIC3206_PAGES      (256)
+#define HOST_AIC3206_REGS       (128)
+
+HOST_I2cDevice *HOST_aic3206Attach(void);
+Uint16 HOST_aic3206Reg(Uint16 page, Uint16 reg);
+void   HOST_aic3206SetReg(Uint16 page, Uint16 reg, Uint16 value);
+Uint32 HOST_aic3206Writes(void);
+
+/****************************************************************************
+ * Board support (host_board.c)
+ ****************************************************************************/
+
+/* Console text written through C55x_msgWrite() */
+Uint32 HOST_msgTake(char *buf, Uint32 max);
+void   HOST_msgClear(void);
+void   HOST_msgEcho(Bool echo);
+
+Uint32 HOST_nowUsec(void);
+
+#endif /* _HOST_MODEL_H_ */
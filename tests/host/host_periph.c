@@ -0,0 +1,1182 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file host_periph.c
+*
+*   \brief Host models of the system control registers, I2S2, DMA, GPIO,
+*          MMC/SD, UART and timers, with the CSL calls the modules make on
+*          them.
+*
+*   The models are only as deep as the tests need: the I2S transmitter
+*   records what it sends and the receiver plays back a given input, the
+*   DMA moves one word per channel and frame event in ping-pong auto-reload
+*   mode, the MMC/SD card is a byte image read through the CSL calls, the
+*   UART sends instantly unless the line is held, and flag registers are
+*   write 1 to clear.
+*
+*/
+
+#include "csl_host.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define HOST_REG(type, field)   ((Uint16)(offsetof(type, field) / 2))
+
+#define HOST_BLOCK(name) \
+	static Uint16 name[HOST_MMIO_BLOCK_SIZE / 2] \
+	__attribute__((aligned(HOST_MMIO_BLOCK_SIZE)))
+
+HOST_BLOCK(sysBlock);
+HOST_BLOCK(i2sBlock);
+HOST_BLOCK(gpioBlock);
+HOST_BLOCK(uartBlock);
+
+static CSL_CpuRegs cpuRegs;
+
+CSL_SysRegs  *CSL_SYSCTRL_REGS = (CSL_SysRegs *)sysBlock;
+CSL_CpuRegs  *CSL_CPU_REGS     = &cpuRegs;
+CSL_GpioRegs *CSL_GPIO_REGS    = (CSL_GpioRegs *)gpioBlock;
+
+CSL_GpioObj    GpioObj;
+CSL_GpioHandle gpioHandle;
+
+/* Defined by audio_common.c and platform.c when a test links them */
+CSL_I2sHandle    hI2s      __attribute__((weak));
+Uint16           i2sOpMode __attribute__((weak)) = I2S_POLLED;
+CSL_UartObj      uartObj   __attribute__((weak));
+
+/****************************************************************************
+ * System control
+ ****************************************************************************/
+
+static void HOST_sysWrite(Uint16 reg, Uint16 old, volatile Uint16 *value)
+{
+	if ((reg == HOST_REG(CSL_SysRegs, DMAIFR)) ||
+	    (reg == HOST_REG(CSL_SysRegs, TIAFR)))
+	{
+		*value = old & ~*value;
+	}
+}
+
+/**
+ *
+ * \brief C55x_getSysClk() of platform.c, reading the registers without
+ *        trapping
+ *
+ */
+Uint32 HOST_sysClkKhz(void)
+{
+	CSL_SysRegs *sys = CSL_SYSCTRL_REGS;
+	Uint16       cgcr2 = HOST_regGet(&sys->CGCR2);
+	Uint16       cgcr4 = HOST_regGet(&sys->CGCR4);
+	Uint32       sysClk = CSL_PLL_CLOCKIN;
+
+	if (CSL_FEXT(cgcr2, SYS_CGCR2_RDBYPASS) == 0)
+	{
+		sysClk = sysClk / (CSL_FEXT(cgcr2, SYS_CGCR2_RDRATIO) + 4);
+	}
+
+	sysClk = sysClk * (CSL_FEXT(HOST_regGet(&sys->CGCR1), SYS_CGCR1_M) + 4);
+
+	if (CSL_FEXT(cgcr4, SYS_CGCR4_OUTDIVEN) == 1)
+	{
+		sysClk = sysClk / (CSL_FEXT(cgcr4, SYS_CGCR4_ODRATIO) + 1);
+	}
+
+	return (sysClk / 1000);
+}
+
+CSL_Status SYS_setEBSR(int field, int mode)
+{
+	return (CSL_SOK);
+}
+
+/****************************************************************************
+ * I2S2
+ ****************************************************************************/
+
+static CSL_I2sHandleObj  i2sObj;
+static Bool              i2sOpen;
+static Bool              i2sTxOn;
+static Uint16            i2sIntFlags;
+
+static const Int16      *i2sIn;
+static Uint32            i2sInCount;
+static Uint32            i2sInPos;
+
+static Int16            *i2sOut;
+static Uint32            i2sOutFrames;
+static Uint32            i2sOutMax;
+
+static void HOST_i2sRecord(Int16 left, Int16 right)
+{
+	if (i2sOutFrames == i2sOutMax)
+	{
+		i2sOutMax = (i2sOutMax == 0) ? 4096 : 2 * i2sOutMax;
+		i2sOut    = realloc(i2sOut, i2sOutMax * 2 * sizeof(Int16));
+	}
+
+	i2sOut[2 * i2sOutFrames]     = left;
+	i2sOut[2 * i2sOutFrames + 1] = right;
+	i2sOutFrames++;
+}
+
+static Int16 HOST_i2sInput(Uint16 channel)
+{
+	if (i2sInPos >= i2sInCount)
+	{
+		return (0);
+	}
+
+	return (i2sIn[2 * i2sInPos + channel]);
+}
+
+static void HOST_i2sRead(Uint16 reg, volatile Uint16 *value)
+{
+	if (reg == HOST_REG(CSL_I2sRegs, I2SINTFL))
+	{
+		if (i2sObj.opMode == I2S_INTERRUPT)
+		{
+			/* Set by the frame clock, cleared by the read */
+			*value      = i2sIntFlags;
+			i2sIntFlags = 0;
+		}
+		else
+		{
+			/* The codec is always ready in polled mode */
+			*value = CSL_I2S_I2SINTFL_XMITSTFL_MASK |
+			         CSL_I2S_I2SINTFL_RCVSTFL_MASK;
+		}
+	}
+	else if (reg == HOST_REG(CSL_I2sRegs, I2SRXLT1))
+	{
+		*value = (Uint16)HOST_i2sInput(0);
+	}
+	else if (reg == HOST_REG(CSL_I2sRegs, I2SRXRT1))
+	{
+		*value = (Uint16)HOST_i2sInput(1);
+		i2sInPos++;
+	}
+}
+
+static void HOST_i2sWrite(Uint16 reg, Uint16 old, volatile Uint16 *value)
+{
+	CSL_I2sRegs *regs = (CSL_I2sRegs *)i2sBlock;
+
+	/* Polled writes go out as soon as the right sample is in */
+	if ((reg == HOST_REG(CSL_I2sRegs, I2STXRT1)) && i2sTxOn &&
+	    (i2sObj.opMode == I2S_POLLED))
+	{
+		HOST_i2sRecord((Int16)regs->I2STXLT1, (Int16)*value);
+	}
+}
+
+CSL_I2sHandle I2S_open(int instance, int opMode, int chanType)
+{
+	if (i2sOpen)
+	{
+		return (NULL);
+	}
+
+	i2sOpen        = TRUE;
+	i2sTxOn        = FALSE;
+	i2sIntFlags    = 0;
+	i2sObj.hwRegs  = (CSL_I2sRegs *)i2sBlock;
+	i2sObj.opMode  = (Uint16)opMode;
+
+	return (&i2sObj);
+}
+
+CSL_Status I2S_setup(CSL_I2sHandle h, I2S_Config *config)
+{
+	return ((h == &i2sObj) && i2sOpen) ? CSL_SOK : CSL_ESYS_BADHANDLE;
+}
+
+CSL_Status I2S_transEnable(CSL_I2sHandle h, Uint16 enable)
+{
+	if ((h != &i2sObj) || !i2sOpen)
+	{
+		return (CSL_ESYS_BADHANDLE);
+	}
+
+	i2sTxOn = enable ? TRUE : FALSE;
+
+	return (CSL_SOK);
+}
+
+CSL_Status I2S_close(CSL_I2sHandle h)
+{
+	if ((h != &i2sObj) || !i2sOpen)
+	{
+		return (CSL_ESYS_BADHANDLE);
+	}
+
+	i2sOpen = FALSE;
+	i2sTxOn = FALSE;
+
+	return (CSL_SOK);
+}
+
+CSL_Status I2S_reset(CSL_I2sHandle h)
+{
+	return (CSL_SOK);
+}
+
+static void HOST_dmaEvent(int dmaEvt);
+
+/**
+ *
+ * \brief Runs the frame clock for 'frames' frames
+ *
+ */
+void HOST_i2sTick(Uint32 frames)
+{
+	CSL_I2sRegs *regs = (CSL_I2sRegs *)i2sBlock;
+	Uint16       mask;
+
+	while (frames--)
+	{
+		if (!i2sOpen || !i2sTxOn)
+		{
+			continue;
+		}
+
+		if ((i2sObj.opMode == DMA_INTERRUPT) ||
+		    (i2sObj.opMode == DMA_POLLED))
+		{
+			HOST_dmaEvent(CSL_DMA_EVT_I2S2_TX);
+		}
+		else if (i2sObj.opMode == I2S_INTERRUPT)
+		{
+			i2sIntFlags = CSL_I2S_I2SINTFL_XMITSTFL_MASK |
+			              CSL_I2S_I2SINTFL_RCVSTFL_MASK;
+			mask = HOST_regGet(&regs->I2SINTMASK);
+			/* I2S2 uses the PROG1/PROG0 vectors on the C5545 */
+			if (mask & CSL_I2S_I2SINTMASK_RCVST_MASK)
+			{
+				HOST_irqRaise(PROG0_EVENT);
+			}
+			if (mask & CSL_I2S_I2SINTMASK_XMITST_MASK)
+			{
+				HOST_irqRaise(PROG1_EVENT);
+			}
+		}
+		else
+		{
+			continue;
+		}
+
+		HOST_i2sRecord((Int16)HOST_regGet(&regs->I2STXLT1),
+		               (Int16)HOST_regGet(&regs->I2STXRT1));
+	}
+}
+
+void HOST_i2sSetInput(const Int16 *frames, Uint32 count)
+{
+	i2sIn      = frames;
+	i2sInCount = count;
+	i2sInPos   = 0;
+}
+
+Uint32 HOST_i2sInputUsed(void)
+{
+	return (i2sInPos);
+}
+
+const Int16 *HOST_i2sOutput(Uint32 *frames)
+{
+	*frames = i2sOutFrames;
+
+	return (i2sOut);
+}
+
+void HOST_i2sClearOutput(void)
+{
+	i2sOutFrames = 0;
+}
+
+Bool HOST_i2sTxEnabled(void)
+{
+	return (i2sOpen && i2sTxOn);
+}
+
+void HOST_i2sWatch(Bool watch)
+{
+	CSL_I2sRegs *regs = (CSL_I2sRegs *)i2sBlock;
+
+	if (watch)
+	{
+		HOST_mmioWatch(i2sBlock, HOST_i2sRead, HOST_i2sWrite);
+	}
+	else
+	{
+		HOST_mmioUnwatch(i2sBlock);
+		regs->I2SINTFL = CSL_I2S_I2SINTFL_XMITSTFL_MASK |
+		                 CSL_I2S_I2SINTFL_RCVSTFL_MASK;
+	}
+}
+
+/****************************************************************************
+ * DMA
+ ****************************************************************************/
+
+/* I/O space word addresses of the I2S2 data registers */
+#define HOST_I2S2_TXLT0_ADDR    (0x2A08)
+#define HOST_I2S2_TXRT0_ADDR    (0x2A0C)
+
+static CSL_DMA_Handle dmaChan[HOST_DMA_CHANNELS];
+static Uint16         dmaFailOpen;
+
+CSL_Status DMA_init(void)
+{
+	return (CSL_SOK);
+}
+
+CSL_DMA_Handle DMA_open(CSL_DMAChanNum chan, CSL_DMA_ChannelObj *obj,
+                        CSL_Status *status)
+{
+	if ((chan < 0) || (chan >= HOST_DMA_CHANNELS) || (obj == NULL))
+	{
+		*status = CSL_ESYS_INVPARAMS;
+		return (NULL);
+	}
+
+	if ((dmaFailOpen & (1 << chan)) || (dmaChan[chan] != NULL))
+	{
+		dmaFailOpen &= ~(1 << chan);
+		*status = CSL_ESYS_BADHANDLE;
+		return (NULL);
+	}
+
+	memset(obj, 0, sizeof(CSL_DMA_ChannelObj));
+	obj->chanNum  = chan;
+	obj->isOpen   = TRUE;
+	dmaChan[chan] = obj;
+	*status       = CSL_SOK;
+
+	return (obj);
+}
+
+CSL_Status DMA_config(CSL_DMA_Handle h, CSL_DMA_Config *config)
+{
+	if ((h == NULL) || !h->isOpen)
+	{
+		return (CSL_ESYS_BADHANDLE);
+	}
+
+	h->config = *config;
+
+	return (CSL_SOK);
+}
+
+CSL_Status DMA_start(CSL_DMA_Handle h)
+{
+	if ((h == NULL) || !h->isOpen)
+	{
+		return (CSL_ESYS_BADHANDLE);
+	}
+
+	h->running  = TRUE;
+	h->pos      = 0;
+	h->lastHalf = 0;
+
+	return (CSL_SOK);
+}
+
+CSL_Status DMA_stop(CSL_DMA_Handle h)
+{
+	if ((h == NULL) || !h->isOpen)
+	{
+		return (CSL_ESYS_BADHANDLE);
+	}
+
+	h->running = FALSE;
+
+	return (CSL_SOK);
+}
+
+CSL_Status DMA_close(CSL_DMA_Handle h)
+{
+	if ((h == NULL) || !h->isOpen)
+	{
+		return (CSL_ESYS_BADHANDLE);
+	}
+
+	h->isOpen  = FALSE;
+	h->running = FALSE;
+	dmaChan[h->chanNum] = NULL;
+
+	return (CSL_SOK);
+}
+
+CSL_Status DMA_reset(CSL_DMA_Handle h)
+{
+	return (CSL_SOK);
+}
+
+Int16 DMA_getLastTransferType(CSL_DMA_Handle h, CSL_Status *status)
+{
+	*status = ((h != NULL) && h->isOpen) ? CSL_SOK : CSL_ESYS_BADHANDLE;
+
+	return ((h != NULL) ? (Int16)h->lastHalf : 0);
+}
+
+/* One transfer on every running channel triggered by 'dmaEvt' */
+static void HOST_dmaEvent(int dmaEvt)
+{
+	CSL_I2sRegs    *regs = (CSL_I2sRegs *)i2sBlock;
+	CSL_DMA_Handle  h;
+	Uint32         *src;
+	Uint32          word;
+	Uint16          words;
+	Uint16          done = 0;
+	Uint16          chan;
+
+	for (chan = 0; chan < HOST_DMA_CHANNELS; chan++)
+	{
+		h = dmaChan[chan];
+		if ((h == NULL) || !h->running ||
+		    (h->config.trigger != CSL_DMA_EVENT_TRIGGER) ||
+		    (h->config.dmaEvt != dmaEvt))
+		{
+			continue;
+		}
+
+		/* Static buffers sit in the low 4 GB (tests link -no-pie) */
+		src   = (Uint32 *)(uintptr_t)h->config.srcAddr;
+		words = h->config.dataLen / 4;
+		word  = src[h->pos];
+
+		if (h->config.destAddr == HOST_I2S2_TXLT0_ADDR)
+		{
+			HOST_regSet(&regs->I2STXLT0, (Uint16)(word & 0xFFFF));
+			HOST_regSet(&regs->I2STXLT1, (Uint16)(word >> 16));
+		}
+		else if (h->config.destAddr == HOST_I2S2_TXRT0_ADDR)
+		{
+			HOST_regSet(&regs->I2STXRT0, (Uint16)(word & 0xFFFF));
+			HOST_regSet(&regs->I2STXRT1, (Uint16)(word >> 16));
+		}
+
+		h->pos++;
+		if (h->config.pingPongMode && (h->pos == words / 2))
+		{
+			h->lastHalf = 0;
+		}
+		else if (h->pos == words)
+		{
+			h->lastHalf = h->config.pingPongMode ? 1 : 0;
+			h->pos      = 0;
+			h->running  = h->config.autoMode ? TRUE : FALSE;
+		}
+		else
+		{
+			continue;
+		}
+
+		if (h->config.dmaInt == CSL_DMA_INTERRUPT_ENABLE)
+		{
+			done |= (1 << chan);
+		}
+	}
+
+	if (done != 0)
+	{
+		HOST_regSet(&CSL_SYSCTRL_REGS->DMAIFR,
+		            HOST_regGet(&CSL_SYSCTRL_REGS->DMAIFR) | done);
+		HOST_irqRaise(DMA_EVENT);
+	}
+}
+
+void HOST_dmaFailOpen(CSL_DMAChanNum chan)
+{
+	dmaFailOpen |= (1 << chan);
+}
+
+Bool HOST_dmaChannelOpen(CSL_DMAChanNum chan)
+{
+	return ((dmaChan[chan] != NULL) ? TRUE : FALSE);
+}
+
+Uint16 HOST_dmaOpenCount(void)
+{
+	Uint16 chan;
+	Uint16 count = 0;
+
+	for (chan = 0; chan < HOST_DMA_CHANNELS; chan++)
+	{
+		count += (dmaChan[chan] != NULL) ? 1 : 0;
+	}
+
+	return (count);
+}
+
+/****************************************************************************
+ * GPIO
+ ****************************************************************************/
+
+static Uint32 gpioLevel;
+static int    gpioTrigger[CSL_GPIO_NUM_PIN];
+
+static void HOST_gpioWrite(Uint16 reg, Uint16 old, volatile Uint16 *value)
+{
+	if ((reg == HOST_REG(CSL_GpioRegs, IOINTFLG1)) ||
+	    (reg == HOST_REG(CSL_GpioRegs, IOINTFLG2)))
+	{
+		*value = old & ~*value;
+	}
+}
+
+/* Register and bit of 'pin' in a 1/2 register pair */
+static volatile Uint16 *HOST_gpioReg(volatile Uint16 *reg1, Uint16 pin,
+                                     Uint16 *bit)
+{
+	*bit = 1 << (pin & 0xF);
+
+	return ((pin < 16) ? reg1 : reg1 + 1);
+}
+
+CSL_GpioHandle GPIO_open(CSL_GpioObj *obj, CSL_Status *status)
+{
+	*status = CSL_SOK;
+
+	return (obj);
+}
+
+CSL_Status GPIO_reset(CSL_GpioHandle hGpio)
+{
+	memset(gpioTrigger, 0, sizeof(gpioTrigger));
+	HOST_regSet(&CSL_GPIO_REGS->IOINTEN1, 0);
+	HOST_regSet(&CSL_GPIO_REGS->IOINTEN2, 0);
+	HOST_regSet(&CSL_GPIO_REGS->IOINTEDG1, 0);
+	HOST_regSet(&CSL_GPIO_REGS->IOINTEDG2, 0);
+
+	return (CSL_SOK);
+}
+
+CSL_Status GPIO_configBit(CSL_GpioHandle hGpio, CSL_GpioPinConfig *config)
+{
+	if ((config->pinNum < 0) || (config->pinNum >= CSL_GPIO_NUM_PIN))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	gpioTrigger[config->pinNum] = config->trigger;
+
+	return (CSL_SOK);
+}
+
+static CSL_Status HOST_gpioSetBit(volatile Uint16 *reg1, int pin, Bool set)
+{
+	volatile Uint16 *reg;
+	Uint16           bit;
+
+	if ((pin < 0) || (pin >= CSL_GPIO_NUM_PIN))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	reg = HOST_gpioReg(reg1, (Uint16)pin, &bit);
+	HOST_regSet(reg, set ? (HOST_regGet(reg) | bit) :
+	                       (HOST_regGet(reg) & ~bit));
+
+	return (CSL_SOK);
+}
+
+CSL_Status GPIO_enableInt(CSL_GpioHandle hGpio, CSL_GpioPinNum pin)
+{
+	return (HOST_gpioSetBit(&CSL_GPIO_REGS->IOINTEN1, pin, TRUE));
+}
+
+CSL_Status GPIO_disableInt(CSL_GpioHandle hGpio, CSL_GpioPinNum pin)
+{
+	return (HOST_gpioSetBit(&CSL_GPIO_REGS->IOINTEN1, pin, FALSE));
+}
+
+Int16 GPIO_statusBit(CSL_GpioHandle hGpio, CSL_GpioPinNum pin,
+                     CSL_Status *status)
+{
+	Uint16 bit;
+	Uint16 flags;
+
+	*status = CSL_SOK;
+	flags   = HOST_regGet(HOST_gpioReg(&CSL_GPIO_REGS->IOINTFLG1,
+	                                   (Uint16)pin, &bit));
+
+	return ((flags & bit) ? 1 : 0);
+}
+
+CSL_Status GPIO_clearInt(CSL_GpioHandle hGpio, CSL_GpioPinNum pin)
+{
+	return (HOST_gpioSetBit(&CSL_GPIO_REGS->IOINTFLG1, pin, FALSE));
+}
+
+CSL_Status GPIO_read(CSL_GpioHandle hGpio, CSL_GpioPinNum pin, Uint16 *val)
+{
+	*val = (gpioLevel >> pin) & 1;
+
+	return (CSL_SOK);
+}
+
+/**
+ *
+ * \brief Drives an input pin; an edge matching its trigger sets the flag
+ *        and raises the GPIO event if the pin interrupt is enabled
+ *
+ */
+void HOST_gpioSetPin(Uint16 pin, Uint16 level)
+{
+	volatile Uint16 *flag;
+	Uint16           bit;
+	Bool             rising;
+
+	if (((gpioLevel >> pin) & 1) == (level ? 1u : 0u))
+	{
+		return;
+	}
+
+	gpioLevel ^= (1u << pin);
+	rising     = level ? TRUE : FALSE;
+
+	if (!((rising && (gpioTrigger[pin] == CSL_GPIO_TRIG_RISING_EDGE)) ||
+	      (!rising && (gpioTrigger[pin] == CSL_GPIO_TRIG_FALLING_EDGE))))
+	{
+		return;
+	}
+
+	if ((HOST_regGet(HOST_gpioReg(&CSL_GPIO_REGS->IOINTEN1, pin, &bit)) &
+	     bit) == 0)
+	{
+		return;
+	}
+
+	flag = HOST_gpioReg(&CSL_GPIO_REGS->IOINTFLG1, pin, &bit);
+	HOST_regSet(flag, HOST_regGet(flag) | bit);
+	HOST_irqRaise(GPIO_EVENT);
+}
+
+/****************************************************************************
+ * UART
+ ****************************************************************************/
+
+#define HOST_UART_RX_SIZE   (4096)
+
+static HOST_UartSinkFxn  uartSink;
+static void             *uartSinkArg;
+static Uint8            *uartTx;
+static Uint32            uartTxCount;
+static Uint32            uartTxMax;
+static Uint8             uartRx[HOST_UART_RX_SIZE];
+static Uint32            uartRxHead;
+static Uint32            uartRxTail;
+static Bool              uartHeld;
+static Uint32            uartBaudRate;
+
+static void HOST_uartSend(Uint8 byte)
+{
+	if (uartSink != NULL)
+	{
+		uartSink(byte, uartSinkArg);
+		return;
+	}
+
+	if (uartTxCount == uartTxMax)
+	{
+		uartTxMax = (uartTxMax == 0) ? 4096 : 2 * uartTxMax;
+		uartTx    = realloc(uartTx, uartTxMax);
+	}
+	uartTx[uartTxCount++] = byte;
+}
+
+static Uint16 HOST_uartIer(void)
+{
+	return (HOST_regGet(&uartObj.uartRegs->IER));
+}
+
+static Bool HOST_uartLevel(void)
+{
+	Uint16 ier = HOST_uartIer();
+
+	return ((((ier & CSL_UART_IER_ETBEI_MASK) && !uartHeld) ||
+	         ((ier & CSL_UART_IER_ERBI_MASK) && (uartRxHead != uartRxTail))) ?
+	        TRUE : FALSE);
+}
+
+static void HOST_uartRead(Uint16 reg, volatile Uint16 *value)
+{
+	if (reg == HOST_REG(CSL_UartRegs, LSR))
+	{
+		*value = ((uartRxHead != uartRxTail) ? CSL_UART_LSR_DR_MASK : 0) |
+		         (uartHeld ? 0 : (CSL_UART_LSR_THRE_MASK |
+		                          CSL_UART_LSR_TEMT_MASK));
+	}
+	else if (reg == HOST_REG(CSL_UartRegs, RBR))
+	{
+		if (uartRxHead != uartRxTail)
+		{
+			*value = uartRx[uartRxTail++ % HOST_UART_RX_SIZE];
+		}
+	}
+	else if (reg == HOST_REG(CSL_UartRegs, IIR))
+	{
+		if ((HOST_uartIer() & CSL_UART_IER_ERBI_MASK) &&
+		    (uartRxHead != uartRxTail))
+		{
+			*value = 0x4;
+		}
+		else if ((HOST_uartIer() & CSL_UART_IER_ETBEI_MASK) && !uartHeld)
+		{
+			*value = 0x2;
+		}
+		else
+		{
+			*value = 0x1;
+		}
+	}
+}
+
+static void HOST_uartWrite(Uint16 reg, Uint16 old, volatile Uint16 *value)
+{
+	if (reg == HOST_REG(CSL_UartRegs, THR))
+	{
+		HOST_uartSend((Uint8)*value);
+	}
+
+	/* The FIFO empties at once, THR empty is asserted again */
+	if (((reg == HOST_REG(CSL_UartRegs, THR)) ||
+	     (reg == HOST_REG(CSL_UartRegs, IER))) && HOST_uartLevel())
+	{
+		HOST_irqRaise(UART_EVENT);
+	}
+}
+
+CSL_Status UART_init(CSL_UartObj *obj, int instance, int opMode)
+{
+	obj->uartRegs = (CSL_UartRegs *)uartBlock;
+
+	return (CSL_SOK);
+}
+
+CSL_Status UART_setup(CSL_UartHandle hUart, CSL_UartSetup *setup)
+{
+	return (UART_setupBaudRate(hUart, setup->clkInput, setup->baud));
+}
+
+CSL_Status UART_setupBaudRate(CSL_UartHandle hUart, Uint32 clkInput,
+                              Uint32 baudRate)
+{
+	Uint32 divisor;
+
+	if ((hUart == NULL) || (baudRate == 0))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	divisor = (clkInput + 8 * baudRate) / (16 * baudRate);
+	if (divisor == 0)
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	hUart->sysClk = clkInput;
+	hUart->baud   = baudRate;
+	uartBaudRate  = clkInput / (16 * divisor);
+
+	return (CSL_SOK);
+}
+
+CSL_Status UART_read(CSL_UartHandle hUart, char *buf, Uint16 count,
+                     Uint16 timeout)
+{
+	while (count--)
+	{
+		*buf++ = (uartRxHead != uartRxTail) ?
+		         (char)uartRx[uartRxTail++ % HOST_UART_RX_SIZE] : 0;
+	}
+
+	return (CSL_SOK);
+}
+
+CSL_Status UART_write(CSL_UartHandle hUart, char *buf, Uint16 count,
+                      Uint16 timeout)
+{
+	while (count--)
+	{
+		HOST_uartSend((Uint8)*buf++);
+	}
+
+	return (CSL_SOK);
+}
+
+CSL_Status UART_fputc(CSL_UartHandle hUart, char c, Uint16 timeout)
+{
+	HOST_uartSend((Uint8)c);
+
+	return (CSL_SOK);
+}
+
+CSL_Status UART_fputs(CSL_UartHandle hUart, const char *s, Uint16 timeout)
+{
+	while (*s != '\0')
+	{
+		HOST_uartSend((Uint8)*s++);
+	}
+
+	return (CSL_SOK);
+}
+
+CSL_Status UART_eventEnable(CSL_UartHandle hUart, int event)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status UART_eventDisable(CSL_UartHandle hUart, int event)
+{
+	return (CSL_SOK);
+}
+
+void HOST_uartSetSink(HOST_UartSinkFxn sinkFxn, void *arg)
+{
+	uartSink    = sinkFxn;
+	uartSinkArg = arg;
+}
+
+Uint32 HOST_uartTake(Uint8 *buf, Uint32 max)
+{
+	Uint32 n = (uartTxCount < max) ? uartTxCount : max;
+
+	memcpy(buf, uartTx, n);
+	memmove(uartTx, uartTx + n, uartTxCount - n);
+	uartTxCount -= n;
+
+	return (n);
+}
+
+void HOST_uartReceive(const Uint8 *data, Uint32 length)
+{
+	while (length-- && ((uartRxHead - uartRxTail) < HOST_UART_RX_SIZE))
+	{
+		uartRx[uartRxHead++ % HOST_UART_RX_SIZE] = *data++;
+	}
+
+	if (HOST_uartLevel())
+	{
+		HOST_irqRaise(UART_EVENT);
+	}
+}
+
+void HOST_uartHold(Bool hold)
+{
+	uartHeld = hold;
+
+	if (!hold && HOST_uartLevel())
+	{
+		HOST_irqRaise(UART_EVENT);
+	}
+}
+
+Uint32 HOST_uartBaud(void)
+{
+	return (uartBaudRate);
+}
+
+/****************************************************************************
+ * MMC/SD
+ ****************************************************************************/
+
+#define HOST_MMCSD_SECTOR   (512)
+
+static const Uint8 *mmcsdImage;
+static Uint32       mmcsdBytes;
+static Bool         mmcsdHighCapacity;
+static Uint32       mmcsdFailReads;
+static Uint32       mmcsdReads;
+static Uint16       mmcsdClkDiv;
+
+void HOST_mmcsdInsert(const Uint8 *image, Uint32 bytes, Bool highCapacity)
+{
+	mmcsdImage        = image;
+	mmcsdBytes        = bytes;
+	mmcsdHighCapacity = highCapacity;
+	mmcsdFailReads    = 0;
+	mmcsdReads        = 0;
+}
+
+void HOST_mmcsdFailReads(Uint32 count)
+{
+	mmcsdFailReads = count;
+}
+
+Uint32 HOST_mmcsdReads(void)
+{
+	return (mmcsdReads);
+}
+
+Uint16 HOST_mmcsdClockDiv(void)
+{
+	return (mmcsdClkDiv);
+}
+
+CSL_MmcsdHandle MMC_open(CSL_MMCControllerObj *pMmcsdContObj,
+                         CSL_MmcsdInstId instId, CSL_MMCSDOpMode opMode,
+                         CSL_Status *status)
+{
+	memset(pMmcsdContObj, 0, sizeof(*pMmcsdContObj));
+	*status = CSL_SOK;
+
+	return (pMmcsdContObj);
+}
+
+CSL_Status MMC_close(CSL_MmcsdHandle hMmcsd)
+{
+	return ((hMmcsd == NULL) ? CSL_ESYS_BADHANDLE : CSL_SOK);
+}
+
+CSL_Status MMC_sendGoIdle(CSL_MmcsdHandle hMmcsd)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status MMC_selectCard(CSL_MmcsdHandle hMmcsd, CSL_MMCCardObj *pCardObj)
+{
+	memset(pCardObj, 0, sizeof(*pCardObj));
+	hMmcsd->cardObj = pCardObj;
+
+	if (mmcsdImage != NULL)
+	{
+		pCardObj->cardType     = CSL_SD_CARD;
+		pCardObj->sdHcDetected = mmcsdHighCapacity;
+	}
+
+	return (CSL_SOK);
+}
+
+CSL_Status MMC_sendOpCond(CSL_MmcsdHandle hMmcsd, Uint16 clkDivValue)
+{
+	hMmcsd->clkDiv = clkDivValue;
+	mmcsdClkDiv    = clkDivValue;
+
+	return ((mmcsdImage != NULL) ? CSL_SOK : CSL_ESYS_FAIL);
+}
+
+CSL_Status SD_sendAllCID(CSL_MmcsdHandle hMmcsd,
+                         CSL_MMCCardIdObj *pSdCardIdObj)
+{
+	memset(pSdCardIdObj, 0, sizeof(*pSdCardIdObj));
+
+	return (CSL_SOK);
+}
+
+CSL_Status SD_sendRca(CSL_MmcsdHandle hMmcsd, CSL_MMCCardObj *pSdCardObj,
+                      Uint16 *pRCardAddr)
+{
+	pSdCardObj->rca = 1;
+	*pRCardAddr     = 1;
+
+	return (CSL_SOK);
+}
+
+CSL_Status SD_getCardCsd(CSL_MmcsdHandle hMmcsd,
+                         CSL_MMCCardCsdObj *pSdCardCsdObj)
+{
+	memset(pSdCardCsdObj, 0, sizeof(*pSdCardCsdObj));
+	pSdCardCsdObj->readBlLen = 9;
+
+	return (CSL_SOK);
+}
+
+CSL_Status MMC_setCardType(CSL_MMCCardObj *pCardObj, CSL_CardType cardType)
+{
+	pCardObj->cardType = cardType;
+
+	return (CSL_SOK);
+}
+
+CSL_Status MMC_setCardPtr(CSL_MmcsdHandle hMmcsd, CSL_MMCCardObj *pCardObj)
+{
+	hMmcsd->cardObj = pCardObj;
+
+	return (CSL_SOK);
+}
+
+CSL_Status MMC_getNumberOfBlocks(CSL_MmcsdHandle hMmcsd, Uint32 *pNumBlks)
+{
+	*pNumBlks = mmcsdBytes / HOST_MMCSD_SECTOR;
+
+	return (CSL_SOK);
+}
+
+CSL_Status MMC_setEndianMode(CSL_MmcsdHandle hMmcsd,
+                             CSL_MmcsdEndianModes writeEndianMode,
+                             CSL_MmcsdEndianModes readEndianMode)
+{
+	hMmcsd->littleEndian = (readEndianMode == CSL_MMCSD_ENDIAN_LITTLE);
+
+	return (CSL_SOK);
+}
+
+CSL_Status MMC_setBlockLength(CSL_MmcsdHandle hMmcsd, Uint32 blockLen)
+{
+	hMmcsd->blockLen = blockLen;
+	if (hMmcsd->cardObj != NULL)
+	{
+		hMmcsd->cardObj->blockLength = blockLen;
+	}
+
+	return (CSL_SOK);
+}
+
+/* Whole blocks only, from a block aligned address in the card's unit */
+CSL_Status MMC_read(CSL_MmcsdHandle hMmcsd, Uint32 cardAddr,
+                    Uint16 noOfBytes, Uint16 *pReadBuffer)
+{
+	Uint32 offset;
+	Uint16 i;
+
+	mmcsdReads++;
+
+	if ((mmcsdImage == NULL) || (hMmcsd == NULL) ||
+	    (hMmcsd->cardObj == NULL) || (hMmcsd->blockLen != HOST_MMCSD_SECTOR))
+	{
+		return (CSL_ESYS_FAIL);
+	}
+
+	if (mmcsdHighCapacity)
+	{
+		offset = cardAddr * HOST_MMCSD_SECTOR;
+	}
+	else
+	{
+		offset = cardAddr;
+	}
+
+	if ((noOfBytes == 0) || ((noOfBytes % HOST_MMCSD_SECTOR) != 0) ||
+	    ((offset % HOST_MMCSD_SECTOR) != 0) ||
+	    (offset + noOfBytes > mmcsdBytes))
+	{
+		return (CSL_ESYS_INVPARAMS);
+	}
+
+	if (mmcsdFailReads != 0)
+	{
+		mmcsdFailReads--;
+		return (CSL_ESYS_FAIL);
+	}
+
+	for (i = 0; i < noOfBytes / 2; i++)
+	{
+		if (hMmcsd->littleEndian)
+		{
+			pReadBuffer[i] = mmcsdImage[offset + 2 * i] |
+			                 ((Uint16)mmcsdImage[offset + 2 * i + 1] << 8);
+		}
+		else
+		{
+			pReadBuffer[i] = ((Uint16)mmcsdImage[offset + 2 * i] << 8) |
+			                 mmcsdImage[offset + 2 * i + 1];
+		}
+	}
+
+	return (CSL_SOK);
+}
+
+/****************************************************************************
+ * General purpose timers, only the target builds run them
+ ****************************************************************************/
+
+CSL_Handle GPT_open(CSL_Instance instance, CSL_GptObj *obj,
+                    CSL_Status *status)
+{
+	*status = CSL_SOK;
+
+	return (obj);
+}
+
+CSL_Status GPT_reset(CSL_Handle hGpt)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status GPT_config(CSL_Handle hGpt, CSL_Config *config)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status GPT_start(CSL_Handle hGpt)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status GPT_stop(CSL_Handle hGpt)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status GPT_close(CSL_Handle hGpt)
+{
+	return (CSL_SOK);
+}
+
+CSL_Status GPT_getCnt(CSL_Handle hGpt, Uint32 *count)
+{
+	*count = 0;
+
+	return (CSL_SOK);
+}
+
+/****************************************************************************
+ * Reset state
+ ****************************************************************************/
+
+__attribute__((constructor))
+static void HOST_periphInit(void)
+{
+	CSL_SysRegs *sys = CSL_SYSCTRL_REGS;
+
+	/* PLL at 32.768 kHz * 3052 = 100.008 MHz, RD bypassed, as set up by
+	 * initPlatform() */
+	sys->CGCR1 = 0x8000 | (3052 - 4);
+	sys->CGCR2 = 0x8000;
+	sys->CGCR3 = 0x0806;
+	sys->CGCR4 = 0x0000;
+	sys->CCR2  = 0x0001;
+
+	HOST_mmioWatch(sysBlock, NULL, HOST_sysWrite);
+	HOST_mmioWatch(gpioBlock, NULL, HOST_gpioWrite);
+
+	uartObj.uartRegs = (CSL_UartRegs *)uartBlock;
+	HOST_mmioWatch(uartBlock, HOST_uartRead, HOST_uartWrite);
+	HOST_irqSetLevel(UART_EVENT, HOST_uartLevel);
+
+	HOST_i2sWatch(TRUE);
+}
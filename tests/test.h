@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test.h
+*
+*   \brief Check macros of the host tests.
+*
+*   A test program is a list of test functions run by TEST_RUN(); a failed
+*   check prints where it was and the test carries on. main() returns the
+*   number of failed checks, so 'make check' stops on the first program
+*   that had any.
+*
+*/
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include "csl_host.h"
+#include <time.h>
+
+extern int testFailures;
+
+#define TEST_MAIN_DATA      int testFailures
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) \
+		{ \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			testFailures++; \
+		} \
+	} while (0)
+
+#define CHECK_EQ(actual, expected) \
+	do { \
+		long long _a = (long long)(actual); \
+		long long _e = (long long)(expected); \
+		if (_a != _e) \
+		{ \
+			printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, \
+			       #actual, _a, _e); \
+			testFailures++; \
+		} \
+	} while (0)
+
+#define TEST_RUN(fxn) \
+	do { \
+		int _before = testFailures; \
+		fxn(); \
+		printf("%-40s %s\n", #fxn, \
+		       (testFailures == _before) ? "ok" : "FAILED"); \
+	} while (0)
+
+/* Benchmark timer, ns per call of 'body' averaged over 'iterations' */
+#define BENCH(name, iterations, body) \
+	do { \
+		struct timespec _t0, _t1; \
+		long _i; \
+		clock_gettime(CLOCK_MONOTONIC, &_t0); \
+		for (_i = 0; _i < (iterations); _i++) \
+		{ \
+			body; \
+		} \
+		clock_gettime(CLOCK_MONOTONIC, &_t1); \
+		printf("  bench %-32s %10.1f ns\n", name, \
+		       ((_t1.tv_sec - _t0.tv_sec) * 1e9 + \
+		        (_t1.tv_nsec - _t0.tv_nsec)) / (double)(iterations)); \
+	} while (0)
+
+#endif /* _TEST_H_ */
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_adpcm.c
+*
+*   \brief Host test and benchmark of the IMA-ADPCM codec against
+*          reference vectors.
+*
+*   The vectors were produced by an independent IMA/DVI implementation
+*   (Python's audioop lin2adpcm/adpcm2lin) and repacked first sample in
+*   the low nibble. refInput covers silence, a 1 kHz tone at 8 kHz, a full
+*   scale square that saturates the predictor, noise and a decaying burst;
+*   randCodes is arbitrary codes decoded from the state (-1234, 40).
+*
+*/
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "test.h"
+#include "adpcm.h"
+
+TEST_MAIN_DATA;
+
+#define REF_SAMPLES     (242)
+#define RAND_SAMPLES    (160)
+#define BLOCK_FRAMES    (48)
+
+static const Int16 refInput[242] =
+{
+	     0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+	     0,      0,      0,      0,      0,      0,      0,   8485,  12000,   8485,
+	     0,  -8485, -12000,  -8485,      0,   8485,  12000,   8485,      0,  -8485,
+	-12000,  -8485,      0,   8485,  12000,   8485,      0,  -8485, -12000,  -8485,
+	     0,   8485,  12000,   8485,      0,  -8485, -12000,  -8485,      0,   8485,
+	 12000,   8485,      0,  -8485, -12000,  -8485,      0,   8485,  12000,   8485,
+	     0,  -8485, -12000,  -8485,      0,   8485,  12000,   8485,      0,  -8485,
+	-12000,  -8485,      0,   8485,  12000,   8485,      0,  -8485, -12000,  -8485,
+	     0,   8485,  12000,   8485,      0,  -8485, -12000,  -8485,      0,   8485,
+	 12000,   8485,      0,  -8485, -12000,  -8485, -32768, -32768, -32768, -32768,
+	-32768, -32768, -32768, -32768,  32767,  32767,  32767,  32767,  32767,  32767,
+	 32767,  32767, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+	 32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,   6050,  -3187,
+	   -36,  -7434,   -262,   2719,  -7411,  -1551,    353,   2442,    847,  11380,
+	  -923,  -2567,  -3065,  -6536,  -6031,   5050,  -6134,    268,  -3437,  -1459,
+	  3795,  -4078,   1552,  -1000,   3571,   1454,  -1989,  -2906,  -1826,   5767,
+	 -1679,   7786,    760,   8671,  -1262,   8853,  -3673, -12075,    471,   -480,
+	   691,  -1713,   6204,   3060,   2787,  -6680,  -3040,   1208,  -2304,  -2468,
+	 12461,   -959,  -4789,   7256,   4958,  -8787,  12152,   -548,   2301,  -5855,
+	 10687,   5945,   8448,  -1969,   1261,  -7015,   1407,  -6455,   3288,   6692,
+	 -3956, -14165, -16368, -11057,  -1903,   6418,  10442,   9198,   4182,  -1742,
+	 -5835,  -6650,  -4427,   -683,   2679,   4267,   3713,   1645,   -762,  -2402,
+	 -2701,  -1771,   -240,   1117,   1743,   1498,    646,   -331,   -988,  -1097,
+	  -708,    -82,    465,    712,    604,    253,   -143,   -406,   -445,   -283,
+	   -27,    193
+};
+
+static const Uint16 refCodes[61] =
+{
+	0x0000, 0x0000, 0x0000, 0x0000, 0x7770, 0xFFFD, 0x8775, 0x19BD,
+	0xA135, 0x19DB, 0xA134, 0x19DB, 0xA134, 0x19DB, 0xA134, 0x19DB,
+	0xA134, 0x19DB, 0xA134, 0x19DB, 0xA134, 0x19DB, 0xA134, 0x19DB,
+	0x089F, 0x8088, 0x0177, 0x0000, 0x08BF, 0x8088, 0x0047, 0x0000,
+	0x909D, 0x1A01, 0x3810, 0x908D, 0x2C40, 0xB209, 0x9292, 0x6199,
+	0x2A5B, 0xAC4C, 0x8084, 0xB881, 0x0A21, 0x59B7, 0xA5C8, 0x8390,
+	0xB1B0, 0x14B3, 0x18BC, 0x8134, 0x8ABA, 0x1231, 0xAAA8, 0x3218,
+	0xAA91, 0x318A, 0xA812, 0x189B, 0x0032
+};
+
+static const Int16 refDecoded[242] =
+{
+	     0,      0,      0,      0,      0,      0,      0,      0,      0,      0,
+	     0,      0,      0,      0,      0,      0,      0,     11,     41,    104,
+	     4,   -195,   -625,  -1550,    -93,   2817,   9053,   8162,   -753,  -9058,
+	-12293,  -9352,    454,   9590,  13149,   7756,    893,  -8913, -12828,  -9269,
+	   439,   9575,  13134,   7741,    878,  -8928, -12843,  -9284,    424,   9560,
+	 13119,   7726,    863,  -8943, -12858,  -9299,    409,   9545,  13104,   7711,
+	   848,  -8958, -12873,  -9314,    394,   9530,  13089,   7696,    833,  -8973,
+	-12888,  -9329,    379,   9515,  13074,   7681,    818,  -8988, -12903,  -9344,
+	   364,   9500,  13059,   7666,    803,  -9003, -12918,  -9359,    349,   9485,
+	 13044,   7651,    788,  -9018, -12933,  -9374, -25554, -32491, -32768, -30857,
+	-32594, -32768, -31333, -32638, -14840,  23315,  32767,  32767,  32767,  32767,
+	 32767,  32767,  -1920, -30589, -32768, -29383, -32460, -32768, -30225, -32537,
+	 -1004,  32767,  32767,  32767,  32767,  32767,  32767,  32767,   7330,  -2826,
+	   251,  -8143,   -513,   1799,  -8712,  -2979,  -1242,   3495,   2060,  11196,
+	 -1856,  -3593,  -2014,  -6320,  -5015,   5664,  -7258,   1428,  -3309,  -1874,
+	  4652,  -3653,   1740,  -1201,   3256,    825,  -1384,  -3392,  -1567,   5628,
+	 -1235,   8571,   2045,   7977,  -1731,  10016,  -4198, -13753,   1883,   -219,
+	  1692,    -45,   4692,   3257,   1952,  -6353,  -3118,   1784,  -2673,  -1863,
+	  9187,  -1867,  -6173,   8184,   6273,  -9363,  13761,  -1627,   1171,  -6459,
+	  9728,   7626,   9537,  -2623,   2114,  -7935,   1201,  -7104,   2604,   6519,
+	 -4160, -14209, -15514, -11955,  -2247,   6889,  10448,   9370,   4468,  -1772,
+	 -5824,  -6560,  -4552,   -292,   2475,   3984,   3527,   1449,   -441,  -2158,
+	 -2470,  -1618,   -327,   1315,   1954,   1372,    491,   -310,  -1038,  -1170,
+	  -810,    -44,    453,    724,    642,    269,   -207,   -391,   -447,   -294,
+	   -63,    231
+};
+
+static const Uint16 randCodes[40] =
+{
+	0x0E5F, 0xB24B, 0x0516, 0x9928, 0xF8B5, 0xB799, 0xAE1F, 0x049D,
+	0x599D, 0x7D4C, 0xCD31, 0x09F8, 0x1676, 0xAF4B, 0x5B57, 0x7475,
+	0x45B8, 0xACC2, 0x6AB3, 0x675A, 0x6C89, 0x7F96, 0x6C99, 0x5610,
+	0x2492, 0x522D, 0x4EC6, 0x311E, 0x9497, 0x7991, 0x6FC0, 0xF454,
+	0x659B, 0xE58E, 0x355E, 0x9E00, 0xC629, 0xC198, 0xF1D4, 0xA9B3
+};
+
+static const Int16 randDecoded[160] =
+{
+	 -1865,   -870,  -2592,  -2358,  -3850,  -2104,   -931,  -2423,     99,   1129,
+	  4564,   5021,   4606,   6496,   5466,   4530,   7654,   4745,   4367,   -786,
+	 -2995,  -5003,   4128,  -5008, -22806, -15176, -32768, -32768, -32768, -32768,
+	   750,   4845, -32768, -32768, -32768,   4474, -32388,   4474, -32768,  28668,
+	 32767,  32767,  -4475, -32768, -32768, -32768, -32768, -29044,  14970,  32767,
+	 32767,  32767,   6698,  32767, -28669, -32768,  23095,  32767,   4098,  32767,
+	 32767,  32767,  32767,  32767,  28672,   2603,  32767,  32767,  32767,   -751,
+	-32768, -32768,  -6699, -30398, -32768,   3607, -16871,  24095,  32767,  32767,
+	 20481,  16757, -13714,  32767,  32767,  20481, -32768,  28668,  16382,   5210,
+	-25261,  27984,  32079,  32767,  32767,  32767,  32767,  21595,  32767,  32767,
+	 -8199,  12279,  30900,  32767,  32767,  -4095, -32768,   4094, -32768, -20482,
+	 -9310,  14389,  32767,  20481,  32767,  20481,  31653,  21497,  12265,  32767,
+	 32767,   -751, -32768,  20477,  32767,  32767,  32767, -28669, -32768, -32768,
+	  4474,  32767, -20478, -24573,  16393, -32768, -32768,  12285,  32767,  32767,
+	 32767,  32767,  -7244, -19530, -30702, -13774,  26237, -10625, -14720, -25892,
+	-15736, -32768,    750, -32768, -20482, -32768,  -4099, -30168, -32768, -32768
+};
+
+
+static Int16 out[REF_SAMPLES];
+
+static void test_encodeMatchesReference(void)
+{
+	Uint16      codes[ADPCM_WORDS(REF_SAMPLES)];
+	ADPCM_State state;
+	Uint16      i;
+
+	/* Unused nibbles of the last word must be left alone */
+	memset(codes, 0xFF, sizeof(codes));
+
+	ADPCM_init(&state, 0, 0);
+	ADPCM_encode(&state, refInput, codes, 0, 100);
+	ADPCM_encode(&state, &refInput[100], codes, 100, REF_SAMPLES - 100);
+
+	for (i = 0; i < ADPCM_WORDS(REF_SAMPLES) - 1; i++)
+	{
+		CHECK_EQ(codes[i], refCodes[i]);
+	}
+	CHECK_EQ(codes[i], refCodes[i] | 0xFF00);
+	CHECK_EQ(state.predictor, 231);
+	CHECK_EQ(state.index, 39);
+}
+
+static void test_decodeMatchesReference(void)
+{
+	ADPCM_State state;
+	Uint32      pos;
+	Uint16      count;
+	Uint16      i;
+
+	/* Uneven pieces start and end on every nibble of a word */
+	ADPCM_init(&state, 0, 0);
+	for (pos = 0, count = 1; pos < REF_SAMPLES; pos += count, count++)
+	{
+		if (count > REF_SAMPLES - pos)
+		{
+			count = (Uint16)(REF_SAMPLES - pos);
+		}
+		ADPCM_decode(&state, refCodes, pos, &out[pos], count);
+	}
+	for (i = 0; i < REF_SAMPLES; i++)
+	{
+		CHECK_EQ(out[i], refDecoded[i]);
+	}
+
+	ADPCM_init(&state, -1234, 40);
+	ADPCM_decode(&state, randCodes, 0, out, RAND_SAMPLES);
+	for (i = 0; i < RAND_SAMPLES; i++)
+	{
+		CHECK_EQ(out[i], randDecoded[i]);
+	}
+	CHECK_EQ(state.predictor, -32768);
+	CHECK_EQ(state.index, 84);
+}
+
+/* Codes placed right before an inaccessible page: a decode that ends on a
+ * word boundary used to load the word after the last one */
+static void test_decodeNoOverread(void)
+{
+	long         page = sysconf(_SC_PAGESIZE);
+	Uint8       *map;
+	Uint16      *codes;
+	ADPCM_State  state;
+	Uint16       i;
+
+	map = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE,
+	           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	CHECK(map != MAP_FAILED);
+	if (map == MAP_FAILED)
+	{
+		return;
+	}
+	CHECK_EQ(mprotect(map + page, page, PROT_NONE), 0);
+
+	codes = (Uint16 *)(map + page) - 8;
+	memcpy(codes, randCodes, 8 * sizeof(Uint16));
+
+	ADPCM_init(&state, -1234, 40);
+	ADPCM_decode(&state, codes, 0, out, 32);
+	for (i = 0; i < 32; i++)
+	{
+		CHECK_EQ(out[i], randDecoded[i]);
+	}
+
+	ADPCM_init(&state, 0, 0);
+	ADPCM_decode(&state, codes, 30, out, 2);
+	ADPCM_decode(&state, codes, 32, out, 0);
+
+	munmap(map, 2 * page);
+}
+
+static void test_streamMatchesOneShot(void)
+{
+	static const ADPCM_State start = { 0, 0 };
+	ADPCM_Stream stream;
+	Int16        left[BLOCK_FRAMES];
+	Int16        right[BLOCK_FRAMES];
+	Uint32       pos;
+	Uint16       i;
+
+	ADPCM_streamInit(&stream, refCodes, REF_SAMPLES, &start, FALSE);
+	for (pos = 0; pos < 6 * BLOCK_FRAMES; pos += BLOCK_FRAMES)
+	{
+		ADPCM_fill(left, right, BLOCK_FRAMES, &stream);
+		for (i = 0; i < BLOCK_FRAMES; i++)
+		{
+			CHECK_EQ(left[i], (pos + i < REF_SAMPLES) ?
+			                  refDecoded[pos + i] : 0);
+			CHECK_EQ(right[i], left[i]);
+		}
+	}
+	CHECK(ADPCM_streamDone(&stream));
+
+	/* A looping stream restarts from the start state */
+	ADPCM_streamInit(&stream, refCodes, REF_SAMPLES, &start, TRUE);
+	for (pos = 0; pos < 2 * REF_SAMPLES; pos += BLOCK_FRAMES)
+	{
+		ADPCM_fill(left, right, BLOCK_FRAMES, &stream);
+		for (i = 0; i < BLOCK_FRAMES; i++)
+		{
+			CHECK_EQ(left[i], refDecoded[(pos + i) % REF_SAMPLES]);
+		}
+	}
+	CHECK(!ADPCM_streamDone(&stream));
+}
+
+static void bench_decode(void)
+{
+	ADPCM_State state;
+	Int16       block[BLOCK_FRAMES];
+	Uint16      codes[ADPCM_WORDS(BLOCK_FRAMES)];
+
+	ADPCM_init(&state, 0, 0);
+	BENCH("ADPCM_decode 48 samples", 200000,
+	      ADPCM_decode(&state, refCodes, (_i & 3) * BLOCK_FRAMES,
+	                   block, BLOCK_FRAMES));
+	BENCH("ADPCM_encode 48 samples", 200000,
+	      ADPCM_encode(&state, &refInput[(_i & 3) * BLOCK_FRAMES], codes,
+	                   0, BLOCK_FRAMES));
+}
+
+int main(void)
+{
+	TEST_RUN(test_encodeMatchesReference);
+	TEST_RUN(test_decodeMatchesReference);
+	TEST_RUN(test_decodeNoOverread);
+	TEST_RUN(test_streamMatchesOneShot);
+	bench_decode();
+
+	return (testFailures);
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_aic3206_cache.c
+*
+*   \brief Host test of the AIC3206 register shadow on the simulated
+*          I2C bus: skipped writes and page selects, read hits and
+*          misses, volatile registers and invalidation on reset.
+*
+*/
+
+#include "test.h"
+#include "aic3206_cache.h"
+
+TEST_MAIN_DATA;
+
+/* Polled writes are one transaction, reads two (repeated start) */
+#define READ_TRANSACTIONS   (2)
+
+static AIC3206_CacheStats stats;
+static AIC3206_CacheStats before;
+
+static Uint32 busTransactions(void)
+{
+	HOST_I2cStats bus;
+
+	HOST_i2cGetStats(&bus);
+	HOST_i2cClearStats();
+
+	return (bus.transactions);
+}
+
+static void statsMark(void)
+{
+	AIC3206_getCacheStats(&before);
+	HOST_i2cClearStats();
+}
+
+#define STAT_DELTA(field)   (stats.field - before.field)
+
+/* Runs first: nothing is known before the first page select or reset */
+static void test_unknownPage(void)
+{
+	Uint16 value;
+
+	HOST_aic3206Attach();
+	statsMark();
+
+	CHECK_EQ(AIC3206_cachePage(), AIC3206_PAGE_UNKNOWN);
+
+	/* The write goes out but cannot be filed under a page */
+	HOST_aic3206SetReg(0, 0, 1);
+	HOST_aic3206SetReg(1, 0, 1);
+	AIC3206_write(20, 0x55);
+	CHECK_EQ(busTransactions(), 1);
+	CHECK_EQ(HOST_aic3206Reg(1, 20), 0x55);
+
+	/* Reading the page register learns the page */
+	CHECK_EQ(AIC3206_read(0, &value), TEST_PASS);
+	CHECK_EQ(value, 1);
+	CHECK_EQ(AIC3206_cachePage(), 1);
+	CHECK_EQ(busTransactions(), READ_TRANSACTIONS);
+
+	AIC3206_getCacheStats(&stats);
+	CHECK_EQ(STAT_DELTA(readMisses), 1);
+	CHECK_EQ(STAT_DELTA(writesIssued), 1);
+}
+
+static void test_pageSelects(void)
+{
+	HOST_aic3206Attach();
+	AIC3206_cacheInvalidate();
+	statsMark();
+
+	/* Page 0 after reset, selecting it again stays off the bus */
+	AIC3206_write(0, 0);
+	CHECK_EQ(busTransactions(), 0);
+
+	AIC3206_write(0, 1);
+	AIC3206_write(0, 1);
+	CHECK_EQ(busTransactions(), 1);
+	CHECK_EQ(HOST_aic3206Reg(0, 0), 1);
+	CHECK_EQ(AIC3206_cachePage(), 1);
+
+	AIC3206_getCacheStats(&stats);
+	CHECK_EQ(STAT_DELTA(pageSkipped), 2);
+	CHECK_EQ(STAT_DELTA(writesIssued), 1);
+}
+
+/* The shell volume and GPIO paths write the same value over and over */
+static void test_redundantWrites(void)
+{
+	HOST_aic3206Attach();
+	AIC3206_cacheInvalidate();
+	statsMark();
+
+	AIC3206_write(65, 0x10);
+	AIC3206_write(65, 0x10);
+	AIC3206_write(65, 0x10);
+	CHECK_EQ(busTransactions(), 1);
+
+	AIC3206_write(65, 0x20);
+	CHECK_EQ(busTransactions(), 1);
+	CHECK_EQ(HOST_aic3206Reg(0, 65), 0x20);
+
+	/* Same register number on the other page is another register */
+	AIC3206_write(0, 1);
+	AIC3206_write(65, 0x20);
+	CHECK_EQ(busTransactions(), 2);
+	CHECK_EQ(HOST_aic3206Reg(1, 65), 0x20);
+
+	AIC3206_getCacheStats(&stats);
+	CHECK_EQ(STAT_DELTA(writesSkipped), 2);
+	CHECK_EQ(STAT_DELTA(writesIssued), 4);
+}
+
+/* A write that failed is reported and not taken into the shadow */
+static void test_failedWriteReported(void)
+{
+	HOST_aic3206Attach();
+	AIC3206_cacheInvalidate();
+
+	CHECK_EQ(AIC3206_write(65, 0x10), TEST_PASS);
+	CHECK_EQ(AIC3206_write(65, 0x10), TEST_PASS);
+
+	/* Nobody acknowledges */
+	HOST_i2cReset();
+	CHECK_EQ(AIC3206_write(65, 0x30), TEST_FAIL);
+
+	HOST_aic3206Attach();
+	HOST_i2cClearStats();
+	CHECK_EQ(AIC3206_write(65, 0x30), TEST_PASS);
+	CHECK_EQ(busTransactions(), 1);
+	CHECK_EQ(HOST_aic3206Reg(0, 65), 0x30);
+}
+
+static void test_readHitsAndMisses(void)
+{
+	Uint16 value;
+
+	HOST_aic3206Attach();
+	AIC3206_cacheInvalidate();
+	HOST_aic3206SetReg(0, 27, 0x0d);
+	statsMark();
+
+	/* First read goes to the codec, the second is served locally */
+	CHECK_EQ(AIC3206_read(27, &value), TEST_PASS);
+	CHECK_EQ(value, 0x0d);
+	CHECK_EQ(busTransactions(), READ_TRANSACTIONS);
+
+	CHECK_EQ(AIC3206_read(27, &value), TEST_PASS);
+	CHECK_EQ(value, 0x0d);
+	CHECK_EQ(busTransactions(), 0);
+
+	/* Written values read back without the bus */
+	AIC3206_write(28, 0x04);
+	busTransactions();
+	CHECK_EQ(AIC3206_read(28, &value), TEST_PASS);
+	CHECK_EQ(value, 0x04);
+	CHECK_EQ(busTransactions(), 0);
+
+	/* Flag registers change on their own and always go to the codec */
+	HOST_aic3206SetReg(0, 37, 0x88);
+	CHECK_EQ(AIC3206_read(37, &value), TEST_PASS);
+	HOST_aic3206SetReg(0, 37, 0x00);
+	CHECK_EQ(AIC3206_read(37, &value), TEST_PASS);
+	CHECK_EQ(value, 0x00);
+	CHECK_EQ(busTransactions(), 2 * READ_TRANSACTIONS);
+
+	AIC3206_getCacheStats(&stats);
+	CHECK_EQ(STAT_DELTA(readHits), 2);
+	CHECK_EQ(STAT_DELTA(readMisses), 3);
+}
+
+static void test_resetInvalidates(void)
+{
+	Uint16 value;
+
+	HOST_aic3206Attach();
+	AIC3206_cacheInvalidate();
+	AIC3206_write(0, 1);
+	AIC3206_write(9, 0x30);
+	AIC3206_write(0, 0);
+	statsMark();
+
+	/* Software reset: every register, the page included, is back at
+	 * its default */
+	AIC3206_write(1, 0x01);
+	CHECK_EQ(busTransactions(), 1);
+	CHECK_EQ(AIC3206_cachePage(), 0);
+
+	AIC3206_write(0, 1);
+	CHECK_EQ(AIC3206_read(9, &value), TEST_PASS);
+	CHECK_EQ(value, 0);
+	CHECK_EQ(busTransactions(), 1 + READ_TRANSACTIONS);
+
+	/* The value cached before the reset has to be written again */
+	AIC3206_write(9, 0x30);
+	CHECK_EQ(busTransactions(), 1);
+	CHECK_EQ(HOST_aic3206Reg(1, 9), 0x30);
+
+	AIC3206_getCacheStats(&stats);
+	CHECK_EQ(STAT_DELTA(invalidates), 1);
+	CHECK_EQ(STAT_DELTA(readMisses), 1);
+}
+
+int main(void)
+{
+	HOST_i2cReset();
+
+	TEST_RUN(test_unknownPage);
+	TEST_RUN(test_pageSelects);
+	TEST_RUN(test_redundantWrites);
+	TEST_RUN(test_failedWriteReported);
+	TEST_RUN(test_readHitsAndMisses);
+	TEST_RUN(test_resetInvalidates);
+
+	return (testFailures);
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_aic3206_seq.c
+*
+*   \brief Replays the playback test bring-up against the simulated
+*          AIC3206 and reports what it cost on the bus.
+*
+*   The old bring-up sent one register per transaction with a 3ms wait in
+*   front of each; the report puts the burst writer next to that.
+*
+*/
+
+#include "test.h"
+#include "aic3206_init.h"
+#include "aic3206_cache.h"
+#include "audio_rate.h"
+#include "i2c_clock.h"
+#include "timebase.h"
+#include "cpu_idle.h"
+#include "i2c_async.h"
+
+TEST_MAIN_DATA;
+
+/* Per register cost of the old AIC3206_write() */
+#define LEGACY_WAIT_MS      (3)
+#define LEGACY_BYTES        (3)
+
+/* Waits the datasheet asks for: reset, reference, PLL, HP and ADC */
+#define DATASHEET_WAIT_MS   (1 + 40 + 10 + 1 + 1)
+
+static void busSetup(void)
+{
+	C55x_timebaseInit();
+	HOST_i2cReset();
+	HOST_aic3206Attach();
+	I2C_clockSetBusRate(I2C_BUS_RATE_400K);
+	AIC3206_cacheInvalidate();
+	AIC3206_clearSeqStats();
+	audio_invalidate_sample_rate();
+	HOST_i2cClearStats();
+}
+
+static void checkSeq(const AIC3206_RegSeq *seq, Uint16 count)
+{
+	Uint16 i;
+
+	for (i = 0; i < count; i++)
+	{
+		/* The reset register clears itself */
+		if ((seq[i].page == 0) && (seq[i].reg == 1))
+		{
+			continue;
+		}
+		CHECK_EQ(HOST_aic3206Reg(seq[i].page, seq[i].reg), seq[i].value);
+	}
+}
+
+static void test_replayPlaybackInit(void)
+{
+	AIC3206_SeqStats seq;
+	HOST_I2cStats    bus;
+	Uint32           start;
+	Uint32           elapsedUs;
+	Uint32           legacyUs;
+	Uint32           legacyBusUs;
+	Uint32           writes;
+
+	busSetup();
+
+	start = HOST_nowUsec();
+	CHECK_EQ(AIC3206_writeSeqNoWait(aic3206PowerUpSeq, aic3206PowerUpLen),
+	         TEST_PASS);
+	CHECK_EQ(audio_set_sample_rate(48000), TEST_PASS);
+	AIC3206_seqWait();
+	CHECK_EQ(AIC3206_writeSeq(aic3206RoutingSeq, aic3206RoutingLen),
+	         TEST_PASS);
+	elapsedUs = HOST_nowUsec() - start;
+
+	checkSeq(aic3206PowerUpSeq, aic3206PowerUpLen);
+	checkSeq(aic3206RoutingSeq, aic3206RoutingLen);
+
+	AIC3206_getSeqStats(&seq);
+	HOST_i2cGetStats(&bus);
+
+	/* The writer's own accounting agrees with the bus */
+	CHECK_EQ(seq.transactions, bus.transactions);
+	CHECK_EQ(seq.bytes, bus.bytes);
+	CHECK(seq.busTimeUs * 10 > bus.busTimeUsec * 9);
+	CHECK(seq.busTimeUs * 10 < bus.busTimeUsec * 11);
+	CHECK_EQ(bus.nacks, 0);
+
+	/* The old writer: a page select and a 3ms wait around every write,
+	 * then the same explicit waits */
+	legacyBusUs = seq.writes * 2 *
+	              ((LEGACY_BYTES * 9 + 2) * 1000000UL / I2C_BUS_RATE_400K);
+	legacyUs    = seq.writes * 2 * LEGACY_WAIT_MS * 1000 + legacyBusUs +
+	              DATASHEET_WAIT_MS * 1000;
+
+	/* Bursts and page selects only on a page change: fewer transactions
+	 * than registers, under half the bus time */
+	writes = aic3206PowerUpLen + aic3206RoutingLen;
+	CHECK(seq.writes >= writes);
+	CHECK(seq.transactions < seq.writes);
+	CHECK(bus.busTimeUsec * 2 < legacyBusUs);
+
+	/* Only the datasheet waits are left, and the reference wait runs
+	 * alongside the clock setup */
+	CHECK(elapsedUs < DATASHEET_WAIT_MS * 1000 + 20000);
+	CHECK(elapsedUs * 4 < legacyUs);
+
+	printf("  %lu writes in %lu transactions, %lu bytes, bus %lu us\n",
+	       (unsigned long)seq.writes, (unsigned long)seq.transactions,
+	       (unsigned long)seq.bytes, (unsigned long)bus.busTimeUsec);
+	printf("  bring-up %lu us; one write per transaction: bus %lu us, "
+	       "bring-up %lu us\n", (unsigned long)elapsedUs,
+	       (unsigned long)legacyBusUs, (unsigned long)legacyUs);
+}
+
+static void test_consecutiveRegsBurst(void)
+{
+	static const AIC3206_RegSeq run[] =
+	{
+		{ 1, 52, 0x30, 0 }, { 1, 53, 0x01, 0 }, { 1, 54, 0x03, 0 },
+		{ 1, 55, 0x30, 0 }, { 1, 56, 0x02, 0 }, { 1, 57, 0xc0, 0 }
+	};
+	AIC3206_SeqStats seq;
+	HOST_I2cStats    bus;
+
+	busSetup();
+
+	CHECK_EQ(AIC3206_writeSeq(run, 6), TEST_PASS);
+	checkSeq(run, 6);
+
+	/* Page select and one burst */
+	HOST_i2cGetStats(&bus);
+	CHECK_EQ(bus.transactions, 2);
+	CHECK_EQ(bus.bytes, (1 + 2) + (1 + 1 + 6));
+
+	/* Nothing new: the shadow keeps it off the bus */
+	HOST_i2cClearStats();
+	CHECK_EQ(AIC3206_writeSeq(run, 6), TEST_PASS);
+	HOST_i2cGetStats(&bus);
+	CHECK_EQ(bus.transactions, 0);
+
+	AIC3206_getSeqStats(&seq);
+	CHECK_EQ(seq.writes, 6);
+}
+
+static void test_delayEndsBurst(void)
+{
+	static const AIC3206_RegSeq run[] =
+	{
+		{ 0, 63, 0xd4, 0 }, { 0, 64, 0x02, 2 }, { 0, 65, 0x01, 0 }
+	};
+	AIC3206_SeqStats seq;
+	HOST_I2cStats    bus;
+
+	busSetup();
+
+	CHECK_EQ(AIC3206_writeSeq(run, 3), TEST_PASS);
+	checkSeq(run, 3);
+
+	/* The page is known to be 0 after a reset */
+	HOST_i2cGetStats(&bus);
+	CHECK_EQ(bus.transactions, 2);
+
+	AIC3206_getSeqStats(&seq);
+	CHECK_EQ(seq.delayMs, 2);
+}
+
+static void test_deferredWaitCounted(void)
+{
+	static const AIC3206_RegSeq run[] =
+	{
+		{ 0, 63, 0xd4, 20 }
+	};
+	AIC3206_SeqStats seq;
+	C55x_IdleStats   idle;
+	Uint32           waitedUs;
+
+	busSetup();
+	C55x_idleInit();
+	C55x_idleStatsReset();
+
+	/* Nothing overlaps: the whole delay is waited and idled through */
+	CHECK_EQ(AIC3206_writeSeqNoWait(run, 1), TEST_PASS);
+	waitedUs = AIC3206_seqWait();
+	CHECK(waitedUs >= 19000);
+
+	AIC3206_getSeqStats(&seq);
+	CHECK(seq.delayMs >= 19);
+	CHECK(seq.delayMs <= 21);
+
+	C55x_idleGetStats(&idle);
+	CHECK(idle.wakeups > 0);
+
+	/* Work covering most of the delay: only the rest is counted */
+	AIC3206_cacheInvalidate();
+	AIC3206_clearSeqStats();
+	CHECK_EQ(AIC3206_writeSeqNoWait(run, 1), TEST_PASS);
+	C55x_delay_usec(15000);
+	waitedUs = AIC3206_seqWait();
+	CHECK(waitedUs < 10000);
+
+	AIC3206_getSeqStats(&seq);
+	CHECK(seq.delayMs >= 1);
+	CHECK(seq.delayMs <= 10);
+
+	/* Nothing pending, nothing counted */
+	AIC3206_seqWait();
+	AIC3206_getSeqStats(&seq);
+	CHECK(seq.delayMs <= 10);
+}
+
+static void test_lateReadIgnored(void)
+{
+	HOST_I2cDevice *codec;
+	Uint16          value;
+
+	busSetup();
+	codec = HOST_aic3206Attach();
+	HOST_aic3206SetReg(0, 60, 0x05);
+	HOST_aic3206SetReg(0, 61, 0x0A);
+
+	HOST_irqTicker(100);
+	CHECK_EQ(I2C_asyncOpen(), TEST_PASS);
+
+	/* The codec answers after the read gave up */
+	codec->ackDelayUsec = AIC3206_BUS_TIMEOUT_USEC + 5000;
+	CHECK_EQ(AIC3206_busRead(60, &value), TEST_FAIL);
+
+	/* The next read waits the late one out and returns its own register */
+	codec->ackDelayUsec = 0;
+	value = 0;
+	CHECK_EQ(AIC3206_busRead(61, &value), TEST_PASS);
+	CHECK_EQ(value, 0x0A);
+
+	CHECK_EQ(I2C_asyncClose(I2C_ASYNC_CLOSE_USEC), TEST_PASS);
+	HOST_irqTicker(0);
+}
+
+int main(void)
+{
+	TEST_RUN(test_replayPlaybackInit);
+	TEST_RUN(test_consecutiveRegsBurst);
+	TEST_RUN(test_delayEndsBurst);
+	TEST_RUN(test_deferredWaitCounted);
+	TEST_RUN(test_lateReadIgnored);
+
+	return (testFailures);
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_audio_pipeline.c
+*
+*   \brief WAV driven regression of the capture -> process -> playback
+*          pipeline on the I2S interrupt model.
+*
+*   The input is a 16-bit stereo WAV, either the file named on the command
+*   line or a generated sweep. Every frame must come out unchanged exactly
+*   'latencyFrames' frame clocks later. The output can be written back as a
+*   WAV for listening:
+*
+*       build/test_audio_pipeline [in.wav [out.wav]]
+*
+*/
+
+#include <math.h>
+
+#include "test.h"
+#include "audio_pipeline.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+#define BLOCK_FRAMES    (48)
+#define SWEEP_FRAMES    (12000)
+#define WAV_HEADER_LEN  (44)
+
+static Int16  *wavFrames;
+static Uint32  wavCount;
+static const char *wavOutPath;
+
+static Uint32 rd32(const Uint8 *p)
+{
+	return (p[0] | (p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24));
+}
+
+static void wr32(Uint8 *p, Uint32 v)
+{
+	p[0] = (Uint8)v;
+	p[1] = (Uint8)(v >> 8);
+	p[2] = (Uint8)(v >> 16);
+	p[3] = (Uint8)(v >> 24);
+}
+
+/* 16-bit stereo PCM only, the format the pipeline runs at */
+static Bool wavLoad(const char *path)
+{
+	FILE   *file;
+	Uint8   hdr[12];
+	Uint8   chunk[8];
+	Uint8   fmt[16];
+	Uint32  size;
+	Uint32  i;
+	Bool    fmtOk = FALSE;
+
+	file = fopen(path, "rb");
+	if ((file == NULL) || (fread(hdr, 1, 12, file) != 12) ||
+	    memcmp(hdr, "RIFF", 4) || memcmp(&hdr[8], "WAVE", 4))
+	{
+		return (FALSE);
+	}
+
+	while (fread(chunk, 1, 8, file) == 8)
+	{
+		size = rd32(&chunk[4]);
+		if (!memcmp(chunk, "fmt ", 4) && (size >= 16))
+		{
+			if (fread(fmt, 1, 16, file) != 16)
+			{
+				break;
+			}
+			fmtOk = (fmt[0] == 1) && (fmt[2] == 2) && (fmt[14] == 16);
+			size -= 16;
+		}
+		else if (!memcmp(chunk, "data", 4) && fmtOk)
+		{
+			wavCount  = size / 4;
+			wavFrames = malloc(wavCount * 4);
+			wavCount  = fread(wavFrames, 4, wavCount, file);
+			for (i = 0; i < 2 * wavCount; i++)
+			{
+				wavFrames[i] = (Int16)(((Uint8 *)&wavFrames[i])[0] |
+				                       (((Uint8 *)&wavFrames[i])[1] << 8));
+			}
+			fclose(file);
+			return (TRUE);
+		}
+		fseek(file, (size + 1) & ~1UL, SEEK_CUR);
+	}
+
+	fclose(file);
+	return (FALSE);
+}
+
+static void wavSave(const char *path, const Int16 *frames, Uint32 count)
+{
+	static const Uint8 fmt[16] =
+	    { 1, 0, 2, 0, 0x80, 0xBB, 0, 0, 0, 0xEE, 2, 0, 4, 0, 16, 0 };
+	FILE  *file;
+	Uint8  hdr[WAV_HEADER_LEN];
+
+	memcpy(hdr, "RIFF", 4);
+	wr32(&hdr[4], WAV_HEADER_LEN - 8 + count * 4);
+	memcpy(&hdr[8], "WAVEfmt ", 8);
+	wr32(&hdr[16], 16);
+	memcpy(&hdr[20], fmt, 16);
+	memcpy(&hdr[36], "data", 4);
+	wr32(&hdr[40], count * 4);
+
+	file = fopen(path, "wb");
+	if (file != NULL)
+	{
+		fwrite(hdr, 1, WAV_HEADER_LEN, file);
+		fwrite(frames, 4, count, file);
+		fclose(file);
+	}
+}
+
+/* Left and right differ, so a swapped or split frame shows */
+static void makeSweep(void)
+{
+	double phase = 0.0;
+	Uint32 i;
+
+	wavCount  = SWEEP_FRAMES;
+	wavFrames = malloc(wavCount * 4);
+	for (i = 0; i < wavCount; i++)
+	{
+		phase += 2.0 * M_PI * (20.0 + 20000.0 * i / wavCount) / 48000.0;
+		wavFrames[2 * i]     = (Int16)(30000.0 * sin(phase));
+		wavFrames[2 * i + 1] = (Int16)(-20000.0 * cos(phase)) | 1;
+	}
+}
+
+/* Runs the whole input through, servicing once every 'period' frames */
+static Uint32 runPipeline(Uint16 latency, Uint16 period,
+                          AUDIO_PipelineStats *stats)
+{
+	AUDIO_PipelineConfig config;
+	const Int16 *out;
+	Uint32       outCount;
+	Uint32       errors = 0;
+	Uint32       n;
+
+	config.blockFrames   = BLOCK_FRAMES;
+	config.latencyFrames = latency;
+	config.processFxn    = NULL;
+	config.arg           = NULL;
+
+	HOST_i2sSetInput(wavFrames, wavCount);
+	CHECK_EQ(AUDIO_pipelineOpen(&config), TEST_PASS);
+	HOST_i2sClearOutput();
+
+	for (n = 1; n <= wavCount + latency; n++)
+	{
+		HOST_i2sTick(1);
+		if ((n % period) == 0)
+		{
+			AUDIO_pipelineService();
+		}
+	}
+
+	AUDIO_pipelineClose();
+	AUDIO_pipelineGetStats(stats);
+
+	out = HOST_i2sOutput(&outCount);
+	CHECK_EQ(outCount, wavCount + latency);
+	for (n = 0; n < outCount; n++)
+	{
+		if (n < latency)
+		{
+			errors += (out[2 * n] != 0) || (out[2 * n + 1] != 0);
+		}
+		else
+		{
+			errors += (out[2 * n] != wavFrames[2 * (n - latency)]) ||
+			          (out[2 * n + 1] != wavFrames[2 * (n - latency) + 1]);
+		}
+	}
+
+	if (wavOutPath != NULL)
+	{
+		wavSave(wavOutPath, out, outCount);
+	}
+
+	return (errors);
+}
+
+/* The reported latency is the delay the frames really see */
+static void test_latencyIsPrime(void)
+{
+	AUDIO_PipelineStats stats;
+
+	CHECK_EQ(runPipeline(2 * BLOCK_FRAMES, 1, &stats), 0);
+	CHECK_EQ(stats.latencyFrames, 2 * BLOCK_FRAMES);
+	CHECK_EQ(stats.blocks, wavCount / BLOCK_FRAMES +
+	                      (2 * BLOCK_FRAMES) / BLOCK_FRAMES);
+	CHECK_EQ(stats.underruns, 0);
+	CHECK_EQ(stats.overruns, 0);
+	CHECK_EQ(stats.minTxFrames, BLOCK_FRAMES);
+
+	/* Timed without a processing stage too */
+	CHECK(stats.worstCycles > 0);
+	CHECK(stats.worstCycles >= stats.lastCycles);
+
+	CHECK_EQ(runPipeline(3 * BLOCK_FRAMES + 5, 1, &stats), 0);
+	CHECK_EQ(stats.underruns, 0);
+}
+
+/* The minimum prime survives the main loop missing one block period */
+static void test_blockOfSlack(void)
+{
+	AUDIO_PipelineStats stats;
+
+	CHECK_EQ(runPipeline(2 * BLOCK_FRAMES, 2 * BLOCK_FRAMES, &stats), 0);
+	CHECK_EQ(stats.underruns, 0);
+	CHECK_EQ(stats.minTxFrames, 0);
+}
+
+/* A block that does not fit the TX ring is counted as lost */
+static void test_shortWriteIsOverrun(void)
+{
+	AUDIO_PipelineConfig config;
+	AUDIO_PipelineStats  stats;
+	static Int16         fill[2 * AUDIO_PIPELINE_TX_FRAMES];
+
+	config.blockFrames   = BLOCK_FRAMES;
+	config.latencyFrames = 2 * BLOCK_FRAMES;
+	config.processFxn    = NULL;
+	config.arg           = NULL;
+
+	HOST_i2sSetInput(wavFrames, wavCount);
+	CHECK_EQ(AUDIO_pipelineOpen(&config), TEST_PASS);
+	HOST_i2sTick(BLOCK_FRAMES);
+
+	/* Leave room for half a block */
+	CHECK_EQ(I2S_ringWriteFrames(fill, I2S_ringTxSpaceFrames() -
+	                                   BLOCK_FRAMES / 2),
+	         AUDIO_PIPELINE_TX_FRAMES - BLOCK_FRAMES - BLOCK_FRAMES / 2);
+
+	CHECK_EQ(AUDIO_pipelineService(), 1);
+	AUDIO_pipelineClose();
+
+	AUDIO_pipelineGetStats(&stats);
+	CHECK_EQ(stats.overruns, BLOCK_FRAMES - BLOCK_FRAMES / 2);
+}
+
+static void test_latencyRange(void)
+{
+	AUDIO_PipelineConfig config;
+
+	config.blockFrames   = BLOCK_FRAMES;
+	config.processFxn    = NULL;
+	config.arg           = NULL;
+
+	config.latencyFrames = 2 * BLOCK_FRAMES - 1;
+	CHECK_EQ(AUDIO_pipelineOpen(&config), TEST_FAIL);
+	config.latencyFrames = AUDIO_PIPELINE_TX_FRAMES + 1;
+	CHECK_EQ(AUDIO_pipelineOpen(&config), TEST_FAIL);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc > 1)
+	{
+		if (!wavLoad(argv[1]))
+		{
+			printf("%s: not a 16-bit stereo PCM WAV\n", argv[1]);
+			return (1);
+		}
+		wavOutPath = (argc > 2) ? argv[2] : NULL;
+	}
+	else
+	{
+		makeSweep();
+	}
+
+	C55x_timebaseInit();
+
+	TEST_RUN(test_latencyIsPrime);
+	TEST_RUN(test_blockOfSlack);
+	TEST_RUN(test_shortWriteIsOverrun);
+	TEST_RUN(test_latencyRange);
+
+	return (testFailures);
+}
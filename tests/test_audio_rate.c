@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_audio_rate.c
+*
+*   \brief The sample rate table against its generator and the datasheet
+*          clock limits.
+*
+*/
+
+#include "test.h"
+#include "rate_gen.h"
+
+TEST_MAIN_DATA;
+
+static const Uint32 supportedRates[] =
+	{ 8000, 16000, 22050, 32000, 44100, 48000, 96000 };
+
+#define NUM_RATES   (sizeof(supportedRates) / sizeof(supportedRates[0]))
+
+static void test_tableValid(void)
+{
+	CHECK_EQ(audio_check_rate_table(), TEST_PASS);
+}
+
+/* The compiled table is exactly what tools/gen_rate_table prints */
+static void test_tableIsGenerated(void)
+{
+	const AUDIO_RateConfig *entry;
+	AUDIO_RateConfig        cfg;
+	Uint16                  i;
+
+	for (i = 0; i < NUM_RATES; i++)
+	{
+		entry = audio_find_sample_rate(supportedRates[i]);
+		CHECK(entry != NULL);
+		CHECK_EQ(RATE_generate(supportedRates[i], &cfg), TEST_PASS);
+		if (entry != NULL)
+		{
+			CHECK_EQ(memcmp(entry, &cfg, sizeof(cfg)), 0);
+		}
+	}
+}
+
+/* Other rates of the two families are found, foreign ones are not */
+static void test_generatorRange(void)
+{
+	static const Uint32 goodRates[] = { 11025, 24000, 88200 };
+	static const Uint32 badRates[]  = { 0, 12345, 44000, 50000 };
+	AUDIO_RateConfig    cfg;
+	Uint16              i;
+
+	for (i = 0; i < sizeof(goodRates) / sizeof(goodRates[0]); i++)
+	{
+		CHECK_EQ(RATE_generate(goodRates[i], &cfg), TEST_PASS);
+		CHECK_EQ(cfg.fs, goodRates[i]);
+	}
+	for (i = 0; i < sizeof(badRates) / sizeof(badRates[0]); i++)
+	{
+		CHECK_EQ(RATE_generate(badRates[i], &cfg), TEST_FAIL);
+	}
+	CHECK(audio_find_sample_rate(11025) == NULL);
+}
+
+/* Each datasheet limit on its own turns a good entry bad */
+static void test_checkRejects(void)
+{
+	AUDIO_RateConfig good;
+	AUDIO_RateConfig cfg;
+
+	good = *audio_find_sample_rate(48000);
+
+	cfg = good; cfg.mdac++;                 /* fs no longer exact       */
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+	cfg = good; cfg.pllJ = 12;              /* fractional J above 11    */
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+	cfg = good; cfg.pllD = 10000;
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+	cfg = good; cfg.pllP = 2;               /* PLL below 80 MHz         */
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+	cfg = good; cfg.ndac = 1; cfg.mdac = 14; /* DAC_CLK above 49.152 MHz */
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+	cfg = good; cfg.dosr = 32; cfg.mdac = 28; /* DOSR * fs below 2.8 MHz */
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+	cfg = good; cfg.bclkN = 15;             /* BCLK below 64 fs         */
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+	cfg = good; cfg.madc = 1; cfg.aosr = 256; /* ADC_MOD_CLK too fast    */
+	CHECK_EQ(audio_check_rate_config(&cfg), TEST_FAIL);
+}
+
+int main(void)
+{
+	TEST_RUN(test_tableValid);
+	TEST_RUN(test_tableIsGenerated);
+	TEST_RUN(test_generatorRange);
+	TEST_RUN(test_checkRejects);
+
+	return (testFailures);
+}
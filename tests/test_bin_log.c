@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_bin_log.c
+*
+*   \brief Host test of the binary log: records out of the UART log ring
+*          are decoded by the host reader from the dumped format table,
+*          and a damaged capture loses only the records it touches.
+*
+*/
+
+#include "test.h"
+#include "bin_log.h"
+#include "uart_log.h"
+#include "timebase.h"
+#include "blog_reader.h"
+
+TEST_MAIN_DATA;
+
+#define MAX_LINES   (64)
+
+static char   lines[MAX_LINES][BLOG_READER_MAX_LINE + 32];
+static Uint16 lineCount;
+
+static void collect(const char *line, void *arg)
+{
+	if (lineCount < MAX_LINES)
+	{
+		strcpy(lines[lineCount++], line);
+	}
+}
+
+/* Index of the first line containing 'text', -1 if none */
+static int findLine(const char *text)
+{
+	Uint16 i;
+
+	for (i = 0; i < lineCount; i++)
+	{
+		if (strstr(lines[i], text) != NULL)
+		{
+			return (i);
+		}
+	}
+
+	return (-1);
+}
+
+static Uint8  capture[4096];
+
+static Uint32 captureRun(void)
+{
+	UART_logFlush();
+
+	return (HOST_uartTake(capture, sizeof(capture)));
+}
+
+static void logSetup(void)
+{
+	C55x_timebaseInit();
+	HOST_uartHold(FALSE);
+	CHECK_EQ(UART_logOpen(), TEST_PASS);
+	HOST_uartTake(capture, sizeof(capture));
+	lineCount = 0;
+}
+
+static void test_decodeCapture(void)
+{
+	static BLOG_Reader rd;
+	Uint32      length;
+	int         text;
+	int         load;
+	char        expect[64];
+
+	logSetup();
+
+	BLOG_setMode(BLOG_MODE_TEXT);
+	BLOG_dumpFormats();
+	C55x_msgWrite("plain text\n\r");
+
+	BLOG_setMode(BLOG_MODE_BINARY);
+	BLOG2(BLOG_ID_CPU_LOAD, 42, 58);
+	C55x_msgWrite("more text\n\r");
+	BLOG3(BLOG_ID_BENCH, 1000, -83, 0xBEEF);
+	BLOG0(BLOG_ID_I2C_WR_FAIL);
+	BLOG6(BLOG_ID_PIPE_STATS, 0x7FFFFFFF, -1, 0, 1, 2, 0x80000000UL);
+	BLOG_setMode(BLOG_MODE_TEXT);
+
+	length = captureRun();
+	CHECK(length > 0);
+
+	BLOG_readerInit(&rd, collect, NULL);
+	BLOG_readerFeed(&rd, capture, length);
+	BLOG_readerEnd(&rd);
+
+	CHECK_EQ(rd.records, 4);
+	CHECK_EQ(rd.badRecords, 0);
+	CHECK_EQ(rd.unknownIds, 0);
+
+	/* The clock comes from the table header */
+	snprintf(expect, sizeof(expect), "timebase %lu kHz",
+	         (unsigned long)C55x_timebaseGetClock());
+	CHECK(findLine(expect) >= 0);
+	CHECK_EQ(rd.clkKhz, C55x_timebaseGetClock());
+
+	text = findLine("plain text");
+	load = findLine("CPU: 42% active, 58% idle");
+	CHECK(text >= 0);
+	CHECK(load > text);
+	CHECK(findLine("more text") > load);
+	CHECK(findLine("Bench 1000: -83 beef") > findLine("more text"));
+	CHECK(findLine("I2C Write failed") >= 0);
+	CHECK(findLine("Pipeline: 2147483647 blocks, latency -1 samples, "
+	               "headroom 0 frames, 1 underruns, 2 overruns, "
+	               "worst block 2147483648 cycles") >= 0);
+	CHECK(strstr(lines[load], " us] ") != NULL);
+
+	BLOG_readerFree(&rd);
+	UART_logClose();
+}
+
+static void test_syncInsideVarint(void)
+{
+	static BLOG_Reader rd;
+	Int32  args[BLOG_MAX_ARGS] = { 1000, -83, 0xBEEF };
+	Uint8  rec[BLOG_MAX_RECORD];
+	Uint8  stream[3 * BLOG_MAX_RECORD];
+	Uint16 recLen;
+	Uint16 n;
+
+	/* Zig-zag of -83 is 0xA5: a sync byte in the middle of the record */
+	recLen = BLOG_encode(rec, BLOG_ID_BENCH, 5, args);
+	CHECK(recLen <= BLOG_MAX_RECORD);
+	CHECK_EQ(rec[0], BLOG_SYNC);
+	CHECK(memchr(&rec[1], BLOG_SYNC, recLen - 1) != NULL);
+
+	lineCount = 0;
+	BLOG_readerInit(&rd, collect, NULL);
+	BLOG_readerFeed(&rd, (const Uint8 *)"BLOG 0 3 Bench %lu: %ld %lx\n\r", 29);
+
+	/* First record without its sync byte, then two whole ones */
+	n = 0;
+	memcpy(&stream[n], &rec[1], recLen - 1);
+	n += recLen - 1;
+	memcpy(&stream[n], rec, recLen);
+	n += recLen;
+	memcpy(&stream[n], rec, recLen);
+	n += recLen;
+
+	BLOG_readerFeed(&rd, stream, n);
+	BLOG_readerEnd(&rd);
+
+	CHECK_EQ(rd.records, 2);
+	CHECK(rd.badRecords >= 1);
+	CHECK_EQ(rd.cycles, 10);
+
+	BLOG_readerFree(&rd);
+}
+
+static void test_damagedRecordSkipped(void)
+{
+	static BLOG_Reader rd;
+	Int32  args[BLOG_MAX_ARGS] = { 7, 9 };
+	Uint8  rec[BLOG_MAX_RECORD];
+	Uint8  stream[3 * BLOG_MAX_RECORD];
+	Uint16 recLen;
+	Uint16 i;
+
+	recLen = BLOG_encode(rec, BLOG_ID_CPU_LOAD, 1, args);
+
+	lineCount = 0;
+	BLOG_readerInit(&rd, collect, NULL);
+
+	/* A bit flipped in every byte after the sync in turn: never decoded */
+	for (i = 1; i < recLen; i++)
+	{
+		memcpy(stream, rec, recLen);
+		stream[i] ^= 0x04;
+		memcpy(&stream[recLen], rec, recLen);
+		BLOG_readerFeed(&rd, stream, 2 * recLen);
+	}
+	BLOG_readerEnd(&rd);
+
+	CHECK_EQ(rd.records, recLen - 1);
+	CHECK_EQ(rd.badRecords, recLen - 1);
+
+	/* Unknown to the reader without a table, still decoded */
+	CHECK_EQ(rd.unknownIds, recLen - 1);
+	CHECK(findLine("BLOG id 2: 7 9") >= 0);
+
+	/* Cut short at the end of a capture */
+	BLOG_readerInit(&rd, collect, NULL);
+	BLOG_readerFeed(&rd, rec, recLen - 1);
+	BLOG_readerEnd(&rd);
+	CHECK_EQ(rd.records, 0);
+	CHECK_EQ(rd.badRecords, 1);
+
+	BLOG_readerFree(&rd);
+}
+
+static void test_worstCaseLength(void)
+{
+	Int32  args[BLOG_MAX_ARGS];
+	Uint8  rec[BLOG_MAX_RECORD + 1];
+	Uint16 i;
+
+	for (i = 0; i < BLOG_MAX_ARGS; i++)
+	{
+		args[i] = (Int32)0x80000000UL;
+	}
+
+	rec[BLOG_MAX_RECORD] = 0x5A;
+	CHECK_EQ(BLOG_encode(rec, BLOG_ID_PIPE_STATS, 0xFFFFFFFF, args),
+	         BLOG_MAX_RECORD);
+	CHECK_EQ(rec[BLOG_MAX_RECORD], 0x5A);
+	CHECK_EQ(rec[1] + BLOG_RECORD_OVERHEAD, BLOG_MAX_RECORD);
+}
+
+int main(void)
+{
+	TEST_RUN(test_decodeCapture);
+	TEST_RUN(test_syncInsideVarint);
+	TEST_RUN(test_damagedRecordSkipped);
+	TEST_RUN(test_worstCaseLength);
+
+	return (testFailures);
+}
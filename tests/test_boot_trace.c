@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_boot_trace.c
+*
+*   \brief Host test of the boot tracer on the host timebase: the stage
+*          marks of the first and of later runs, the deferred codec wait
+*          between two marks, and the table printed once at the first
+*          sample.
+*
+*/
+
+#include "test.h"
+#include "boot_trace.h"
+#include "aic3206_seq.h"
+#include "aic3206_cache.h"
+#include "i2c_clock.h"
+#include "timebase.h"
+#include "cpu_idle.h"
+
+TEST_MAIN_DATA;
+
+#define DUMP_SIZE       (4096)
+
+static char dump[DUMP_SIZE];
+
+/* Runs BOOT_traceService() and keeps what it printed */
+static Uint32 serviceDump(void)
+{
+	HOST_msgClear();
+	BOOT_traceService();
+
+	return (HOST_msgTake(dump, DUMP_SIZE));
+}
+
+/* Finds a stage line "  <at>  +<delta>  <name>" of the dump */
+static Bool findStage(const char *name, Uint32 *at, Uint32 *delta)
+{
+	const char *line = dump;
+	char        stage[64];
+
+	while (line != NULL)
+	{
+		if ((sscanf(line, " %u +%u %63[^\r\n]", at, delta, stage) == 3) &&
+		    (strcmp(stage, name) == 0))
+		{
+			return (TRUE);
+		}
+
+		line = strchr(line, '\n');
+		if (line != NULL)
+		{
+			line++;
+		}
+	}
+
+	return (FALSE);
+}
+
+/* The first run keeps the system init marks and counts from the start of
+ * the timebase; the table goes out once, at the first sample */
+static void test_firstRunKeepsSystemMarks(void)
+{
+	Uint32 at;
+	Uint32 delta;
+	Uint32 firstUsec;
+	char   total[64];
+
+	C55x_timebaseInit();
+	BOOT_traceMark("pll");
+	C55x_delay_usec(2000);
+	BOOT_traceMark("uart");
+
+	BOOT_traceRunStart();
+	C55x_delay_usec(1000);
+	BOOT_traceMark("i2c");
+
+	/* Nothing before the first sample */
+	CHECK_EQ(serviceDump(), 0);
+	CHECK_EQ(BOOT_traceFirstSampleUsec(), 0);
+
+	BOOT_traceFirstSample();
+	firstUsec = BOOT_traceFirstSampleUsec();
+	CHECK(firstUsec >= 3000);
+
+	CHECK(serviceDump() > 0);
+	CHECK(findStage("pll", &at, &delta));
+	CHECK(findStage("uart", &at, &delta));
+	CHECK(delta >= 2000);
+	CHECK(findStage("i2c", &at, &delta));
+	CHECK(at >= 3000);
+	CHECK(delta >= 1000);
+	CHECK(findStage("first sample", &at, &delta));
+	CHECK_EQ(at, firstUsec);
+	CHECK(!findStage("run start", &at, &delta));
+
+	sprintf(total, "Time to first sample: %u us", firstUsec);
+	CHECK(strstr(dump, total) != NULL);
+
+	/* Printed once, later samples change nothing */
+	CHECK_EQ(serviceDump(), 0);
+	C55x_delay_usec(1000);
+	BOOT_traceFirstSample();
+	CHECK_EQ(BOOT_traceFirstSampleUsec(), firstUsec);
+	CHECK_EQ(serviceDump(), 0);
+}
+
+/* A later run clears the table and counts from its own start */
+static void test_laterRunRestarts(void)
+{
+	Uint32 at;
+	Uint32 delta;
+	Uint16 i;
+
+	C55x_delay_usec(5000);
+	BOOT_traceRunStart();
+	CHECK_EQ(BOOT_traceFirstSampleUsec(), 0);
+	BOOT_traceMark("codec power up");
+	BOOT_traceFirstSample();
+	CHECK(BOOT_traceFirstSampleUsec() < 5000);
+
+	CHECK(serviceDump() > 0);
+	CHECK(findStage("run start", &at, &delta));
+	CHECK(at < 1000);
+	CHECK(findStage("codec power up", &at, &delta));
+	CHECK(!findStage("pll", &at, &delta));
+
+	/* The run start takes one slot, the first sample is dropped too */
+	BOOT_traceRunStart();
+	for (i = 0; i < BOOT_TRACE_MAX_MARKS + 6; i++)
+	{
+		BOOT_traceMark("stage");
+	}
+	BOOT_traceFirstSample();
+
+	CHECK(serviceDump() > 0);
+	CHECK(strstr(dump, "  8 marks dropped") != NULL);
+	CHECK(!findStage("first sample", &at, &delta));
+}
+
+/* Work between the deferred codec write and its wait shortens the stage
+ * that waits, and only what was left is counted as delay */
+static void test_deferredWaitBetweenMarks(void)
+{
+	static const AIC3206_RegSeq powerUp[] =
+	{
+		{ 0, 63, 0xd4, 20 }
+	};
+	AIC3206_SeqStats seq;
+	Uint32           at;
+	Uint32           delta;
+
+	HOST_i2cReset();
+	HOST_aic3206Attach();
+	I2C_clockSetBusRate(I2C_BUS_RATE_400K);
+	AIC3206_cacheInvalidate();
+	AIC3206_clearSeqStats();
+	C55x_idleInit();
+
+	BOOT_traceRunStart();
+	CHECK_EQ(AIC3206_writeSeqNoWait(powerUp, 1), TEST_PASS);
+	BOOT_traceMark("codec power up");
+	C55x_delay_usec(15000);
+	BOOT_traceMark("gpio");
+	AIC3206_seqWait();
+	BOOT_traceMark("codec reference");
+	BOOT_traceFirstSample();
+
+	CHECK(serviceDump() > 0);
+	CHECK(findStage("gpio", &at, &delta));
+	CHECK(delta >= 15000);
+	CHECK(findStage("codec reference", &at, &delta));
+	CHECK(delta < 10000);
+	CHECK(at >= 19000);
+
+	AIC3206_getSeqStats(&seq);
+	CHECK(seq.delayMs >= 1);
+	CHECK(seq.delayMs <= 10);
+}
+
+int main(void)
+{
+	TEST_RUN(test_firstRunKeepsSystemMarks);
+	TEST_RUN(test_laterRunRestarts);
+	TEST_RUN(test_deferredWaitBetweenMarks);
+
+	return (testFailures);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_cmd_queue.c
+*
+*   \brief Host test of the command queue: a producer thread posts as an
+*          ISR would against the dispatching main loop, and a full queue
+*          drops and counts the post.
+*
+*/
+
+#include "test.h"
+#include "cmd_queue.h"
+#include <pthread.h>
+#include <sched.h>
+
+TEST_MAIN_DATA;
+
+#define PRODUCER_POSTS      (200000)
+
+static Uint32          callSeen;
+static Uint32          callErrors;
+static volatile Uint32 producerFull;
+
+/* Command n carries n in its two arguments, n from 0 */
+static void seqCall(Uint16 lo, Uint16 hi)
+{
+	if ((((Uint32)hi << 16) | lo) != callSeen)
+	{
+		callErrors++;
+	}
+	callSeen++;
+}
+
+/* Posts as an ISR does, with interrupts disabled, and retries while the
+ * dispatcher catches up */
+static void *producerThread(void *arg)
+{
+	Uint32 n;
+	Bool   oldIntm;
+	Bool   posted;
+
+	for (n = 0; n < PRODUCER_POSTS; n++)
+	{
+		do
+		{
+			oldIntm = IRQ_globalDisable();
+			posted  = CMD_postCall(seqCall, (Uint16)n, (Uint16)(n >> 16));
+			IRQ_globalRestore(oldIntm);
+
+			if (!posted)
+			{
+				producerFull++;
+				sched_yield();
+			}
+		} while (!posted);
+	}
+
+	return (NULL);
+}
+
+static void test_postAgainstProducerThread(void)
+{
+	CMD_QueueStats stats;
+	pthread_t      thread;
+	Uint32         idle = 0;
+
+	CMD_queueInit();
+	callSeen     = 0;
+	callErrors   = 0;
+	producerFull = 0;
+
+	CHECK_EQ(pthread_create(&thread, NULL, producerThread, NULL), 0);
+
+	/* The main loop never disables interrupts to dispatch */
+	while (callSeen < PRODUCER_POSTS)
+	{
+		if (CMD_dispatch() == 0)
+		{
+			idle++;
+			sched_yield();
+		}
+	}
+
+	pthread_join(thread, NULL);
+
+	CHECK_EQ(CMD_dispatch(), 0);
+	CHECK_EQ(callSeen, PRODUCER_POSTS);
+	CHECK_EQ(callErrors, 0);
+
+	CMD_getStats(&stats);
+	CHECK_EQ(stats.posted, PRODUCER_POSTS);
+	CHECK_EQ(stats.dispatched, PRODUCER_POSTS);
+	CHECK_EQ(stats.dropped, producerFull);
+	CHECK_EQ(stats.depth, 0);
+	CHECK(stats.maxDepth <= CMD_QUEUE_SIZE);
+	printf("  %lu full, %lu idle dispatches, max depth %u\n",
+	       (unsigned long)producerFull, (unsigned long)idle,
+	       stats.maxDepth);
+}
+
+static void test_fullQueueDrops(void)
+{
+	CMD_QueueStats stats;
+	Uint16         i;
+
+	CMD_queueInit();
+	callSeen   = 0;
+	callErrors = 0;
+
+	for (i = 0; i < CMD_QUEUE_SIZE; i++)
+	{
+		CHECK(CMD_postCall(seqCall, i, 0));
+	}
+	CHECK(!CMD_postCall(seqCall, i, 0));
+	CHECK_EQ(CMD_queueDepth(), CMD_QUEUE_SIZE);
+
+	CHECK_EQ(CMD_dispatch(), CMD_QUEUE_SIZE);
+	CHECK_EQ(callSeen, CMD_QUEUE_SIZE);
+	CHECK_EQ(callErrors, 0);
+
+	CMD_getStats(&stats);
+	CHECK_EQ(stats.posted, CMD_QUEUE_SIZE);
+	CHECK_EQ(stats.dropped, 1);
+	CHECK_EQ(stats.maxDepth, CMD_QUEUE_SIZE);
+}
+
+int main(void)
+{
+	TEST_RUN(test_fullQueueDrops);
+	TEST_RUN(test_postAgainstProducerThread);
+
+	return (testFailures);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_cpu_idle.c
+*
+*   \brief Host test of the idle wait and the CPU load accounting: the
+*          work check runs with interrupts disabled, and the load stays
+*          right past the cycle count wrap.
+*
+*/
+
+#include "test.h"
+#include "cpu_idle.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+/* Wraps the 32-bit cycle count every 1.07 s */
+#define FAST_CLK_KHZ    (4000000)
+
+static Uint16 workChecks;
+static Bool   workMasked;
+
+static Bool workPending(void *arg)
+{
+	workChecks++;
+	workMasked = HOST_irqMasked();
+
+	return (*(Bool *)arg);
+}
+
+static void test_workSkipsIdle(void)
+{
+	C55x_IdleStats stats;
+	Bool           work = TRUE;
+
+	C55x_idleInit();
+	workChecks = 0;
+
+	CHECK(!C55x_idleUnless(workPending, &work));
+	CHECK_EQ(workChecks, 1);
+	CHECK(workMasked);
+	CHECK(!HOST_irqMasked());
+
+	C55x_idleGetStats(&stats);
+	CHECK_EQ(stats.wakeups, 0);
+
+	work = FALSE;
+	CHECK(C55x_idleUnless(workPending, &work));
+	CHECK(workMasked);
+	CHECK(!HOST_irqMasked());
+
+	C55x_idleGetStats(&stats);
+	CHECK_EQ(stats.wakeups, 1);
+}
+
+/* An idle delay is mostly idle time */
+static void test_delayIdles(void)
+{
+	C55x_IdleStats stats;
+
+	C55x_timebaseInit();
+	C55x_idleInit();
+
+	C55x_idleDelayUsec(20000);
+
+	C55x_idleGetStats(&stats);
+	CHECK(stats.wakeups > 0);
+	CHECK(stats.idlePercent >= 80);
+	CHECK_EQ(stats.idlePercent + stats.activePercent, 100);
+	CHECK(stats.idleTicks <= stats.totalTicks);
+}
+
+/* 2 s, 80% idle, at a clock that wraps the cycle count twice over */
+static void test_loadPastCycleWrap(void)
+{
+	C55x_IdleStats stats;
+	Uint32         expectTicks;
+	Uint16         i;
+
+	C55x_timebaseSetClock(FAST_CLK_KHZ);
+	C55x_idleInit();
+
+	for (i = 0; i < 20; i++)
+	{
+		C55x_idleDelayUsec(80000);
+		C55x_delay_usec(20000);
+	}
+
+	C55x_idleGetStats(&stats);
+
+	expectTicks = (Uint32)((2ULL * FAST_CLK_KHZ * 1000) >>
+	                       C55X_IDLE_TICK_SHIFT);
+	CHECK(stats.totalTicks >= expectTicks);
+	CHECK(stats.totalTicks < expectTicks + expectTicks / 20);
+	CHECK(stats.idlePercent >= 75);
+	CHECK(stats.idlePercent <= 82);
+
+	C55x_timebaseInit();
+}
+
+int main(void)
+{
+	C55x_timebaseInit();
+
+	TEST_RUN(test_workSkipsIdle);
+	TEST_RUN(test_delayIdles);
+	TEST_RUN(test_loadPastCycleWrap);
+
+	return (testFailures);
+}
@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_dsp_kernels.c
+*
+*   \brief Bit-exactness of every DSP kernel against a reference model,
+*          and kernel benchmarks.
+*
+*   The models here compute each kernel's definition directly with 64-bit
+*   arithmetic. DSP_gain() is checked against DSP_gainRef() as well, built
+*   with DSP_FAST_PATHS and the host models of the C55x intrinsics, so its
+*   fast path runs here as written for the target.
+*
+*   The benchmarks time the host build in nanoseconds. They only compare
+*   the kernels with each other; target cycles have to be measured on the
+*   C5545 with the GPT0 timebase.
+*
+*/
+
+#include "test.h"
+#include "dsp_kernels.h"
+
+TEST_MAIN_DATA;
+
+#define RANDOM_CASES    (1000000)
+#define MAX_TAPS        (255)
+#define MAX_SECTIONS    (6)
+#define BENCH_BLOCK     (48)
+#define BENCH_TAPS      (32)
+#define BENCH_SECTIONS  (4)
+
+static const Int16 corners[] =
+    { -32768, -32767, -16384, -1, 0, 1, 16384, 32767 };
+#define NUM_CORNERS     (sizeof(corners) / sizeof(corners[0]))
+
+static Int16 rand16(void)
+{
+	return ((Int16)(rand() >> 3));
+}
+
+static Int16 refSat16(long long value)
+{
+	return ((Int16)((value > 32767) ? 32767 :
+	                ((value < -32768) ? -32768 : value)));
+}
+
+/* Rounded and saturated, as the kernels return an accumulator */
+static Int16 refRound(long long acc, Uint16 shift)
+{
+	return (refSat16((acc + (1LL << (shift - 1))) >> shift));
+}
+
+static Int16 refMix(Int16 a, Int16 b, Int16 gainA, Int16 gainB)
+{
+	return (refSat16(((long long)a * gainA + (long long)b * gainB) >> 15));
+}
+
+static Uint32 mixDiffers(Int16 a, Int16 b, Int16 gainA, Int16 gainB)
+{
+	Int16 out;
+
+	DSP_mix(&a, &b, &out, 1, gainA, gainB);
+
+	return (out != refMix(a, b, gainA, gainB));
+}
+
+static void test_mixBitExact(void)
+{
+	static Int16 a[200];
+	static Int16 b[200];
+	static Int16 out[200];
+	Int16  gainA;
+	Int16  gainB;
+	Uint32 errors = 0;
+	Uint32 i;
+
+	a[0] = -32768;
+	b[0] = -32768;
+
+	/* Saturating the first product on its own would give 0 here */
+	DSP_mix(a, b, out, 1, -32768, 32767);
+	CHECK_EQ(out[0], 1);
+
+	for (i = 0; i < NUM_CORNERS * NUM_CORNERS * NUM_CORNERS * NUM_CORNERS;
+	     i++)
+	{
+		errors += mixDiffers(corners[i % NUM_CORNERS],
+		                     corners[(i / NUM_CORNERS) % NUM_CORNERS],
+		                     corners[(i / (NUM_CORNERS * NUM_CORNERS)) %
+		                             NUM_CORNERS],
+		                     corners[i / (NUM_CORNERS * NUM_CORNERS *
+		                                  NUM_CORNERS)]);
+	}
+	for (i = 0; i < RANDOM_CASES; i++)
+	{
+		errors += mixDiffers(rand16(), rand16(), rand16(), rand16());
+	}
+
+	/* Whole blocks, written over the first input */
+	gainA = rand16();
+	gainB = rand16();
+	for (i = 0; i < 200; i++)
+	{
+		a[i] = rand16();
+		b[i] = rand16();
+		out[i] = refMix(a[i], b[i], gainA, gainB);
+	}
+	DSP_mix(a, b, a, 200, gainA, gainB);
+	errors += (memcmp(a, out, sizeof(out)) != 0);
+
+	CHECK_EQ(errors, 0);
+}
+
+static void test_gainBitExact(void)
+{
+	Int16  in;
+	Int16  fast;
+	Int16  ref;
+	Int16  gain;
+	Uint32 errors = 0;
+	Uint32 i;
+	Uint16 shift;
+
+	for (shift = 0; shift < 16; shift++)
+	{
+		for (i = 0; i < NUM_CORNERS * NUM_CORNERS + RANDOM_CASES / 16; i++)
+		{
+			if (i < NUM_CORNERS * NUM_CORNERS)
+			{
+				in   = corners[i % NUM_CORNERS];
+				gain = corners[i / NUM_CORNERS];
+			}
+			else
+			{
+				in   = rand16();
+				gain = rand16();
+			}
+			DSP_gain(&in, &fast, 1, gain, shift);
+			DSP_gainRef(&in, &ref, 1, gain, shift);
+			errors += (fast != ref);
+			errors += (ref != refSat16(((long long)in * gain) >>
+			                           (15 - shift)));
+		}
+	}
+	CHECK_EQ(errors, 0);
+}
+
+/* The FIR over a whole stream, with the history kept by the model */
+static void refFir(const Int16 *coefs, Uint16 taps, const Int16 *x,
+                   Uint32 n, Int16 *out)
+{
+	long long acc = 0;
+	Uint16    k;
+
+	for (k = 0; (k < taps) && (k <= n); k++)
+	{
+		acc += (long long)coefs[k] * x[n - k];
+	}
+	*out = refRound(acc, 15);
+}
+
+/* The FIR against the model over one stream, fed in blocks of any length
+ * including ones longer than DSP_FIR_MAX_BLOCK */
+static void test_firBitExact(void)
+{
+	static const Uint16 tapsList[]  = { 1, 2, 3, 17, 64, MAX_TAPS };
+	static const Uint16 blockList[] = { 1, 2, 7, 63, 64, 65, 200 };
+	static Int16 coefs[MAX_TAPS];
+	static Int16 work[DSP_FIR_WORK_LEN(MAX_TAPS)];
+	static Int16 stream[4 * 402];
+	static Int16 out[200];
+	DSP_Fir fir;
+	Int16   expect;
+	Uint32  errors = 0;
+	Uint32  pos;
+	Uint16  t;
+	Uint16  b;
+	Uint16  i;
+	Uint16  pass;
+
+	for (t = 0; t < sizeof(tapsList) / sizeof(tapsList[0]); t++)
+	{
+		for (i = 0; i < tapsList[t]; i++)
+		{
+			coefs[i] = (t & 1) ? corners[i % NUM_CORNERS] : rand16();
+		}
+		DSP_firInit(&fir, coefs, work, tapsList[t]);
+		pos = 0;
+
+		for (pass = 0; pass < 4; pass++)
+		{
+			for (b = 0; b < sizeof(blockList) / sizeof(blockList[0]); b++)
+			{
+				for (i = 0; i < blockList[b]; i++)
+				{
+					stream[pos + i] = (pass & 1) ?
+					    corners[rand() % NUM_CORNERS] : rand16();
+				}
+				DSP_firBlock(&fir, &stream[pos], out, blockList[b]);
+				for (i = 0; i < blockList[b]; i++)
+				{
+					refFir(coefs, tapsList[t], stream, pos + i, &expect);
+					errors += (out[i] != expect);
+				}
+				pos += blockList[b];
+			}
+		}
+	}
+	CHECK_EQ(errors, 0);
+}
+
+/* A block longer than DSP_FIR_MAX_BLOCK still gives the whole impulse
+ * response, so the history carries across the pieces */
+static void test_firLongBlock(void)
+{
+	static Int16 coefs[100];
+	static Int16 work[DSP_FIR_WORK_LEN(100)];
+	static Int16 in[150];
+	static Int16 out[150];
+	DSP_Fir fir;
+	Uint16  i;
+
+	for (i = 0; i < 100; i++)
+	{
+		coefs[i] = (Int16)(i * 300 - 15000);
+	}
+	memset(in, 0, sizeof(in));
+	in[0] = 32767;
+
+	DSP_firInit(&fir, coefs, work, 100);
+	DSP_firBlock(&fir, in, out, 150);
+
+	for (i = 0; i < 150; i++)
+	{
+		CHECK_EQ(out[i], (i < 100) ?
+		         (Int16)(((Int32)coefs[i] * 32767 + 0x4000) >> 15) : 0);
+	}
+}
+
+/* Direct form I cascade, each section rounded and saturated to Q15 */
+static void refBiquad(const Int16 *coefs, Int16 state[][4], Uint16 sections,
+                      const Int16 *in, Int16 *out, Uint16 count)
+{
+	const Int16 *c;
+	long long    acc;
+	Int16        x;
+	Int16        y;
+	Uint16       n;
+	Uint16       sec;
+
+	for (n = 0; n < count; n++)
+	{
+		x = in[n];
+		for (sec = 0; sec < sections; sec++)
+		{
+			c   = &coefs[sec * DSP_BIQUAD_NUM_COEFS];
+			acc = (long long)c[0] * x + (long long)c[1] * state[sec][0] +
+			      (long long)c[2] * state[sec][1] -
+			      (long long)c[3] * state[sec][2] -
+			      (long long)c[4] * state[sec][3];
+			y = refRound(acc, DSP_BIQUAD_COEF_SHIFT);
+
+			state[sec][1] = state[sec][0];
+			state[sec][0] = x;
+			state[sec][3] = state[sec][2];
+			state[sec][2] = y;
+			x = y;
+		}
+		out[n] = x;
+	}
+}
+
+/* Random and full scale coefficients, so the sections saturate as well,
+ * over several blocks to carry the state, in place and out of place */
+static void test_biquadBitExact(void)
+{
+	static const Uint16 blockList[] = { 1, 5, 48, 64, 200 };
+	static Int16 coefs[MAX_SECTIONS * DSP_BIQUAD_NUM_COEFS];
+	static Int16 state[MAX_SECTIONS * DSP_BIQUAD_NUM_STATE];
+	static Int16 refState[MAX_SECTIONS][4];
+	static Int16 in[200];
+	static Int16 out[200];
+	static Int16 expect[200];
+	DSP_Biquad bq;
+	Uint32     errors = 0;
+	Uint16     sections;
+	Uint16     b;
+	Uint16     i;
+	Uint16     pass;
+
+	for (sections = 1; sections <= MAX_SECTIONS; sections++)
+	{
+		for (i = 0; i < sections * DSP_BIQUAD_NUM_COEFS; i++)
+		{
+			coefs[i] = (sections & 1) ? rand16() :
+			                            corners[rand() % NUM_CORNERS];
+		}
+		DSP_biquadInit(&bq, coefs, state, sections);
+		memset(refState, 0, sizeof(refState));
+
+		for (pass = 0; pass < 3; pass++)
+		{
+			for (b = 0; b < sizeof(blockList) / sizeof(blockList[0]); b++)
+			{
+				for (i = 0; i < blockList[b]; i++)
+				{
+					in[i] = (pass == 1) ? corners[rand() % NUM_CORNERS] :
+					                      rand16();
+				}
+				refBiquad(coefs, refState, sections, in, expect,
+				          blockList[b]);
+				if (b & 1)
+				{
+					DSP_biquadBlock(&bq, in, in, blockList[b]);
+					errors += (memcmp(in, expect,
+					                  blockList[b] * sizeof(Int16)) != 0);
+				}
+				else
+				{
+					DSP_biquadBlock(&bq, in, out, blockList[b]);
+					errors += (memcmp(out, expect,
+					                  blockList[b] * sizeof(Int16)) != 0);
+				}
+			}
+		}
+	}
+	CHECK_EQ(errors, 0);
+}
+
+/* A pass-through section and a one-pole lowpass with known outputs */
+static void test_biquadKnownResponse(void)
+{
+	static const Int16 coefs[2 * DSP_BIQUAD_NUM_COEFS] =
+	{
+		16384, 0, 0, 0, 0,          /* y = x                     */
+		8192, 0, 0, -8192, 0        /* y = x / 2 + y[n-1] / 2    */
+	};
+	Int16      state[2 * DSP_BIQUAD_NUM_STATE];
+	Int16      in[4] = { 32767, 0, 0, 0 };
+	Int16      out[4];
+	DSP_Biquad bq;
+
+	DSP_biquadInit(&bq, coefs, state, 2);
+	DSP_biquadBlock(&bq, in, out, 4);
+
+	CHECK_EQ(out[0], 16384);
+	CHECK_EQ(out[1], 8192);
+	CHECK_EQ(out[2], 4096);
+	CHECK_EQ(out[3], 2048);
+}
+
+static void test_interleave(void)
+{
+	Int16  left[65];
+	Int16  right[65];
+	Int16  frames[130];
+	Int16  backLeft[65];
+	Int16  backRight[65];
+	Uint16 i;
+	Uint32 errors = 0;
+
+	for (i = 0; i < 65; i++)
+	{
+		left[i]  = rand16();
+		right[i] = rand16();
+	}
+
+	frames[129] = 0x5A5A;
+	DSP_interleave(left, right, frames, 64);
+	for (i = 0; i < 64; i++)
+	{
+		errors += (frames[2 * i] != left[i]);
+		errors += (frames[2 * i + 1] != right[i]);
+	}
+	CHECK_EQ(frames[129], 0x5A5A);
+
+	backLeft[64]  = 0x1234;
+	backRight[64] = 0x4321;
+	DSP_deinterleave(frames, backLeft, backRight, 64);
+	errors += (memcmp(backLeft, left, 64 * sizeof(Int16)) != 0);
+	errors += (memcmp(backRight, right, 64 * sizeof(Int16)) != 0);
+	CHECK_EQ(backLeft[64], 0x1234);
+	CHECK_EQ(backRight[64], 0x4321);
+
+	CHECK_EQ(errors, 0);
+}
+
+static void bench_kernels(void)
+{
+	static Int16 coefs[BENCH_TAPS];
+	static Int16 work[DSP_FIR_WORK_LEN(BENCH_TAPS)];
+	static Int16 bqCoefs[BENCH_SECTIONS * DSP_BIQUAD_NUM_COEFS];
+	static Int16 bqState[BENCH_SECTIONS * DSP_BIQUAD_NUM_STATE];
+	static Int16 a[2 * BENCH_BLOCK];
+	static Int16 b[2 * BENCH_BLOCK];
+	static Int16 out[2 * BENCH_BLOCK];
+	DSP_Fir    fir;
+	DSP_Biquad bq;
+	Uint16     i;
+
+	for (i = 0; i < 2 * BENCH_BLOCK; i++)
+	{
+		a[i] = rand16();
+		b[i] = rand16();
+	}
+	for (i = 0; i < BENCH_TAPS; i++)
+	{
+		coefs[i] = rand16() >> 4;
+	}
+	for (i = 0; i < BENCH_SECTIONS * DSP_BIQUAD_NUM_COEFS; i++)
+	{
+		bqCoefs[i] = rand16() >> 2;
+	}
+	DSP_firInit(&fir, coefs, work, BENCH_TAPS);
+	DSP_biquadInit(&bq, bqCoefs, bqState, BENCH_SECTIONS);
+
+	BENCH("DSP_firBlock 32 taps x 48", 100000,
+	      DSP_firBlock(&fir, a, out, BENCH_BLOCK));
+	BENCH("DSP_biquadBlock 4 sections x 48", 100000,
+	      DSP_biquadBlock(&bq, a, out, BENCH_BLOCK));
+	BENCH("DSP_mix 2 x 48", 1000000,
+	      DSP_mix(a, b, out, 2 * BENCH_BLOCK, 0x4000, 0x4000));
+	BENCH("DSP_gain 2 x 48", 1000000,
+	      DSP_gain(a, out, 2 * BENCH_BLOCK, 0x5A82, 1));
+	BENCH("DSP_gainRef 2 x 48", 1000000,
+	      DSP_gainRef(a, out, 2 * BENCH_BLOCK, 0x5A82, 1));
+	BENCH("DSP_interleave 48", 1000000,
+	      DSP_interleave(a, b, out, BENCH_BLOCK));
+}
+
+int main(void)
+{
+	srand(5545);
+
+	TEST_RUN(test_mixBitExact);
+	TEST_RUN(test_gainBitExact);
+	TEST_RUN(test_firBitExact);
+	TEST_RUN(test_firLongBlock);
+	TEST_RUN(test_biquadBitExact);
+	TEST_RUN(test_biquadKnownResponse);
+	TEST_RUN(test_interleave);
+	TEST_RUN(bench_kernels);
+
+	return (testFailures);
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_gpio_debounce.c
+*
+*   \brief Host test of the GPIO debouncer: recorded style bounce traces
+*          are replayed through it one time step at a time.
+*
+*/
+
+#include "test.h"
+#include "gpio_debounce.h"
+
+TEST_MAIN_DATA;
+
+#define QUIET       (20)
+
+/* One edge of a trace: the level the pin goes to at 'time' */
+typedef struct
+{
+	Uint32  time;
+	Uint16  level;
+} TraceEdge;
+
+/* One level the debouncer accepted */
+typedef struct
+{
+	Uint32  time;
+	Uint16  level;
+	Uint16  bounces;
+	Uint32  firstEdge;
+} TraceChange;
+
+/* Steps from 'start' to 'start + steps', delivering the edges at their
+ * time and polling with the pin level after them, as the dispatcher
+ * does. Returns the number of accepted changes. */
+static Uint16 replay(GPIO_Debounce *db, Uint32 start, Uint32 steps,
+                     const TraceEdge *edges, Uint16 edgeCount,
+                     TraceChange *changes, Uint16 maxChanges,
+                     Uint16 *filtered)
+{
+	Uint32 step;
+	Uint32 now;
+	Uint16 level = db->stable;
+	Uint16 e = 0;
+	Uint16 count = 0;
+	Bool   wasPending;
+
+	*filtered = 0;
+
+	for (step = 0; step <= steps; step++)
+	{
+		now = start + step;
+
+		while ((e < edgeCount) && (edges[e].time == now))
+		{
+			level = edges[e].level;
+			GPIO_debounceEdge(db, now);
+			e++;
+		}
+
+		wasPending = db->pending;
+		if (GPIO_debouncePoll(db, now, QUIET, level))
+		{
+			if (count < maxChanges)
+			{
+				changes[count].time      = now;
+				changes[count].level     = db->stable;
+				changes[count].bounces   = db->bounces;
+				changes[count].firstEdge = db->firstEdge;
+			}
+			count++;
+		}
+		else if (wasPending && !db->pending)
+		{
+			(*filtered)++;
+		}
+	}
+
+	CHECK_EQ(e, edgeCount);
+
+	return (count);
+}
+
+static void test_cleanEdge(void)
+{
+	static const TraceEdge trace[] = { { 100, 1 } };
+	GPIO_Debounce db;
+	TraceChange   changes[4];
+	Uint16        filtered;
+
+	GPIO_debounceInit(&db, 0);
+	CHECK_EQ(replay(&db, 0, 200, trace, 1, changes, 4, &filtered), 1);
+	CHECK_EQ(changes[0].time, 100 + QUIET);
+	CHECK_EQ(changes[0].level, 1);
+	CHECK_EQ(changes[0].bounces, 1);
+	CHECK_EQ(filtered, 0);
+}
+
+/* A press that rings for a while: one change, timed from the first edge,
+ * accepted a quiet time after the last one */
+static void test_bouncyPress(void)
+{
+	static const TraceEdge trace[] =
+	{
+		{ 100, 1 }, { 102, 0 }, { 103, 1 }, { 107, 0 }, { 108, 1 },
+		{ 115, 0 }, { 116, 1 }
+	};
+	GPIO_Debounce db;
+	TraceChange   changes[4];
+	Uint16        filtered;
+
+	GPIO_debounceInit(&db, 0);
+	CHECK_EQ(replay(&db, 0, 300, trace, 7, changes, 4, &filtered), 1);
+	CHECK_EQ(changes[0].time, 116 + QUIET);
+	CHECK_EQ(changes[0].level, 1);
+	CHECK_EQ(changes[0].bounces, 7);
+	CHECK_EQ(changes[0].firstEdge, 100);
+	CHECK_EQ(filtered, 0);
+}
+
+/* Edges closer than the quiet time never let a level through early */
+static void test_noEarlyAccept(void)
+{
+	static const TraceEdge trace[] =
+	{
+		{ 10, 1 }, { 25, 0 }, { 40, 1 }, { 55, 0 }, { 70, 1 }
+	};
+	GPIO_Debounce db;
+	TraceChange   changes[4];
+	Uint16        filtered;
+
+	GPIO_debounceInit(&db, 0);
+	CHECK_EQ(replay(&db, 0, 70 + QUIET - 1, trace, 5, changes, 4,
+	                &filtered), 0);
+	CHECK(db.pending);
+	CHECK_EQ(db.stable, 0);
+
+	CHECK(GPIO_debouncePoll(&db, 70 + QUIET, QUIET, 1));
+	CHECK_EQ(db.bounces, 5);
+}
+
+/* Noise that settles back where it began is dropped */
+static void test_glitchFiltered(void)
+{
+	static const TraceEdge trace[] =
+	{
+		{ 50, 1 }, { 51, 0 }, { 53, 1 }, { 54, 0 }
+	};
+	GPIO_Debounce db;
+	TraceChange   changes[4];
+	Uint16        filtered;
+
+	GPIO_debounceInit(&db, 0);
+	CHECK_EQ(replay(&db, 0, 200, trace, 4, changes, 4, &filtered), 0);
+	CHECK_EQ(filtered, 1);
+	CHECK(!db.pending);
+	CHECK_EQ(db.stable, 0);
+}
+
+/* Press and release, both bouncing, on a clock about to wrap */
+static void test_pressReleaseAcrossWrap(void)
+{
+	static const TraceEdge trace[] =
+	{
+		{ 0xFFFFFFF0UL, 1 }, { 0xFFFFFFF3UL, 0 }, { 0xFFFFFFF5UL, 1 },
+		{ 60, 0 }, { 61, 1 }, { 64, 0 }
+	};
+	GPIO_Debounce db;
+	TraceChange   changes[4];
+	Uint16        filtered;
+
+	GPIO_debounceInit(&db, 0);
+	CHECK_EQ(replay(&db, 0xFFFFFF00UL, 0x200, trace, 6, changes, 4,
+	                &filtered), 2);
+
+	CHECK_EQ(changes[0].time, (Uint32)(0xFFFFFFF5UL + QUIET));
+	CHECK_EQ(changes[0].level, 1);
+	CHECK_EQ(changes[0].bounces, 3);
+	CHECK_EQ(changes[0].firstEdge, 0xFFFFFFF0UL);
+
+	CHECK_EQ(changes[1].time, 64 + QUIET);
+	CHECK_EQ(changes[1].level, 0);
+	CHECK_EQ(changes[1].bounces, 3);
+	CHECK_EQ(changes[1].firstEdge, 60);
+	CHECK_EQ(filtered, 0);
+}
+
+/* Without a clock every quiet time is zero and a level counts at once */
+static void test_zeroQuietTime(void)
+{
+	GPIO_Debounce db;
+
+	GPIO_debounceInit(&db, 1);
+	GPIO_debounceEdge(&db, 5);
+	CHECK(GPIO_debouncePoll(&db, 5, 0, 0));
+	CHECK_EQ(db.stable, 0);
+	CHECK(!GPIO_debouncePoll(&db, 6, 0, 0));
+}
+
+int main(void)
+{
+	TEST_RUN(test_cleanEdge);
+	TEST_RUN(test_bouncyPress);
+	TEST_RUN(test_noEarlyAccept);
+	TEST_RUN(test_glitchFiltered);
+	TEST_RUN(test_pressReleaseAcrossWrap);
+	TEST_RUN(test_zeroQuietTime);
+
+	return (testFailures);
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_gpio_event.c
+*
+*   \brief Host test of the GPIO event dispatcher: edges go from the ISR
+*          through the command queue to the debounced callbacks.
+*
+*/
+
+#include "test.h"
+#include "cmd_queue.h"
+#include "gpio_event.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+#define BUTTON_PIN          (13)
+#define DEBOUNCE_USEC       (5000)
+
+static Uint16      callCount;
+static Uint16      pressCount;
+static GPIO_Event  lastPress;
+
+static void nopCall(Uint16 arg0, Uint16 arg1)
+{
+	callCount++;
+}
+
+static void onPress(const GPIO_Event *event, void *arg)
+{
+	lastPress = *event;
+	pressCount++;
+}
+
+/* Waits out the debounce time, dispatching as the main loop does */
+static Uint16 settle(Uint32 usec)
+{
+	Uint32 start = C55x_nowUsec();
+	Uint16 delivered = 0;
+
+	do
+	{
+		CMD_dispatch();
+		delivered += GPIO_eventDispatch();
+	} while ((Uint32)(C55x_nowUsec() - start) < usec);
+
+	return (delivered);
+}
+
+/* Opened before the timebase runs, as at boot: the quiet time still has
+ * to follow the clock started afterwards */
+static void test_gpioEdgesThroughQueue(void)
+{
+	GPIO_EventStats gpioStats;
+	CMD_QueueStats  stats;
+
+	CMD_queueInit();
+	CHECK_EQ(gpio_interrupt_initiliastion(), TEST_PASS);
+	CHECK_EQ(GPIO_eventOpen(DEBOUNCE_USEC), TEST_PASS);
+	CHECK_EQ(GPIO_eventRegister(BUTTON_PIN, GPIO_EDGE_RISING, onPress,
+	                            NULL), TEST_PASS);
+	C55x_timebaseInit();
+	CMD_setClock(C55x_nowCycles);
+
+	/* The bouncing press: rising edges interrupt, the ISR posts each */
+	HOST_gpioSetPin(BUTTON_PIN, 1);
+	HOST_gpioSetPin(BUTTON_PIN, 0);
+	HOST_gpioSetPin(BUTTON_PIN, 1);
+	HOST_gpioSetPin(BUTTON_PIN, 0);
+	HOST_gpioSetPin(BUTTON_PIN, 1);
+	CHECK_EQ(CMD_queueDepth(), 3);
+
+	CHECK_EQ(CMD_dispatch(), 3);
+	CHECK_EQ(GPIO_eventDispatch(), 0);
+	CHECK_EQ(pressCount, 0);
+
+	CHECK_EQ(settle(DEBOUNCE_USEC + 1000), 1);
+	CHECK_EQ(pressCount, 1);
+	CHECK_EQ(lastPress.pin, BUTTON_PIN);
+	CHECK_EQ(lastPress.edge, GPIO_EDGE_RISING);
+	CHECK_EQ(lastPress.bounces, 3);
+
+	/* Released and pressed again with the queue full: the edge is lost
+	 * and counted, and the level is never seen to change */
+	HOST_gpioSetPin(BUTTON_PIN, 0);
+	settle(DEBOUNCE_USEC + 1000);
+	while (CMD_postCall(nopCall, 0, 0))
+	{
+	}
+	HOST_gpioSetPin(BUTTON_PIN, 1);
+	settle(DEBOUNCE_USEC + 1000);
+	CHECK_EQ(pressCount, 1);
+
+	GPIO_eventGetStats(&gpioStats);
+	CHECK_EQ(gpioStats.interrupts, 5);
+	CHECK_EQ(gpioStats.edges, 4);
+	CHECK_EQ(gpioStats.events, 2);
+	CHECK_EQ(gpioStats.dropped, 1);
+
+	CMD_getStats(&stats);
+	CHECK_EQ(stats.isrCount, 5);
+	CHECK_EQ(stats.depth, 0);
+}
+
+/* Opens the dispatcher on a released button */
+static void buttonSetup(void)
+{
+	HOST_gpioSetPin(BUTTON_PIN, 0);
+	CMD_queueInit();
+	CHECK_EQ(GPIO_eventOpen(DEBOUNCE_USEC), TEST_PASS);
+	CHECK_EQ(GPIO_eventRegister(BUTTON_PIN, GPIO_EDGE_RISING, onPress,
+	                            NULL), TEST_PASS);
+	pressCount = 0;
+}
+
+/* A bounce the ISR posts after the main loop's CMD_dispatch() holds the
+ * level back until it has been fed and its own window has passed */
+static void test_edgeAfterCmdDispatch(void)
+{
+	buttonSetup();
+
+	HOST_gpioSetPin(BUTTON_PIN, 1);
+	CHECK_EQ(CMD_dispatch(), 1);
+	C55x_delay_usec(DEBOUNCE_USEC + 1000);
+
+	/* The first window is over, then the contact bounces */
+	CHECK_EQ(CMD_dispatch(), 0);
+	HOST_gpioSetPin(BUTTON_PIN, 0);
+	HOST_gpioSetPin(BUTTON_PIN, 1);
+	CHECK_EQ(GPIO_eventDispatch(), 0);
+	CHECK_EQ(pressCount, 0);
+
+	CHECK_EQ(CMD_dispatch(), 1);
+	CHECK_EQ(GPIO_eventDispatch(), 0);
+
+	CHECK_EQ(settle(DEBOUNCE_USEC + 1000), 1);
+	CHECK_EQ(pressCount, 1);
+	CHECK_EQ(lastPress.bounces, 2);
+}
+
+/* An interrupt without a registered pin's flag posts nothing */
+static void test_emptyInterruptNotPosted(void)
+{
+	GPIO_EventStats gpioStats;
+
+	buttonSetup();
+
+	HOST_irqRaise(GPIO_EVENT);
+	CHECK_EQ(CMD_queueDepth(), 0);
+
+	GPIO_eventGetStats(&gpioStats);
+	CHECK_EQ(gpioStats.interrupts, 1);
+	CHECK_EQ(gpioStats.dropped, 0);
+}
+
+int main(void)
+{
+	TEST_RUN(test_gpioEdgesThroughQueue);
+	TEST_RUN(test_edgeAfterCmdDispatch);
+	TEST_RUN(test_emptyInterruptNotPosted);
+
+	return (testFailures);
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_i2c_async.c
+*
+*   \brief Host test of the interrupt driven I2C driver on the simulated
+*          bus, with the model polled from a timer so the ISR preempts
+*          the main thread as on the target.
+*
+*/
+
+#include "test.h"
+#include "i2c_async.h"
+#include "aic3206_seq.h"
+#include "aic3206_cache.h"
+#include "i2c_clock.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+#define TICK_USEC       (100)
+#define WAIT_USEC       (50000)
+
+#define STUCK_ADDR      (0x50)
+#define ABSENT_ADDR     (0x51)
+
+typedef struct
+{
+	Uint16      count;
+	Uint16      order[I2C_ASYNC_QUEUE_SIZE];
+	CSL_Status  status[I2C_ASYNC_QUEUE_SIZE];
+} DoneLog;
+
+static DoneLog doneLog;
+
+static void txnDone(CSL_Status status, void *arg)
+{
+	if (doneLog.count < I2C_ASYNC_QUEUE_SIZE)
+	{
+		doneLog.order[doneLog.count]  = (Uint16)(size_t)arg;
+		doneLog.status[doneLog.count] = status;
+		doneLog.count++;
+	}
+}
+
+static Bool waitDone(Uint16 count)
+{
+	Uint32 deadline = C55x_deadline(WAIT_USEC);
+
+	while (doneLog.count < count)
+	{
+		if (C55x_deadlinePassed(deadline))
+		{
+			return (FALSE);
+		}
+	}
+
+	return (TRUE);
+}
+
+static void busSetup(void)
+{
+	HOST_i2cReset();
+	HOST_aic3206Attach();
+	I2C_clockSetBusRate(I2C_BUS_RATE_400K);
+	AIC3206_cacheInvalidate();
+	memset(&doneLog, 0, sizeof(doneLog));
+	I2C_asyncOpen();
+}
+
+/* ICCNT = 0 would move 65536 bytes */
+static void test_rejectsEmpty(void)
+{
+	static const Uint16 reg = 1;
+	Uint16              data;
+	I2C_AsyncStats      stats;
+	HOST_I2cStats       bus;
+
+	busSetup();
+
+	CHECK_EQ(I2C_asyncWrite(AIC3206_I2C_ADDR, &reg, 0, txnDone, NULL),
+	         TEST_FAIL);
+	CHECK_EQ(I2C_asyncWriteRead(AIC3206_I2C_ADDR, &reg, 0, &data, 0,
+	                            txnDone, NULL), TEST_FAIL);
+	CHECK_EQ(I2C_asyncWriteRead(AIC3206_I2C_ADDR, &reg, 1, &data, 0,
+	                            txnDone, NULL), TEST_FAIL);
+
+	/* An empty burst still sends the register address */
+	CHECK_EQ(I2C_asyncBurst(AIC3206_I2C_ADDR, 1, NULL, 0, txnDone, NULL),
+	         TEST_PASS);
+	CHECK(waitDone(1));
+
+	I2C_asyncGetStats(&stats);
+	CHECK_EQ(stats.rejected, 3);
+	CHECK_EQ(stats.submitted, 1);
+
+	HOST_i2cGetStats(&bus);
+	CHECK_EQ(bus.zeroCount, 0);
+
+	CHECK_EQ(I2C_asyncClose(WAIT_USEC), TEST_PASS);
+}
+
+static void test_inOrderCompletion(void)
+{
+	static const Uint16 run1[] = { 0x0d, 0x00 };
+	static const Uint16 page1  = 1;
+	static const Uint16 run2[] = { 0x30, 0x01 };
+	static const Uint16 reg    = 9;
+	Uint16              data   = 0;
+	I2C_AsyncStats      stats;
+	HOST_I2cStats       bus;
+
+	busSetup();
+
+	/* Page 0 burst, page select, page 1 burst, read back */
+	CHECK_EQ(I2C_asyncBurst(AIC3206_I2C_ADDR, 27, run1, 2, txnDone,
+	                        (void *)1), TEST_PASS);
+	CHECK_EQ(I2C_asyncBurst(AIC3206_I2C_ADDR, 0, &page1, 1, txnDone,
+	                        (void *)2), TEST_PASS);
+	CHECK_EQ(I2C_asyncBurst(AIC3206_I2C_ADDR, 9, run2, 2, txnDone,
+	                        (void *)3), TEST_PASS);
+	CHECK_EQ(I2C_asyncWriteRead(AIC3206_I2C_ADDR, &reg, 1, &data, 1,
+	                            txnDone, (void *)4), TEST_PASS);
+
+	/* Queued, not sent: the submits return well before the bus is done */
+	CHECK(I2C_asyncPending() > 0);
+
+	CHECK(waitDone(4));
+	CHECK_EQ(doneLog.order[0], 1);
+	CHECK_EQ(doneLog.order[1], 2);
+	CHECK_EQ(doneLog.order[2], 3);
+	CHECK_EQ(doneLog.order[3], 4);
+	CHECK_EQ(doneLog.status[3], CSL_SOK);
+
+	CHECK_EQ(HOST_aic3206Reg(0, 27), 0x0d);
+	CHECK_EQ(HOST_aic3206Reg(1, 9), 0x30);
+	CHECK_EQ(HOST_aic3206Reg(1, 10), 0x01);
+	CHECK_EQ(data, 0x30);
+
+	I2C_asyncGetStats(&stats);
+	CHECK_EQ(stats.completed, 4);
+
+	/* Write-read is two starts */
+	HOST_i2cGetStats(&bus);
+	CHECK_EQ(bus.transactions, 5);
+	CHECK(HOST_irqCount(I2C_EVENT) > 0);
+
+	CHECK_EQ(I2C_asyncClose(WAIT_USEC), TEST_PASS);
+}
+
+static void test_nackThenNext(void)
+{
+	static const Uint16 data[] = { 0x55 };
+
+	busSetup();
+
+	CHECK_EQ(I2C_asyncWrite(ABSENT_ADDR, data, 1, txnDone, (void *)1),
+	         TEST_PASS);
+	CHECK_EQ(I2C_asyncBurst(AIC3206_I2C_ADDR, 20, data, 1, txnDone,
+	                        (void *)2), TEST_PASS);
+
+	CHECK(waitDone(2));
+	CHECK_EQ(doneLog.status[0], CSL_I2C_NACK_ERR);
+	CHECK_EQ(doneLog.status[1], CSL_SOK);
+	CHECK_EQ(HOST_aic3206Reg(0, 20), 0x55);
+
+	CHECK_EQ(I2C_asyncClose(WAIT_USEC), TEST_PASS);
+}
+
+/* A device holding SCL low must not hang the close */
+static void test_closeTimesOut(void)
+{
+	static const Uint16 data[] = { 0x55 };
+	HOST_I2cDevice      stuck;
+	I2C_AsyncStats      stats;
+	Uint32              start;
+	Uint32              elapsed;
+
+	busSetup();
+	memset(&stuck, 0, sizeof(stuck));
+	stuck.addr  = STUCK_ADDR;
+	stuck.stuck = TRUE;
+	HOST_i2cAttach(&stuck);
+
+	CHECK_EQ(I2C_asyncWrite(STUCK_ADDR, data, 1, txnDone, (void *)1),
+	         TEST_PASS);
+	CHECK_EQ(I2C_asyncBurst(AIC3206_I2C_ADDR, 20, data, 1, txnDone,
+	                        (void *)2), TEST_PASS);
+
+	start = C55x_nowUsec();
+	CHECK_EQ(I2C_asyncClose(5000), TEST_FAIL);
+	elapsed = C55x_nowUsec() - start;
+	CHECK(elapsed >= 5000);
+	CHECK(elapsed < 5000 + WAIT_USEC);
+
+	/* Both callbacks ran, so nobody waits on them forever */
+	CHECK_EQ(doneLog.count, 2);
+	CHECK_EQ(doneLog.status[0], CSL_I2C_TIMEOUT_ERROR);
+	CHECK_EQ(doneLog.status[1], CSL_I2C_TIMEOUT_ERROR);
+	CHECK_EQ(I2C_asyncPending(), 0);
+	CHECK(!I2C_asyncIsOpen());
+
+	I2C_asyncGetStats(&stats);
+	CHECK_EQ(stats.aborted, 2);
+
+	/* The module is idle again for the polled calls */
+	CHECK(HOST_i2cIdle());
+}
+
+/* The codec writer queues its bursts instead of polling the bus */
+static void test_codecSeqOnAsync(void)
+{
+	static const AIC3206_RegSeq seq[] =
+	{
+		{ 0, 27, 0x0d, 0 }, { 0, 28, 0x00, 0 },
+		{ 1, 1,  0x08, 0 }, { 1, 2,  0x01, 0 },
+		{ 1, 12, 0x08, 0 }, { 1, 13, 0x08, 0 },
+		{ 0, 64, 0x02, 0 }, { 0, 65, 0x00, 0 }
+	};
+	AIC3206_SeqStats seqStats;
+	I2C_AsyncStats   stats;
+	HOST_I2cStats    bus;
+	Uint32           start;
+	Uint32           queuedUs;
+	Uint16           value;
+	Uint16           i;
+
+	busSetup();
+	AIC3206_clearSeqStats();
+
+	start = C55x_nowUsec();
+	CHECK_EQ(AIC3206_writeSeqNoWait(seq, 8), TEST_PASS);
+	queuedUs = C55x_nowUsec() - start;
+	AIC3206_seqWait();
+
+	for (i = 0; i < 8; i++)
+	{
+		CHECK_EQ(HOST_aic3206Reg(seq[i].page, seq[i].reg), seq[i].value);
+	}
+
+	AIC3206_getSeqStats(&seqStats);
+	I2C_asyncGetStats(&stats);
+	HOST_i2cGetStats(&bus);
+	CHECK_EQ(stats.completed, seqStats.transactions);
+	CHECK_EQ(bus.transactions, seqStats.transactions);
+
+	/* The CPU was back long before the bus was done */
+	CHECK(queuedUs * 2 < bus.busTimeUsec);
+
+	/* Single writes and reads go the same way */
+	AIC3206_write(0, 1);
+	AIC3206_write(20, 0x44);
+	AIC3206_cacheForget();
+	CHECK_EQ(AIC3206_read(20, &value), TEST_PASS);
+	CHECK_EQ(value, 0x44);
+	CHECK_EQ(HOST_aic3206Reg(1, 20), 0x44);
+
+	CHECK_EQ(I2C_asyncClose(WAIT_USEC), TEST_PASS);
+
+	printf("  %lu bursts queued in %lu us, %lu us on the bus\n",
+	       (unsigned long)seqStats.transactions, (unsigned long)queuedUs,
+	       (unsigned long)bus.busTimeUsec);
+}
+
+/* A failed queued burst leaves the shadow knowing nothing */
+static void test_codecFailureForgets(void)
+{
+	static const AIC3206_RegSeq seq[] = { { 0, 27, 0x0d, 0 } };
+	AIC3206_CacheStats cache;
+
+	busSetup();
+
+	/* Codec gone from the bus */
+	HOST_i2cReset();
+	I2C_clockSetBusRate(I2C_BUS_RATE_400K);
+
+	CHECK_EQ(AIC3206_writeSeq(seq, 1), TEST_FAIL);
+	CHECK_EQ(AIC3206_cachePage(), AIC3206_PAGE_UNKNOWN);
+	CHECK(!AIC3206_cacheHolds(0, 27, 0x0d));
+
+	AIC3206_getCacheStats(&cache);
+	CHECK(cache.invalidates > 0);
+
+	CHECK_EQ(I2C_asyncClose(WAIT_USEC), TEST_PASS);
+}
+
+int main(void)
+{
+	C55x_timebaseInit();
+	HOST_irqTicker(TICK_USEC);
+
+	TEST_RUN(test_rejectsEmpty);
+	TEST_RUN(test_inOrderCompletion);
+	TEST_RUN(test_nackThenNext);
+	TEST_RUN(test_closeTimesOut);
+	TEST_RUN(test_codecSeqOnAsync);
+	TEST_RUN(test_codecFailureForgets);
+
+	HOST_irqTicker(0);
+
+	return (testFailures);
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_i2c_clock.c
+*
+*   \brief Host test of the I2C prescaler and SCL timing calculator over
+*          the system clocks the PLL can give, with the resulting rate
+*          checked against the bus model.
+*
+*/
+
+#include "test.h"
+#include "i2c_clock.h"
+
+TEST_MAIN_DATA;
+
+/* System clock sweep, kHz */
+#define SWEEP_FIRST_KHZ     (12000)
+#define SWEEP_LAST_KHZ      (150000)
+#define SWEEP_STEP_KHZ      (250)
+
+/* Obtained rate may be this much below the requested one, percent */
+#define RATE_SLACK_PCT      (10)
+
+typedef struct
+{
+	Uint32  busHz;
+	Uint32  lowMinNs;       /* tLOW minimum of the I2C specification  */
+	Uint32  highMinNs;      /* tHIGH minimum of the I2C specification */
+} BusMode;
+
+static const BusMode busModes[] =
+{
+	{ I2C_BUS_RATE_100K, 4700, 4000 },
+	{ I2C_BUS_RATE_400K, 1300,  600 },
+	{ I2C_BUS_RATE_1M,    500,  260 },
+};
+
+#define BUS_MODES   (sizeof(busModes) / sizeof(busModes[0]))
+
+/* CGCR settings of the PLL, input clock CSL_PLL_CLOCKIN */
+typedef struct
+{
+	Uint16  cgcr1;
+	Uint16  cgcr2;
+	Uint16  cgcr4;
+} PllSetting;
+
+#define PLL_M(m)            (0x8000 | ((m) - 4))
+#define PLL_RD_BYPASS       (0x8000)
+#define PLL_RD(r)           ((r) - 4)
+#define PLL_OD_OFF          (0x0000)
+#define PLL_OD(o)           (0x0200 | ((o) - 1))
+
+static const PllSetting pllSettings[] =
+{
+	{ PLL_M(375),  PLL_RD_BYPASS, PLL_OD_OFF },   /*  12.288 MHz */
+	{ PLL_M(1526), PLL_RD_BYPASS, PLL_OD_OFF },   /*  50.004 MHz */
+	{ PLL_M(1835), PLL_RD_BYPASS, PLL_OD_OFF },   /*  60.129 MHz */
+	{ PLL_M(2289), PLL_RD_BYPASS, PLL_OD_OFF },   /*  75.006 MHz */
+	{ PLL_M(3052), PLL_RD_BYPASS, PLL_OD_OFF },   /* 100.008 MHz */
+	{ PLL_M(3662), PLL_RD_BYPASS, PLL_OD_OFF },   /* 119.996 MHz */
+	{ PLL_M(3052), PLL_RD_BYPASS, PLL_OD(2) },    /*  50.004 MHz */
+	{ PLL_M(4095), PLL_RD(4),     PLL_OD_OFF },   /*  33.546 MHz */
+	{ PLL_M(3000), PLL_RD(5),     PLL_OD(3) },    /*   6.554 MHz */
+};
+
+#define PLL_SETTINGS    (sizeof(pllSettings) / sizeof(pllSettings[0]))
+
+static Uint16 sclDelay(Uint16 psc)
+{
+	return ((psc == 0) ? 7 : ((psc == 1) ? 6 : 5));
+}
+
+/* Checks one result of I2C_clockCompute() against the specification */
+static void checkParams(Uint32 sysClkKhz, const BusMode *mode,
+                        const I2C_ClockParams *params)
+{
+	Uint32 modClkKhz = sysClkKhz / (params->icpsc + 1);
+	Uint16 d = sclDelay(params->icpsc);
+	Uint32 lowNs;
+	Uint32 highNs;
+	Uint32 busHz;
+	int    failures = testFailures;
+
+	CHECK(modClkKhz >= I2C_CLOCK_MODULE_MIN_KHZ);
+	CHECK(modClkKhz <= I2C_CLOCK_MODULE_MAX_KHZ);
+	CHECK(params->icclkl > 0);
+	CHECK(params->icclkh > 0);
+
+	lowNs  = ((params->icclkl + d) * 1000000UL) / modClkKhz;
+	highNs = ((params->icclkh + d) * 1000000UL) / modClkKhz;
+	CHECK(lowNs >= mode->lowMinNs);
+	CHECK(highNs >= mode->highMinNs);
+
+	busHz = (modClkKhz * 1000) / (params->icclkl + params->icclkh + 2 * d);
+	CHECK_EQ(params->busHz, busHz);
+	CHECK(params->busHz <= mode->busHz);
+	CHECK(params->busHz >= mode->busHz - mode->busHz * RATE_SLACK_PCT / 100);
+
+	if (testFailures != failures)
+	{
+		printf("  at %lu kHz, %lu Hz: psc %u low %u high %u\n",
+		       (unsigned long)sysClkKhz, (unsigned long)mode->busHz,
+		       params->icpsc, params->icclkl, params->icclkh);
+	}
+}
+
+static void test_sweepSysClk(void)
+{
+	I2C_ClockParams params;
+	Uint32          sysClkKhz;
+	Uint16          mode;
+
+	for (sysClkKhz = SWEEP_FIRST_KHZ; sysClkKhz <= SWEEP_LAST_KHZ;
+	     sysClkKhz += SWEEP_STEP_KHZ)
+	{
+		for (mode = 0; mode < BUS_MODES; mode++)
+		{
+			if (I2C_clockCompute(sysClkKhz, busModes[mode].busHz,
+			                     &params) == TEST_PASS)
+			{
+				checkParams(sysClkKhz, &busModes[mode], &params);
+			}
+			else
+			{
+				/* Only fast mode plus may be out of reach */
+				CHECK_EQ(busModes[mode].busHz, I2C_BUS_RATE_1M);
+			}
+		}
+	}
+}
+
+static void test_fastModePlusReach(void)
+{
+	I2C_ClockParams params;
+
+	/* 16 module clocks per bit at least with the prescaler bypassed */
+	CHECK_EQ(I2C_clockCompute(12288, I2C_BUS_RATE_1M, &params), TEST_FAIL);
+	CHECK_EQ(I2C_clockCompute(100000, I2C_BUS_RATE_1M, &params), TEST_PASS);
+	CHECK_EQ(I2C_clockCompute(120000, I2C_BUS_RATE_1M, &params), TEST_PASS);
+}
+
+static void test_invalidInput(void)
+{
+	I2C_ClockParams params;
+
+	CHECK_EQ(I2C_clockCompute(0, I2C_BUS_RATE_400K, &params), TEST_FAIL);
+	CHECK_EQ(I2C_clockCompute(100000, 0, &params), TEST_FAIL);
+	CHECK_EQ(I2C_clockCompute(100000, 2 * I2C_BUS_RATE_1M, &params),
+	         TEST_FAIL);
+	/* Below the 6.7 MHz module clock minimum */
+	CHECK_EQ(I2C_clockCompute(6000, I2C_BUS_RATE_100K, &params), TEST_FAIL);
+}
+
+static void setPll(const PllSetting *pll)
+{
+	CSL_SysRegs *sys = CSL_SYSCTRL_REGS;
+
+	HOST_regSet(&sys->CGCR1, pll->cgcr1);
+	HOST_regSet(&sys->CGCR2, pll->cgcr2);
+	HOST_regSet(&sys->CGCR4, pll->cgcr4);
+}
+
+static void test_retimeAcrossPll(void)
+{
+	CSL_I2cRegsOvly i2cReg = CSL_I2C_0_REGS;
+	I2C_ClockParams params;
+	I2C_ClockParams expected;
+	Uint32          sysClkKhz;
+	Uint32          busRate;
+	Uint16          pll;
+	Uint16          mode;
+
+	for (pll = 0; pll < PLL_SETTINGS; pll++)
+	{
+		setPll(&pllSettings[pll]);
+		sysClkKhz = C55x_getSysClk();
+
+		for (mode = 0; mode < BUS_MODES; mode++)
+		{
+			if (I2C_clockCompute(sysClkKhz, busModes[mode].busHz,
+			                     &expected) != TEST_PASS)
+			{
+				CHECK_EQ(I2C_clockSetBusRate(busModes[mode].busHz),
+				         TEST_FAIL);
+				continue;
+			}
+
+			CHECK_EQ(I2C_clockSetBusRate(busModes[mode].busHz), TEST_PASS);
+			CHECK_EQ(I2C_clockGetBusRate(), busModes[mode].busHz);
+
+			I2C_clockGetParams(&params);
+			CHECK_EQ(params.icpsc, expected.icpsc);
+			CHECK_EQ(params.icclkl, expected.icclkl);
+			CHECK_EQ(params.icclkh, expected.icclkh);
+			CHECK_EQ(HOST_regGet(&i2cReg->ICPSC), expected.icpsc);
+			CHECK_EQ(HOST_regGet(&i2cReg->ICCLKL), expected.icclkl);
+			CHECK_EQ(HOST_regGet(&i2cReg->ICCLKH), expected.icclkh);
+
+			/* The model derives the rate from the registers */
+			busRate = HOST_i2cBusRate();
+			CHECK(busRate + busRate / 1000 >= params.busHz);
+			CHECK(busRate <= params.busHz + params.busHz / 1000);
+		}
+	}
+}
+
+static void test_failedRateKeepsOld(void)
+{
+	I2C_ClockParams before;
+	I2C_ClockParams after;
+
+	setPll(&pllSettings[0]);
+	CHECK_EQ(I2C_clockSetBusRate(I2C_BUS_RATE_400K), TEST_PASS);
+	I2C_clockGetParams(&before);
+
+	CHECK_EQ(I2C_clockSetBusRate(I2C_BUS_RATE_1M), TEST_FAIL);
+	CHECK_EQ(I2C_clockGetBusRate(), I2C_BUS_RATE_400K);
+	I2C_clockGetParams(&after);
+	CHECK_EQ(after.busHz, before.busHz);
+
+	/* A PLL change followed by a retime keeps the selected rate */
+	setPll(&pllSettings[4]);
+	CHECK_EQ(I2C_clockRetime(), TEST_PASS);
+	I2C_clockGetParams(&after);
+	CHECK_EQ(after.icpsc, 8);
+	CHECK(after.busHz <= I2C_BUS_RATE_400K);
+}
+
+int main(void)
+{
+	HOST_i2cReset();
+
+	TEST_RUN(test_sweepSysClk);
+	TEST_RUN(test_fastModePlusReach);
+	TEST_RUN(test_invalidInput);
+	TEST_RUN(test_retimeAcrossPll);
+	TEST_RUN(test_failedRateKeepsOld);
+
+	return (testFailures);
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_i2c_probe.c
+*
+*   \brief Host test of the I2C bus scan and device probe against a bus
+*          of simulated devices: the codec, a device that stretches the
+*          clock before it acknowledges and one that holds SCL low. The
+*          stretching device counts the bytes it is sent and read.
+*
+*/
+
+#include "test.h"
+#include "i2c_probe.h"
+#include "i2c_async.h"
+#include "i2c_clock.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+#define TICK_USEC       (100)
+
+/* Bus of the test; the codec comes from HOST_aic3206Attach() */
+#define SLOW_ADDR       (0x50)
+#define SLOW_ACK_USEC   (400)
+#define STUCK_ADDR      (0x68)
+#define ABSENT_ADDR     (0x51)
+#define LATE_ADDR       (0x52)
+#define LATE_ACK_USEC   (I2C_PROBE_TIMEOUT_USEC + 5000)
+
+/* Trapped register accesses are slow on the host, leave room */
+#define SCAN_USEC       (5000)
+
+static Uint16 devWrites;
+static Uint16 devReads;
+static Uint16 devLastByte;
+
+static Bool devWrite(HOST_I2cDevice *dev, Uint16 byte, Bool first)
+{
+	devWrites++;
+	devLastByte = byte;
+	return (TRUE);
+}
+
+static Uint16 devRead(HOST_I2cDevice *dev)
+{
+	devReads++;
+	return (0x5A);
+}
+
+static HOST_I2cDevice slowDev  = { SLOW_ADDR, SLOW_ACK_USEC, FALSE,
+                                   devWrite, devRead };
+static HOST_I2cDevice stuckDev = { STUCK_ADDR, 0, TRUE };
+static HOST_I2cDevice lateDev  = { LATE_ADDR, LATE_ACK_USEC, FALSE,
+                                   devWrite, devRead };
+
+static void busSetup(Bool withStuck)
+{
+	HOST_i2cReset();
+	HOST_aic3206Attach();
+	HOST_i2cAttach(&slowDev);
+	devWrites   = 0;
+	devReads    = 0;
+	devLastByte = 0;
+	if (withStuck)
+	{
+		HOST_i2cAttach(&stuckDev);
+	}
+	I2C_clockSetBusRate(I2C_BUS_RATE_100K);
+}
+
+static void test_scanFindsDevices(void)
+{
+	static I2C_ScanResult scan;
+	Uint16                addr;
+
+	busSetup(FALSE);
+
+	CHECK_EQ(i2cScan(I2C_SCAN_FIRST_ADDR, I2C_SCAN_LAST_ADDR,
+	                 SCAN_USEC, &scan), CSL_SOK);
+	CHECK_EQ(scan.found, 2);
+	CHECK_EQ(scan.timeouts, 0);
+
+	for (addr = 0; addr < I2C_SCAN_ADDR_COUNT; addr++)
+	{
+		CHECK_EQ(I2C_SCAN_IS_PRESENT(&scan, addr),
+		         (addr == AIC3206_I2C_ADDR) || (addr == SLOW_ADDR));
+	}
+
+	/* Each address was read once, nothing was written to it */
+	CHECK_EQ(devReads, 1);
+	CHECK_EQ(devWrites, 0);
+
+	/* Address and data byte at 100 kHz, the slow device adds its stretch */
+	CHECK(scan.responseTime[AIC3206_I2C_ADDR] >= 190);
+	CHECK(scan.responseTime[AIC3206_I2C_ADDR] < SCAN_USEC);
+	CHECK(scan.responseTime[SLOW_ADDR] >= 190 + SLOW_ACK_USEC);
+
+	/* A refusal comes after the address byte */
+	CHECK(scan.responseTime[ABSENT_ADDR] >= 90);
+	CHECK(scan.responseTime[ABSENT_ADDR] < SCAN_USEC);
+
+	CHECK(HOST_i2cIdle());
+}
+
+static void test_scanSurvivesStuckDevice(void)
+{
+	static I2C_ScanResult scan;
+
+	busSetup(TRUE);
+
+	CHECK_EQ(i2cScan(I2C_SCAN_FIRST_ADDR, I2C_SCAN_LAST_ADDR,
+	                 SCAN_USEC, &scan), CSL_SOK);
+	CHECK_EQ(scan.timeouts, 1);
+	CHECK_EQ(scan.responseTime[STUCK_ADDR], 0);
+	CHECK(!I2C_SCAN_IS_PRESENT(&scan, STUCK_ADDR));
+
+	/* The module reset freed the bus for the addresses after it */
+	CHECK_EQ(scan.found, 2);
+	CHECK(I2C_SCAN_IS_PRESENT(&scan, STUCK_ADDR + 1) == 0);
+	CHECK(scan.responseTime[STUCK_ADDR + 1] > 0);
+}
+
+static void test_scanRejects(void)
+{
+	static I2C_ScanResult scan;
+
+	busSetup(FALSE);
+
+	CHECK_EQ(i2cScan(0x20, 0x10, SCAN_USEC, &scan),
+	         CSL_ESYS_INVPARAMS);
+	CHECK_EQ(i2cScan(0x10, I2C_SCAN_ADDR_COUNT, SCAN_USEC,
+	                 &scan), CSL_ESYS_INVPARAMS);
+	CHECK_EQ(i2cScan(0x10, 0x20, 0, &scan), CSL_ESYS_INVPARAMS);
+
+	/* The async driver owns the registers once open */
+	CHECK_EQ(I2C_asyncOpen(), TEST_PASS);
+	CHECK_EQ(i2cScan(0x10, 0x20, SCAN_USEC, &scan),
+	         CSL_ESYS_BADHANDLE);
+	CHECK_EQ(I2C_asyncClose(I2C_ASYNC_CLOSE_USEC), TEST_PASS);
+}
+
+static void test_probePolled(void)
+{
+	Uint16 data[2] = { 0x00, 0x00 };
+
+	busSetup(FALSE);
+
+	CHECK_EQ(i2cProbe(AIC3206_I2C_ADDR, data, 2), CSL_SOK);
+	CHECK_EQ(i2cProbe(SLOW_ADDR, data, 1), CSL_SOK);
+	CHECK_EQ(i2cProbe(ABSENT_ADDR, data, 1), I2C_RET_NO_ACK_READ);
+	CHECK_EQ(i2cProbe(AIC3206_I2C_ADDR, data, 0), CSL_ESYS_INVPARAMS);
+}
+
+static void test_probeOnAsync(void)
+{
+	Uint16         data[2] = { 0x00, 0x00 };
+	Uint16         big[I2C_PROBE_MAX_BYTES + 1];
+	I2C_AsyncStats before;
+	I2C_AsyncStats after;
+	HOST_I2cStats  bus;
+
+	busSetup(TRUE);
+	memset(big, 0, sizeof(big));
+
+	CHECK_EQ(I2C_asyncOpen(), TEST_PASS);
+	I2C_asyncGetStats(&before);
+	HOST_i2cClearStats();
+
+	CHECK_EQ(i2cProbe(AIC3206_I2C_ADDR, data, 2), CSL_SOK);
+	CHECK_EQ(i2cProbe(SLOW_ADDR, data, 1), CSL_SOK);
+	CHECK_EQ(i2cProbe(ABSENT_ADDR, data, 1), I2C_RET_NO_ACK_READ);
+	CHECK_EQ(i2cProbe(AIC3206_I2C_ADDR, big, I2C_PROBE_MAX_BYTES + 1),
+	         CSL_ESYS_INVPARAMS);
+
+	/* The probes went through the driver and onto the simulated bus */
+	I2C_asyncGetStats(&after);
+	CHECK_EQ(after.submitted - before.submitted, 3);
+	CHECK_EQ(after.nacks - before.nacks, 1);
+	HOST_i2cGetStats(&bus);
+	CHECK_EQ(bus.transactions, 3);
+
+	/* A device holding SCL times the probe out; closing frees the bus */
+	CHECK_EQ(i2cProbe(STUCK_ADDR, data, 1), I2C_RET_IDLE_TIMEOUT);
+	CHECK_EQ(I2C_asyncClose(I2C_ASYNC_CLOSE_USEC), TEST_FAIL);
+
+	I2C_asyncGetStats(&after);
+	CHECK_EQ(after.aborted - before.aborted, 1);
+	CHECK(!I2C_asyncIsOpen());
+}
+
+static void test_probeLateCompletion(void)
+{
+	Uint16 first[1]  = { 0x11 };
+	Uint16 second[1] = { 0x22 };
+
+	busSetup(FALSE);
+	HOST_i2cAttach(&lateDev);
+
+	CHECK_EQ(I2C_asyncOpen(), TEST_PASS);
+
+	/* The late device acknowledges after the probe gave up */
+	CHECK_EQ(i2cProbe(LATE_ADDR, first, 1), I2C_RET_IDLE_TIMEOUT);
+
+	/* The next probe waits for the buffer and takes only its own answer,
+	 * not the late acknowledge */
+	CHECK_EQ(i2cProbe(ABSENT_ADDR, second, 1), I2C_RET_NO_ACK_READ);
+	CHECK_EQ(devWrites, 1);
+	CHECK_EQ(devLastByte, 0x11);
+
+	CHECK_EQ(i2cProbe(SLOW_ADDR, second, 1), CSL_SOK);
+	CHECK_EQ(devLastByte, 0x22);
+
+	CHECK_EQ(I2C_asyncClose(I2C_ASYNC_CLOSE_USEC), TEST_PASS);
+}
+
+int main(void)
+{
+	C55x_timebaseInit();
+
+	TEST_RUN(test_scanFindsDevices);
+	TEST_RUN(test_scanSurvivesStuckDevice);
+	TEST_RUN(test_scanRejects);
+	TEST_RUN(test_probePolled);
+
+	HOST_irqTicker(TICK_USEC);
+	TEST_RUN(test_probeOnAsync);
+	TEST_RUN(test_probeLateCompletion);
+	HOST_irqTicker(0);
+
+	return (testFailures);
+}
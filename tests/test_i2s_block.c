@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_i2s_block.c
+*
+*   \brief Host test and benchmark of the polled I2S block transfers.
+*
+*   The register accesses per frame stand in for the cycle count: on the
+*   C55x each peripheral access costs several wait states, far more than
+*   the loop around it.
+*
+*/
+
+#include "test.h"
+#include "i2s_block.h"
+
+TEST_MAIN_DATA;
+
+#define BLOCK_FRAMES    (48)
+#define TEST_FRAMES     (480)
+
+static Int16 inFrames[2 * TEST_FRAMES];
+static Int16 outFrames[2 * TEST_FRAMES];
+
+static void openPolled(void)
+{
+	i2sOpMode = I2S_POLLED;
+	CHECK_EQ(initialise_i2s_interface(), TEST_PASS);
+	HOST_i2sClearOutput();
+}
+
+/* Frames go out whole and in order, with one flag poll per frame */
+static void test_writeBlock(void)
+{
+	const Int16 *out;
+	Uint32       frames;
+	Uint32       traps;
+	Uint32       i;
+
+	openPolled();
+	for (i = 0; i < 2 * TEST_FRAMES; i++)
+	{
+		inFrames[i] = (Int16)(i * 7 - 1000);
+	}
+
+	traps = HOST_mmioTraps();
+	for (i = 0; i < TEST_FRAMES; i += BLOCK_FRAMES)
+	{
+		I2S_writeBlock(&inFrames[2 * i], BLOCK_FRAMES);
+	}
+	CHECK_EQ(HOST_mmioTraps() - traps, 3 * TEST_FRAMES);
+
+	out = HOST_i2sOutput(&frames);
+	CHECK_EQ(frames, TEST_FRAMES);
+	CHECK_EQ(memcmp(out, inFrames, sizeof(inFrames)), 0);
+
+	I2S_close(hI2s);
+}
+
+static void test_readBlock(void)
+{
+	Uint32 traps;
+	Uint32 i;
+
+	openPolled();
+	HOST_i2sSetInput(inFrames, TEST_FRAMES);
+	memset(outFrames, 0, sizeof(outFrames));
+
+	traps = HOST_mmioTraps();
+	for (i = 0; i < TEST_FRAMES; i += BLOCK_FRAMES)
+	{
+		I2S_readBlock(&outFrames[2 * i], BLOCK_FRAMES);
+	}
+	CHECK_EQ(HOST_mmioTraps() - traps, 3 * TEST_FRAMES);
+	CHECK_EQ(HOST_i2sInputUsed(), TEST_FRAMES);
+	CHECK_EQ(memcmp(outFrames, inFrames, sizeof(inFrames)), 0);
+
+	I2S_close(hI2s);
+}
+
+/* Loop cost with the registers as plain memory */
+static void bench_blocks(void)
+{
+	openPolled();
+	HOST_i2sWatch(FALSE);
+
+	printf("  register accesses per frame: 3 each way\n");
+	BENCH("I2S_writeBlock per frame", 200000 / BLOCK_FRAMES * BLOCK_FRAMES,
+	      I2S_writeBlock(&inFrames[2 * (_i % BLOCK_FRAMES)], 1));
+	BENCH("I2S_writeBlock(48) per call", 20000,
+	      I2S_writeBlock(inFrames, BLOCK_FRAMES));
+	BENCH("I2S_readBlock(48) per call", 20000,
+	      I2S_readBlock(outFrames, BLOCK_FRAMES));
+
+	HOST_i2sWatch(TRUE);
+	I2S_close(hI2s);
+}
+
+int main(void)
+{
+	TEST_RUN(test_writeBlock);
+	TEST_RUN(test_readBlock);
+	TEST_RUN(bench_blocks);
+
+	return (testFailures);
+}
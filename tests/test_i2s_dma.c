@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_i2s_dma.c
+*
+*   \brief Host test of the ping-pong DMA transmit engine against the DMA
+*          and I2S models.
+*
+*/
+
+#include "test.h"
+#include "i2s_dma.h"
+
+TEST_MAIN_DATA;
+
+/* DMAIFR flag of a channel another driver owns */
+#define OTHER_CHAN_FLAG     (1 << CSL_DMA_CHAN0)
+
+static Int16 rampNext;
+
+/* Left counts up, right is the negated count */
+static void rampFill(Int16 *left, Int16 *right, Uint16 frames, void *arg)
+{
+	Uint16 i;
+
+	for (i = 0; i < frames; i++)
+	{
+		left[i]  = rampNext;
+		right[i] = -rampNext;
+		rampNext++;
+	}
+}
+
+static void startRamp(void)
+{
+	rampNext = 0;
+	HOST_i2sClearOutput();
+	CHECK_EQ(I2S_dmaOpen(rampFill, NULL), TEST_PASS);
+	CHECK_EQ(I2S_dmaStart(), TEST_PASS);
+}
+
+/* Plays 'frames' frames, refilling the way the main loop does */
+static void play(Uint32 frames)
+{
+	while (frames--)
+	{
+		HOST_i2sTick(1);
+		I2S_dmaService();
+	}
+}
+
+/* The stream must be the ramp without a gap or a repeat */
+static void test_continuousOutput(void)
+{
+	const Int16  *out;
+	I2S_DmaStats  stats;
+	Uint32        frames;
+	Uint32        i;
+	Uint32        errors = 0;
+
+	startRamp();
+	play(20 * I2S_DMA_BLOCK_FRAMES);
+
+	out = HOST_i2sOutput(&frames);
+	CHECK_EQ(frames, 20 * I2S_DMA_BLOCK_FRAMES);
+	for (i = 0; i < frames; i++)
+	{
+		errors += (out[2 * i] != (Int16)i) || (out[2 * i + 1] != -(Int16)i);
+	}
+	CHECK_EQ(errors, 0);
+
+	I2S_dmaGetStats(&stats);
+	CHECK_EQ(stats.blocksPlayed, 20);
+	CHECK_EQ(stats.underruns, 0);
+
+	I2S_dmaStop();
+	CHECK_EQ(HOST_dmaOpenCount(), 0);
+	CHECK(!HOST_i2sTxEnabled());
+}
+
+/* A refill that does not come in time replays the old half */
+static void test_underrunCounted(void)
+{
+	I2S_DmaStats stats;
+
+	startRamp();
+	HOST_i2sTick(3 * I2S_DMA_BLOCK_FRAMES);
+
+	I2S_dmaGetStats(&stats);
+	CHECK_EQ(stats.blocksPlayed, 3);
+	CHECK_EQ(stats.underruns, 1);
+
+	I2S_dmaStop();
+}
+
+/* DMAIFR is write 1 to clear and shared with the other DMA users: the
+ * engine must only clear its own channels, at start and in the ISR */
+static void test_foreignFlagsKept(void)
+{
+	CSL_SysRegs *sys = CSL_SYSCTRL_REGS;
+
+	rampNext = 0;
+	CHECK_EQ(I2S_dmaOpen(rampFill, NULL), TEST_PASS);
+
+	HOST_regSet(&sys->DMAIFR, OTHER_CHAN_FLAG);
+	CHECK_EQ(I2S_dmaStart(), TEST_PASS);
+	CHECK_EQ(HOST_regGet(&sys->DMAIFR) & OTHER_CHAN_FLAG, OTHER_CHAN_FLAG);
+
+	play(I2S_DMA_BLOCK_FRAMES);
+	CHECK(HOST_irqCount(DMA_EVENT) != 0);
+	CHECK_EQ(HOST_regGet(&sys->DMAIFR), OTHER_CHAN_FLAG);
+
+	I2S_dmaStop();
+	HOST_regSet(&sys->DMAIFR, 0);
+}
+
+/* A failed open leaves nothing open: a later open must succeed */
+static void test_openFailureReleases(void)
+{
+	HOST_dmaFailOpen(I2S_DMA_TX_RIGHT_CHAN);
+	CHECK_EQ(I2S_dmaOpen(rampFill, NULL), TEST_FAIL);
+	CHECK_EQ(HOST_dmaOpenCount(), 0);
+	CHECK(!HOST_dmaChannelOpen(I2S_DMA_TX_LEFT_CHAN));
+	CHECK_EQ(i2sOpMode, I2S_POLLED);
+
+	HOST_dmaFailOpen(I2S_DMA_TX_LEFT_CHAN);
+	CHECK_EQ(I2S_dmaOpen(rampFill, NULL), TEST_FAIL);
+	CHECK_EQ(HOST_dmaOpenCount(), 0);
+
+	startRamp();
+	play(2 * I2S_DMA_BLOCK_FRAMES);
+	I2S_dmaStop();
+	CHECK_EQ(HOST_dmaOpenCount(), 0);
+}
+
+int main(void)
+{
+	IRQ_globalEnable();
+
+	TEST_RUN(test_continuousOutput);
+	TEST_RUN(test_underrunCounted);
+	TEST_RUN(test_foreignFlagsKept);
+	TEST_RUN(test_openFailureReleases);
+
+	return (testFailures);
+}
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_i2s_ring.c
+*
+*   \brief Host test of the I2S sample rings: wrap-around, the ISR
+*          running on a thread of their own against the main loop, and
+*          both directions served from the one flag register.
+*
+*/
+
+#include "test.h"
+#include "i2s_ring.h"
+#include <pthread.h>
+#include <sched.h>
+
+TEST_MAIN_DATA;
+
+#define STREAM_FRAMES       (200000)
+
+/* Either side gives up the CPU when it has nothing to do, so the test
+ * also runs on a single core; preemption still lands anywhere */
+static volatile Bool   isrStop;
+static volatile Bool   rxDone;
+static Uint32          txSeen;
+static Uint32          txErrors;
+static Uint32          txSilence;
+
+/* Frame n is (n, ~n), n from 1; (0, 0) is the underrun silence */
+static void makeFrame(Int16 *frame, Uint32 n)
+{
+	frame[0] = (Int16)n;
+	frame[1] = (Int16)~n;
+}
+
+static void test_ringWrap(void)
+{
+	I2S_Ring ring;
+	Int16    buf[8];
+	Int16    in[6];
+	Int16    out[6];
+	Uint16   pass;
+	Uint16   i;
+
+	I2S_ringInit(&ring, buf, 8);
+	CHECK_EQ(I2S_ringSpace(&ring), 8);
+
+	/* 16-bit indices wrap many times over */
+	for (pass = 0; pass < 20000; pass++)
+	{
+		for (i = 0; i < 6; i++)
+		{
+			in[i] = (Int16)(pass * 6 + i);
+		}
+		CHECK_EQ(I2S_ringPut(&ring, in, 6), 6);
+		CHECK_EQ(I2S_ringPut(&ring, in, 6), 2);
+		CHECK_EQ(I2S_ringGet(&ring, out, 6), 6);
+		CHECK_EQ(memcmp(in, out, sizeof(out)), 0);
+		CHECK_EQ(I2S_ringGet(&ring, out, 6), 2);
+		if (testFailures != 0)
+		{
+			break;
+		}
+	}
+	CHECK_EQ(I2S_ringCount(&ring), 0);
+}
+
+/* Stands in for the frame clock: runs the TX ISR as fast as it can and
+ * checks what it sends */
+static void *txIsrThread(void *arg)
+{
+	CSL_I2sRegs *regs = hI2s->hwRegs;
+	Uint32       expect = 1;
+	Int16        frame[2];
+
+	while (!isrStop)
+	{
+		i2sRingIsr();
+
+		frame[0] = (Int16)regs->I2STXLT1;
+		frame[1] = (Int16)regs->I2STXRT1;
+		if ((frame[0] == 0) && (frame[1] == 0))
+		{
+			txSilence++;
+			sched_yield();
+			continue;
+		}
+
+		makeFrame(frame, expect);
+		if ((frame[0] != (Int16)regs->I2STXLT1) ||
+		    (frame[1] != (Int16)regs->I2STXRT1))
+		{
+			txErrors++;
+		}
+		expect++;
+		txSeen++;
+	}
+
+	return (NULL);
+}
+
+static void test_txAgainstIsrThread(void)
+{
+	pthread_t     thread;
+	I2S_RingStats stats;
+	Int16         block[2 * 48];
+	Uint32        next = 1;
+	Uint16        i;
+	Uint16        frames;
+	Uint16        done;
+
+	CHECK_EQ(I2S_ringOpen(I2S_RING_TX, 0), TEST_PASS);
+
+	isrStop = FALSE;
+	pthread_create(&thread, NULL, txIsrThread, NULL);
+
+	while (next <= STREAM_FRAMES)
+	{
+		frames = (Uint16)(1 + (next % 48));
+		for (i = 0; i < frames; i++)
+		{
+			makeFrame(&block[2 * i], next + i);
+		}
+
+		done = 0;
+		while (done < frames)
+		{
+			done += I2S_ringWriteFrames(&block[2 * done], frames - done);
+			if (done < frames)
+			{
+				sched_yield();
+			}
+		}
+		next += frames;
+	}
+
+	while (I2S_ringTxSpaceFrames() < I2S_RING_TX_SIZE / 2)
+	{
+		sched_yield();
+	}
+	isrStop = TRUE;
+	pthread_join(thread, NULL);
+
+	I2S_ringGetStats(&stats);
+	CHECK_EQ(txErrors, 0);
+	CHECK_EQ(txSeen, next - 1);
+	CHECK_EQ(stats.txFrames, next - 1);
+	CHECK_EQ(stats.underruns, txSilence);
+
+	I2S_ringClose();
+}
+
+static void *rxIsrThread(void *arg)
+{
+	CSL_I2sRegs *regs = hI2s->hwRegs;
+	Uint32       n;
+	Int16        frame[2];
+
+	for (n = 1; n <= STREAM_FRAMES; n++)
+	{
+		makeFrame(frame, n);
+		regs->I2SRXLT1 = frame[0];
+		regs->I2SRXRT1 = frame[1];
+		i2sRingIsr();
+
+		if ((n % 64) == 0)
+		{
+			sched_yield();
+		}
+	}
+
+	rxDone = TRUE;
+
+	return (NULL);
+}
+
+/* Frames may only go missing where the ISR counted an overrun */
+static void test_rxAgainstIsrThread(void)
+{
+	pthread_t     thread;
+	I2S_RingStats stats;
+	Int16         block[2 * 32];
+	Int16         expect[2];
+	Uint32        next = 1;
+	Uint32        received = 0;
+	Uint32        gaps = 0;
+	Uint32        errors = 0;
+	Uint16        frames;
+	Uint16        i;
+	Int16         step;
+
+	CHECK_EQ(I2S_ringOpen(I2S_RING_RX, 0), TEST_PASS);
+	rxDone = FALSE;
+	pthread_create(&thread, NULL, rxIsrThread, NULL);
+
+	do
+	{
+		frames = I2S_ringReadFrames(block, 32);
+		for (i = 0; i < frames; i++)
+		{
+			/* Skip ahead over dropped frames, the pair must match */
+			step = (Int16)(block[2 * i] - (Int16)next);
+			if (step < 0)
+			{
+				errors++;
+			}
+			else if (step > 0)
+			{
+				gaps  += (Uint16)step;
+				next  += (Uint16)step;
+			}
+			makeFrame(expect, next);
+			errors += (block[2 * i + 1] != expect[1]);
+			next++;
+			received++;
+		}
+
+		if (frames == 0)
+		{
+			sched_yield();
+		}
+	} while (!rxDone || (I2S_ringRxCountFrames() != 0));
+
+	pthread_join(thread, NULL);
+
+	I2S_ringGetStats(&stats);
+	CHECK_EQ(errors, 0);
+	CHECK_EQ(stats.rxFrames, received);
+	CHECK_EQ(stats.overruns, STREAM_FRAMES - received);
+
+	I2S_ringClose();
+}
+
+/* The two events share I2SINTFL, which clears on read */
+static void test_fullDuplexOnFrameClock(void)
+{
+	static Int16  in[2 * 64];
+	Int16         block[2 * 64];
+	I2S_RingStats stats;
+	Uint32        n;
+
+	for (n = 0; n < 64; n++)
+	{
+		makeFrame(&in[2 * n], n + 1);
+	}
+
+	HOST_i2sWatch(TRUE);
+	HOST_i2sSetInput(in, 64);
+	CHECK_EQ(I2S_ringOpen(I2S_RING_TX | I2S_RING_RX, 0), TEST_PASS);
+
+	HOST_i2sTick(64);
+
+	I2S_ringGetStats(&stats);
+	CHECK_EQ(stats.rxFrames, 64);
+	CHECK_EQ(stats.underruns, 64);
+	CHECK_EQ(I2S_ringReadFrames(block, 64), 64);
+	CHECK_EQ(memcmp(block, in, sizeof(in)), 0);
+
+	I2S_ringClose();
+	HOST_i2sWatch(FALSE);
+}
+
+static void test_openFailureReleases(void)
+{
+	CSL_I2sHandle other;
+
+	/* The interface is taken, so the ring cannot set it up */
+	other = I2S_open(I2S_INSTANCE2, I2S_POLLED, I2S_CHAN_STEREO);
+	CHECK(other != NULL);
+
+	CHECK_EQ(I2S_ringOpen(I2S_RING_TX, 0), TEST_FAIL);
+	CHECK(hI2s == NULL);
+	CHECK_EQ(i2sOpMode, I2S_POLLED);
+
+	I2S_close(other);
+	CHECK_EQ(I2S_ringOpen(I2S_RING_TX, 0), TEST_PASS);
+	I2S_ringClose();
+}
+
+int main(void)
+{
+	/* Plain registers, the ISRs run on another thread */
+	HOST_i2sWatch(FALSE);
+
+	TEST_RUN(test_ringWrap);
+	TEST_RUN(test_txAgainstIsrThread);
+	TEST_RUN(test_rxAgainstIsrThread);
+	TEST_RUN(test_fullDuplexOnFrameClock);
+	TEST_RUN(test_openFailureReleases);
+
+	return (testFailures);
+}
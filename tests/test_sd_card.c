@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_sd_card.c
+*
+*   \brief Host test of the microSD block device: card set up, sector
+*          addressing of standard and high capacity cards, and a WAV file
+*          streamed from the card through the WAV player.
+*
+*/
+
+#include "test.h"
+#include "sd_card.h"
+#include "wav_stream.h"
+
+TEST_MAIN_DATA;
+
+#define CARD_SECTORS    (256)
+#define WAV_SECTOR      (16)
+#define WAV_FRAMES      (20000)
+#define WAV_RATE        (22050)
+#define FILL_FRAMES     (48)
+
+static Uint8  card[CARD_SECTORS * SDCARD_SECTOR_BYTES];
+static Uint32 cardPos;
+
+static const WAV_BlockDevice sdDev = { SDCARD_read, NULL };
+
+static void put16(Uint16 v)
+{
+	card[cardPos++] = (Uint8)v;
+	card[cardPos++] = (Uint8)(v >> 8);
+}
+
+static void put32(Uint32 v)
+{
+	put16((Uint16)v);
+	put16((Uint16)(v >> 16));
+}
+
+static void putTag(const char *tag)
+{
+	memcpy(&card[cardPos], tag, 4);
+	cardPos += 4;
+}
+
+static Int16 sampleOf(Uint32 n, Uint16 c)
+{
+	return ((Int16)(c ? (-(Int32)n - 1) : (Int32)n * 3));
+}
+
+/* Stereo 16-bit WAV at WAV_SECTOR, the rest of the card a fill pattern */
+static void buildCard(void)
+{
+	Uint32 n;
+
+	memset(card, 0xA5, sizeof(card));
+	cardPos = WAV_SECTOR * SDCARD_SECTOR_BYTES;
+
+	putTag("RIFF");
+	put32(36 + WAV_FRAMES * 4);
+	putTag("WAVE");
+	putTag("fmt ");
+	put32(16);
+	put16(1);
+	put16(2);
+	put32(WAV_RATE);
+	put32(WAV_RATE * 4);
+	put16(4);
+	put16(16);
+	putTag("data");
+	put32(WAV_FRAMES * 4);
+	for (n = 0; n < WAV_FRAMES; n++)
+	{
+		put16((Uint16)sampleOf(n, 0));
+		put16((Uint16)sampleOf(n, 1));
+	}
+}
+
+static void test_noCard(void)
+{
+	Uint16 buf[SDCARD_SECTOR_BYTES / 2];
+
+	HOST_mmcsdInsert(NULL, 0, FALSE);
+	CHECK_EQ(SDCARD_open(), TEST_FAIL);
+	CHECK(SDCARD_read(NULL, 0, 1, buf) != 0);
+}
+
+/* Both card kinds read the same sectors, whatever unit they address in */
+static void checkSectors(Bool highCapacity)
+{
+	static Uint16 buf[SDCARD_MAX_SECTORS * 3 * SDCARD_SECTOR_BYTES / 2];
+	SDCARD_Info   info;
+	Uint32        errors = 0;
+	Uint32        i;
+
+	HOST_mmcsdInsert(card, sizeof(card), highCapacity);
+	CHECK_EQ(SDCARD_open(), TEST_PASS);
+
+	SDCARD_getInfo(&info);
+	CHECK_EQ(info.highCapacity, highCapacity);
+	CHECK_EQ(info.sectors, CARD_SECTORS);
+
+	/* 100 MHz system clock: 25 MHz at most, two above 400 kHz */
+	CHECK_EQ(HOST_mmcsdClockDiv(), 2);
+
+	/* Longer than one MMC_read(), starting past the first sector */
+	CHECK_EQ(SDCARD_read(NULL, WAV_SECTOR, 2 * SDCARD_MAX_SECTORS + 3, buf),
+	         0);
+	CHECK_EQ(HOST_mmcsdReads(), 3);
+	for (i = 0; i < (2 * SDCARD_MAX_SECTORS + 3) * SDCARD_SECTOR_BYTES / 2;
+	     i++)
+	{
+		errors += (buf[i] !=
+		           (card[WAV_SECTOR * SDCARD_SECTOR_BYTES + 2 * i] |
+		            (card[WAV_SECTOR * SDCARD_SECTOR_BYTES + 2 * i + 1] << 8)));
+	}
+	CHECK_EQ(errors, 0);
+
+	/* Past the end of the card */
+	CHECK(SDCARD_read(NULL, CARD_SECTORS - 1, 2, buf) != 0);
+	SDCARD_getInfo(&info);
+	CHECK_EQ(info.readErrors, 1);
+
+	SDCARD_close();
+	CHECK(SDCARD_read(NULL, 0, 1, buf) != 0);
+}
+
+static void test_standardCapacity(void)
+{
+	checkSectors(FALSE);
+}
+
+static void test_highCapacity(void)
+{
+	checkSectors(TRUE);
+}
+
+/* The whole file through WAV_open(), WAV_service() and WAV_fill(), the
+ * way the playback loop runs it */
+static void test_wavFromCard(void)
+{
+	Int16     left[FILL_FRAMES];
+	Int16     right[FILL_FRAMES];
+	WAV_Info  info;
+	WAV_Stats stats;
+	Uint32    played = 0;
+	Uint32    errors = 0;
+	Uint16    i;
+
+	HOST_mmcsdInsert(card, sizeof(card), TRUE);
+	CHECK_EQ(SDCARD_open(), TEST_PASS);
+	CHECK_EQ(WAV_open(&sdDev, WAV_SECTOR, 3, &info), TEST_PASS);
+	CHECK_EQ(info.sampleRate, WAV_RATE);
+	CHECK_EQ(info.channels, 2);
+	CHECK_EQ(info.dataFrames, WAV_FRAMES);
+
+	while (!WAV_done())
+	{
+		WAV_service();
+		WAV_fill(left, right, FILL_FRAMES, NULL);
+		for (i = 0; (i < FILL_FRAMES) && (played < WAV_FRAMES); i++)
+		{
+			errors += (left[i] != sampleOf(played, 0));
+			errors += (right[i] != sampleOf(played, 1));
+			played++;
+		}
+	}
+	CHECK_EQ(errors, 0);
+	CHECK_EQ(played, WAV_FRAMES);
+
+	WAV_getStats(&stats);
+	CHECK_EQ(stats.underruns, 0);
+	CHECK_EQ(stats.readErrors, 0);
+
+	SDCARD_close();
+}
+
+/* A failing card shows up in the WAV read errors, not as bad samples */
+static void test_readErrorReported(void)
+{
+	Int16     left[FILL_FRAMES];
+	Int16     right[FILL_FRAMES];
+	WAV_Stats stats;
+	Uint16    i;
+
+	HOST_mmcsdInsert(card, sizeof(card), FALSE);
+	CHECK_EQ(SDCARD_open(), TEST_PASS);
+	CHECK_EQ(WAV_open(&sdDev, WAV_SECTOR, 2, NULL), TEST_PASS);
+
+	/* Play out the first buffer so that the service reads again */
+	for (i = 0; i < WAV_BUF_WORDS / 2 / FILL_FRAMES + 1; i++)
+	{
+		WAV_fill(left, right, FILL_FRAMES, NULL);
+	}
+
+	HOST_mmcsdFailReads(1);
+	CHECK_EQ(WAV_service(), 0);
+	WAV_getStats(&stats);
+	CHECK_EQ(stats.readErrors, 1);
+
+	SDCARD_close();
+}
+
+int main(void)
+{
+	buildCard();
+
+	TEST_RUN(test_noCard);
+	TEST_RUN(test_standardCapacity);
+	TEST_RUN(test_highCapacity);
+	TEST_RUN(test_wavFromCard);
+	TEST_RUN(test_readErrorReported);
+
+	return (testFailures);
+}
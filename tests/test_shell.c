@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_shell.c
+*
+*   \brief Host test of the shell: number parsing, the parameter and
+*          command registry, command lines and the line editor.
+*
+*/
+
+#include "test.h"
+#include "shell.h"
+
+TEST_MAIN_DATA;
+
+static char   output[4096];
+static Int32  gainValue;
+static Int32  rateValue = 48000;
+static Uint16 cmdCalls;
+static Uint16 cmdArgc;
+static char   cmdArg[SHELL_LINE_MAX + 1];
+
+static Int32 gainGet(void)
+{
+	return (gainValue);
+}
+
+static TEST_STATUS gainSet(Int32 value)
+{
+	gainValue = value;
+
+	return (TEST_PASS);
+}
+
+static Int32 rateGet(void)
+{
+	return (rateValue);
+}
+
+static TEST_STATUS failSet(Int32 value)
+{
+	return (TEST_FAIL);
+}
+
+static TEST_STATUS echoCmd(Uint16 argc, char *argv[])
+{
+	cmdCalls++;
+	cmdArgc = argc;
+	strcpy(cmdArg, (argc > 1) ? argv[argc - 1] : "");
+
+	return (TEST_PASS);
+}
+
+static const SHELL_Param gainParam =
+	{ "gain", "output gain, dB", -60, 12, gainGet, gainSet };
+static const SHELL_Param rateParam =
+	{ "rate", "sample rate", 8000, 96000, rateGet, NULL };
+static const SHELL_Param lockParam =
+	{ "lock", "refuses every value", 0, 1, gainGet, failSet };
+static const SHELL_Command echoCommand =
+	{ "echo", "runs the test hook", echoCmd };
+
+/* Runs a line, returns what it printed */
+static const char *run(const char *line, TEST_STATUS expect)
+{
+	char   buf[SHELL_LINE_MAX * 2];
+	Uint32 n;
+
+	strcpy(buf, line);
+	HOST_msgClear();
+	CHECK_EQ(SHELL_execute(buf), expect);
+	n = HOST_msgTake(output, sizeof(output) - 1);
+	output[n] = '\0';
+
+	return (output);
+}
+
+static void shellSetup(void)
+{
+	SHELL_init();
+	gainValue = 0;
+	cmdCalls  = 0;
+	CHECK_EQ(SHELL_registerParam(&gainParam), TEST_PASS);
+	CHECK_EQ(SHELL_registerParam(&rateParam), TEST_PASS);
+	CHECK_EQ(SHELL_registerParam(&lockParam), TEST_PASS);
+	CHECK_EQ(SHELL_registerCommand(&echoCommand), TEST_PASS);
+}
+
+static void test_parseInt(void)
+{
+	static const struct
+	{
+		const char *text;
+		Bool        ok;
+		Int32       value;
+	} cases[] =
+	{
+		{ "0",           TRUE,  0 },
+		{ "42",          TRUE,  42 },
+		{ "-42",         TRUE,  -42 },
+		{ "+7",          TRUE,  7 },
+		/* A leading zero is decimal, not octal */
+		{ "010",         TRUE,  10 },
+		{ "08",          TRUE,  8 },
+		{ "-0099",       TRUE,  -99 },
+		{ "0x10",        TRUE,  16 },
+		{ "0X1f",        TRUE,  31 },
+		{ "-0x10",       TRUE,  -16 },
+		{ "0x0",         TRUE,  0 },
+		{ "2147483647",  TRUE,  2147483647L },
+		{ "-2147483648", TRUE,  (Int32)0x80000000UL },
+		{ "0x7FFFFFFF",  TRUE,  2147483647L },
+		{ "0xFFFFFFFF",  TRUE,  -1 },
+		{ "2147483648",  FALSE, 0 },
+		{ "-2147483649", FALSE, 0 },
+		{ "0x100000000", FALSE, 0 },
+		{ "",            FALSE, 0 },
+		{ "-",           FALSE, 0 },
+		{ "0x",          FALSE, 0 },
+		{ "0x-5",        FALSE, 0 },
+		{ "0x 5",        FALSE, 0 },
+		{ "+-5",         FALSE, 0 },
+		{ " 5",          FALSE, 0 },
+		{ "5 ",          FALSE, 0 },
+		{ "12a",         FALSE, 0 },
+		{ "0x1g",        FALSE, 0 },
+		{ "1e3",         FALSE, 0 }
+	};
+	Int32  value;
+	Uint16 i;
+
+	CHECK(!SHELL_parseInt(NULL, &value));
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		value = 12345;
+		if (SHELL_parseInt(cases[i].text, &value) != cases[i].ok)
+		{
+			printf("  \"%s\" %s\n", cases[i].text,
+			       cases[i].ok ? "rejected" : "accepted");
+			testFailures++;
+		}
+		else if (cases[i].ok && (value != cases[i].value))
+		{
+			printf("  \"%s\" is %d\n", cases[i].text, (int)value);
+			testFailures++;
+		}
+		else if (!cases[i].ok)
+		{
+			/* Left alone on failure */
+			CHECK_EQ(value, 12345);
+		}
+	}
+}
+
+static void test_registry(void)
+{
+	static SHELL_Param   params[SHELL_MAX_PARAMS];
+	static char          names[SHELL_MAX_PARAMS][8];
+	static SHELL_Command noFxn = { "nofxn", "", NULL };
+	static const SHELL_Param noGet = { "noget", "", 0, 1, NULL, gainSet };
+	Uint16 i;
+
+	shellSetup();
+
+	/* Names are unique, a getter is required */
+	CHECK_EQ(SHELL_registerParam(&gainParam), TEST_FAIL);
+	CHECK_EQ(SHELL_registerParam(&noGet), TEST_FAIL);
+	CHECK_EQ(SHELL_registerCommand(&noFxn), TEST_FAIL);
+
+	/* Fills up */
+	for (i = 0; i < SHELL_MAX_PARAMS; i++)
+	{
+		sprintf(names[i], "p%d", i);
+		params[i]      = gainParam;
+		params[i].name = names[i];
+	}
+	for (i = 0; i < SHELL_MAX_PARAMS - 3; i++)
+	{
+		CHECK_EQ(SHELL_registerParam(&params[i]), TEST_PASS);
+	}
+	CHECK_EQ(SHELL_registerParam(&params[i]), TEST_FAIL);
+
+	for (i = 1; i < SHELL_MAX_COMMANDS; i++)
+	{
+		CHECK_EQ(SHELL_registerCommand(&echoCommand), TEST_PASS);
+	}
+	CHECK_EQ(SHELL_registerCommand(&echoCommand), TEST_FAIL);
+
+	/* Help lists all of them */
+	run("help", TEST_PASS);
+	CHECK(strstr(output, "gain     output gain, dB [-60..12]") != NULL);
+	CHECK(strstr(output, "rate     sample rate [8000..96000] ro") != NULL);
+	CHECK(strstr(output, "echo     runs the test hook") != NULL);
+	CHECK(strstr(output, "p8 ") != NULL);
+
+	/* SHELL_init() empties it */
+	SHELL_init();
+	run("get gain", TEST_FAIL);
+	CHECK(strstr(output, "Unknown parameter") != NULL);
+}
+
+static void test_getSet(void)
+{
+	shellSetup();
+
+	run("get gain", TEST_PASS);
+	CHECK(strcmp(output, "gain = 0\n\r") == 0);
+
+	run("set gain -12", TEST_PASS);
+	CHECK(strcmp(output, "gain = -12\n\r") == 0);
+	CHECK_EQ(gainValue, -12);
+
+	/* Leading zeros and hex */
+	run("set gain 010", TEST_PASS);
+	CHECK_EQ(gainValue, 10);
+	run("set gain 0xA", TEST_PASS);
+	CHECK_EQ(gainValue, 10);
+	run("set gain -0x3c", TEST_PASS);
+	CHECK_EQ(gainValue, -60);
+
+	/* Range, syntax and read-only */
+	run("set gain 13", TEST_FAIL);
+	CHECK(strcmp(output, "gain range -60..12\n\r") == 0);
+	run("set gain -61", TEST_FAIL);
+	run("set gain 1.5", TEST_FAIL);
+	CHECK(strstr(output, "Usage") != NULL);
+	run("set gain", TEST_FAIL);
+	CHECK_EQ(gainValue, -60);
+
+	run("set rate 44100", TEST_FAIL);
+	CHECK(strcmp(output, "rate is read-only\n\r") == 0);
+	CHECK_EQ(rateValue, 48000);
+
+	run("set lock 1", TEST_FAIL);
+	CHECK(strcmp(output, "lock: set failed\n\r") == 0);
+
+	run("get", TEST_FAIL);
+	run("get volume", TEST_FAIL);
+	CHECK(strstr(output, "Unknown parameter") != NULL);
+
+	run("list", TEST_PASS);
+	CHECK(strcmp(output, "gain     -60\n\rrate     48000\n\r"
+	                     "lock     -60\n\r") == 0);
+}
+
+static void test_commands(void)
+{
+	shellSetup();
+
+	/* Blanks and tabs split, empty lines do nothing */
+	run("  echo \t one  two ", TEST_PASS);
+	CHECK_EQ(cmdCalls, 1);
+	CHECK_EQ(cmdArgc, 3);
+	CHECK(strcmp(cmdArg, "two") == 0);
+
+	run("", TEST_PASS);
+	run("   ", TEST_PASS);
+	CHECK_EQ(cmdCalls, 1);
+
+	run("echo a b c d", TEST_FAIL);
+	CHECK(strstr(output, "Too many arguments") != NULL);
+	CHECK_EQ(cmdCalls, 1);
+
+	run("ech", TEST_FAIL);
+	CHECK(strstr(output, "Unknown command") != NULL);
+}
+
+static void feed(const char *text)
+{
+	while (*text != '\0')
+	{
+		SHELL_input(*text++);
+	}
+}
+
+static void test_lineEditor(void)
+{
+	char   line[SHELL_LINE_MAX + 8];
+	Uint32 n;
+
+	shellSetup();
+
+	/* Backspace and DEL erase, CR or LF runs */
+	feed("set gaim\b\bin 5\r");
+	CHECK_EQ(gainValue, 5);
+	feed("set gain 6x\x7f\n");
+	CHECK_EQ(gainValue, 6);
+
+	/* ESC drops the line, control characters are ignored */
+	feed("set gain 7\x1b" "echo \x01ok\r");
+	CHECK_EQ(gainValue, 6);
+	CHECK_EQ(cmdCalls, 1);
+	CHECK(strcmp(cmdArg, "ok") == 0);
+
+	/* Too long: reported, not run, and the next line is fine */
+	HOST_msgClear();
+	memset(line, 'x', sizeof(line));
+	strcpy(&line[SHELL_LINE_MAX - 4], " echo\r");
+	memcpy(line, "echo", 4);
+	feed(line);
+	n = HOST_msgTake(output, sizeof(output) - 1);
+	output[n] = '\0';
+	CHECK(strstr(output, "Line too long") != NULL);
+	CHECK_EQ(cmdCalls, 1);
+
+	/* Exactly SHELL_LINE_MAX characters still run */
+	memset(line, ' ', SHELL_LINE_MAX);
+	memcpy(line, "echo", 4);
+	line[SHELL_LINE_MAX - 1] = 'z';
+	line[SHELL_LINE_MAX]     = '\r';
+	line[SHELL_LINE_MAX + 1] = '\0';
+	feed(line);
+	CHECK_EQ(cmdCalls, 2);
+	CHECK(strcmp(cmdArg, "z") == 0);
+}
+
+int main(void)
+{
+	TEST_RUN(test_parseInt);
+	TEST_RUN(test_registry);
+	TEST_RUN(test_getSet);
+	TEST_RUN(test_commands);
+	TEST_RUN(test_lineEditor);
+
+	return (testFailures);
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_synth_voice.c
+*
+*   \brief Host test and benchmark of the synth voice engine: long
+*          envelopes at 96 kHz, stale note handles and cost per block.
+*
+*/
+
+#include "test.h"
+#include "synth_voice.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+#define BLOCK_FRAMES    (48)
+
+static Int16 left[SYNTH_MAX_BLOCK];
+static Int16 right[SYNTH_MAX_BLOCK];
+
+static Int16 blockPeak(const Int16 *x, Uint16 count)
+{
+	Int16 peak = 0;
+
+	while (count--)
+	{
+		if (abs(*x) > peak)
+		{
+			peak = (Int16)abs(*x);
+		}
+		x++;
+	}
+
+	return (peak);
+}
+
+/* 50 s of attack at 96 kHz is 4.8M samples; ms * fs alone wraps 32 bits
+ * and made the attack almost ten times too fast */
+static void test_longEnvelope96k(void)
+{
+	static const SYNTH_Adsr slow = { 50000, 0, 0x7FFF, 0 };
+	Uint32 blocks;
+	Int16  peak;
+
+	SYNTH_init(96000, 4);
+	SYNTH_noteOn(1000, 0x7FFF, SYNTH_PAN_CENTER, &slow);
+
+	/* One second in: the envelope is at 1/50 of full scale */
+	for (blocks = 0; blocks < 96000 / SYNTH_MAX_BLOCK; blocks++)
+	{
+		SYNTH_render(left, right, SYNTH_MAX_BLOCK);
+	}
+	peak = blockPeak(left, SYNTH_MAX_BLOCK);
+	CHECK(peak > 300);
+	CHECK(peak < 340);
+}
+
+/* A note-off for a note whose voice was stolen leaves the new note alone */
+static void test_staleHandle(void)
+{
+	static const SYNTH_Adsr adsr = { 0, 0, 0x7FFF, 0 };
+	SYNTH_Stats stats;
+	Int16       first;
+	Int16       second;
+	Int16       third;
+
+	SYNTH_init(48000, 2);
+	first  = SYNTH_noteOn(440, 0x4000, SYNTH_PAN_CENTER, &adsr);
+	second = SYNTH_noteOn(550, 0x4000, SYNTH_PAN_CENTER, &adsr);
+	third  = SYNTH_noteOn(660, 0x4000, SYNTH_PAN_CENTER, &adsr);
+
+	SYNTH_getStats(&stats);
+	CHECK_EQ(stats.voicesStolen, 1);
+	CHECK(first >= 0);
+	CHECK(second >= 0);
+	CHECK(third >= 0);
+	CHECK((third != first) && (third != second));
+
+	/* Both old handles: one is stale, one still owns its voice */
+	SYNTH_noteOff(first);
+	SYNTH_noteOff(second);
+	SYNTH_render(left, right, BLOCK_FRAMES);
+	SYNTH_render(left, right, BLOCK_FRAMES);
+	SYNTH_getStats(&stats);
+	CHECK_EQ(stats.activeVoices, 1);
+
+	SYNTH_noteOff(third);
+	SYNTH_render(left, right, BLOCK_FRAMES);
+	SYNTH_render(left, right, BLOCK_FRAMES);
+	SYNTH_getStats(&stats);
+	CHECK_EQ(stats.activeVoices, 0);
+
+	/* Invalid handles are ignored */
+	SYNTH_noteOff(-1);
+	SYNTH_noteOff(0x7FFF);
+}
+
+/* Rising zero crossings of the left channel over 'frames' frames */
+static Uint32 risingCrossings(Uint32 frames)
+{
+	Uint32 count = 0;
+	Int16  prev = 0;
+	Uint16 i;
+
+	while (frames != 0)
+	{
+		SYNTH_render(left, right, BLOCK_FRAMES);
+		for (i = 0; i < BLOCK_FRAMES; i++)
+		{
+			count += (prev < 0) && (left[i] >= 0);
+			prev   = left[i];
+		}
+		frames -= BLOCK_FRAMES;
+	}
+
+	return (count);
+}
+
+/* After a rate change the notes keep their pitch and envelope times, and
+ * a note the new rate cannot carry stops */
+static void test_rateChange(void)
+{
+	static const SYNTH_Adsr flat = { 0, 0, 0x7FFF, 0 };
+	static const SYNTH_Adsr slow = { 1000, 0, 0x7FFF, 0 };
+	SYNTH_Stats stats;
+	Uint32      blocks;
+	Int16       peak;
+
+	SYNTH_init(48000, 4);
+	SYNTH_noteOn(1000, 0x7FFF, SYNTH_PAN_LEFT, &flat);
+	SYNTH_noteOn(15000, 0x2000, SYNTH_PAN_RIGHT, &flat);
+	SYNTH_setSampleRate(24000);
+
+	/* 0.2 s at the new rate */
+	CHECK(abs((Int32)risingCrossings(4800) - 200) <= 1);
+	SYNTH_getStats(&stats);
+	CHECK_EQ(stats.activeVoices, 1);
+
+	/* Half the attack at the new rate is half of full scale */
+	SYNTH_init(48000, 4);
+	SYNTH_noteOn(1000, 0x7FFF, SYNTH_PAN_LEFT, &slow);
+	SYNTH_setSampleRate(24000);
+	for (blocks = 0; blocks < 12000 / BLOCK_FRAMES; blocks++)
+	{
+		SYNTH_render(left, right, BLOCK_FRAMES);
+	}
+	peak = blockPeak(left, BLOCK_FRAMES);
+	CHECK(peak > 15500);
+	CHECK(peak < 17000);
+}
+
+static void test_cyclesReported(void)
+{
+	static const SYNTH_Adsr adsr = { 5, 50, 0x6000, 100 };
+	SYNTH_Stats stats;
+
+	SYNTH_init(48000, 8);
+	SYNTH_noteOn(440, 0x2000, SYNTH_PAN_LEFT, &adsr);
+	SYNTH_render(left, right, BLOCK_FRAMES);
+
+	SYNTH_getStats(&stats);
+	CHECK(stats.lastCycles > 0);
+	CHECK(stats.worstCycles >= stats.lastCycles);
+}
+
+static void bench_render(void)
+{
+	static const SYNTH_Adsr adsr = { 5, 50, 0x6000, 100 };
+	static const Uint16 voiceCounts[] = { 1, 4, 8, 16 };
+	SYNTH_Stats stats;
+	char        name[40];
+	Uint16      v;
+	Uint16      i;
+
+	for (v = 0; v < sizeof(voiceCounts) / sizeof(voiceCounts[0]); v++)
+	{
+		SYNTH_init(48000, voiceCounts[v]);
+		for (i = 0; i < voiceCounts[v]; i++)
+		{
+			SYNTH_noteOn(220 + 110 * i, 0x1000, SYNTH_PAN_CENTER, &adsr);
+		}
+
+		sprintf(name, "SYNTH_render(48) %u voices", voiceCounts[v]);
+		BENCH(name, 20000, SYNTH_render(left, right, BLOCK_FRAMES));
+
+		SYNTH_getStats(&stats);
+		printf("  %u voices: last block %lu cycles at %lu kHz\n",
+		       voiceCounts[v], (unsigned long)stats.lastCycles,
+		       (unsigned long)HOST_sysClkKhz());
+	}
+}
+
+int main(void)
+{
+	C55x_timebaseInit();
+
+	TEST_RUN(test_longEnvelope96k);
+	TEST_RUN(test_staleHandle);
+	TEST_RUN(test_rateChange);
+	TEST_RUN(test_cyclesReported);
+	TEST_RUN(bench_render);
+
+	return (testFailures);
+}
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_sys_clock.c
+*
+*   \brief Host test of the PLL search and the clock change notifier
+*          chain. The settings found are programmed into the CGCR
+*          registers of the host model, whose clock is what
+*          C55x_getSysClk() returns.
+*
+*/
+
+#include "test.h"
+#include "sys_clock.h"
+#include "platform_uart.h"
+#include "i2c_clock.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+/* Limits of the C5545 PLL, as in sys_clock.c */
+#define PLL_REF_MIN_HZ      (30000)
+#define PLL_REF_MAX_HZ      (170000)
+#define PLL_OUT_MIN_HZ      (60000000)
+#define PLL_OUT_MAX_HZ      (120000000)
+
+/* A 12 MHz crystal cannot be divided into the reference range */
+#define CLKIN_11M_HZ        (11289600)
+
+/* Notifier calls in the order they came */
+#define CALL_LOG_SIZE       (32)
+
+typedef struct
+{
+	Uint16  id;
+	Uint16  event;
+	Uint32  sysClkKhz;
+	Uint32  timebaseKhz;    /* clock the timebase was scaled to then */
+} NotifyCall;
+
+static NotifyCall callLog[CALL_LOG_SIZE];
+static Uint16     callCount;
+
+static void logCall(Uint16 id, Uint16 event, Uint32 sysClkKhz)
+{
+	if (callCount < CALL_LOG_SIZE)
+	{
+		callLog[callCount].id          = id;
+		callLog[callCount].event       = event;
+		callLog[callCount].sysClkKhz   = sysClkKhz;
+		callLog[callCount].timebaseKhz = C55x_timebaseGetClock();
+		callCount++;
+	}
+}
+
+#define NOTIFIER(n) \
+	static void notify##n(Uint16 event, Uint32 sysClkKhz) \
+	{ \
+		logCall(n, event, sysClkKhz); \
+	}
+
+NOTIFIER(1)
+NOTIFIER(2)
+NOTIFIER(3)
+NOTIFIER(4)
+NOTIFIER(5)
+NOTIFIER(6)
+NOTIFIER(7)
+NOTIFIER(8)
+
+/* The UART hooks of platform.c, logged as notifier 100 */
+#define UART_ID             (100)
+#define UART_DRAIN          (0)
+#define UART_RETIME         (1)
+
+void uart_drain(void)
+{
+	logCall(UART_ID, UART_DRAIN, C55x_getSysClk());
+}
+
+Platform_STATUS uart_retime(Uint32 sysClkKhz)
+{
+	logCall(UART_ID, UART_RETIME, sysClkKhz);
+
+	return (0);
+}
+
+/* Decodes the CGCR values the way the hardware does */
+static void checkPll(Uint32 clkInHz, Uint32 targetKhz,
+                     const C55x_PllParams *params)
+{
+	Uint32 refHz;
+	Uint32 outHz;
+	Uint32 sysHz;
+	Uint32 errHz;
+	Uint16 m;
+	Uint16 od;
+	int    failures = testFailures;
+
+	CHECK(params->reg[0] & 0x8000);
+	m = (params->reg[0] & 0x0FFF) + 4;
+
+	if (params->reg[1] & 0x8000)
+	{
+		refHz = clkInHz;
+	}
+	else
+	{
+		refHz = clkInHz / ((params->reg[1] & 0x3F) + 4);
+	}
+	od = (params->reg[3] & 0x0200) ? ((params->reg[3] & 0x3F) + 1) : 1;
+
+	CHECK(refHz >= PLL_REF_MIN_HZ);
+	CHECK(refHz <= PLL_REF_MAX_HZ);
+
+	outHz = refHz * m;
+	CHECK(outHz >= PLL_OUT_MIN_HZ);
+	CHECK(outHz <= PLL_OUT_MAX_HZ);
+
+	sysHz = outHz / od;
+	CHECK_EQ(params->sysClkKhz, sysHz / 1000);
+
+	/* Nearest multiplier: within half a reference step of the target */
+	errHz = (sysHz > targetKhz * 1000) ? (sysHz - targetKhz * 1000) :
+	                                     (targetKhz * 1000 - sysHz);
+	CHECK(errHz <= refHz / 2);
+
+	if (testFailures != failures)
+	{
+		printf("  %lu Hz in, %lu kHz: %04x %04x %04x %04x\n",
+		       (unsigned long)clkInHz, (unsigned long)targetKhz,
+		       params->reg[0], params->reg[1], params->reg[2],
+		       params->reg[3]);
+	}
+}
+
+static void setPll(const C55x_PllParams *params)
+{
+	CSL_SysRegs *sys = CSL_SYSCTRL_REGS;
+
+	HOST_regSet(&sys->CGCR1, params->reg[0]);
+	HOST_regSet(&sys->CGCR2, params->reg[1]);
+	HOST_regSet(&sys->CGCR3, params->reg[2]);
+	HOST_regSet(&sys->CGCR4, params->reg[3]);
+}
+
+static void test_pllSearch32k(void)
+{
+	static const Uint32 targets[] =
+	{
+		1000, 12288, 24576, 40000, 50000, 60000, 75000, 98304,
+		100000, 120000
+	};
+	C55x_PllParams params;
+	Uint16         i;
+
+	for (i = 0; i < sizeof(targets) / sizeof(targets[0]); i++)
+	{
+		CHECK_EQ(C55x_pllSearch(CSL_PLL_CLOCKIN, targets[i], &params),
+		         TEST_PASS);
+		checkPll(CSL_PLL_CLOCKIN, targets[i], &params);
+
+		/* The registers give the clock the search reported */
+		setPll(&params);
+		CHECK_EQ(HOST_sysClkKhz(), params.sysClkKhz);
+	}
+}
+
+static void test_pllSearchSweep(void)
+{
+	C55x_PllParams params;
+	Uint32         targetKhz;
+
+	for (targetKhz = 1000; targetKhz <= 120000; targetKhz += 731)
+	{
+		if (C55x_pllSearch(CSL_PLL_CLOCKIN, targetKhz, &params) ==
+		    TEST_PASS)
+		{
+			checkPll(CSL_PLL_CLOCKIN, targetKhz, &params);
+		}
+		else
+		{
+			CHECK(FALSE);
+		}
+
+		if (C55x_pllSearch(CLKIN_11M_HZ, targetKhz, &params) == TEST_PASS)
+		{
+			checkPll(CLKIN_11M_HZ, targetKhz, &params);
+		}
+		else
+		{
+			CHECK(FALSE);
+		}
+	}
+}
+
+static void test_pllSearchLimits(void)
+{
+	C55x_PllParams params;
+
+	/* Above the PLL output, and below its output over the largest OD */
+	CHECK_EQ(C55x_pllSearch(CSL_PLL_CLOCKIN, 150000, &params), TEST_FAIL);
+	CHECK_EQ(C55x_pllSearch(CSL_PLL_CLOCKIN, 500, &params), TEST_FAIL);
+
+	/* The reference divider goes to 67 at most */
+	CHECK_EQ(C55x_pllSearch(12000000, 100000, &params), TEST_FAIL);
+	CHECK_EQ(C55x_pllSearch(CLKIN_11M_HZ, 100000, &params), TEST_PASS);
+	CHECK((params.reg[1] & 0x8000) == 0);
+}
+
+static void test_notifierChain(void)
+{
+	C55x_PllParams params;
+	Uint32         oldKhz;
+	Uint16         i;
+
+	CHECK_EQ(C55x_clkRegisterNotifier(notify1), TEST_PASS);
+	CHECK_EQ(C55x_clkRegisterNotifier(notify2), TEST_PASS);
+	CHECK_EQ(C55x_clkRegisterNotifier(notify3), TEST_PASS);
+	/* Registering twice does not call twice */
+	CHECK_EQ(C55x_clkRegisterNotifier(notify2), TEST_PASS);
+
+	/* The searches above left the registers at another clock */
+	C55x_timebaseInit();
+	oldKhz    = C55x_getSysClk();
+	callCount = 0;
+
+	CHECK_EQ(C55x_setSysClk(60000), TEST_PASS);
+	C55x_pllSearch(CSL_PLL_CLOCKIN, 60000, &params);
+	CHECK_EQ(C55x_getSysClk(), params.sysClkKhz);
+
+	/* Every PRE in registration order with the old clock, then every
+	 * POST with the new one, the timebase already re-scaled */
+	CHECK_EQ(callCount, 6);
+	for (i = 0; i < 3; i++)
+	{
+		CHECK_EQ(callLog[i].id, i + 1);
+		CHECK_EQ(callLog[i].event, C55X_CLK_PRE_CHANGE);
+		CHECK_EQ(callLog[i].sysClkKhz, oldKhz);
+		CHECK_EQ(callLog[i].timebaseKhz, oldKhz);
+
+		CHECK_EQ(callLog[3 + i].id, i + 1);
+		CHECK_EQ(callLog[3 + i].event, C55X_CLK_POST_CHANGE);
+		CHECK_EQ(callLog[3 + i].sysClkKhz, params.sysClkKhz);
+		CHECK_EQ(callLog[3 + i].timebaseKhz, params.sysClkKhz);
+	}
+
+	/* No notifier runs for a clock that cannot be made */
+	callCount = 0;
+	CHECK_EQ(C55x_setSysClk(150000), TEST_FAIL);
+	CHECK_EQ(callCount, 0);
+	CHECK_EQ(C55x_getSysClk(), params.sysClkKhz);
+}
+
+/* The I2C and the UART follow the clock */
+static void test_defaultNotifiers(void)
+{
+	Uint32 oldKhz;
+	Uint16 i;
+	Bool   drained = FALSE;
+	Bool   retimed = FALSE;
+
+	HOST_i2cReset();
+	CHECK_EQ(I2C_clockSetBusRate(I2C_BUS_RATE_400K), TEST_PASS);
+
+	C55x_clkRegisterDefaultNotifiers();
+
+	oldKhz    = C55x_getSysClk();
+	callCount = 0;
+	CHECK_EQ(C55x_setSysClk(100000), TEST_PASS);
+
+	/* The bus rate the registers give stays at the one selected */
+	CHECK(HOST_i2cBusRate() <= I2C_BUS_RATE_400K);
+	CHECK(HOST_i2cBusRate() >= I2C_BUS_RATE_400K * 9 / 10);
+
+	for (i = 0; i < callCount; i++)
+	{
+		if (callLog[i].id != UART_ID)
+		{
+			continue;
+		}
+		if (callLog[i].event == UART_DRAIN)
+		{
+			/* Drained before the clock went */
+			CHECK(!retimed);
+			CHECK_EQ(callLog[i].sysClkKhz, oldKhz);
+			drained = TRUE;
+		}
+		else
+		{
+			CHECK(drained);
+			CHECK_EQ(callLog[i].sysClkKhz, C55x_getSysClk());
+			retimed = TRUE;
+		}
+	}
+
+	CHECK(drained);
+	CHECK(retimed);
+}
+
+/* Runs last, the table cannot be emptied */
+static void test_notifierTableFull(void)
+{
+	/* 3 + the I2C and UART defaults + 3 fill the table */
+	CHECK_EQ(C55x_clkRegisterNotifier(notify4), TEST_PASS);
+	CHECK_EQ(C55x_clkRegisterNotifier(notify5), TEST_PASS);
+	CHECK_EQ(C55x_clkRegisterNotifier(notify6), TEST_PASS);
+	CHECK_EQ(C55x_clkRegisterNotifier(notify7), TEST_FAIL);
+	CHECK_EQ(C55x_clkRegisterNotifier(notify8), TEST_FAIL);
+
+	/* One already in still registers */
+	CHECK_EQ(C55x_clkRegisterNotifier(notify1), TEST_PASS);
+}
+
+int main(void)
+{
+	C55x_timebaseInit();
+
+	TEST_RUN(test_pllSearch32k);
+	TEST_RUN(test_pllSearchSweep);
+	TEST_RUN(test_pllSearchLimits);
+	TEST_RUN(test_notifierChain);
+	TEST_RUN(test_defaultNotifiers);
+	TEST_RUN(test_notifierTableFull);
+
+	return (testFailures);
+}
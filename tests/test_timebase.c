@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_timebase.c
+*
+*   \brief Host test of the cycle timebase on its clock_gettime() count:
+*          conversions, deadlines, delays, clock changes and the cycle
+*          count wrap, against CLOCK_MONOTONIC.
+*
+*/
+
+#include "test.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+/* Host scheduling slack on a measured interval */
+#define SLACK_USEC      (2000)
+
+/* Wraps the 32-bit cycle count every 1.07 s */
+#define FAST_CLK_KHZ    (4000000)
+
+static Uint32 monoUsec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((Uint32)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000));
+}
+
+static void sleepUsec(Uint32 usec)
+{
+	struct timespec ts;
+
+	ts.tv_sec  = usec / 1000000;
+	ts.tv_nsec = (usec % 1000000) * 1000;
+	while (nanosleep(&ts, &ts) != 0)
+	{
+	}
+}
+
+/* 'got' is within the slack of 'want' */
+#define CHECK_NEAR(got, want) \
+	CHECK(((Int32)((got) - (want)) > -SLACK_USEC) && \
+	      ((Int32)((got) - (want)) < SLACK_USEC))
+
+static void test_conversions(void)
+{
+	Uint32 usec;
+
+	C55x_timebaseSetClock(100000);
+	CHECK_EQ(C55x_timebaseGetClock(), 100000);
+	CHECK_EQ(C55x_usecToCycles(1), 100);
+	CHECK_EQ(C55x_usecToCycles(1000), 100000);
+	CHECK_EQ(C55x_usecToCycles(40000000), 4000000000UL);
+	CHECK_EQ(C55x_cyclesToUsec(100000), 1000);
+	CHECK_EQ(C55x_cyclesToUsec(4000000000UL), 40000000);
+
+	/* 12.288 MHz is not a whole number of cycles per microsecond */
+	C55x_timebaseSetClock(12288);
+	CHECK_EQ(C55x_usecToCycles(1), 12);
+	CHECK_EQ(C55x_usecToCycles(1000), 12288);
+	CHECK_EQ(C55x_usecToCycles(1000000), 12288000);
+	CHECK_EQ(C55x_cyclesToUsec(12288), 1000);
+	CHECK_EQ(C55x_cyclesToUsec(0xFFFFFFFFUL), 349525333);
+
+	for (usec = 1; usec < 100000000; usec = usec * 3 + 7)
+	{
+		CHECK(C55x_cyclesToUsec(C55x_usecToCycles(usec)) <= usec);
+		CHECK(C55x_cyclesToUsec(C55x_usecToCycles(usec)) + 1 >= usec);
+	}
+
+	/* No clock, no time */
+	C55x_timebaseSetClock(0);
+	CHECK(!C55x_timebaseRunning());
+	CHECK_EQ(C55x_cyclesToUsec(100000), 0);
+
+	C55x_timebaseInit();
+	CHECK(C55x_timebaseRunning());
+}
+
+static void test_tracksMonotonic(void)
+{
+	Uint32 mono0;
+	Uint32 now0;
+
+	C55x_timebaseInit();
+
+	mono0 = monoUsec();
+	now0  = C55x_nowUsec();
+	sleepUsec(20000);
+
+	CHECK_NEAR(C55x_nowUsec() - now0, monoUsec() - mono0);
+}
+
+static void test_deadlines(void)
+{
+	Uint32 deadline;
+	Uint32 now;
+
+	C55x_timebaseInit();
+
+	deadline = C55x_deadline(5000);
+	CHECK(!C55x_deadlinePassed(deadline));
+	sleepUsec(6000);
+	CHECK(C55x_deadlinePassed(deadline));
+
+	/* Differences are signed, half the wrap either way */
+	now = C55x_nowCycles();
+	CHECK(C55x_deadlinePassed(now - 1));
+	CHECK(C55x_deadlinePassed(now - 0x7FFFFFF0UL));
+	CHECK(!C55x_deadlinePassed(now + 0x40000000UL));
+	CHECK(C55x_deadlinePassed(C55x_deadline(0)));
+}
+
+static void test_delayUsec(void)
+{
+	Uint32 mono0;
+	Uint32 elapsed;
+
+	C55x_timebaseInit();
+
+	mono0 = monoUsec();
+	C55x_delay_usec(3000);
+	elapsed = monoUsec() - mono0;
+
+	CHECK(elapsed >= 3000);
+	CHECK(elapsed < 3000 + SLACK_USEC);
+}
+
+/* The microsecond count carries on across a PLL change */
+static void test_clockChange(void)
+{
+	Uint32 before;
+	Uint32 after;
+	Uint32 mono0;
+
+	C55x_timebaseInit();
+	sleepUsec(5000);
+
+	before = C55x_nowUsec();
+	C55x_timebaseSetClock(12288);
+	after = C55x_nowUsec();
+	CHECK(after >= before);
+	CHECK(after - before < SLACK_USEC);
+
+	mono0  = monoUsec();
+	before = C55x_nowUsec();
+	sleepUsec(10000);
+	CHECK_NEAR(C55x_nowUsec() - before, monoUsec() - mono0);
+
+	C55x_timebaseInit();
+}
+
+/* Read every 100ms, the count stays right past several cycle wraps */
+static void test_pastCycleWrap(void)
+{
+	Uint32 mono0;
+	Uint32 now0;
+	Uint32 last;
+	Uint32 now;
+	Uint16 i;
+
+	C55x_timebaseSetClock(FAST_CLK_KHZ);
+
+	mono0 = monoUsec();
+	now0  = C55x_nowUsec();
+	last  = now0;
+
+	for (i = 0; i < 25; i++)
+	{
+		sleepUsec(100000);
+		now = C55x_nowUsec();
+		CHECK((Int32)(now - last) > 0);
+		last = now;
+	}
+
+	CHECK_NEAR(last - now0, monoUsec() - mono0);
+
+	C55x_timebaseInit();
+}
+
+static void bench_nowUsec(void)
+{
+	volatile Uint32 sink;
+
+	C55x_timebaseInit();
+
+	BENCH("C55x_nowCycles", 1000000, sink = C55x_nowCycles());
+	BENCH("C55x_nowUsec", 1000000, sink = C55x_nowUsec());
+}
+
+int main(void)
+{
+	TEST_RUN(test_conversions);
+	TEST_RUN(test_tracksMonotonic);
+	TEST_RUN(test_deadlines);
+	TEST_RUN(test_delayUsec);
+	TEST_RUN(test_clockChange);
+	TEST_RUN(test_pastCycleWrap);
+	TEST_RUN(bench_nowUsec);
+
+	return (testFailures);
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_uart_log.c
+*
+*   \brief Host test of the interrupt driven console against the fake
+*          UART: order, message length, drops, flushing with interrupts
+*          disabled and giving up on a stalled line.
+*
+*/
+
+#include "test.h"
+#include "uart_log.h"
+#include "timebase.h"
+
+TEST_MAIN_DATA;
+
+static char uartOut[UART_LOG_RING_SIZE * 4];
+
+static Uint32 takeOutput(void)
+{
+	Uint32 n;
+
+	n = HOST_uartTake((Uint8 *)uartOut, sizeof(uartOut) - 1);
+	uartOut[n] = '\0';
+
+	return (n);
+}
+
+static void logSetup(void)
+{
+	C55x_timebaseInit();
+	HOST_uartHold(FALSE);
+	CHECK_EQ(UART_logOpen(), TEST_PASS);
+	takeOutput();
+	HOST_msgClear();
+}
+
+static void test_messagesInOrder(void)
+{
+	UART_LogStats stats;
+	Uint16        i;
+
+	logSetup();
+
+	for (i = 0; i < 20; i++)
+	{
+		C55x_msgWrite("line %d\n\r", i);
+	}
+	UART_logFlush();
+
+	CHECK_EQ(takeOutput(), 10 * 8 + 10 * 9);
+	CHECK(strncmp(uartOut, "line 0\n\rline 1\n\r", 16) == 0);
+	CHECK(strstr(uartOut, "line 19\n\r") != NULL);
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.messages, 20);
+	CHECK_EQ(stats.bytes, 170);
+	CHECK_EQ(stats.dropped, 0);
+
+	UART_logClose();
+}
+
+static void test_longMessageKept(void)
+{
+	char          text[UART_LOG_MAX_MSG + 50];
+	UART_LogStats stats;
+
+	logSetup();
+
+	/* Anything the polled console takes fits whole */
+	memset(text, 'a', sizeof(text));
+	text[UART_LOG_MAX_MSG - 1] = '\0';
+	C55x_msgWrite("%s", text);
+	UART_logFlush();
+	CHECK_EQ(takeOutput(), UART_LOG_MAX_MSG - 1);
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.truncated, 0);
+
+	/* Longer is cut and counted */
+	text[UART_LOG_MAX_MSG - 1] = 'a';
+	text[sizeof(text) - 1]     = '\0';
+	C55x_msgWrite("%s", text);
+	UART_logFlush();
+	CHECK_EQ(takeOutput(), UART_LOG_MAX_MSG - 1);
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.truncated, 1);
+
+	UART_logClose();
+}
+
+static void test_ringFullDrops(void)
+{
+	char          text[64];
+	UART_LogStats stats;
+	Uint16        i;
+
+	logSetup();
+	memset(text, 'b', sizeof(text));
+
+	/* The far end stops reading: the ring fills, whole messages drop */
+	HOST_uartHold(TRUE);
+	for (i = 0; i < UART_LOG_RING_SIZE / sizeof(text) + 4; i++)
+	{
+		UART_logWrite(text, sizeof(text));
+	}
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.messages, UART_LOG_RING_SIZE / sizeof(text));
+	CHECK_EQ(stats.dropped, 4);
+	CHECK_EQ(stats.droppedBytes, 4 * sizeof(text));
+	CHECK_EQ(stats.maxLevel, UART_LOG_RING_SIZE);
+
+	HOST_uartHold(FALSE);
+	UART_logFlush();
+	CHECK_EQ(takeOutput(), UART_LOG_RING_SIZE);
+
+	UART_logClose();
+}
+
+static void test_flushInterruptsDisabled(void)
+{
+	UART_LogStats stats;
+	Bool          oldIntm;
+
+	logSetup();
+
+	/* The ISR cannot run: the flush feeds the FIFO itself */
+	oldIntm = IRQ_globalDisable();
+	C55x_msgWrite("fatal: %s\n\r", "stopped with INTM set");
+	UART_logFlush();
+	CHECK_EQ(takeOutput(), 30);
+	CHECK(strcmp(uartOut, "fatal: stopped with INTM set\n\r") == 0);
+	IRQ_globalRestore(oldIntm);
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.droppedBytes, 0);
+
+	UART_logClose();
+}
+
+static void test_flushGivesUp(void)
+{
+	UART_LogStats stats;
+	Uint32        start;
+	Uint32        waited;
+	Bool          oldIntm;
+
+	logSetup();
+
+	/* A line that never drains: the flush gives up and counts the rest */
+	HOST_uartHold(TRUE);
+	UART_logWrite("never sent", 10);
+
+	start = C55x_nowUsec();
+	UART_logFlush();
+	waited = C55x_nowUsec() - start;
+	CHECK(waited >= UART_LOG_FLUSH_TIMEOUT_USEC);
+	CHECK(waited < UART_LOG_FLUSH_TIMEOUT_USEC + 100000);
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.droppedBytes, 10);
+
+	/* The same with interrupts disabled */
+	UART_logWrite("never sent", 10);
+	oldIntm = IRQ_globalDisable();
+	UART_logFlush();
+	IRQ_globalRestore(oldIntm);
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.droppedBytes, 20);
+
+	/* Nothing left over once the line is back */
+	HOST_uartHold(FALSE);
+	C55x_msgWrite("back\n\r");
+	UART_logFlush();
+	CHECK_EQ(takeOutput(), 6);
+	CHECK(strcmp(uartOut, "back\n\r") == 0);
+
+	UART_logClose();
+}
+
+static void test_receiveRing(void)
+{
+	UART_LogStats stats;
+	Uint8         input[UART_LOG_RX_SIZE + 8];
+	char          c;
+	Uint16        i;
+
+	logSetup();
+
+	HOST_uartReceive((const Uint8 *)"ok\r", 3);
+	CHECK(UART_logReadChar(&c) && (c == 'o'));
+	CHECK(UART_logReadChar(&c) && (c == 'k'));
+	CHECK(UART_logReadChar(&c) && (c == '\r'));
+	CHECK(!UART_logReadChar(&c));
+
+	/* Characters beyond the ring are counted, not kept */
+	for (i = 0; i < sizeof(input); i++)
+	{
+		input[i] = (Uint8)i;
+	}
+	HOST_uartReceive(input, sizeof(input));
+
+	for (i = 0; UART_logReadChar(&c); i++)
+	{
+		CHECK_EQ((Uint8)c, i);
+	}
+	CHECK_EQ(i, UART_LOG_RX_SIZE);
+
+	UART_logGetStats(&stats);
+	CHECK_EQ(stats.rxDropped, 8);
+
+	UART_logClose();
+}
+
+int main(void)
+{
+	TEST_RUN(test_messagesInOrder);
+	TEST_RUN(test_longMessageKept);
+	TEST_RUN(test_ringFullDrops);
+	TEST_RUN(test_flushInterruptsDisabled);
+	TEST_RUN(test_flushGivesUp);
+	TEST_RUN(test_receiveRing);
+
+	return (testFailures);
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_uart_stream.c
+*
+*   \brief Host test of the UART stream: console text goes out in frames
+*          while streaming, and the host reader decodes the stream through
+*          a pty into a WAV and a CSV file, skipping a torn frame.
+*
+*/
+
+/* posix_openpt() and friends */
+#define _GNU_SOURCE
+
+#include "test.h"
+#include "uart_stream.h"
+#include "uart_log.h"
+#include "timebase.h"
+#include "stream_reader.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+
+TEST_MAIN_DATA;
+
+#define TAP_FRAMES      (64)
+#define PTY_WAIT_MSEC   (2000)
+
+static Uint8 capture[8192];
+
+static Uint32 takeCapture(void)
+{
+	return (HOST_uartTake(capture, sizeof(capture)));
+}
+
+/* Until the line is free again, text included. A frame started outside
+ * a critical section raises its interrupt from the register trap, which
+ * the host model only latches. */
+static void waitSent(void)
+{
+	while (!STREAM_idle())
+	{
+		HOST_irqPoll();
+	}
+}
+
+static char   textOut[1024];
+static Uint16 textLen;
+static Uint16 textFrames;
+
+static void textFrame(const STREAM_ReaderFrame *frame, void *arg)
+{
+	if ((frame->type == STREAM_FRAME_TEXT) &&
+	    (textLen + frame->length < sizeof(textOut)))
+	{
+		memcpy(&textOut[textLen], frame->payload, frame->length);
+		textLen += frame->length;
+		textOut[textLen] = '\0';
+		textFrames++;
+	}
+}
+
+static void test_consoleInFrames(void)
+{
+	static STREAM_Reader rd;
+	STREAM_Stats stats;
+	Uint32       length;
+
+	C55x_timebaseInit();
+	HOST_uartHold(FALSE);
+	CHECK_EQ(UART_logOpen(), TEST_PASS);
+	takeCapture();
+
+	CHECK_EQ(STREAM_open(0), TEST_PASS);
+	CHECK(STREAM_active());
+	CHECK(!UART_logActive());
+
+	/* Longer than one frame holds */
+	C55x_msgWrite("streaming at %lu baud, the console goes out in text "
+	              "frames from now on\n\r", (Uint32)STREAM_DEFAULT_BAUD);
+	C55x_msgWrite("second line\n\r");
+	waitSent();
+
+	/* Nothing but frames on the line */
+	length = takeCapture();
+	CHECK(length > 0);
+	CHECK_EQ(capture[0], STREAM_SYNC0);
+
+	textLen    = 0;
+	textFrames = 0;
+	STREAM_readerInit(&rd, textFrame, NULL);
+	STREAM_readerFeed(&rd, capture, length);
+
+	CHECK_EQ(rd.junkBytes, 0);
+	CHECK_EQ(rd.badCrc, 0);
+	CHECK(textFrames >= 2);
+	CHECK(strcmp(textOut, "streaming at 3125000 baud, the console goes out "
+	                      "in text frames from now on\n\rsecond line\n\r") ==
+	      0);
+
+	STREAM_getStats(&stats);
+	CHECK_EQ(stats.textBytes, textLen);
+	CHECK_EQ(stats.textDropped, 0);
+
+	/* Back to plain text on the log ring */
+	STREAM_close();
+	CHECK(UART_logActive());
+	C55x_msgWrite("console\n\r");
+	UART_logFlush();
+	length = takeCapture();
+	CHECK_EQ(length, 9);
+	CHECK(memcmp(capture, "console\n\r", 9) == 0);
+
+	UART_logClose();
+}
+
+static void test_textRingFull(void)
+{
+	STREAM_Stats stats;
+	char         text[100];
+	Uint16       queued = 0;
+	Uint16       i;
+
+	C55x_timebaseInit();
+	HOST_uartHold(FALSE);
+	CHECK_EQ(STREAM_open(0), TEST_PASS);
+
+	/* The line stalls: text piles up, then whole messages drop */
+	HOST_uartHold(TRUE);
+	memset(text, 't', sizeof(text));
+	for (i = 0; i < 8; i++)
+	{
+		queued += (STREAM_text(text, sizeof(text)) != 0);
+	}
+
+	STREAM_getStats(&stats);
+	CHECK_EQ(stats.textDropped, 8 - queued);
+	CHECK(queued * sizeof(text) <= STREAM_TEXT_RING_SIZE + STREAM_TEXT_MAX);
+	CHECK(queued < 8);
+
+	HOST_uartHold(FALSE);
+	STREAM_close();
+	takeCapture();
+
+	STREAM_getStats(&stats);
+	CHECK_EQ(stats.textBytes, queued * sizeof(text));
+}
+
+/* The reader side of the pty, in a thread as a capture on a PC would be */
+typedef struct
+{
+	int             fd;
+	STREAM_Reader   rd;
+	STREAM_Capture  cap;
+	Uint32          framesWanted;
+} PtyReader;
+
+static void *ptyReaderThread(void *arg)
+{
+	PtyReader    *pr = (PtyReader *)arg;
+	struct pollfd pfd;
+	Uint8         buf[256];
+	ssize_t       n;
+
+	pfd.fd     = pr->fd;
+	pfd.events = POLLIN;
+
+	while (pr->rd.frames < pr->framesWanted)
+	{
+		if (poll(&pfd, 1, PTY_WAIT_MSEC) <= 0)
+		{
+			break;
+		}
+
+		n = read(pr->fd, buf, sizeof(buf));
+		if (n <= 0)
+		{
+			break;
+		}
+		STREAM_readerFeed(&pr->rd, buf, (Uint32)n);
+	}
+
+	return (NULL);
+}
+
+static void ptySink(Uint8 byte, void *arg)
+{
+	int fd = *(int *)arg;
+
+	CHECK_EQ(write(fd, &byte, 1), 1);
+}
+
+static void test_ptyCapture(void)
+{
+	static PtyReader pr;
+	static Int16     block[2][TAP_FRAMES];
+	Uint32           counters[3] = { 7, 0x12345678UL, 0xFFFFFFFFUL };
+	char             wavPath[] = "/tmp/test_uart_stream_wav_XXXXXX";
+	char             csvPath[] = "/tmp/test_uart_stream_csv_XXXXXX";
+	char             textBuf[256];
+	char             line[128];
+	Uint8            hdr[44];
+	Int16            samples[2 * TAP_FRAMES];
+	FILE            *wav;
+	FILE            *csv;
+	FILE            *text;
+	pthread_t        thread;
+	int              master;
+	Uint16           i;
+
+	C55x_timebaseInit();
+	HOST_uartHold(FALSE);
+
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+	CHECK(master >= 0);
+	CHECK_EQ(grantpt(master), 0);
+	CHECK_EQ(unlockpt(master), 0);
+
+	pr.fd = STREAM_readerOpenTty(ptsname(master), 115200);
+	CHECK(pr.fd >= 0);
+
+	wav  = fdopen(mkstemp(wavPath), "w+b");
+	csv  = fdopen(mkstemp(csvPath), "w+");
+	text = fmemopen(textBuf, sizeof(textBuf), "w");
+	CHECK((wav != NULL) && (csv != NULL) && (text != NULL));
+
+	/* Two audio blocks, a torn one, text and the counters */
+	pr.framesWanted = 4;
+	STREAM_captureInit(&pr.cap, wav, csv, text, 48000);
+	STREAM_readerInit(&pr.rd, STREAM_captureFrame, &pr.cap);
+	CHECK_EQ(pthread_create(&thread, NULL, ptyReaderThread, &pr), 0);
+
+	HOST_uartSetSink(ptySink, &master);
+	CHECK_EQ(STREAM_open(0), TEST_PASS);
+	STREAM_tapSelect(STREAM_TAP_DMA_LEFT, 2, 1);
+
+	for (i = 0; i < TAP_FRAMES; i++)
+	{
+		block[0][i] = (Int16)(i * 300 - 9000);
+		block[1][i] = (Int16)(-i * 211);
+	}
+
+	STREAM_tap(STREAM_TAP_DMA_LEFT, block[0], TAP_FRAMES, 1);
+	waitSent();
+
+	/* Reused while the line is held: sent torn, the reader drops it */
+	HOST_uartHold(TRUE);
+	STREAM_tap(STREAM_TAP_DMA_LEFT, block[1], TAP_FRAMES, 1);
+	STREAM_release(block[1]);
+	HOST_uartHold(FALSE);
+	waitSent();
+
+	STREAM_tap(STREAM_TAP_DMA_LEFT, block[1], TAP_FRAMES, 1);
+	waitSent();
+
+	C55x_msgWrite("run done\n\r");
+	waitSent();
+	CHECK(STREAM_sendCounters(counters, 3));
+	waitSent();
+	STREAM_close();
+	HOST_uartSetSink(NULL, NULL);
+
+	pthread_join(thread, NULL);
+	STREAM_captureEnd(&pr.cap);
+
+	CHECK_EQ(pr.rd.frames, 4);
+	CHECK_EQ(pr.rd.badCrc, 1);
+	CHECK_EQ(pr.rd.lost, 1);
+	CHECK_EQ(pr.cap.audioFrames, 2);
+	CHECK_EQ(pr.cap.blocksMissed, 1);
+	CHECK_EQ(pr.cap.samples, TAP_FRAMES);
+	CHECK_EQ(pr.cap.counterFrames, 1);
+
+	/* WAV at the decimated rate, every other frame of each block */
+	rewind(wav);
+	CHECK_EQ(fread(hdr, 1, sizeof(hdr), wav), sizeof(hdr));
+	CHECK(memcmp(hdr, "RIFF", 4) == 0);
+	CHECK(memcmp(&hdr[8], "WAVEfmt ", 8) == 0);
+	CHECK_EQ(hdr[22], 1);
+	CHECK_EQ(hdr[24] | (hdr[25] << 8) | (hdr[26] << 16), 24000);
+	CHECK_EQ(hdr[40] | (hdr[41] << 8), 2 * TAP_FRAMES);
+	CHECK_EQ(fread(samples, 2, 2 * TAP_FRAMES, wav), TAP_FRAMES);
+	for (i = 0; i < TAP_FRAMES / 2; i++)
+	{
+		CHECK_EQ(samples[i], block[0][2 * i]);
+		CHECK_EQ(samples[TAP_FRAMES / 2 + i], block[1][2 * i]);
+	}
+
+	rewind(csv);
+	CHECK(fgets(line, sizeof(line), csv) != NULL);
+	CHECK(strcmp(line, "4,7,305419896,4294967295\n") == 0);
+
+	fclose(text);
+	CHECK(strcmp(textBuf, "run done\n") == 0);
+
+	fclose(wav);
+	fclose(csv);
+	unlink(wavPath);
+	unlink(csvPath);
+	close(pr.fd);
+	close(master);
+}
+
+int main(void)
+{
+	TEST_RUN(test_consoleInFrames);
+	TEST_RUN(test_textRingFull);
+	TEST_RUN(test_ptyCapture);
+
+	return (testFailures);
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file test_wav_stream.c
+*
+*   \brief WAV player against files built in memory: header lengths that
+*          split stereo frames across buffers, read-ahead underruns and
+*          malformed headers.
+*
+*/
+
+#include "test.h"
+#include "wav_stream.h"
+
+TEST_MAIN_DATA;
+
+#define MAX_FILE_BYTES  (64 * 1024)
+#define FILL_FRAMES     (48)
+
+typedef struct
+{
+	Uint8   data[MAX_FILE_BYTES];
+	Uint32  length;
+	Uint32  reads;
+} MemFile;
+
+static MemFile memFile;
+
+static Int16 memRead(void *ctx, Uint32 sector, Uint16 count, Uint16 *buf)
+{
+	MemFile *file = (MemFile *)ctx;
+	Uint32   byte = sector * WAV_SECTOR_BYTES;
+	Uint32   i;
+
+	file->reads++;
+	for (i = 0; i < (Uint32)count * WAV_SECTOR_WORDS; i++, byte += 2)
+	{
+		buf[i] = (byte + 1 < file->length) ?
+		         (file->data[byte] | (file->data[byte + 1] << 8)) : 0;
+	}
+
+	return (0);
+}
+
+static const WAV_BlockDevice memDev = { memRead, &memFile };
+
+static void put16(Uint16 v)
+{
+	memFile.data[memFile.length++] = (Uint8)v;
+	memFile.data[memFile.length++] = (Uint8)(v >> 8);
+}
+
+static void put32(Uint32 v)
+{
+	put16((Uint16)v);
+	put16((Uint16)(v >> 16));
+}
+
+static void putTag(const char *tag)
+{
+	memcpy(&memFile.data[memFile.length], tag, 4);
+	memFile.length += 4;
+}
+
+/* Sample value of frame 'n', channel 'c': both differ everywhere */
+static Int16 sampleOf(Uint32 n, Uint16 c)
+{
+	return ((Int16)(c ? (-(Int32)n - 1) : (Int32)n));
+}
+
+/* RIFF/WAVE with a 'fmt ' chunk of 'fmtLen' bytes, an optional JUNK chunk
+ * with 'junkLen' bytes and 'frames' frames of data */
+static void buildWav(Uint16 channels, Uint16 fmtLen, Uint32 junkLen,
+                     Uint32 frames)
+{
+	Uint32 n;
+	Uint16 c;
+
+	memset(&memFile, 0, sizeof(memFile));
+	putTag("RIFF");
+	put32(0);
+	putTag("WAVE");
+
+	putTag("fmt ");
+	put32(fmtLen);
+	put16(1);
+	put16(channels);
+	put32(48000);
+	put32(48000 * 2 * channels);
+	put16(2 * channels);
+	put16(16);
+	for (n = 16; n < fmtLen; n += 2)
+	{
+		put16(0);
+	}
+
+	if (junkLen != 0)
+	{
+		putTag("JUNK");
+		put32(junkLen);
+		memFile.length += (junkLen + 1) & ~1UL;
+	}
+
+	putTag("data");
+	put32(frames * channels * 2);
+	for (n = 0; n < frames; n++)
+	{
+		for (c = 0; c < channels; c++)
+		{
+			put16((Uint16)sampleOf(n, c));
+		}
+	}
+}
+
+/* Plays the whole file, servicing the read-ahead every 'servicePeriod'
+ * fills, and counts frames that come out wrong */
+static Uint32 playAll(Uint16 channels, Uint32 frames, Uint16 servicePeriod)
+{
+	Int16    left[FILL_FRAMES];
+	Int16    right[FILL_FRAMES];
+	WAV_Info info;
+	Uint32   expect = 0;
+	Uint32   errors = 0;
+	Uint32   fills = 0;
+	Uint16   i;
+
+	CHECK_EQ(WAV_open(&memDev, 0, 3, &info), TEST_PASS);
+	CHECK_EQ(info.channels, channels);
+	CHECK_EQ(info.dataFrames, frames);
+
+	while (!WAV_done() && (fills < 100000))
+	{
+		if ((fills++ % servicePeriod) == 0)
+		{
+			WAV_service();
+		}
+		WAV_fill(left, right, FILL_FRAMES, NULL);
+
+		for (i = 0; i < FILL_FRAMES; i++)
+		{
+			/* Underrun silence; only frame 0 of a mono file is all zero */
+			if ((left[i] == 0) && (right[i] == 0) && (expect != 0))
+			{
+				continue;
+			}
+			if (expect >= frames)
+			{
+				break;
+			}
+			errors += (left[i] != sampleOf(expect, 0)) ||
+			          (right[i] != sampleOf(expect, channels - 1));
+			expect++;
+		}
+	}
+
+	CHECK_EQ(expect, frames);
+
+	return (errors);
+}
+
+/* An 18 byte fmt chunk puts the samples at an odd word: frames straddle
+ * every buffer boundary */
+static void test_oddHeaderStereo(void)
+{
+	buildWav(2, 18, 0, 5000);
+	CHECK_EQ(playAll(2, 5000, 1), 0);
+}
+
+static void test_evenHeaderStereo(void)
+{
+	buildWav(2, 16, 0, 5000);
+	CHECK_EQ(playAll(2, 5000, 1), 0);
+}
+
+static void test_mono(void)
+{
+	buildWav(1, 18, 0, 7000);
+	CHECK_EQ(playAll(1, 7000, 1), 0);
+}
+
+/* A slow reader: frames are held back, not split or skipped */
+static void test_underrunKeepsFrames(void)
+{
+	WAV_Stats stats;
+
+	buildWav(2, 18, 0, 9000);
+	CHECK_EQ(playAll(2, 9000, 50), 0);
+	WAV_getStats(&stats);
+	CHECK(stats.underruns > 0);
+}
+
+/* Header taking the whole first buffer */
+static void test_headerFillsBuffer(void)
+{
+	/* RIFF 12 + fmt 24 + JUNK 8 + body + data 8 = 2048 bytes */
+	buildWav(2, 16, WAV_BUF_WORDS * 2 - 12 - 24 - 8 - 8, 3000);
+	CHECK_EQ(playAll(2, 3000, 1), 0);
+}
+
+static void test_malformedHeaders(void)
+{
+	WAV_Info info;
+
+	/* fmt chunk header in the last words of the buffer, its fields past
+	 * the end */
+	buildWav(2, 16, WAV_BUF_WORDS * 2 - 12 - 8 - 8 - 24, 100);
+	memcpy(&memFile.data[12], "JUNK", 4);
+	memcpy(&memFile.data[WAV_BUF_WORDS * 2 - 8], "fmt ", 4);
+	memFile.data[WAV_BUF_WORDS * 2 - 4] = 16;
+	CHECK_EQ(WAV_open(&memDev, 0, 3, &info), TEST_FAIL);
+
+	/* fmt chunk too short for the fields read */
+	buildWav(2, 16, 0, 100);
+	memFile.data[16] = 14;
+	CHECK_EQ(WAV_open(&memDev, 0, 3, &info), TEST_FAIL);
+
+	/* A chunk length that would wrap the 16-bit word position */
+	buildWav(2, 16, 0, 100);
+	memcpy(&memFile.data[12], "JUNK", 4);
+	memFile.data[16] = 0xF0;
+	memFile.data[17] = 0xFF;
+	memFile.data[18] = 0x01;
+	memFile.data[19] = 0x00;
+	CHECK_EQ(WAV_open(&memDev, 0, 3, &info), TEST_FAIL);
+
+	/* No data chunk */
+	buildWav(2, 16, 0, 0);
+	memcpy(&memFile.data[36], "list", 4);
+	CHECK_EQ(WAV_open(&memDev, 0, 3, &info), TEST_FAIL);
+}
+
+int main(void)
+{
+	TEST_RUN(test_oddHeaderStereo);
+	TEST_RUN(test_evenHeaderStereo);
+	TEST_RUN(test_mono);
+	TEST_RUN(test_underrunKeepsFrames);
+	TEST_RUN(test_headerFillsBuffer);
+	TEST_RUN(test_malformedHeaders);
+
+	return (testFailures);
+}
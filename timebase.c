@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file timebase.c
+*
+*   \brief Free running cycle timebase on GPT0 with delay and deadline
+*          helpers.
+*
+*   GPT0 counts down from 0xFFFFFFFF with auto-reload at half the system
+*   clock. C55x_nowCycles() turns the count into system clock cycles that
+*   wrap every 2^32 cycles (43 s at 100 MHz), so intervals and deadlines
+*   are computed with unsigned differences and must stay below half of
+*   that.
+*
+*   Conversions to and from microseconds use the clock set at init time
+*   from C55x_getSysClk(), or given to C55x_timebaseSetClock() when the
+*   PLL is reprogrammed. C55x_nowUsec() folds the time elapsed at the old
+*   clock in on every such change, so it stays right across clock changes
+*   as long as it is read at least once per cycle count wrap.
+*
+*   Off target the cycle count comes from clock_gettime(), scaled to the
+*   same clock, so code timed with the helpers behaves alike on a host.
+*
+*/
+
+#include "timebase.h"
+
+#ifndef __TMS320C55X__
+#include <time.h>
+#endif
+
+static Uint32       tbClkKhz;
+
+/* C55x_nowUsec() origin, moved on every clock change */
+static Uint32       tbBaseUsec;
+static Uint32       tbBaseCycles;
+
+#ifdef __TMS320C55X__
+
+static CSL_GptObj   gptObj;
+static CSL_Handle   hGpt;
+
+/**
+ *
+ * \brief Starts GPT0 free running and scales the timebase from the
+ *        current system clock
+ *
+ */
+void C55x_timebaseInit(void)
+{
+	CSL_Config  hwConfig;
+	CSL_Status  status;
+
+	if (hGpt == NULL)
+	{
+		hGpt = GPT_open(GPT_0, &gptObj, &status);
+		if ((hGpt == NULL) || (status != CSL_SOK))
+		{
+			hGpt = NULL;
+			return;
+		}
+
+		GPT_reset(hGpt);
+
+		hwConfig.autoLoad    = GPT_AUTO_ENABLE;
+		hwConfig.ctrlTim     = GPT_TIMER_ENABLE;
+		hwConfig.preScaleDiv = GPT_PRE_SC_DIV_0;
+		hwConfig.prdLow      = 0xFFFF;
+		hwConfig.prdHigh     = 0xFFFF;
+
+		GPT_config(hGpt, &hwConfig);
+		GPT_start(hGpt);
+	}
+
+	C55x_timebaseSetClock(C55x_getSysClk());
+}
+
+/**
+ *
+ * \brief Tells whether the timer runs, before that delays fall back to
+ *        instruction loops
+ *
+ */
+Bool C55x_timebaseRunning(void)
+{
+	return (((hGpt != NULL) && (tbClkKhz != 0)) ? TRUE : FALSE);
+}
+
+/**
+ *
+ * \brief Returns the free running system clock cycle count
+ *
+ */
+Uint32 C55x_nowCycles(void)
+{
+	Uint32 count = 0xFFFFFFFF;
+
+	if (hGpt != NULL)
+	{
+		GPT_getCnt(hGpt, &count);
+	}
+
+	/* The timer counts down */
+	return ((0xFFFFFFFF - count) * C55X_TIMEBASE_PRESCALE);
+}
+
+#else
+
+void C55x_timebaseInit(void)
+{
+	C55x_timebaseSetClock(C55x_getSysClk());
+}
+
+Bool C55x_timebaseRunning(void)
+{
+	return ((tbClkKhz != 0) ? TRUE : FALSE);
+}
+
+Uint32 C55x_nowCycles(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((Uint32)ts.tv_sec * tbClkKhz * 1000 +
+	        (Uint32)(((unsigned long long)ts.tv_nsec * tbClkKhz) / 1000000));
+}
+
+#endif /* __TMS320C55X__ */
+
+/**
+ *
+ * \brief Sets the system clock the cycle/time conversions are based on
+ *
+ * \param  sysClkKhz - system clock in kHz
+ *
+ */
+void C55x_timebaseSetClock(Uint32 sysClkKhz)
+{
+	Bool oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+	tbBaseUsec   = C55x_nowUsec();
+	tbClkKhz     = sysClkKhz;
+	tbBaseCycles = C55x_nowCycles();
+	IRQ_globalRestore(oldIntm);
+}
+
+/**
+ *
+ * \brief Returns the microseconds since the timebase was started. Has to
+ *        be called at least once per cycle count wrap.
+ *
+ */
+Uint32 C55x_nowUsec(void)
+{
+	Uint32 now;
+	Uint32 msec;
+	Uint32 usec;
+	Bool   oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+	now = C55x_nowCycles();
+
+	/* Fold whole milliseconds into the origin, exactly tbClkKhz cycles
+	 * each, so the interval left never reaches the wrap */
+	if (tbClkKhz != 0)
+	{
+		msec          = (now - tbBaseCycles) / tbClkKhz;
+		tbBaseUsec   += msec * 1000;
+		tbBaseCycles += msec * tbClkKhz;
+	}
+
+	usec = tbBaseUsec + C55x_cyclesToUsec(now - tbBaseCycles);
+	IRQ_globalRestore(oldIntm);
+
+	return (usec);
+}
+
+/**
+ *
+ * \brief Returns the system clock in kHz the timebase is scaled to
+ *
+ */
+Uint32 C55x_timebaseGetClock(void)
+{
+	return (tbClkKhz);
+}
+
+/**
+ *
+ * \brief Converts microseconds to system clock cycles
+ *
+ */
+Uint32 C55x_usecToCycles(Uint32 usec)
+{
+	return ((usec / 1000) * tbClkKhz + ((usec % 1000) * tbClkKhz) / 1000);
+}
+
+/**
+ *
+ * \brief Converts system clock cycles to microseconds
+ *
+ */
+Uint32 C55x_cyclesToUsec(Uint32 cycles)
+{
+	if (tbClkKhz == 0)
+	{
+		return (0);
+	}
+
+	return ((cycles / tbClkKhz) * 1000 +
+	        ((cycles % tbClkKhz) * 1000) / tbClkKhz);
+}
+
+/**
+ *
+ * \brief Returns the cycle count 'usec' microseconds from now
+ *
+ */
+Uint32 C55x_deadline(Uint32 usec)
+{
+	return (C55x_nowCycles() + C55x_usecToCycles(usec));
+}
+
+/**
+ *
+ * \brief Tells whether a deadline from C55x_deadline() has passed
+ *
+ */
+Bool C55x_deadlinePassed(Uint32 deadline)
+{
+	return (((Int32)(C55x_nowCycles() - deadline) >= 0) ? TRUE : FALSE);
+}
+
+/**
+ *
+ * \brief Waits 'usec' microseconds, at most half the timebase wrap
+ *
+ * \param    usec - number of microseconds
+ *
+ * \return   void
+ */
+void C55x_delay_usec(Uint32 usec)
+{
+	Uint32 start;
+	Uint32 cycles;
+
+	cycles = C55x_usecToCycles(usec);
+	start  = C55x_nowCycles();
+
+	while ((C55x_nowCycles() - start) < cycles)
+	{
+		;
+	}
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file timebase.h
+*
+*   \brief Free running cycle timebase on GPT0 with delay and deadline
+*          helpers.
+*
+*/
+
+#ifndef _TIMEBASE_H_
+#define _TIMEBASE_H_
+
+#include "platform_internals.h"
+
+/* GPT_PRE_SC_DIV_0 clocks the timer at half the system clock */
+#define C55X_TIMEBASE_PRESCALE  (2)
+
+void   C55x_timebaseInit(void);
+void   C55x_timebaseSetClock(Uint32 sysClkKhz);
+Uint32 C55x_timebaseGetClock(void);
+Bool   C55x_timebaseRunning(void);
+Uint32 C55x_nowCycles(void);
+Uint32 C55x_nowUsec(void);
+Uint32 C55x_usecToCycles(Uint32 usec);
+Uint32 C55x_cyclesToUsec(Uint32 cycles);
+void   C55x_delay_usec(Uint32 usec);
+Uint32 C55x_deadline(Uint32 usec);
+Bool   C55x_deadlinePassed(Uint32 deadline);
+
+#endif /* _TIMEBASE_H_ */
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file adpcm_encode.c
+*
+*   \brief Encodes a WAV file into an ADPCM prompt for ADPCM_fill().
+*
+*       adpcm_encode <in.wav> <dir/name>
+*
+*   The input is 16-bit PCM, mono or stereo; stereo is mixed down to mono.
+*   <name>.c and <name>.h are written with the packed codes, the sample
+*   count, the sample rate and the encoder start state, ready to be passed
+*   to ADPCM_streamInit(). A name such as prompt_chime gives
+*   promptChimeCodes, promptChimeStart and PROMPT_CHIME_SAMPLES.
+*
+*/
+
+#include <ctype.h>
+
+#include "adpcm.h"
+
+#define CODES_PER_LINE  (8)
+#define NAME_LEN        (64)
+
+static Uint32 rd16(const Uint8 *p)
+{
+	return (p[0] | (p[1] << 8));
+}
+
+static Uint32 rd32(const Uint8 *p)
+{
+	return (p[0] | (p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24));
+}
+
+/* Returns the mono samples of a 16-bit PCM WAV, NULL if it is not one */
+static Int16 *wavLoad(const char *path, Uint32 *count, Uint32 *rate)
+{
+	FILE   *file;
+	Uint8   hdr[16];
+	Uint8   raw[4];
+	Uint32  size;
+	Uint16  channels = 0;
+	Int16  *samples  = NULL;
+	Uint32  i;
+
+	file = fopen(path, "rb");
+	if (file == NULL)
+	{
+		return (NULL);
+	}
+
+	if ((fread(hdr, 1, 12, file) != 12) ||
+	    memcmp(hdr, "RIFF", 4) || memcmp(&hdr[8], "WAVE", 4))
+	{
+		fclose(file);
+		return (NULL);
+	}
+
+	while (fread(hdr, 1, 8, file) == 8)
+	{
+		size = rd32(&hdr[4]);
+		if (!memcmp(hdr, "fmt ", 4) && (size >= 16))
+		{
+			if (fread(hdr, 1, 16, file) != 16)
+			{
+				break;
+			}
+			channels = (Uint16)rd16(&hdr[2]);
+			*rate    = rd32(&hdr[4]);
+			if ((rd16(&hdr[0]) != 1) || (rd16(&hdr[14]) != 16) ||
+			    (channels < 1) || (channels > 2))
+			{
+				break;
+			}
+			fseek(file, (size - 16 + 1) & ~1UL, SEEK_CUR);
+		}
+		else if (!memcmp(hdr, "data", 4) && (channels != 0))
+		{
+			*count  = size / (2 * channels);
+			samples = malloc(*count * sizeof(Int16) + 1);
+			for (i = 0; i < *count; i++)
+			{
+				if (fread(raw, 2, channels, file) != channels)
+				{
+					*count = i;
+					break;
+				}
+				samples[i] = (Int16)rd16(raw);
+				if (channels == 2)
+				{
+					samples[i] = (Int16)(((Int32)samples[i] +
+					                      (Int16)rd16(&raw[2])) >> 1);
+				}
+			}
+			break;
+		}
+		else
+		{
+			fseek(file, (size + 1) & ~1UL, SEEK_CUR);
+		}
+	}
+
+	fclose(file);
+
+	return (samples);
+}
+
+/* prompt_chime -> promptChime (upper == FALSE) or PROMPT_CHIME */
+static void makeSymbol(char *out, const char *name, Bool upper)
+{
+	Bool  cap = FALSE;
+	Uint16 len = 0;
+
+	for (; *name && (len < NAME_LEN - 1); name++)
+	{
+		if (*name == '_')
+		{
+			cap = TRUE;
+			if (!upper)
+			{
+				continue;
+			}
+		}
+		out[len++] = (char)((upper || cap) ? toupper((unsigned char)*name) :
+		                                     *name);
+		cap = FALSE;
+	}
+	out[len] = '\0';
+}
+
+static FILE *openOutput(const char *name, const char *ext)
+{
+	char  path[256];
+	FILE *file;
+
+	snprintf(path, sizeof(path), "%s.%s", name, ext);
+	file = fopen(path, "w");
+	if (file == NULL)
+	{
+		fprintf(stderr, "cannot write %s\n", path);
+	}
+
+	return (file);
+}
+
+int main(int argc, char **argv)
+{
+	const char  *name;
+	const char  *base;
+	char         symbol[NAME_LEN];
+	char         macro[NAME_LEN];
+	Int16       *samples;
+	Uint16      *codes;
+	Uint32       count = 0;
+	Uint32       rate  = 0;
+	Uint32       words;
+	Uint32       i;
+	ADPCM_State  state;
+	ADPCM_State  start;
+	FILE        *file;
+
+	if (argc != 3)
+	{
+		fprintf(stderr, "usage: adpcm_encode <in.wav> <dir/name>\n");
+		return (1);
+	}
+
+	name = argv[2];
+	base = strrchr(name, '/') ? (strrchr(name, '/') + 1) : name;
+	makeSymbol(symbol, base, FALSE);
+	makeSymbol(macro, base, TRUE);
+
+	samples = wavLoad(argv[1], &count, &rate);
+	if ((samples == NULL) || (count == 0))
+	{
+		fprintf(stderr, "%s: not a 16-bit PCM WAV\n", argv[1]);
+		return (1);
+	}
+
+	/* Start from the first sample so the prompt does not click in */
+	ADPCM_init(&start, samples[0], 0);
+	state = start;
+
+	words = ADPCM_WORDS(count);
+	codes = calloc(words, sizeof(Uint16));
+	for (i = 0; i < count; i += 0x8000)
+	{
+		ADPCM_encode(&state, &samples[i], codes, i,
+		             (Uint16)(((count - i) > 0x8000) ? 0x8000 : (count - i)));
+	}
+
+	file = openOutput(name, "h");
+	if (file == NULL)
+	{
+		return (1);
+	}
+	fprintf(file, "/* Generated by tools/adpcm_encode from %s, do not edit */\n\n",
+	        argv[1]);
+	fprintf(file, "#ifndef _%s_H_\n#define _%s_H_\n\n", macro, macro);
+	fprintf(file, "#include \"adpcm.h\"\n\n");
+	fprintf(file, "#define %s_SAMPLES (%luUL)\n", macro, (unsigned long)count);
+	fprintf(file, "#define %s_RATE    (%luUL)\n\n", macro, (unsigned long)rate);
+	fprintf(file, "extern const Uint16      %sCodes[ADPCM_WORDS(%s_SAMPLES)];\n",
+	        symbol, macro);
+	fprintf(file, "extern const ADPCM_State %sStart;\n\n", symbol);
+	fprintf(file, "#endif /* _%s_H_ */\n", macro);
+	fclose(file);
+
+	file = openOutput(name, "c");
+	if (file == NULL)
+	{
+		return (1);
+	}
+	fprintf(file, "/* Generated by tools/adpcm_encode from %s, do not edit */\n\n",
+	        argv[1]);
+	fprintf(file, "#include \"%s.h\"\n\n", base);
+	fprintf(file, "const ADPCM_State %sStart = { %d, %d };\n\n",
+	        symbol, start.predictor, start.index);
+	fprintf(file, "const Uint16 %sCodes[ADPCM_WORDS(%s_SAMPLES)] =\n{\n",
+	        symbol, macro);
+	for (i = 0; i < words; i++)
+	{
+		fprintf(file, "%s0x%04X%s", (i % CODES_PER_LINE) ? " " : "\t",
+		        codes[i], (i + 1 < words) ? "," : "");
+		if (((i + 1) % CODES_PER_LINE == 0) || (i + 1 == words))
+		{
+			fprintf(file, "\n");
+		}
+	}
+	fprintf(file, "};\n");
+	fclose(file);
+
+	printf("%s: %lu samples at %lu Hz, %lu words\n", argv[1],
+	       (unsigned long)count, (unsigned long)rate, (unsigned long)words);
+
+	free(codes);
+	free(samples);
+
+	return (0);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file blog_decode.c
+*
+*   \brief Decodes a console capture with binary log records.
+*
+*       blog_decode [capture]
+*
+*   Reads the capture, or stdin, and writes the console text with every
+*   record turned back into its line to stdout. The format table comes
+*   from the capture itself, as printed by BLOG_dumpFormats() before
+*   binary mode; the counts of records and of damaged ones go to stderr.
+*
+*/
+
+#include "blog_reader.h"
+
+static void lineOut(const char *line, void *arg)
+{
+	fprintf((FILE *)arg, "%s\n", line);
+}
+
+int main(int argc, char **argv)
+{
+	static BLOG_Reader rd;
+	FILE  *in = stdin;
+	Uint8  buf[4096];
+	size_t n;
+
+	if (argc > 2)
+	{
+		fprintf(stderr, "usage: blog_decode [capture]\n");
+		return (1);
+	}
+
+	if (argc == 2)
+	{
+		in = fopen(argv[1], "rb");
+		if (in == NULL)
+		{
+			fprintf(stderr, "cannot read %s\n", argv[1]);
+			return (1);
+		}
+	}
+
+	BLOG_readerInit(&rd, lineOut, stdout);
+
+	while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+	{
+		BLOG_readerFeed(&rd, buf, (Uint32)n);
+	}
+	BLOG_readerEnd(&rd);
+
+	fprintf(stderr, "%lu records, %lu damaged, %lu not in the table\n",
+	        (unsigned long)rd.records, (unsigned long)rd.badRecords,
+	        (unsigned long)rd.unknownIds);
+
+	BLOG_readerFree(&rd);
+	if (in != stdin)
+	{
+		fclose(in);
+	}
+
+	return ((rd.badRecords != 0) ? 2 : 0);
+}
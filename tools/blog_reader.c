@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file blog_reader.c
+*
+*   \brief Host reader of a console capture with binary log records.
+*
+*   Text goes through a line at a time. The lines BLOG_dumpFormats()
+*   prints build the format table:
+*
+*       BLOG formats <count>, timebase <clock> kHz
+*       BLOG <id> <nargs> <format>
+*
+*   A sync byte starts a record candidate; it is decoded only if its
+*   length and CRC-8 match, see bin_log.c. Otherwise the sync byte is
+*   dropped and the bytes after it are scanned again, so one lost or
+*   damaged byte costs one record, not the rest of the capture.
+*
+*   Records print as one line, the time since binary mode was entered
+*   first: microseconds once the table header gave the clock, cycles
+*   before that.
+*
+*/
+
+#include "blog_reader.h"
+
+static void BLOG_readerEmit(BLOG_Reader *rd, const char *line)
+{
+	if (rd->outFxn != NULL)
+	{
+		rd->outFxn(line, rd->arg);
+	}
+}
+
+/* Table lines are passed through as well */
+static void BLOG_readerLine(BLOG_Reader *rd)
+{
+	unsigned count;
+	unsigned long clk;
+	unsigned id;
+	unsigned nargs;
+	int      used = 0;
+	char    *fmt;
+
+	rd->line[rd->lineLen] = '\0';
+
+	if (sscanf(rd->line, "BLOG formats %u, timebase %lu kHz", &count,
+	           &clk) == 2)
+	{
+		rd->clkKhz = (Uint32)clk;
+	}
+	else if ((sscanf(rd->line, "BLOG %u %u %n", &id, &nargs, &used) == 2) &&
+	         (used != 0) && (id < BLOG_READER_MAX_FORMATS) &&
+	         (nargs <= BLOG_MAX_ARGS))
+	{
+		fmt = strdup(&rd->line[used]);
+		if (fmt != NULL)
+		{
+			free(rd->formats[id].fmt);
+			rd->formats[id].known = TRUE;
+			rd->formats[id].nargs = (Uint16)nargs;
+			rd->formats[id].fmt   = fmt;
+		}
+	}
+
+	BLOG_readerEmit(rd, rd->line);
+	rd->lineLen = 0;
+}
+
+static void BLOG_readerText(BLOG_Reader *rd, Uint8 c)
+{
+	if (c == '\n')
+	{
+		BLOG_readerLine(rd);
+	}
+	else if (c != '\r')
+	{
+		if (rd->lineLen == BLOG_READER_MAX_LINE - 1)
+		{
+			BLOG_readerLine(rd);
+		}
+		rd->line[rd->lineLen++] = (char)c;
+	}
+}
+
+/* Zig-zag LEB128; FALSE if it runs past 'end' or over 32 bits */
+static Bool BLOG_readerVarint(const Uint8 **p, const Uint8 *end, Uint32 *value)
+{
+	Uint32 v     = 0;
+	Uint16 shift = 0;
+
+	while (*p < end)
+	{
+		v |= (Uint32)(**p & 0x7F) << shift;
+		if ((*(*p)++ & 0x80) == 0)
+		{
+			*value = v;
+			return (TRUE);
+		}
+
+		shift += 7;
+		if (shift > 28)
+		{
+			return (FALSE);
+		}
+	}
+
+	return (FALSE);
+}
+
+/* printf of a table format with the 32-bit arguments of a record */
+static void BLOG_readerFormat(char *out, Uint32 size, const char *fmt,
+                              const Int32 *args, Uint16 nargs)
+{
+	char   spec[32];
+	Uint32 used = 0;
+	Uint16 n;
+	Uint16 next = 0;
+
+	while ((*fmt != '\0') && (used < size - 1))
+	{
+		if (*fmt != '%')
+		{
+			out[used++] = *fmt++;
+			continue;
+		}
+
+		/* Flags and width kept, the 'l' and 'h' size modifiers dropped */
+		n         = 0;
+		spec[n++] = *fmt++;
+		while ((*fmt != '\0') && (n < sizeof(spec) - 2) &&
+		       (strchr("diouxXc%", *fmt) == NULL))
+		{
+			if ((*fmt != 'l') && (*fmt != 'h'))
+			{
+				spec[n++] = *fmt;
+			}
+			fmt++;
+		}
+		if (*fmt == '\0')
+		{
+			break;
+		}
+		spec[n++] = *fmt;
+		spec[n]   = '\0';
+
+		if (*fmt == '%')
+		{
+			out[used++] = '%';
+		}
+		else
+		{
+			used += snprintf(&out[used], size - used, spec,
+			                 (next < nargs) ? args[next] : 0);
+			next++;
+			if (used >= size)
+			{
+				used = size - 1;
+			}
+		}
+		fmt++;
+	}
+
+	out[used] = '\0';
+}
+
+/* TRUE if 'rec' holds a whole record with a good CRC, which it prints */
+static Bool BLOG_readerRecord(BLOG_Reader *rd)
+{
+	const Uint8 *p   = &rd->rec[2];
+	const Uint8 *end = &rd->rec[rd->recLen - 1];
+	Uint32       delta;
+	Uint32       raw;
+	Int32        args[BLOG_MAX_ARGS];
+	Uint16       nargs = 0;
+	Uint8        id;
+	char         text[BLOG_READER_MAX_LINE];
+	char         line[BLOG_READER_MAX_LINE + 32];
+	Uint32       n;
+	Uint16       i;
+
+	if (BLOG_crc8(&rd->rec[1], rd->recLen - 2) != rd->rec[rd->recLen - 1])
+	{
+		return (FALSE);
+	}
+
+	id = *p++;
+	if (!BLOG_readerVarint(&p, end, &delta))
+	{
+		return (FALSE);
+	}
+
+	while ((p < end) && (nargs < BLOG_MAX_ARGS))
+	{
+		if (!BLOG_readerVarint(&p, end, &raw))
+		{
+			return (FALSE);
+		}
+		args[nargs++] = (Int32)((raw >> 1) ^ (0 - (raw & 1)));
+	}
+	if (p != end)
+	{
+		return (FALSE);
+	}
+
+	rd->records++;
+	rd->cycles += delta;
+
+	if (rd->formats[id].known && (rd->formats[id].nargs == nargs))
+	{
+		BLOG_readerFormat(text, sizeof(text), rd->formats[id].fmt, args,
+		                  nargs);
+	}
+	else
+	{
+		rd->unknownIds++;
+		n = snprintf(text, sizeof(text), "BLOG id %u:", id);
+		for (i = 0; (i < nargs) && (n < sizeof(text)); i++)
+		{
+			n += snprintf(&text[n], sizeof(text) - n, " %d", args[i]);
+		}
+	}
+
+	if (rd->clkKhz != 0)
+	{
+		snprintf(line, sizeof(line), "[%12llu us] %s",
+		         rd->cycles * 1000 / rd->clkKhz, text);
+	}
+	else
+	{
+		snprintf(line, sizeof(line), "[%12llu cy] %s", rd->cycles, text);
+	}
+	BLOG_readerEmit(rd, line);
+
+	return (TRUE);
+}
+
+/**
+ *
+ * \brief Sets up an empty reader
+ *
+ * \param  rd     - reader
+ * \param  outFxn - receives the output lines
+ * \param  arg    - argument for 'outFxn'
+ *
+ */
+void BLOG_readerInit(BLOG_Reader *rd, BLOG_ReaderOutFxn outFxn, void *arg)
+{
+	memset(rd, 0, sizeof(BLOG_Reader));
+	rd->outFxn = outFxn;
+	rd->arg    = arg;
+}
+
+/**
+ *
+ * \brief Reads a piece of capture, any split of it
+ *
+ * \param  rd     - reader
+ * \param  data   - captured bytes
+ * \param  length - number of bytes
+ *
+ */
+void BLOG_readerFeed(BLOG_Reader *rd, const Uint8 *data, Uint32 length)
+{
+	Uint8  retry[BLOG_MAX_RECORD];
+	Uint16 retryLen;
+	Uint8  c;
+
+	while (length-- > 0)
+	{
+		c = *data++;
+
+		if (rd->recLen == 0)
+		{
+			if (c == BLOG_SYNC)
+			{
+				rd->rec[rd->recLen++] = c;
+			}
+			else
+			{
+				BLOG_readerText(rd, c);
+			}
+			continue;
+		}
+
+		rd->rec[rd->recLen++] = c;
+
+		/* Length byte: a record body holds at least the id and a delta */
+		if ((rd->recLen == 2) &&
+		    ((c < 2) || (c + BLOG_RECORD_OVERHEAD > BLOG_MAX_RECORD)))
+		{
+			rd->badRecords++;
+			rd->recLen = 0;
+			BLOG_readerFeed(rd, &c, 1);
+			continue;
+		}
+
+		if ((rd->recLen < 2) ||
+		    (rd->recLen < rd->rec[1] + BLOG_RECORD_OVERHEAD))
+		{
+			continue;
+		}
+
+		if (!BLOG_readerRecord(rd))
+		{
+			/* Not a record start after all: scan on after the sync */
+			rd->badRecords++;
+			retryLen = rd->recLen - 1;
+			memcpy(retry, &rd->rec[1], retryLen);
+			rd->recLen = 0;
+			BLOG_readerFeed(rd, retry, retryLen);
+			continue;
+		}
+
+		rd->recLen = 0;
+	}
+}
+
+/**
+ *
+ * \brief Ends the capture: counts a partial record as bad and prints a
+ *        partial last line
+ *
+ * \param  rd - reader
+ *
+ */
+void BLOG_readerEnd(BLOG_Reader *rd)
+{
+	Uint8  retry[BLOG_MAX_RECORD];
+	Uint16 retryLen;
+
+	/* A record cut short: what follows its sync may still be text */
+	while (rd->recLen != 0)
+	{
+		rd->badRecords++;
+		retryLen = rd->recLen - 1;
+		memcpy(retry, &rd->rec[1], retryLen);
+		rd->recLen = 0;
+		BLOG_readerFeed(rd, retry, retryLen);
+	}
+
+	if (rd->lineLen != 0)
+	{
+		BLOG_readerLine(rd);
+	}
+}
+
+/**
+ *
+ * \brief Releases the format table
+ *
+ * \param  rd - reader
+ *
+ */
+void BLOG_readerFree(BLOG_Reader *rd)
+{
+	Uint16 i;
+
+	for (i = 0; i < BLOG_READER_MAX_FORMATS; i++)
+	{
+		free(rd->formats[i].fmt);
+		rd->formats[i].fmt   = NULL;
+		rd->formats[i].known = FALSE;
+	}
+}
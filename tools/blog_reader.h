@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file blog_reader.h
+*
+*   \brief Host reader of a console capture with binary log records.
+*
+*/
+
+#ifndef _BLOG_READER_H_
+#define _BLOG_READER_H_
+
+#include "bin_log.h"
+
+#define BLOG_READER_MAX_FORMATS (256)
+#define BLOG_READER_MAX_LINE    (512)
+
+/* Receives one line of output, without the line end */
+typedef void (*BLOG_ReaderOutFxn)(const char *line, void *arg);
+
+typedef struct
+{
+	Bool    known;
+	Uint16  nargs;
+	char   *fmt;
+} BLOG_ReaderFormat;
+
+typedef struct
+{
+	BLOG_ReaderFormat   formats[BLOG_READER_MAX_FORMATS];
+	Uint32              clkKhz;         /* 0 until the table header      */
+	unsigned long long  cycles;         /* sum of the record deltas      */
+
+	char                line[BLOG_READER_MAX_LINE];
+	Uint16              lineLen;
+
+	Uint8               rec[BLOG_MAX_RECORD];
+	Uint16              recLen;
+
+	Uint32              records;        /* records decoded               */
+	Uint32              badRecords;     /* sync bytes that were no record */
+	Uint32              unknownIds;     /* records missing from the table */
+
+	BLOG_ReaderOutFxn   outFxn;
+	void               *arg;
+} BLOG_Reader;
+
+void BLOG_readerInit(BLOG_Reader *rd, BLOG_ReaderOutFxn outFxn, void *arg);
+void BLOG_readerFeed(BLOG_Reader *rd, const Uint8 *data, Uint32 length);
+void BLOG_readerEnd(BLOG_Reader *rd);
+void BLOG_readerFree(BLOG_Reader *rd);
+
+#endif /* _BLOG_READER_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file gen_rate_table.c
+*
+*   \brief Prints the audio_rate.c sample rate table.
+*
+*       gen_rate_table [fs ...]
+*
+*   Without arguments the rates audio_rate.c supports are generated. The
+*   exit status is non-zero if any rate has no valid setting.
+*
+*/
+
+#include "rate_gen.h"
+
+static const Uint32 defaultRates[] =
+	{ 8000, 16000, 22050, 32000, 44100, 48000, 96000 };
+
+int main(int argc, char **argv)
+{
+	AUDIO_RateConfig cfg;
+	Uint32           fs;
+	int              count;
+	int              i;
+	int              failed = 0;
+
+	count = (argc > 1) ? (argc - 1) :
+	        (int)(sizeof(defaultRates) / sizeof(defaultRates[0]));
+
+	printf("\t/*   fs    P  R  J     D  NDAC MDAC DOSR  NADC MADC AOSR  BCLK */\n");
+	for (i = 0; i < count; i++)
+	{
+		fs = (argc > 1) ? (Uint32)strtoul(argv[i + 1], NULL, 10) :
+		                  defaultRates[i];
+
+		if (RATE_generate(fs, &cfg) != TEST_PASS)
+		{
+			fprintf(stderr, "no valid clock setting for %lu Hz\n",
+			        (unsigned long)fs);
+			failed = 1;
+			continue;
+		}
+
+		printf("\t{ %5lu, %3u, %u, %u, %4u, %2u, %3u, %4u, %3u, %3u, %4u, %3u }%s\n",
+		       (unsigned long)cfg.fs, cfg.pllP, cfg.pllR, cfg.pllJ, cfg.pllD,
+		       cfg.ndac, cfg.mdac, cfg.dosr, cfg.nadc, cfg.madc, cfg.aosr,
+		       cfg.bclkN, (i + 1 < count) ? "," : "");
+	}
+
+	return (failed);
+}
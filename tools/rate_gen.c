@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file rate_gen.c
+*
+*   \brief Host generator of the AIC3206 sample rate table.
+*
+*   The PLL runs at the datasheet's setting for the rate family (86.016 MHz
+*   for multiples of 8 kHz, 90.3168 MHz for multiples of 11.025 kHz from a
+*   12 MHz MCLK), so switching within a family never re-locks it. The
+*   dividers are then picked in a fixed order:
+*
+*   - DOSR: the largest power of two within the DOSR * fs limit
+*   - NDAC: the smallest that keeps DAC_CLK and DAC_MOD_CLK in range
+*   - AOSR: the largest power of two up to 128 within the same limit
+*   - NADC: the smallest that keeps ADC_CLK at or below 256 x the family
+*           base rate, the classic codec master clock
+*   - BCLK N: the largest that still gives BCLK >= 112 fs
+*
+*   Every result is validated with audio_check_rate_config(), the check
+*   the target runs at start-up.
+*
+*/
+
+#include "rate_gen.h"
+
+/* BCLK target, as in the original 48 kHz bring-up */
+#define RATE_GEN_BCLK_PER_FS    (112)
+#define RATE_GEN_MAX_AOSR       (128)
+
+typedef struct
+{
+	Uint32  baseFs;
+	Uint16  pllP;
+	Uint16  pllR;
+	Uint16  pllJ;
+	Uint16  pllD;
+} RATE_Family;
+
+static const RATE_Family rateFamilies[] =
+{
+	{ 48000, 1, 1, 7, 1680 },
+	{ 44100, 1, 1, 7, 5264 }
+};
+
+#define RATE_NUM_FAMILIES   (sizeof(rateFamilies) / sizeof(rateFamilies[0]))
+
+/* Largest power of two up to 'max' dividing 'k' with osr * fs in range */
+static Uint16 RATE_pickOsr(Uint32 k, Uint32 fs, Uint16 max)
+{
+	Uint16 osr;
+
+	for (osr = max; osr >= 1; osr >>= 1)
+	{
+		if (((k % osr) == 0) &&
+		    (((Uint32)osr * fs) <= AUDIO_RATE_DOSR_FS_MAX_HZ))
+		{
+			return (osr);
+		}
+	}
+
+	return (0);
+}
+
+/* Smallest N dividing 'k' with clk / N <= maxClk and a legal M = k / N */
+static Uint16 RATE_pickN(Uint32 pllClk, Uint32 k, Uint32 maxClk)
+{
+	Uint16 n;
+
+	for (n = 1; n <= 128; n++)
+	{
+		if (((k % n) == 0) && ((k / n) <= 128) &&
+		    ((pllClk / n) <= maxClk) &&
+		    ((pllClk / n / (k / n)) <= AUDIO_RATE_MOD_CLK_MAX_HZ))
+		{
+			return (n);
+		}
+	}
+
+	return (0);
+}
+
+/**
+ *
+ * \brief Computes the table entry for 'fs'
+ *
+ * \param  fs  - sample rate in Hz
+ * \param  cfg - filled in on success
+ *
+ * \return
+ * \n      TEST_PASS  - 'cfg' is a valid entry
+ * \n      TEST_FAIL  - no family can produce 'fs'
+ *
+ */
+TEST_STATUS RATE_generate(Uint32 fs, AUDIO_RateConfig *cfg)
+{
+	const RATE_Family *family;
+	Uint32 pllIn;
+	Uint32 pllClk;
+	Uint32 k;
+	Uint16 f;
+
+	for (f = 0; f < RATE_NUM_FAMILIES; f++)
+	{
+		family = &rateFamilies[f];
+		pllIn  = AUDIO_RATE_MCLK_HZ / family->pllP;
+		pllClk = (pllIn * family->pllR * family->pllJ) +
+		         ((pllIn / 10000) * family->pllR * family->pllD);
+		if ((fs == 0) || ((pllClk % fs) != 0))
+		{
+			continue;
+		}
+		k = pllClk / fs;
+
+		memset(cfg, 0, sizeof(*cfg));
+		cfg->fs   = fs;
+		cfg->pllP = family->pllP;
+		cfg->pllR = family->pllR;
+		cfg->pllJ = family->pllJ;
+		cfg->pllD = family->pllD;
+
+		cfg->dosr = RATE_pickOsr(k, fs, 1024);
+		if (cfg->dosr == 0)
+		{
+			continue;
+		}
+		cfg->ndac = RATE_pickN(pllClk, k / cfg->dosr,
+		                       AUDIO_RATE_CODEC_CLK_MAX_HZ);
+		if (cfg->ndac == 0)
+		{
+			continue;
+		}
+		cfg->mdac = (Uint16)(k / cfg->dosr / cfg->ndac);
+
+		cfg->aosr = RATE_pickOsr(k, fs, RATE_GEN_MAX_AOSR);
+		if (cfg->aosr == 0)
+		{
+			continue;
+		}
+		cfg->nadc = RATE_pickN(pllClk, k / cfg->aosr, 256 * family->baseFs);
+		if (cfg->nadc == 0)
+		{
+			continue;
+		}
+		cfg->madc = (Uint16)(k / cfg->aosr / cfg->nadc);
+
+		for (cfg->bclkN = 128; cfg->bclkN > 1; cfg->bclkN--)
+		{
+			if ((pllClk / cfg->ndac / cfg->bclkN) >=
+			    (RATE_GEN_BCLK_PER_FS * fs))
+			{
+				break;
+			}
+		}
+
+		if (audio_check_rate_config(cfg) == TEST_PASS)
+		{
+			return (TEST_PASS);
+		}
+	}
+
+	return (TEST_FAIL);
+}
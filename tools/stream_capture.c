@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file stream_capture.c
+*
+*   \brief Captures the UART stream to a WAV file and a CSV file.
+*
+*       stream_capture [-b baud] [-r rate] [-n frames] <device> <out.wav>
+*                      [counters.csv]
+*
+*   <device> is the serial line, or a file holding a raw capture. The
+*   samples of the first tap point seen go to <out.wav> at 'rate' (48000
+*   by default) divided by the tap decimation, the counters frames to
+*   <counters.csv> and the console text to stdout. The capture ends at the
+*   end of the input, after 'frames' good frames, or on Ctrl-C; the frame
+*   counts go to stderr.
+*
+*   -b sets the line rate when termios has a constant for it. Other rates,
+*   such as STREAM_DEFAULT_BAUD, have to be set up on the adapter first.
+*
+*/
+
+#include "stream_reader.h"
+#include <signal.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t stopped;
+
+static void onSignal(int sig)
+{
+	stopped = 1;
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: stream_capture [-b baud] [-r rate] [-n frames] "
+	                "<device> <out.wav> [counters.csv]\n");
+}
+
+int main(int argc, char **argv)
+{
+	static STREAM_Reader rd;
+	STREAM_Capture cap;
+	Uint32  baud   = 0;
+	Uint32  rate   = 48000;
+	Uint32  frames = 0;
+	FILE   *wav;
+	FILE   *csv    = NULL;
+	Uint8   buf[4096];
+	ssize_t n;
+	int     fd;
+	int     opt;
+
+	while ((opt = getopt(argc, argv, "b:r:n:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'b':
+				baud = strtoul(optarg, NULL, 10);
+				break;
+			case 'r':
+				rate = strtoul(optarg, NULL, 10);
+				break;
+			case 'n':
+				frames = strtoul(optarg, NULL, 10);
+				break;
+			default:
+				usage();
+				return (1);
+		}
+	}
+
+	if ((argc - optind < 2) || (argc - optind > 3) || (rate == 0))
+	{
+		usage();
+		return (1);
+	}
+
+	fd = STREAM_readerOpenTty(argv[optind], baud);
+	if (fd < 0)
+	{
+		fprintf(stderr, "cannot open %s\n", argv[optind]);
+		return (1);
+	}
+
+	wav = fopen(argv[optind + 1], "wb");
+	if (wav == NULL)
+	{
+		fprintf(stderr, "cannot write %s\n", argv[optind + 1]);
+		return (1);
+	}
+
+	if (argc - optind == 3)
+	{
+		csv = fopen(argv[optind + 2], "w");
+		if (csv == NULL)
+		{
+			fprintf(stderr, "cannot write %s\n", argv[optind + 2]);
+			return (1);
+		}
+	}
+
+	signal(SIGINT, onSignal);
+
+	STREAM_captureInit(&cap, wav, csv, stdout, rate);
+	STREAM_readerInit(&rd, STREAM_captureFrame, &cap);
+
+	while (!stopped && ((frames == 0) || (rd.frames < frames)))
+	{
+		n = read(fd, buf, sizeof(buf));
+		if (n <= 0)
+		{
+			break;
+		}
+		STREAM_readerFeed(&rd, buf, (Uint32)n);
+	}
+
+	STREAM_captureEnd(&cap);
+
+	fprintf(stderr, "%lu frames, %lu bad CRC, %lu lost; %lu samples in "
+	        "%lu audio frames, %lu blocks missed, %lu counters frames\n",
+	        (unsigned long)rd.frames, (unsigned long)rd.badCrc,
+	        (unsigned long)rd.lost, (unsigned long)cap.samples,
+	        (unsigned long)cap.audioFrames, (unsigned long)cap.blocksMissed,
+	        (unsigned long)cap.counterFrames);
+
+	fclose(wav);
+	if (csv != NULL)
+	{
+		fclose(csv);
+	}
+	close(fd);
+
+	return (0);
+}
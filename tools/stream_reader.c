@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file stream_reader.c
+*
+*   \brief Host reader of the UART stream: frame decoder, serial line
+*          set up and WAV / CSV capture.
+*
+*   The decoder looks for the two sync bytes and takes a frame only if
+*   its CRC-16 matches, see uart_stream.c. A torn or damaged frame is
+*   counted and the bytes after its first sync byte are scanned again, so
+*   the next good frame is found wherever it starts. Sequence number gaps
+*   count the frames lost on the way.
+*
+*   The capture writes the samples of one tap point to a 16-bit PCM WAV
+*   file, whose sizes are filled in at the end, the counters frames to a
+*   CSV file, one line each, and the console text to a stream of its own.
+*
+*/
+
+#include "stream_reader.h"
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define WAV_HDR_LEN     (44)
+
+static Uint32 rd16(const Uint8 *p)
+{
+	return (p[0] | (p[1] << 8));
+}
+
+static Uint32 rd32(const Uint8 *p)
+{
+	return (p[0] | (p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24));
+}
+
+static void wr16(Uint8 *p, Uint32 v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+}
+
+static void wr32(Uint8 *p, Uint32 v)
+{
+	wr16(p, v & 0xFFFF);
+	wr16(p + 2, v >> 16);
+}
+
+static void STREAM_readerDrop(STREAM_Reader *rd, Uint32 count)
+{
+	memmove(rd->buf, &rd->buf[count], rd->len - count);
+	rd->len -= count;
+}
+
+/* Takes every whole frame off the front of the buffer */
+static void STREAM_readerParse(STREAM_Reader *rd)
+{
+	STREAM_ReaderFrame frame;
+	Uint32             length;
+
+	while (rd->len > 0)
+	{
+		if ((rd->buf[0] != STREAM_SYNC0) ||
+		    ((rd->len >= 2) && (rd->buf[1] != STREAM_SYNC1)))
+		{
+			rd->junkBytes++;
+			STREAM_readerDrop(rd, 1);
+			continue;
+		}
+
+		if (rd->len < 6)
+		{
+			return;
+		}
+
+		length = rd16(&rd->buf[4]);
+		if (length > STREAM_READER_MAX_PAYLOAD)
+		{
+			rd->junkBytes++;
+			STREAM_readerDrop(rd, 1);
+			continue;
+		}
+
+		if (rd->len < length + STREAM_READER_OVERHEAD)
+		{
+			return;
+		}
+
+		if (STREAM_crc16(0xFFFF, &rd->buf[2], (Uint16)(4 + length)) !=
+		    rd16(&rd->buf[6 + length]))
+		{
+			/* Torn, or a sync pattern inside a damaged frame */
+			rd->badCrc++;
+			STREAM_readerDrop(rd, 1);
+			continue;
+		}
+
+		frame.type    = rd->buf[2];
+		frame.seq     = rd->buf[3];
+		frame.length  = (Uint16)length;
+		frame.payload = &rd->buf[6];
+
+		if (rd->seqValid)
+		{
+			rd->lost += (frame.seq - rd->lastSeq - 1) & 0xFF;
+		}
+		rd->seqValid = TRUE;
+		rd->lastSeq  = frame.seq;
+		rd->frames++;
+
+		if (rd->frameFxn != NULL)
+		{
+			rd->frameFxn(&frame, rd->arg);
+		}
+
+		STREAM_readerDrop(rd, length + STREAM_READER_OVERHEAD);
+	}
+}
+
+/**
+ *
+ * \brief Sets up an empty reader
+ *
+ * \param  rd       - reader
+ * \param  frameFxn - receives the good frames
+ * \param  arg      - argument for 'frameFxn'
+ *
+ */
+void STREAM_readerInit(STREAM_Reader *rd, STREAM_ReaderFrameFxn frameFxn,
+                       void *arg)
+{
+	memset(rd, 0, sizeof(STREAM_Reader));
+	rd->frameFxn = frameFxn;
+	rd->arg      = arg;
+}
+
+/**
+ *
+ * \brief Reads a piece of the stream, any split of it
+ *
+ * \param  rd     - reader
+ * \param  data   - received bytes
+ * \param  length - number of bytes
+ *
+ */
+void STREAM_readerFeed(STREAM_Reader *rd, const Uint8 *data, Uint32 length)
+{
+	Uint32 n;
+
+	while (length > 0)
+	{
+		n = sizeof(rd->buf) - rd->len;
+		if (n > length)
+		{
+			n = length;
+		}
+
+		memcpy(&rd->buf[rd->len], data, n);
+		rd->len += n;
+		data    += n;
+		length  -= n;
+
+		STREAM_readerParse(rd);
+	}
+}
+
+/**
+ *
+ * \brief Opens a serial line, or a pty, raw at 'baud'
+ *
+ * \param  path - device
+ * \param  baud - line rate; 0, or a rate termios has no constant for,
+ *                leaves the rate as it is
+ *
+ * \return File descriptor, -1 on error
+ *
+ */
+int STREAM_readerOpenTty(const char *path, Uint32 baud)
+{
+	static const struct
+	{
+		Uint32  baud;
+		speed_t speed;
+	} rates[] =
+	{
+		{ 115200, B115200 }, { 230400, B230400 }, { 460800, B460800 },
+		{ 921600, B921600 }, { 1000000, B1000000 }, { 2000000, B2000000 },
+		{ 3000000, B3000000 }, { 4000000, B4000000 }
+	};
+	struct termios tio;
+	Uint16         i;
+	int            fd;
+
+	fd = open(path, O_RDONLY | O_NOCTTY);
+	if (fd < 0)
+	{
+		return (-1);
+	}
+
+	/* A capture file is read as it is */
+	if (tcgetattr(fd, &tio) != 0)
+	{
+		return (fd);
+	}
+
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	tio.c_cc[VMIN]  = 1;
+	tio.c_cc[VTIME] = 0;
+
+	for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+	{
+		if (rates[i].baud == baud)
+		{
+			cfsetispeed(&tio, rates[i].speed);
+			cfsetospeed(&tio, rates[i].speed);
+		}
+	}
+
+	if (tcsetattr(fd, TCSANOW, &tio) != 0)
+	{
+		close(fd);
+		return (-1);
+	}
+
+	return (fd);
+}
+
+static void STREAM_captureWavHeader(STREAM_Capture *cap)
+{
+	Uint8  hdr[WAV_HDR_LEN];
+	Uint32 rate  = cap->sampleRate / cap->decimation;
+	Uint32 bytes = 2 * cap->samples;
+
+	memcpy(hdr, "RIFF", 4);
+	wr32(&hdr[4], 36 + bytes);
+	memcpy(&hdr[8], "WAVEfmt ", 8);
+	wr32(&hdr[16], 16);
+	wr16(&hdr[20], 1);
+	wr16(&hdr[22], cap->channels);
+	wr32(&hdr[24], rate);
+	wr32(&hdr[28], rate * 2 * cap->channels);
+	wr16(&hdr[32], 2 * cap->channels);
+	wr16(&hdr[34], 16);
+	memcpy(&hdr[36], "data", 4);
+	wr32(&hdr[40], bytes);
+
+	fseek(cap->wav, 0, SEEK_SET);
+	fwrite(hdr, 1, sizeof(hdr), cap->wav);
+	fseek(cap->wav, 0, SEEK_END);
+}
+
+/**
+ *
+ * \brief Sets up a capture; any of the outputs may be NULL
+ *
+ * \param  cap        - capture
+ * \param  wav        - WAV file, opened for writing and seekable
+ * \param  csv        - counters
+ * \param  text       - console text
+ * \param  sampleRate - audio rate before the tap decimation
+ *
+ */
+void STREAM_captureInit(STREAM_Capture *cap, FILE *wav, FILE *csv,
+                        FILE *text, Uint32 sampleRate)
+{
+	memset(cap, 0, sizeof(STREAM_Capture));
+	cap->wav        = wav;
+	cap->csv        = csv;
+	cap->text       = text;
+	cap->sampleRate = sampleRate;
+}
+
+/**
+ *
+ * \brief Frame handler for STREAM_readerInit(), 'arg' is the capture
+ *
+ */
+void STREAM_captureFrame(const STREAM_ReaderFrame *frame, void *arg)
+{
+	STREAM_Capture *cap = (STREAM_Capture *)arg;
+	const Uint8    *p   = frame->payload;
+	Uint32          block;
+	Uint16          frames;
+	Uint16          channels;
+	Uint16          i;
+
+	switch (frame->type)
+	{
+		case STREAM_FRAME_AUDIO:
+			if (frame->length < STREAM_AUDIO_HDR_LEN)
+			{
+				cap->framesIgnored++;
+				break;
+			}
+
+			frames   = (Uint16)rd16(&p[2]);
+			channels = p[4];
+			block    = rd32(&p[5]);
+
+			if ((channels == 0) || (p[1] == 0) ||
+			    (frame->length != STREAM_AUDIO_HDR_LEN +
+			                      2 * frames * channels))
+			{
+				cap->framesIgnored++;
+				break;
+			}
+
+			/* The first audio frame fixes the layout of the file */
+			if (cap->audioFrames == 0)
+			{
+				cap->tap        = p[0];
+				cap->decimation = p[1];
+				cap->channels   = channels;
+				if (cap->wav != NULL)
+				{
+					STREAM_captureWavHeader(cap);
+				}
+			}
+			else if ((p[0] != cap->tap) || (p[1] != cap->decimation) ||
+			         (channels != cap->channels))
+			{
+				cap->framesIgnored++;
+				break;
+			}
+			else
+			{
+				cap->blocksMissed += block - cap->lastBlock - 1;
+			}
+
+			cap->lastBlock = block;
+			cap->audioFrames++;
+			cap->samples += frames * channels;
+
+			/* Samples are little endian on the wire as in the file */
+			if (cap->wav != NULL)
+			{
+				fwrite(&p[STREAM_AUDIO_HDR_LEN], 2, frames * channels,
+				       cap->wav);
+			}
+			break;
+
+		case STREAM_FRAME_COUNTERS:
+			cap->counterFrames++;
+			if (cap->csv != NULL)
+			{
+				fprintf(cap->csv, "%u", frame->seq);
+				for (i = 0; i + 4 <= frame->length; i += 4)
+				{
+					fprintf(cap->csv, ",%lu", (unsigned long)rd32(&p[i]));
+				}
+				fprintf(cap->csv, "\n");
+			}
+			break;
+
+		case STREAM_FRAME_TEXT:
+			if (cap->text != NULL)
+			{
+				for (i = 0; i < frame->length; i++)
+				{
+					if (p[i] != '\r')
+					{
+						fputc(p[i], cap->text);
+					}
+				}
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+ *
+ * \brief Fills in the WAV sizes and flushes the outputs
+ *
+ * \param  cap - capture
+ *
+ */
+void STREAM_captureEnd(STREAM_Capture *cap)
+{
+	if ((cap->wav != NULL) && (cap->audioFrames != 0))
+	{
+		STREAM_captureWavHeader(cap);
+	}
+
+	if (cap->wav != NULL)
+	{
+		fflush(cap->wav);
+	}
+	if (cap->csv != NULL)
+	{
+		fflush(cap->csv);
+	}
+	if (cap->text != NULL)
+	{
+		fflush(cap->text);
+	}
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file stream_reader.h
+*
+*   \brief Host reader of the UART stream: frame decoder, serial line
+*          set up and WAV / CSV capture.
+*
+*/
+
+#ifndef _STREAM_READER_H_
+#define _STREAM_READER_H_
+
+#include "uart_stream.h"
+
+/* Longest payload taken; anything longer is treated as noise */
+#define STREAM_READER_MAX_PAYLOAD   (8192)
+
+/* Sync, type, sequence, length and CRC around the payload */
+#define STREAM_READER_OVERHEAD      (8)
+
+/* Offset of the samples in an audio payload */
+#define STREAM_AUDIO_HDR_LEN        (9)
+
+typedef struct
+{
+	Uint16       type;
+	Uint16       seq;
+	Uint16       length;
+	const Uint8 *payload;
+} STREAM_ReaderFrame;
+
+/* Receives each frame with a good CRC */
+typedef void (*STREAM_ReaderFrameFxn)(const STREAM_ReaderFrame *frame,
+                                      void *arg);
+
+typedef struct
+{
+	Uint8                   buf[STREAM_READER_MAX_PAYLOAD +
+	                            STREAM_READER_OVERHEAD];
+	Uint32                  len;
+	Bool                    seqValid;
+	Uint16                  lastSeq;
+
+	Uint32                  frames;     /* frames with a good CRC          */
+	Uint32                  badCrc;     /* torn or damaged frames          */
+	Uint32                  lost;       /* sequence numbers never seen     */
+	Uint32                  junkBytes;  /* bytes outside any frame         */
+
+	STREAM_ReaderFrameFxn   frameFxn;
+	void                   *arg;
+} STREAM_Reader;
+
+typedef struct
+{
+	FILE    *wav;
+	FILE    *csv;
+	FILE    *text;
+	Uint32   sampleRate;        /* before decimation                   */
+	Uint16   tap;               /* taken from the first audio frame    */
+	Uint16   channels;
+	Uint16   decimation;
+	Uint32   lastBlock;
+	Uint32   samples;           /* written to the WAV                  */
+	Uint32   audioFrames;
+	Uint32   blocksMissed;      /* block number gaps                   */
+	Uint32   framesIgnored;     /* audio from another tap or layout    */
+	Uint32   counterFrames;
+} STREAM_Capture;
+
+void STREAM_readerInit(STREAM_Reader *rd, STREAM_ReaderFrameFxn frameFxn,
+                       void *arg);
+void STREAM_readerFeed(STREAM_Reader *rd, const Uint8 *data, Uint32 length);
+int  STREAM_readerOpenTty(const char *path, Uint32 baud);
+
+void STREAM_captureInit(STREAM_Capture *cap, FILE *wav, FILE *csv,
+                        FILE *text, Uint32 sampleRate);
+void STREAM_captureFrame(const STREAM_ReaderFrame *frame, void *arg);
+void STREAM_captureEnd(STREAM_Capture *cap);
+
+#endif /* _STREAM_READER_H_ */
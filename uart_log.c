@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file uart_log.c
+*
+*   \brief Ring buffered console output drained by the UART transmit
+*          interrupt.
+*
+*   A polled UART_fputs() at 115200 baud costs about 87us per character,
+*   so a console message stalls the caller for milliseconds. Once
+*   UART_logOpen() has run, C55x_msgWrite() formats into a local buffer,
+*   appends the text to a ring and returns; the transmit interrupt refills
+*   the 16 byte UART FIFO from the ring in the background. A message that
+*   does not fit is dropped whole and counted rather than waited for.
+*
+*   Any number of producers, ISRs included, may write. The C55x has no
+*   compare-and-swap, so a producer holds interrupts off while it copies
+*   its message in (a few hundred cycles at most); the ISR is the only
+*   consumer and never blocks a producer. Until UART_logOpen(), and after
+*   UART_logClose(), console output is polled as before.
+*
+*   UART_logFlush() works with interrupts disabled too, refilling the FIFO
+*   itself, and gives up on a UART that stops taking characters.
+*
+*   The same interrupt moves received characters into a small ring, which
+*   UART_logReadChar() empties without waiting.
+*
+*   gpio_interrupt_initiliastion() resets the vector table, so the logger
+*   has to be opened after it.
+*
+*/
+
+#include "uart_log.h"
+#include "timebase.h"
+
+#define UART_LOG_RING_MASK      (UART_LOG_RING_SIZE - 1)
+#define UART_LOG_RX_MASK        (UART_LOG_RX_SIZE - 1)
+
+static char              logRing[UART_LOG_RING_SIZE];
+static volatile Uint16   logHead;
+static volatile Uint16   logTail;
+static volatile Bool     logTxActive;
+static Bool              logOpen;
+
+static char              logRxRing[UART_LOG_RX_SIZE];
+static volatile Uint16   logRxHead;
+static volatile Uint16   logRxTail;
+
+static UART_LogStats     logStats;
+
+/* Enables the THR empty interrupt, which fires at once while it is empty */
+static void UART_logKick(void)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+
+	logTxActive = TRUE;
+	hUart->uartRegs->IER |= CSL_UART_IER_ETBEI_MASK;
+}
+
+/* Moves received characters into the receive ring, refills the transmit
+ * FIFO from the log ring and stops the transmit interrupt once the log
+ * ring is empty. Runs with interrupts disabled. */
+static void UART_logService(void)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+	Uint16         tail;
+	Uint16         n;
+	volatile Uint16 iir;
+
+	/* Reading IIR acknowledges the THR empty event */
+	iir = hUart->uartRegs->IIR;
+	iir = iir;
+
+	while (hUart->uartRegs->LSR & CSL_UART_LSR_DR_MASK)
+	{
+		if ((Uint16)(logRxHead - logRxTail) < UART_LOG_RX_SIZE)
+		{
+			logRxRing[logRxHead & UART_LOG_RX_MASK] =
+			    hUart->uartRegs->RBR & 0xFF;
+			logRxHead++;
+		}
+		else
+		{
+			iir = hUart->uartRegs->RBR;
+			logStats.rxDropped++;
+		}
+	}
+
+	if ((hUart->uartRegs->LSR & CSL_UART_LSR_THRE_MASK) == 0)
+	{
+		return;
+	}
+
+	tail = logTail;
+	for (n = 0; (n < UART_LOG_FIFO_DEPTH) && (tail != logHead); n++)
+	{
+		hUart->uartRegs->THR = logRing[tail & UART_LOG_RING_MASK] & 0xFF;
+		tail++;
+	}
+	logTail = tail;
+	logStats.bytes += n;
+
+	if (tail == logHead)
+	{
+		hUart->uartRegs->IER &= ~CSL_UART_IER_ETBEI_MASK;
+		logTxActive = FALSE;
+	}
+}
+
+/**
+ *  \brief  UART Interrupt Service Routine
+ *
+ *  \return none
+ */
+interrupt void uartLogIsr(void)
+{
+	UART_logService();
+}
+
+/**
+ *
+ * \brief Switches console output to the ring. The UART must already be
+ *        set up by uart_initialisation().
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS UART_logOpen(void)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+	Bool           oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+
+	logHead     = 0;
+	logTail     = 0;
+	logTxActive = FALSE;
+	logRxHead   = 0;
+	logRxTail   = 0;
+	memset(&logStats, 0, sizeof(logStats));
+
+	hUart->uartRegs->IER &= ~CSL_UART_IER_ETBEI_MASK;
+	hUart->uartRegs->IER |= CSL_UART_IER_ERBI_MASK;
+
+	IRQ_clear(UART_EVENT);
+	IRQ_plug(UART_EVENT, &uartLogIsr);
+	IRQ_enable(UART_EVENT);
+
+	logOpen = TRUE;
+
+	IRQ_globalRestore(oldIntm);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Sends what is left in the ring and returns to polled output
+ *
+ */
+void UART_logClose(void)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+
+	if (!logOpen)
+	{
+		return;
+	}
+
+	UART_logFlush();
+
+	logOpen = FALSE;
+	hUart->uartRegs->IER &= ~(CSL_UART_IER_ETBEI_MASK |
+	                          CSL_UART_IER_ERBI_MASK);
+	IRQ_disable(UART_EVENT);
+}
+
+/**
+ *
+ * \brief Tells whether console output goes through the ring
+ *
+ */
+Bool UART_logActive(void)
+{
+	return (logOpen);
+}
+
+/**
+ *
+ * \brief Queues 'length' characters, all or nothing
+ *
+ * \param  msg    - text
+ * \param  length - number of characters
+ *
+ * \return Characters queued, 0 if the message was dropped
+ *
+ */
+Int32 UART_logWrite(const char *msg, Uint16 length)
+{
+	Uint16 head;
+	Uint16 level;
+	Uint16 i;
+	Bool   oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+
+	head  = logHead;
+	level = (Uint16)(head - logTail);
+	if ((UART_LOG_RING_SIZE - level) < length)
+	{
+		logStats.dropped++;
+		logStats.droppedBytes += length;
+		IRQ_globalRestore(oldIntm);
+		return (0);
+	}
+
+	for (i = 0; i < length; i++)
+	{
+		logRing[(head + i) & UART_LOG_RING_MASK] = msg[i];
+	}
+	logHead = head + length;
+
+	logStats.messages++;
+	if ((level + length) > logStats.maxLevel)
+	{
+		logStats.maxLevel = level + length;
+	}
+
+	if (!logTxActive)
+	{
+		UART_logKick();
+	}
+
+	IRQ_globalRestore(oldIntm);
+
+	return (length);
+}
+
+/**
+ *
+ * \brief Formats a message and queues it
+ *
+ * \param  fmt  - printf style format
+ * \param  args - arguments
+ *
+ * \return Characters queued, 0 if the message was dropped
+ *
+ */
+Int32 UART_logVPrintf(const char *fmt, va_list args)
+{
+	char   msg[UART_LOG_MAX_MSG];
+	Int32  length;
+	Bool   oldIntm;
+
+	length = vsnprintf(msg, sizeof(msg), fmt, args);
+	if (length < 0)
+	{
+		return (0);
+	}
+	if (length >= (Int32)sizeof(msg))
+	{
+		length = sizeof(msg) - 1;
+
+		oldIntm = IRQ_globalDisable();
+		logStats.truncated++;
+		IRQ_globalRestore(oldIntm);
+	}
+
+	return (UART_logWrite(msg, (Uint16)length));
+}
+
+/**
+ *
+ * \brief Waits until the ring has been handed to the UART. With interrupts
+ *        disabled the FIFO is refilled here; if the UART takes nothing for
+ *        UART_LOG_FLUSH_TIMEOUT_USEC the rest is dropped and counted.
+ *
+ */
+void UART_logFlush(void)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+	Uint32         deadline;
+	Uint16         tail;
+	Bool           masked;
+	Bool           oldIntm;
+
+	/* Whether the ISR can run at all */
+	masked = IRQ_globalDisable();
+	IRQ_globalRestore(masked);
+
+	tail     = logTail;
+	deadline = C55x_deadline(UART_LOG_FLUSH_TIMEOUT_USEC);
+
+	while (logTail != logHead)
+	{
+		if (masked)
+		{
+			UART_logService();
+		}
+
+		if (logTail != tail)
+		{
+			tail     = logTail;
+			deadline = C55x_deadline(UART_LOG_FLUSH_TIMEOUT_USEC);
+		}
+		else if (C55x_deadlinePassed(deadline))
+		{
+			oldIntm = IRQ_globalDisable();
+			logStats.droppedBytes += (Uint16)(logHead - logTail);
+			logTail = logHead;
+			hUart->uartRegs->IER &= ~CSL_UART_IER_ETBEI_MASK;
+			logTxActive = FALSE;
+			IRQ_globalRestore(oldIntm);
+		}
+	}
+}
+
+/**
+ *
+ * \brief Takes one received character, never waits
+ *
+ * \param  c - destination
+ *
+ * \return TRUE if a character was available
+ *
+ */
+Bool UART_logReadChar(char *c)
+{
+	Uint16 tail = logRxTail;
+
+	if (tail == logRxHead)
+	{
+		return (FALSE);
+	}
+
+	*c = logRxRing[tail & UART_LOG_RX_MASK];
+	logRxTail = tail + 1;
+
+	return (TRUE);
+}
+
+/**
+ *
+ * \brief Copies the logger statistics
+ *
+ */
+void UART_logGetStats(UART_LogStats *stats)
+{
+	*stats = logStats;
+}
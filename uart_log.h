@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file uart_log.h
+*
+*   \brief Ring buffered console output drained by the UART transmit
+*          interrupt.
+*
+*/
+
+#ifndef _UART_LOG_H_
+#define _UART_LOG_H_
+
+#include "platform_internals.h"
+#include <stdarg.h>
+
+/* Ring size in characters, must be a power of two */
+#define UART_LOG_RING_SIZE      (1024)
+
+/* Longest formatted message, as long as the polled C55x_msgWrite() takes */
+#define UART_LOG_MAX_MSG        (200)
+
+/* Receive ring size in characters, must be a power of two */
+#define UART_LOG_RX_SIZE        (64)
+
+/* UART transmit FIFO depth */
+#define UART_LOG_FIFO_DEPTH     (16)
+
+/* UART_logFlush() gives up once the UART takes nothing for this long */
+#define UART_LOG_FLUSH_TIMEOUT_USEC (20000)
+
+typedef struct
+{
+	Uint32  messages;       /* messages queued                        */
+	Uint32  bytes;          /* characters sent                        */
+	Uint32  dropped;        /* messages dropped, ring full            */
+	Uint32  droppedBytes;   /* and characters UART_logFlush() gave up */
+	Uint32  truncated;      /* messages cut to UART_LOG_MAX_MSG       */
+	Uint16  maxLevel;       /* fullest the ring has been              */
+	Uint32  rxDropped;      /* characters lost, receive ring full     */
+} UART_LogStats;
+
+TEST_STATUS UART_logOpen(void);
+void UART_logClose(void);
+Bool UART_logActive(void);
+Int32 UART_logWrite(const char *msg, Uint16 length);
+Int32 UART_logVPrintf(const char *fmt, va_list args);
+void UART_logFlush(void);
+Bool UART_logReadChar(char *c);
+void UART_logGetStats(UART_LogStats *stats);
+interrupt void uartLogIsr(void);
+
+#endif /* _UART_LOG_H_ */
@@ -0,0 +1,647 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file uart_stream.c
+*
+*   \brief Framed, CRC checked binary streaming of audio blocks and
+*          counters over the UART.
+*
+*   Frame layout, all multi-byte fields little endian:
+*
+*       0xC5 0x5C  type  seq  len(2)  payload(len)  crc(2)
+*
+*   The CRC is CRC-16/CCITT-FALSE over type, seq, len and the payload. An
+*   audio payload starts with a block header (tap point, decimation,
+*   frames(2), channels, block number(4)) followed by the samples. A
+*   counters payload is a list of 32-bit values, a text payload console
+*   text.
+*
+*   The tap is zero copy. STREAM_tap() only builds the few header bytes and
+*   hands the UART transmit interrupt a pointer into the audio buffer. The
+*   ISR reads each sample as it goes out, skips frames for decimation and
+*   computes the CRC on the fly. A tap that finds a frame still in flight
+*   is skipped and counted, so the audio path never waits. Before an audio
+*   path overwrites a tapped buffer it calls STREAM_release(). If the frame
+*   is still going out it is marked torn and finished with a bad CRC, so
+*   the reader drops it.
+*
+*   STREAM_open() takes over the UART at a higher baud rate. The console
+*   log ring is closed for the duration and reopened by STREAM_close().
+*   Meanwhile C55x_msgWrite() hands console text to STREAM_text(), which
+*   queues it in a ring of its own; the ISR sends it in text frames
+*   whenever no other frame is in flight, so text never lands inside a
+*   frame. A message that does not fit is dropped whole and counted.
+*
+*/
+
+#include "uart_stream.h"
+#include "uart_log.h"
+#include "platform_uart.h"
+
+typedef enum
+{
+	STREAM_PHASE_IDLE = 0,
+	STREAM_PHASE_HDR,
+	STREAM_PHASE_SAMPLES,
+	STREAM_PHASE_BYTES,
+	STREAM_PHASE_CRC
+} STREAM_Phase;
+
+/* CRC-16/CCITT, polynomial 0x1021, four bits at a time */
+static const Uint16 streamCrcTable[16] =
+{
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static Uint8            streamHdr[STREAM_HDR_MAX];
+static Uint8            streamCounterBytes[4 * STREAM_MAX_COUNTERS];
+static Uint8            streamTextBytes[STREAM_TEXT_MAX];
+
+#define STREAM_TEXT_MASK        (STREAM_TEXT_RING_SIZE - 1)
+
+/* Console text waiting for a text frame, any producer, the ISR consumes */
+static char             streamTextRing[STREAM_TEXT_RING_SIZE];
+static volatile Uint16  textHead;
+static volatile Uint16  textTail;
+
+/* Transmit state, owned by the ISR while a frame is in flight */
+static volatile STREAM_Phase txPhase;
+static Uint16           txHdrLen;
+static Uint16           txPos;
+static const Int16     *txSamples;
+static Uint16           txIndex;
+static Uint16           txChannels;
+static Uint16           txChannel;
+static Uint16           txSkip;
+static Uint16           txFramesLeft;
+static Bool             txHighByte;
+static const Uint8     *txBytes;
+static Uint16           txByteCount;
+static Uint16           txCrc;
+static volatile Bool    txTorn;
+
+static Bool             streamOpen;
+static Bool             streamLogWasOpen;
+static Uint32           streamOldBaud;
+static Uint16           streamSeq;
+static STREAM_TapPoint  tapPoint;
+static Uint16           tapDecimation;
+static Uint16           tapInterval;
+static Uint16           tapCount;
+static Uint32           tapBlock;
+static STREAM_Stats     streamStats;
+
+static Uint16 STREAM_crcByte(Uint16 crc, Uint16 b)
+{
+	crc = (Uint16)((crc << 4) ^ streamCrcTable[((crc >> 12) ^ (b >> 4)) & 0xF]);
+	crc = (Uint16)((crc << 4) ^ streamCrcTable[((crc >> 12) ^ b) & 0xF]);
+
+	return (crc & 0xFFFF);
+}
+
+/* Returns the next byte of the frame in flight and advances */
+static Uint16 STREAM_nextByte(void)
+{
+	Uint16 b = 0;
+	Int16  sample;
+
+	switch (txPhase)
+	{
+		case STREAM_PHASE_HDR:
+			b = streamHdr[txPos];
+			if (txPos >= 2)
+			{
+				txCrc = STREAM_crcByte(txCrc, b);
+			}
+			if (++txPos >= txHdrLen)
+			{
+				txPos   = 0;
+				txPhase = (txSamples != NULL) ? STREAM_PHASE_SAMPLES :
+				          (txByteCount ? STREAM_PHASE_BYTES :
+				                         STREAM_PHASE_CRC);
+			}
+			break;
+
+		case STREAM_PHASE_SAMPLES:
+			sample = txSamples[txIndex];
+			b = txHighByte ? ((sample >> 8) & 0xFF) : (sample & 0xFF);
+			txCrc = STREAM_crcByte(txCrc, b);
+			if (txHighByte)
+			{
+				txIndex++;
+				if (++txChannel >= txChannels)
+				{
+					txChannel = 0;
+					txIndex  += txSkip;
+					if (--txFramesLeft == 0)
+					{
+						txPhase = STREAM_PHASE_CRC;
+					}
+				}
+			}
+			txHighByte = !txHighByte;
+			break;
+
+		case STREAM_PHASE_BYTES:
+			b = txBytes[txPos];
+			txCrc = STREAM_crcByte(txCrc, b);
+			if (++txPos >= txByteCount)
+			{
+				txPos   = 0;
+				txPhase = STREAM_PHASE_CRC;
+			}
+			break;
+
+		case STREAM_PHASE_CRC:
+			if (txPos == 0)
+			{
+				if (txTorn)
+				{
+					txCrc ^= 0xFFFF;
+				}
+				b = txCrc & 0xFF;
+				txPos++;
+			}
+			else
+			{
+				b = (txCrc >> 8) & 0xFF;
+				txSamples = NULL;
+				txPhase   = STREAM_PHASE_IDLE;
+				streamStats.framesSent++;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	return (b);
+}
+
+/* Starts a frame whose header is in streamHdr */
+static void STREAM_start(Uint16 type, Uint16 payloadLen)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+
+	streamHdr[0] = STREAM_SYNC0;
+	streamHdr[1] = STREAM_SYNC1;
+	streamHdr[2] = type;
+	streamHdr[3] = streamSeq++ & 0xFF;
+	streamHdr[4] = payloadLen & 0xFF;
+	streamHdr[5] = (payloadLen >> 8) & 0xFF;
+
+	txPos      = 0;
+	txCrc      = 0xFFFF;
+	txTorn     = FALSE;
+	txHighByte = FALSE;
+	txPhase    = STREAM_PHASE_HDR;
+
+	/* THR is empty, the interrupt fires straight away */
+	hUart->uartRegs->IER |= CSL_UART_IER_ETBEI_MASK;
+}
+
+/* Starts a text frame if the line is free and text is queued. Called
+ * with interrupts disabled. */
+static void STREAM_startText(void)
+{
+	Uint16 tail = textTail;
+	Uint16 n;
+
+	if ((txPhase != STREAM_PHASE_IDLE) || (tail == textHead))
+	{
+		return;
+	}
+
+	for (n = 0; (n < STREAM_TEXT_MAX) && (tail != textHead); n++)
+	{
+		streamTextBytes[n] = streamTextRing[tail & STREAM_TEXT_MASK];
+		tail++;
+	}
+	textTail = tail;
+	streamStats.textBytes += n;
+
+	txHdrLen    = 6;
+	txSamples   = NULL;
+	txBytes     = streamTextBytes;
+	txByteCount = n;
+
+	STREAM_start(STREAM_FRAME_TEXT, n);
+}
+
+/**
+ *  \brief  UART Interrupt Service Routine
+ *
+ *  Refills the transmit FIFO with the next bytes of the frame in flight,
+ *  and starts a text frame once it is done if console text is queued.
+ *
+ *  \return none
+ */
+interrupt void uartStreamIsr(void)
+{
+	CSL_UartHandle  hUart = (CSL_UartHandle)(&uartObj);
+	Uint16          n;
+	volatile Uint16 iir;
+
+	iir = hUart->uartRegs->IIR;
+	iir = iir;
+
+	if ((hUart->uartRegs->LSR & CSL_UART_LSR_THRE_MASK) == 0)
+	{
+		return;
+	}
+
+	for (n = 0; (n < UART_LOG_FIFO_DEPTH) &&
+	            (txPhase != STREAM_PHASE_IDLE); n++)
+	{
+		hUart->uartRegs->THR = STREAM_nextByte();
+	}
+	streamStats.bytesSent += n;
+
+	if (txPhase == STREAM_PHASE_IDLE)
+	{
+		hUart->uartRegs->IER &= ~CSL_UART_IER_ETBEI_MASK;
+		STREAM_startText();
+	}
+}
+
+/**
+ *
+ * \brief Switches the UART to streaming at 'baud'
+ *
+ * \param  baud - line rate, STREAM_DEFAULT_BAUD if 0
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS STREAM_open(Uint32 baud)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+	Bool           oldIntm;
+
+	if (streamOpen)
+	{
+		return (TEST_FAIL);
+	}
+
+	if (baud == 0)
+	{
+		baud = STREAM_DEFAULT_BAUD;
+	}
+
+	streamLogWasOpen = UART_logActive();
+	UART_logClose();
+
+	streamOldBaud = uart_getBaud();
+	if (uart_setBaud(baud) != 0)
+	{
+		if (streamLogWasOpen)
+		{
+			UART_logOpen();
+		}
+		return (TEST_FAIL);
+	}
+
+	oldIntm = IRQ_globalDisable();
+
+	txPhase   = STREAM_PHASE_IDLE;
+	txSamples = NULL;
+	textHead  = 0;
+	textTail  = 0;
+	streamSeq = 0;
+	tapPoint  = STREAM_TAP_NONE;
+	memset(&streamStats, 0, sizeof(streamStats));
+
+	hUart->uartRegs->IER &= ~CSL_UART_IER_ETBEI_MASK;
+
+	IRQ_clear(UART_EVENT);
+	IRQ_plug(UART_EVENT, &uartStreamIsr);
+	IRQ_enable(UART_EVENT);
+
+	streamOpen = TRUE;
+
+	IRQ_globalRestore(oldIntm);
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Finishes the frame in flight and the queued text, and gives the
+ *        UART back to the console at its previous baud rate
+ *
+ */
+void STREAM_close(void)
+{
+	CSL_UartHandle hUart = (CSL_UartHandle)(&uartObj);
+
+	if (!streamOpen)
+	{
+		return;
+	}
+
+	tapPoint = STREAM_TAP_NONE;
+	while ((txPhase != STREAM_PHASE_IDLE) || (textTail != textHead))
+	{
+		;
+	}
+
+	streamOpen = FALSE;
+	hUart->uartRegs->IER &= ~CSL_UART_IER_ETBEI_MASK;
+	IRQ_disable(UART_EVENT);
+
+	uart_setBaud(streamOldBaud);
+
+	if (streamLogWasOpen)
+	{
+		UART_logOpen();
+	}
+}
+
+/**
+ *
+ * \brief Tells whether the UART is streaming, console text included
+ *
+ */
+Bool STREAM_active(void)
+{
+	return (streamOpen);
+}
+
+/**
+ *
+ * \brief Tells whether a new frame can start
+ *
+ */
+Bool STREAM_idle(void)
+{
+	return (streamOpen && (txPhase == STREAM_PHASE_IDLE));
+}
+
+/**
+ *
+ * \brief Chooses the audio tap
+ *
+ * \param  point         - tap point, STREAM_TAP_NONE to stop
+ * \param  decimation    - send every n-th frame of a block, 1 for all.
+ *                         There is no anti-alias filter.
+ * \param  blockInterval - send every n-th block, 1 for all
+ *
+ */
+void STREAM_tapSelect(STREAM_TapPoint point, Uint16 decimation,
+                      Uint16 blockInterval)
+{
+	tapPoint      = STREAM_TAP_NONE;
+	tapDecimation = decimation ? decimation : 1;
+	tapInterval   = blockInterval ? blockInterval : 1;
+	tapCount      = 0;
+	tapBlock      = 0;
+	tapPoint      = point;
+}
+
+/**
+ *
+ * \brief Offers an audio block to the stream. Returns at once; the samples
+ *        are read by the UART ISR and must stay valid until the caller
+ *        passes the buffer to STREAM_release().
+ *
+ * \param  point    - tap point the call site stands for
+ * \param  samples  - interleaved samples
+ * \param  frames   - frames in the block
+ * \param  channels - samples per frame
+ *
+ */
+void STREAM_tap(STREAM_TapPoint point, const Int16 *samples,
+                Uint16 frames, Uint16 channels)
+{
+	Uint16 outFrames;
+	Uint16 payloadLen;
+
+	if ((point != tapPoint) || (frames == 0))
+	{
+		return;
+	}
+
+	tapBlock++;
+	if (++tapCount < tapInterval)
+	{
+		return;
+	}
+	tapCount = 0;
+
+	if (txPhase != STREAM_PHASE_IDLE)
+	{
+		streamStats.blocksSkipped++;
+		return;
+	}
+
+	outFrames  = (frames + tapDecimation - 1) / tapDecimation;
+	payloadLen = 9 + (2 * outFrames * channels);
+
+	streamHdr[6]  = point;
+	streamHdr[7]  = tapDecimation & 0xFF;
+	streamHdr[8]  = outFrames & 0xFF;
+	streamHdr[9]  = (outFrames >> 8) & 0xFF;
+	streamHdr[10] = channels & 0xFF;
+	streamHdr[11] = tapBlock & 0xFF;
+	streamHdr[12] = (tapBlock >> 8) & 0xFF;
+	streamHdr[13] = (tapBlock >> 16) & 0xFF;
+	streamHdr[14] = (tapBlock >> 24) & 0xFF;
+	txHdrLen      = 15;
+
+	txSamples    = samples;
+	txIndex      = 0;
+	txChannels   = channels;
+	txChannel    = 0;
+	txSkip       = (tapDecimation - 1) * channels;
+	txFramesLeft = outFrames;
+	txBytes      = NULL;
+	txByteCount  = 0;
+
+	STREAM_start(STREAM_FRAME_AUDIO, payloadLen);
+}
+
+/**
+ *
+ * \brief Called before a tapped buffer is overwritten. A frame still
+ *        reading from it is marked torn.
+ *
+ * \param  samples - buffer about to be reused
+ *
+ */
+void STREAM_release(const Int16 *samples)
+{
+	Bool oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+
+	if ((txSamples == samples) && (txPhase != STREAM_PHASE_IDLE) &&
+	    !txTorn)
+	{
+		txTorn = TRUE;
+		streamStats.torn++;
+	}
+
+	IRQ_globalRestore(oldIntm);
+}
+
+/**
+ *
+ * \brief Sends a counters frame if the channel is free
+ *
+ * \param  values - counters
+ * \param  count  - number of counters, up to STREAM_MAX_COUNTERS
+ *
+ * \return TRUE if the frame was started
+ *
+ */
+Bool STREAM_sendCounters(const Uint32 *values, Uint16 count)
+{
+	Uint16 i;
+
+	if (!STREAM_idle() || (count > STREAM_MAX_COUNTERS))
+	{
+		return (FALSE);
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		streamCounterBytes[4 * i]     = values[i] & 0xFF;
+		streamCounterBytes[4 * i + 1] = (values[i] >> 8) & 0xFF;
+		streamCounterBytes[4 * i + 2] = (values[i] >> 16) & 0xFF;
+		streamCounterBytes[4 * i + 3] = (values[i] >> 24) & 0xFF;
+	}
+
+	txHdrLen    = 6;
+	txSamples   = NULL;
+	txBytes     = streamCounterBytes;
+	txByteCount = 4 * count;
+
+	STREAM_start(STREAM_FRAME_COUNTERS, 4 * count);
+
+	return (TRUE);
+}
+
+/**
+ *
+ * \brief Queues console text for text frames, all or nothing
+ *
+ * \param  msg    - text
+ * \param  length - number of characters
+ *
+ * \return Characters queued, 0 if the message was dropped
+ *
+ */
+Int32 STREAM_text(const char *msg, Uint16 length)
+{
+	Uint16 head;
+	Uint16 i;
+	Bool   oldIntm;
+
+	oldIntm = IRQ_globalDisable();
+
+	head = textHead;
+	if ((STREAM_TEXT_RING_SIZE - (Uint16)(head - textTail)) < length)
+	{
+		streamStats.textDropped++;
+		IRQ_globalRestore(oldIntm);
+		return (0);
+	}
+
+	for (i = 0; i < length; i++)
+	{
+		streamTextRing[(head + i) & STREAM_TEXT_MASK] = msg[i];
+	}
+	textHead = head + length;
+
+	STREAM_startText();
+
+	IRQ_globalRestore(oldIntm);
+
+	return (length);
+}
+
+/**
+ *
+ * \brief Formats console text and queues it for text frames
+ *
+ * \param  fmt  - printf style format
+ * \param  args - arguments
+ *
+ * \return Characters queued, 0 if the message was dropped
+ *
+ */
+Int32 STREAM_vprintf(const char *fmt, va_list args)
+{
+	char   msg[UART_LOG_MAX_MSG];
+	Int32  length;
+
+	length = vsnprintf(msg, sizeof(msg), fmt, args);
+	if (length < 0)
+	{
+		return (0);
+	}
+	if (length >= (Int32)sizeof(msg))
+	{
+		length = sizeof(msg) - 1;
+	}
+
+	return (STREAM_text(msg, (Uint16)length));
+}
+
+/**
+ *
+ * \brief CRC-16/CCITT over 'length' bytes, start with 0xFFFF
+ *
+ */
+Uint16 STREAM_crc16(Uint16 crc, const Uint8 *data, Uint16 length)
+{
+	while (length--)
+	{
+		crc = STREAM_crcByte(crc, *data++ & 0xFF);
+	}
+
+	return (crc);
+}
+
+/**
+ *
+ * \brief Copies the stream statistics
+ *
+ */
+void STREAM_getStats(STREAM_Stats *stats)
+{
+	*stats = streamStats;
+}
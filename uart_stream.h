@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file uart_stream.h
+*
+*   \brief Framed, CRC checked binary streaming of audio blocks and
+*          counters over the UART.
+*
+*/
+
+#ifndef _UART_STREAM_H_
+#define _UART_STREAM_H_
+
+#include "platform_internals.h"
+#include <stdarg.h>
+
+/* Frame start, chosen apart from ASCII text and the BLOG sync byte */
+#define STREAM_SYNC0            (0xC5)
+#define STREAM_SYNC1            (0x5C)
+
+/* Frame types */
+#define STREAM_FRAME_AUDIO      (1)
+#define STREAM_FRAME_COUNTERS   (2)
+#define STREAM_FRAME_TEXT       (3)
+
+/* Sync, type, sequence, payload length and the audio block header */
+#define STREAM_HDR_MAX          (16)
+
+#define STREAM_MAX_COUNTERS     (8)
+
+/* Console text queued while streaming, must be a power of two */
+#define STREAM_TEXT_RING_SIZE   (512)
+
+/* Most text in one frame */
+#define STREAM_TEXT_MAX         (64)
+
+/* 100 MHz / (16 * 3125000) is an exact divisor of 2 */
+#define STREAM_DEFAULT_BAUD     (3125000)
+
+/* Points in the audio path that can be tapped */
+typedef enum
+{
+	STREAM_TAP_NONE = 0,
+	STREAM_TAP_PIPE_OUT,        /* pipeline block after processing */
+	STREAM_TAP_DMA_LEFT,        /* DMA fill, left channel          */
+	STREAM_TAP_DMA_RIGHT        /* DMA fill, right channel         */
+} STREAM_TapPoint;
+
+typedef struct
+{
+	Uint32  framesSent;
+	Uint32  bytesSent;
+	Uint32  blocksSkipped;      /* tap hit while a frame was in flight */
+	Uint32  torn;               /* source reused before it was sent    */
+	Uint32  textBytes;          /* console text sent in frames         */
+	Uint32  textDropped;        /* messages the text ring had no room for */
+} STREAM_Stats;
+
+TEST_STATUS STREAM_open(Uint32 baud);
+void STREAM_close(void);
+Bool STREAM_active(void);
+Bool STREAM_idle(void);
+void STREAM_tapSelect(STREAM_TapPoint point, Uint16 decimation,
+                      Uint16 blockInterval);
+void STREAM_tap(STREAM_TapPoint point, const Int16 *samples,
+                Uint16 frames, Uint16 channels);
+void STREAM_release(const Int16 *samples);
+Bool STREAM_sendCounters(const Uint32 *values, Uint16 count);
+Int32 STREAM_text(const char *msg, Uint16 length);
+Int32 STREAM_vprintf(const char *fmt, va_list args);
+Uint16 STREAM_crc16(Uint16 crc, const Uint8 *data, Uint16 length);
+void STREAM_getStats(STREAM_Stats *stats);
+interrupt void uartStreamIsr(void);
+
+#endif /* _UART_STREAM_H_ */
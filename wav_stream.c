@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file wav_stream.c
+*
+*   \brief Streaming PCM/WAV player reading from a block device with
+*          multi-buffered read-ahead.
+*
+*   The file is read in sector aligned chunks of WAV_SECTORS_PER_BUF
+*   sectors into a ring of 'depth' buffers. WAV_service() runs in the main
+*   loop and tops up every empty buffer; WAV_fill() is an I2S_DmaFillFxn
+*   that drains the ring. As long as one buffer can be read faster than
+*   the other depth-1 buffers play out, the I2S never starves.
+*
+*   With a time source registered through WAV_setClock() the worst device
+*   read time is recorded next to the lowest read-ahead level seen, which
+*   is what is needed to size 'depth' for the slowest cards:
+*
+*       worstReadTime < (depth - 1) * WAV_BUF_WORDS / channels / fs
+*
+*   WAV_fileRead() is a block device backed by a stdio FILE, usable on a
+*   host or through the CCS file I/O on the target. On the C5545 the file
+*   is read from the microSD card with SDCARD_read(), see sd_card.c.
+*
+*/
+
+#include "wav_stream.h"
+
+#define WAV_FMT_PCM     (1)
+
+static Uint16  wavBuf[WAV_MAX_DEPTH][WAV_BUF_WORDS];
+static volatile Uint16  wavBufWords[WAV_MAX_DEPTH];   /* 0 = empty */
+
+static const WAV_BlockDevice *wavDev;
+static WAV_ClockFxn  wavClock;
+static WAV_Info      wavInfo;
+static WAV_Stats     wavStats;
+
+static Uint32  wavNextSector;     /* next sector to read               */
+static Uint32  wavWordsLeft;      /* data words not yet read            */
+static Uint32  wavFramesLeft;     /* frames not yet played              */
+static Uint16  wavSkipWords;      /* header words in the first buffer   */
+static Uint16  wavReadBuf;        /* buffer WAV_service() fills next    */
+static Uint16  wavPlayBuf;        /* buffer WAV_fill() drains           */
+static Uint16  wavPlayPos;        /* word offset in wavPlayBuf          */
+
+/* Little-endian 32-bit value at word offset 'pos' */
+static Uint32 WAV_get32(const Uint16 *words, Uint16 pos)
+{
+	return ((Uint32)words[pos] | ((Uint32)words[pos + 1] << 16));
+}
+
+/* Little-endian four character code at word offset 'pos' */
+static Bool WAV_isTag(const Uint16 *words, Uint16 pos, const char *tag)
+{
+	return ((words[pos]     == ((Uint16)tag[0] | ((Uint16)tag[1] << 8))) &&
+	        (words[pos + 1] == ((Uint16)tag[2] | ((Uint16)tag[3] << 8))));
+}
+
+/**
+ *
+ * \brief Parses the RIFF header in the first sectors of the file. The
+ *        'fmt ' chunk and the 'data' chunk header must lie within the
+ *        first buffer.
+ *
+ * \param  words - first WAV_BUF_WORDS words of the file
+ *
+ * \return
+ * \n      TEST_PASS  - header parsed, wavInfo and wavSkipWords set
+ * \n      TEST_FAIL  - not a 16-bit PCM WAV file
+ *
+ */
+static TEST_STATUS WAV_parseHeader(const Uint16 *words)
+{
+	Uint32 chunkLen;
+	Uint32 next;
+	Uint16 pos;
+	Bool   haveFmt = FALSE;
+
+	if (!WAV_isTag(words, 0, "RIFF") || !WAV_isTag(words, 4, "WAVE"))
+	{
+		return (TEST_FAIL);
+	}
+
+	/* Chunks start at byte 12 and are word aligned */
+	pos = 6;
+	while (pos + 4 <= WAV_BUF_WORDS)
+	{
+		chunkLen = WAV_get32(words, pos + 2);
+
+		if (WAV_isTag(words, pos, "fmt "))
+		{
+			/* The fields used end at word 12 of the chunk */
+			if ((chunkLen < 16) || (pos + 12 > WAV_BUF_WORDS) ||
+			    (words[pos + 4] != WAV_FMT_PCM) ||
+			    (words[pos + 5] < 1) || (words[pos + 5] > 2) ||
+			    (words[pos + 11] != 16))
+			{
+				return (TEST_FAIL);
+			}
+
+			wavInfo.channels   = words[pos + 5];
+			wavInfo.sampleRate = WAV_get32(words, pos + 6);
+			haveFmt = TRUE;
+		}
+		else if (WAV_isTag(words, pos, "data"))
+		{
+			if (!haveFmt)
+			{
+				return (TEST_FAIL);
+			}
+
+			wavSkipWords       = pos + 4;
+			wavInfo.dataFrames = (chunkLen >> 1) / wavInfo.channels;
+			return (TEST_PASS);
+		}
+
+		/* Chunk bodies are padded to an even number of bytes. Worked out
+		 * in 32 bits so a huge length cannot wrap back into the buffer. */
+		next = (Uint32)pos + 4 + ((chunkLen + 1) >> 1);
+		if (next + 4 > WAV_BUF_WORDS)
+		{
+			break;
+		}
+		pos = (Uint16)next;
+	}
+
+	return (TEST_FAIL);
+}
+
+/**
+ *
+ * \brief Reads the next chunk of the file into buffer 'index'
+ *
+ * \return
+ * \n      TEST_PASS  - buffer filled
+ * \n      TEST_FAIL  - device error
+ *
+ */
+static TEST_STATUS WAV_readBuffer(Uint16 index)
+{
+	Uint32 start = 0;
+	Uint32 elapsed;
+	Uint16 words;
+
+	if (wavClock != NULL)
+	{
+		start = wavClock();
+	}
+
+	if (wavDev->read(wavDev->ctx, wavNextSector, WAV_SECTORS_PER_BUF,
+	                 wavBuf[index]) != 0)
+	{
+		wavStats.readErrors++;
+		return (TEST_FAIL);
+	}
+
+	if (wavClock != NULL)
+	{
+		elapsed = wavClock() - start;
+		if (elapsed > wavStats.worstReadTime)
+		{
+			wavStats.worstReadTime = elapsed;
+		}
+	}
+
+	wavNextSector        += WAV_SECTORS_PER_BUF;
+	wavStats.sectorsRead += WAV_SECTORS_PER_BUF;
+
+	words = WAV_BUF_WORDS;
+	if (words > wavWordsLeft)
+	{
+		words = (Uint16)wavWordsLeft;
+	}
+	wavWordsLeft -= words;
+
+	wavBufWords[index] = words;
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief This function opens a WAV file on a block device and fills the
+ *        whole read-ahead ring
+ *
+ * \param  dev         - block device
+ * \param  startSector - first sector of the file
+ * \param  depth       - number of read-ahead buffers, 2 to WAV_MAX_DEPTH
+ * \param  info        - returns the stream format, may be NULL
+ *
+ * \return
+ * \n      TEST_PASS  - Test Passed
+ * \n      TEST_FAIL  - Test Failed
+ *
+ */
+TEST_STATUS WAV_open(const WAV_BlockDevice *dev, Uint32 startSector,
+                     Uint16 depth, WAV_Info *info)
+{
+	Uint16 i;
+
+	if ((depth < 2) || (depth > WAV_MAX_DEPTH))
+	{
+		return (TEST_FAIL);
+	}
+
+	wavDev = dev;
+	memset(&wavStats, 0, sizeof(wavStats));
+	wavStats.depth           = depth;
+	wavStats.minBuffersReady = depth;
+
+	for (i = 0; i < WAV_MAX_DEPTH; i++)
+	{
+		wavBufWords[i] = 0;
+	}
+
+	/* The first buffer carries the header in front of the samples */
+	if (dev->read(dev->ctx, startSector, WAV_SECTORS_PER_BUF, wavBuf[0]) != 0)
+	{
+		C55x_msgWrite("WAV: read failed\n\r");
+		return (TEST_FAIL);
+	}
+
+	if (WAV_parseHeader(wavBuf[0]) != TEST_PASS)
+	{
+		C55x_msgWrite("WAV: not a 16-bit PCM file\n\r");
+		return (TEST_FAIL);
+	}
+
+	wavWordsLeft  = wavInfo.dataFrames * wavInfo.channels + wavSkipWords;
+	wavFramesLeft = wavInfo.dataFrames;
+	wavPlayBuf    = 0;
+	wavPlayPos    = wavSkipWords;
+
+	/* Buffer 0 has already been read along with the header */
+	wavNextSector        = startSector + WAV_SECTORS_PER_BUF;
+	wavStats.sectorsRead = WAV_SECTORS_PER_BUF;
+	wavBufWords[0]       = (wavWordsLeft < WAV_BUF_WORDS) ?
+	                       (Uint16)wavWordsLeft : WAV_BUF_WORDS;
+	wavWordsLeft        -= wavBufWords[0];
+
+	/* A header filling the whole buffer leaves no samples in it */
+	if (wavPlayPos >= wavBufWords[0])
+	{
+		wavBufWords[0] = 0;
+		wavPlayBuf     = 1;
+		wavPlayPos     = 0;
+	}
+
+	for (i = 1; (i < depth) && (wavWordsLeft != 0); i++)
+	{
+		if (WAV_readBuffer(i) != TEST_PASS)
+		{
+			return (TEST_FAIL);
+		}
+	}
+	wavReadBuf = i % depth;
+
+	if (info != NULL)
+	{
+		*info = wavInfo;
+	}
+
+	return (TEST_PASS);
+}
+
+/**
+ *
+ * \brief Registers a free running time source for read latency stats
+ *
+ */
+void WAV_setClock(WAV_ClockFxn clockFxn)
+{
+	wavClock = clockFxn;
+}
+
+/**
+ *
+ * \brief Refills every empty read-ahead buffer. Called from the main loop.
+ *
+ * \return Number of buffers read
+ *
+ */
+Uint16 WAV_service(void)
+{
+	Uint16 ready;
+	Uint16 filled = 0;
+	Uint16 i;
+
+	while ((wavWordsLeft != 0) && (wavBufWords[wavReadBuf] == 0))
+	{
+		ready = 0;
+		for (i = 0; i < wavStats.depth; i++)
+		{
+			if (wavBufWords[i] != 0)
+			{
+				ready++;
+			}
+		}
+		if (ready < wavStats.minBuffersReady)
+		{
+			wavStats.minBuffersReady = ready;
+		}
+
+		if (WAV_readBuffer(wavReadBuf) != TEST_PASS)
+		{
+			break;
+		}
+
+		wavReadBuf = (wavReadBuf + 1) % wavStats.depth;
+		filled++;
+	}
+
+	return (filled);
+}
+
+/* Sample words WAV_fill() can take without waiting for WAV_service(),
+ * counted up to 'needed' */
+static Uint16 WAV_wordsReady(Uint16 needed)
+{
+	Uint16 ready;
+
+	if (wavBufWords[wavPlayBuf] == 0)
+	{
+		return (0);
+	}
+
+	ready = wavBufWords[wavPlayBuf] - wavPlayPos;
+	if (ready < needed)
+	{
+		ready += wavBufWords[(wavPlayBuf + 1) % wavStats.depth];
+	}
+
+	return (ready);
+}
+
+/* Takes the next sample word, moving on to the next buffer at the end */
+static Int16 WAV_nextWord(void)
+{
+	Int16 word;
+
+	word = (Int16)wavBuf[wavPlayBuf][wavPlayPos++];
+
+	if (wavPlayPos >= wavBufWords[wavPlayBuf])
+	{
+		/* Hand the buffer back to WAV_service() */
+		wavBufWords[wavPlayBuf] = 0;
+		wavPlayBuf = (wavPlayBuf + 1) % wavStats.depth;
+		wavPlayPos = 0;
+	}
+
+	return (word);
+}
+
+/**
+ *
+ * \brief I2S_DmaFillFxn that plays the stream. Mono files are copied to
+ *        both channels; silence is output after the end of the data or
+ *        when the read-ahead has run dry.
+ *
+ *        Buffers hold whole sectors while the header ahead of the samples
+ *        can have any length, so a stereo frame may start at the end of
+ *        one buffer and finish in the next. A frame is only taken once
+ *        both of its samples are ready.
+ *
+ */
+void WAV_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg)
+{
+	Uint16 frame;
+
+	for (frame = 0; frame < frames; frame++)
+	{
+		if ((wavFramesLeft == 0) ||
+		    (WAV_wordsReady(wavInfo.channels) < wavInfo.channels))
+		{
+			if (wavFramesLeft != 0)
+			{
+				wavStats.underruns++;
+			}
+			left[frame]  = 0;
+			right[frame] = 0;
+			continue;
+		}
+
+		left[frame] = WAV_nextWord();
+		if (wavInfo.channels == 2)
+		{
+			right[frame] = WAV_nextWord();
+		}
+		else
+		{
+			right[frame] = left[frame];
+		}
+		wavFramesLeft--;
+	}
+}
+
+/**
+ *
+ * \brief Returns TRUE once every frame of the file has been played
+ *
+ */
+Bool WAV_done(void)
+{
+	return ((wavFramesLeft == 0) ? TRUE : FALSE);
+}
+
+/**
+ *
+ * \brief Copies the stream counters
+ *
+ */
+void WAV_getStats(WAV_Stats *stats)
+{
+	*stats = wavStats;
+}
+
+/**
+ *
+ * \brief Block device read backed by a stdio FILE ('ctx')
+ *
+ * \param  ctx    - FILE pointer
+ * \param  sector - first sector
+ * \param  count  - number of sectors
+ * \param  buf    - destination, WAV_SECTOR_WORDS words per sector
+ *
+ * \return 0 on success, -1 on seek error; short reads are zero padded
+ *
+ */
+Int16 WAV_fileRead(void *ctx, Uint32 sector, Uint16 count, Uint16 *buf)
+{
+	FILE          *file = (FILE *)ctx;
+	unsigned char  bytes[WAV_SECTOR_BYTES];
+	size_t         got;
+	Uint16         i;
+
+	if (fseek(file, (long)sector * WAV_SECTOR_BYTES, SEEK_SET) != 0)
+	{
+		return (-1);
+	}
+
+	while (count--)
+	{
+		got = fread(bytes, 1, WAV_SECTOR_BYTES, file);
+		memset(&bytes[got], 0, WAV_SECTOR_BYTES - got);
+
+		/* Pack byte pairs, also correct where a char is 16 bits wide */
+		for (i = 0; i < WAV_SECTOR_WORDS; i++)
+		{
+			buf[i] = (Uint16)(bytes[2 * i] & 0xFF) |
+			         ((Uint16)(bytes[2 * i + 1] & 0xFF) << 8);
+		}
+		buf += WAV_SECTOR_WORDS;
+	}
+
+	return (0);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2016, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*! \file wav_stream.h
+*
+*   \brief Streaming PCM/WAV player reading from a block device with
+*          multi-buffered read-ahead.
+*
+*/
+
+#ifndef _WAV_STREAM_H_
+#define _WAV_STREAM_H_
+
+#include "audio_common.h"
+
+#define WAV_SECTOR_BYTES        (512)
+#define WAV_SECTOR_WORDS        (WAV_SECTOR_BYTES / 2)
+
+/* Each read-ahead buffer holds this many sectors */
+#define WAV_SECTORS_PER_BUF     (4)
+#define WAV_BUF_WORDS           (WAV_SECTORS_PER_BUF * WAV_SECTOR_WORDS)
+
+/* Deepest read-ahead supported by WAV_open() */
+#define WAV_MAX_DEPTH           (4)
+
+/**
+ * \brief Block device. 'read' fills 'buf' with 'count' sectors starting at
+ *        'sector', one little-endian 16-bit word per two bytes, and
+ *        returns 0 on success.
+ */
+typedef struct
+{
+	Int16  (*read)(void *ctx, Uint32 sector, Uint16 count, Uint16 *buf);
+	void    *ctx;
+} WAV_BlockDevice;
+
+typedef struct
+{
+	Uint32  sampleRate;
+	Uint16  channels;       /* 1 or 2                */
+	Uint32  dataFrames;     /* frames in the file    */
+} WAV_Info;
+
+typedef struct
+{
+	Uint16  depth;              /* read-ahead buffers                     */
+	Uint32  sectorsRead;
+	Uint32  readErrors;
+	Uint32  underruns;          /* fill found no buffer ready             */
+	Uint16  minBuffersReady;    /* lowest read-ahead level before a read  */
+	Uint32  worstReadTime;      /* longest device read, WAV_ClockFxn units */
+} WAV_Stats;
+
+/* Optional time source used to measure device read latency */
+typedef Uint32 (*WAV_ClockFxn)(void);
+
+TEST_STATUS WAV_open(const WAV_BlockDevice *dev, Uint32 startSector,
+                     Uint16 depth, WAV_Info *info);
+void   WAV_setClock(WAV_ClockFxn clockFxn);
+Uint16 WAV_service(void);
+void   WAV_fill(Int16 *left, Int16 *right, Uint16 frames, void *arg);
+Bool   WAV_done(void);
+void   WAV_getStats(WAV_Stats *stats);
+
+Int16  WAV_fileRead(void *ctx, Uint32 sector, Uint16 count, Uint16 *buf);
+
+#endif /* _WAV_STREAM_H_ */